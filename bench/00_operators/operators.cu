@@ -31,3 +31,136 @@ void vector_add(nvbench::state &state, nvbench::type_list<ValueType>)
 
 NVBENCH_BENCH_TYPES(vector_add, NVBENCH_TYPE_AXES(vec_add_types))
   .add_int64_power_of_two_axis("Vector size", nvbench::range(22, 28, 1));
+
+/* Element-wise benchmarks on contiguous rank-3 and rank-4 tensors, launched
+ * at their own rank or with their dimensions merged by exec() */
+template <typename ValueType>
+void collapse_add_rank3(nvbench::state &state, nvbench::type_list<ValueType>)
+{
+  const index_t n = static_cast<index_t>(state.get_int64("Size"));
+  const bool collapse = state.get_int64("Collapse") != 0;
+
+  state.add_element_count(n * n * n, "NumElements");
+  state.add_global_memory_reads<ValueType>(2 * n * n * n, "DataSize");
+  state.add_global_memory_writes<ValueType>(n * n * n);
+
+  tensor_t<ValueType, 3> xv{{n, n, n}};
+  tensor_t<ValueType, 3> xv2{{n, n, n}};
+  xv.PrefetchDevice(0);
+  xv2.PrefetchDevice(0);
+
+  state.exec([&xv, &xv2, collapse](nvbench::launch &launch) {
+    if (collapse) {
+      exec(set(xv, xv + xv2), launch.get_stream());
+    }
+    else {
+      ExecKernel(set(xv, xv + xv2), launch.get_stream());
+    }
+  });
+}
+
+NVBENCH_BENCH_TYPES(collapse_add_rank3, NVBENCH_TYPE_AXES(vec_add_types))
+  .add_int64_power_of_two_axis("Size", nvbench::range(7, 9, 1))
+  .add_int64_axis("Collapse", {0, 1});
+
+template <typename ValueType>
+void collapse_add_rank4(nvbench::state &state, nvbench::type_list<ValueType>)
+{
+  const index_t n = static_cast<index_t>(state.get_int64("Size"));
+  const bool collapse = state.get_int64("Collapse") != 0;
+
+  state.add_element_count(n * n * n * n, "NumElements");
+  state.add_global_memory_reads<ValueType>(2 * n * n * n * n, "DataSize");
+  state.add_global_memory_writes<ValueType>(n * n * n * n);
+
+  tensor_t<ValueType, 4> xv{{n, n, n, n}};
+  tensor_t<ValueType, 4> xv2{{n, n, n, n}};
+  xv.PrefetchDevice(0);
+  xv2.PrefetchDevice(0);
+
+  state.exec([&xv, &xv2, collapse](nvbench::launch &launch) {
+    if (collapse) {
+      exec(set(xv, xv * xv2 + xv), launch.get_stream());
+    }
+    else {
+      ExecKernel(set(xv, xv * xv2 + xv), launch.get_stream());
+    }
+  });
+}
+
+NVBENCH_BENCH_TYPES(collapse_add_rank4, NVBENCH_TYPE_AXES(vec_add_types))
+  .add_int64_power_of_two_axis("Size", nvbench::range(4, 6, 1))
+  .add_int64_axis("Collapse", {0, 1});
+
+/* Element-wise benchmark on strided rank-2 views that can't be merged, with
+ * 64-bit kernel and offset arithmetic or the 32-bit indices exec() picks when
+ * the views fit */
+template <typename ValueType>
+void index_width_add(nvbench::state &state, nvbench::type_list<ValueType>)
+{
+  const index_t n = static_cast<index_t>(state.get_int64("Size"));
+  const bool narrow = state.get_int64("Narrow") != 0;
+
+  state.add_element_count(n * n, "NumElements");
+  state.add_global_memory_reads<ValueType>(2 * n * n, "DataSize");
+  state.add_global_memory_writes<ValueType>(n * n);
+
+  tensor_t<ValueType, 2> xt{{n, n + 1}};
+  tensor_t<ValueType, 2> xt2{{n, n + 1}};
+  xt.PrefetchDevice(0);
+  xt2.PrefetchDevice(0);
+  auto xv = xt.Slice({0, 0}, {matxEnd, n});
+  auto xv2 = xt2.Slice({0, 0}, {matxEnd, n});
+
+  state.exec([&xv, &xv2, narrow](nvbench::launch &launch) {
+    if (narrow) {
+      exec(set(xv, xv * xv2 + xv), launch.get_stream());
+    }
+    else {
+      ExecKernel(set(xv, xv * xv2 + xv), launch.get_stream());
+    }
+  });
+}
+
+NVBENCH_BENCH_TYPES(index_width_add, NVBENCH_TYPE_AXES(vec_add_types))
+  .add_int64_power_of_two_axis("Size", nvbench::range(10, 14, 1))
+  .add_int64_axis("Narrow", {0, 1});
+
+/* Chain of element-wise statements through a temporary, launched one kernel
+ * per statement or fused into one kernel by a deferred queue */
+template <typename ValueType>
+void deferred_chain(nvbench::state &state, nvbench::type_list<ValueType>)
+{
+  const index_t n = static_cast<index_t>(state.get_int64("Vector size"));
+  const bool deferred = state.get_int64("Deferred") != 0;
+
+  state.add_element_count(n, "NumElements");
+
+  tensor_t<ValueType, 1> xv{{n}};
+  tensor_t<ValueType, 1> xv2{{n}};
+  tensor_t<ValueType, 1> tmp{{n}};
+  tensor_t<ValueType, 1> yv{{n}};
+  xv.PrefetchDevice(0);
+  xv2.PrefetchDevice(0);
+  tmp.PrefetchDevice(0);
+  yv.PrefetchDevice(0);
+
+  state.exec([&xv, &xv2, &tmp, &yv, deferred](nvbench::launch &launch) {
+    const cudaStream_t stream = launch.get_stream();
+    if (deferred) {
+      deferred_begin(stream);
+    }
+
+    (tmp = xv * xv2).run(stream);
+    (tmp = tmp + xv).run(stream);
+    (yv = tmp * xv2 - xv).run(stream);
+
+    if (deferred) {
+      deferred_end(stream);
+    }
+  });
+}
+
+NVBENCH_BENCH_TYPES(deferred_chain, NVBENCH_TYPE_AXES(vec_add_types))
+  .add_int64_power_of_two_axis("Vector size", nvbench::range(16, 26, 2))
+  .add_int64_axis("Deferred", {0, 1});
@@ -53,4 +53,65 @@ void fft1d_batches_pow_2(nvbench::state &state, nvbench::type_list<ValueType>)
       [&xv](nvbench::launch &launch) { fft(xv, xv, launch.get_stream()); });
 }
 NVBENCH_BENCH_TYPES(fft1d_batches_pow_2, NVBENCH_TYPE_AXES(fft_types))
-    .add_int64_power_of_two_axis("FFT size", nvbench::range(10, 18, 1));
\ No newline at end of file
+    .add_int64_power_of_two_axis("FFT size", nvbench::range(10, 18, 1));
+/* Host spectrogram, run eagerly or replayed from a captured host graph. The
+ * frames are split in two halves so the graph can run them concurrently. */
+template <typename ValueType>
+void fft1d_host_spectrogram(nvbench::state &state,
+                            nvbench::type_list<ValueType>)
+{
+  using rtype = typename ValueType::value_type;
+  const index_t nfft = 256;
+  const index_t hop = 128;
+  const index_t nframes = 2048;
+  const bool captured = state.get_int64("Captured") != 0;
+
+  tensor_t<rtype, 1> xv{{(nframes - 1) * hop + nfft}};
+  tensor_t<ValueType, 2> sv{{nframes, nfft / 2 + 1}};
+  tensor_t<rtype, 2> pv{{nframes, nfft / 2 + 1}};
+  for (index_t i = 0; i < xv.Size(0); i++) {
+    xv(i) = static_cast<rtype>(i % 17);
+  }
+
+  auto frames = xv.OverlapView({nfft}, {hop});
+  auto spectrogram = [&](const matxHostExecutor_t &exec) {
+    for (index_t h = 0; h < 2; h++) {
+      auto in = frames.Slice({h * nframes / 2, 0},
+                             {(h + 1) * nframes / 2, matxEnd});
+      auto spec =
+          sv.Slice({h * nframes / 2, 0}, {(h + 1) * nframes / 2, matxEnd});
+      auto pwr =
+          pv.Slice({h * nframes / 2, 0}, {(h + 1) * nframes / 2, matxEnd});
+      fft(spec, in, exec);
+
+      auto power = [spec, pwr](const matxHostExecutor_t &) mutable {
+        for (index_t f = 0; f < spec.Size(0); f++) {
+          for (index_t k = 0; k < spec.Size(1); k++) {
+            pwr(f, k) = cuda::std::norm(spec(f, k));
+          }
+        }
+      };
+      if (!HostGraphRecord(exec, {HostRead(spec), HostWrite(pwr)}, power)) {
+        power(exec);
+      }
+    }
+  };
+
+  matxHostExecutor_t exec{4};
+  matxHostGraph_t graph;
+  if (captured) {
+    spectrogram(graph.BeginCapture(exec));
+    graph.EndCapture();
+  }
+
+  state.exec(nvbench::exec_tag::sync, [&](nvbench::launch &) {
+    if (captured) {
+      graph.Replay();
+    }
+    else {
+      spectrogram(exec);
+    }
+  });
+}
+NVBENCH_BENCH_TYPES(fft1d_host_spectrogram, NVBENCH_TYPE_AXES(fft_types))
+    .add_int64_axis("Captured", {0, 1});
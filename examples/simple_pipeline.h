@@ -32,46 +32,12 @@
 
 #pragma once
 #include "matx.h"
+#include "matx_radar.h"
 #include <memory>
 #include <stdint.h>
 
 using namespace matx;
 
-template <class O, class I1, class I2, class I3, class I4>
-class calcDets : public BaseOp<calcDets<O, I1, I2, I3, I4>> {
-private:
-  O out_;
-  I1 xpow_;
-  I2 ba_;
-  I3 norm_;
-  I4 pfa_;
-
-public:
-  calcDets(O out, I1 xpow, I2 ba, I3 norm, I4 pfa)
-      : out_(out), xpow_(xpow), ba_(ba), norm_(norm), pfa_(pfa)
-  {
-  }
-
-  __device__ inline void operator()(index_t idz, index_t idy, index_t idx)
-  {
-    typename I1::type xpow = xpow_(idz, idy, idx);
-    typename I2::type ba = ba_(idz, idy, idx);
-    typename I2::type norm = norm_(idz, idy, idx);
-    typename I2::type alpha = norm * (std::pow(pfa_, -1.0 / norm) - 1);
-    out_(idz, idy, idx) = (xpow > alpha * ba) ? 1 : 0;
-  }
-
-  __host__ __device__ inline index_t Size(uint32_t i) const
-  {
-    return out_.Size(i);
-  }
-
-  static inline constexpr __host__ __device__ int32_t Rank()
-  {
-    return O::Rank();
-  }
-};
-
 template <typename ComplexType = cuda::std::complex<float>>
 class RadarPipeline {
 
@@ -80,15 +46,12 @@ public:
   ~RadarPipeline()
   {
     delete waveformView;
-    delete norms;
     delete inputView;
     delete tpcView;
     delete cancelMask;
-    delete normT;
     delete ba;
     delete dets;
     delete xPow;
-    delete cfarMaskView;
   }
 
   RadarPipeline(const index_t _numPulses, const index_t _numSamples,
@@ -110,15 +73,11 @@ public:
 
     // waveform is of length waveform data but we pad to numSamples for fft
     waveformView = new tensor_t<ComplexType, 1>({numSamplesRnd});
-    norms = new tensor_t<typename ComplexType::value_type, 0>();
     inputView = new tensor_t<ComplexType, 3>(
         {numChannels, numPulses, numSamplesRnd});
     tpcView = new tensor_t<ComplexType, 3>(
         {numChannels, numPulsesRnd, numCompressedSamples});
     cancelMask = new tensor_t<typename ComplexType::value_type, 1>({3});
-    normT = new tensor_t<typename ComplexType::value_type, 3>(
-        {numChannels, numPulsesRnd + cfarMaskY - 1,
-         numCompressedSamples + cfarMaskX - 1});
     ba = new tensor_t<typename ComplexType::value_type, 3>(
         {numChannels, numPulsesRnd + cfarMaskY - 1,
          numCompressedSamples + cfarMaskX - 1});
@@ -134,42 +93,10 @@ public:
 
     cancelMask->SetVals({1, -2, 1});
 
-    cfarMaskView = new tensor_t<typename ComplexType::value_type, 2>(
-        {cfarMaskY, cfarMaskX});
-    // Mask for cfar detection
-    // G == guard, R == reference, C == CUT
-    // mask = [
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R G G G R ;
-    //    R G C G R ;
-    //    R G G G R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ;
-    //    R R R R R ];
-    //  }
-    cfarMaskView->SetVals({{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 1, 1},
-                           {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}});
-
-    // Pre-process CFAR convolution
-    conv2d(*normT, ones({numChannels, numPulsesRnd, numCompressedSamples}),
-           *cfarMaskView, matxConvCorrMode_t::MATX_C_MODE_FULL, stream);
-
     cancelMask->PrefetchDevice(stream);
     ba->PrefetchDevice(stream);
-    normT->PrefetchDevice(stream);
-    cfarMaskView->PrefetchDevice(stream);
     dets->PrefetchDevice(stream);
     waveformView->PrefetchDevice(stream);
-    norms->PrefetchDevice(stream);
     inputView->PrefetchDevice(stream);
     tpcView->PrefetchDevice(stream);
     xPow->PrefetchDevice(stream);
@@ -200,11 +127,9 @@ public:
     // just an element-wise weighting by a pre-computed window function.
     (waveformPart = waveformPart * hamming_x({waveformLength})).run(stream);
 
-    // compute L2 norm
-    sum(*norms, norm(waveformPart), stream);
-    (*norms = sqrt(*norms)).run(stream);
-
-    (waveformPart = waveformPart / *norms).run(stream);
+    // normalize by the L2 norm. The sum is reduced first and the division
+    // reads it in the same kernel that writes the waveform.
+    (waveformPart = waveformPart / sqrt(sum(norm(waveformPart)))).run(stream);
     fft(waveformFull, waveformPart, stream);
     (waveformFull = conj(waveformFull)).run(stream);
 
@@ -247,7 +172,8 @@ public:
   //       SciTech Publishing, Inc., 2010.  Section 17.5.
 
   // Apply a window in pulse to suppress sidelobes. Using a Hamming window for
-  // simplicity, but others would work. repmat().
+  // simplicity, but others would work. The window is applied as the pulses are
+  // loaded for the FFT, and the pulses lost to the canceller are zero-padded.
   void DopplerProcessing()
   {
     const index_t cpulses = numPulses - (cancelMask->Size(0) - 1);
@@ -255,12 +181,7 @@ public:
     auto xc =
         tpcView->Slice({0, 0, 0}, {numChannels, cpulses, numCompressedSamples});
 
-    auto xf = tpcView->Permute({0, 2, 1});
-
-    (xc = xc * hamming_y({numChannels, numPulses - (cancelMask->Size(0) - 1),
-                          numCompressedSamples}))
-        .run(stream);
-    fft(xf, xf, stream);
+    signal::doppler(*tpcView, xc, 1, WINDOW_TYPE_HAMMING, stream);
   }
 
   // Stage 4 - Constant False Alarm Rate (CFAR) Detector - averaging or median
@@ -287,11 +208,14 @@ public:
   // guard cells form a hole within the training window, but CA-CFAR is
   // largely just an averaging filter otherwise with a threshold check
   // at each pixel after applying the filter.
-  // Currently, the window below is defined statically because it is then
-  // easy to visualize, but more typically the number of guard and
-  // reference cells would be given as input and the window would be
-  // constructed; we could update to such an approach, but I'm keeping
-  // it simple for now.
+  // The window is given as guard and reference cell half-widths along the
+  // pulse and range axes. With 1 guard cell on each side in both axes and 1
+  // and 5 reference cells beyond them, it looks like this:
+  //    R R R R R R R R R R R R R
+  //    R R R R R G G G R R R R R
+  //    R R R R R G C G R R R R R
+  //    R R R R R G G G R R R R R
+  //    R R R R R R R R R R R R R
 
   // We apply CFAR to the power of X; X is still complex until this point
   // Xpow = abs(X).^2;
@@ -299,43 +223,23 @@ public:
   {
     (*xPow = norm(*tpcView)).run(stream);
 
-    // Estimate the background average power in each cell
-    // background_averages = conv2(Xpow, mask, 'same') ./ norm;
-    conv2d(*ba, *xPow, *cfarMaskView, matxConvCorrMode_t::MATX_C_MODE_FULL,
-           stream);
-
-    // Computing number of cells contributing to each cell.
-    // This can be done with a convolution of the cfarMask with
-    // ones.
-    // norm = conv2(ones(size(X)), mask, 'same');
-    auto normTrim = normT->Slice({0, cfarMaskY / 2, cfarMaskX / 2},
-                                 {numChannels, numPulsesRnd + cfarMaskY / 2,
-                                  numCompressedSamples + cfarMaskX / 2});
-
     auto baTrim = ba->Slice({0, cfarMaskY / 2, cfarMaskX / 2},
                             {numChannels, numPulsesRnd + cfarMaskY / 2,
                              numCompressedSamples + cfarMaskX / 2});
-    (baTrim = baTrim / normTrim).run(stream);
 
     // The scalar alpha is used as a multiplier on the background averages
     // to achieve a constant false alarm rate (under certain assumptions);
     // it is based upon the desired probability of false alarm (Pfa) and
     // number of reference cells used to estimate the background for the
-    // CUT. For the purposes of computation, it can be assumed as a given
-    // constant, although it does vary at the edges due to the different
-    // training windows.
+    // CUT. It varies at the edges due to the different training windows,
+    // which cfar() accounts for by counting the reference cells each CUT
+    // actually uses.
     // Declare a detection if the power exceeds the background estimate
     // times alpha for a particular cell.
     // dets(find(Xpow > alpha.*background_averages)) = 1;
-
-    // These 2 branches are functionally equivalent.  A custom op is more
-    // efficient as it can avoid repeated loads.
-#if 0
-            IFELSE(*xPow > normTrim*(pow(pfa, -1.0f/normTrim) - 1.0f)*baTrim,
-                        *dets = 1, *dets = 0).run(stream);
-#else
-    calcDets(*dets, *xPow, baTrim, normTrim, pfa).run(stream);
-#endif
+    signal::cfar(*dets, baTrim, *xPow, {cfarGuardY, cfarGuardX},
+                 {cfarMaskY / 2 - cfarGuardY, cfarMaskX / 2 - cfarGuardX}, pfa,
+                 signal::CFAR_TYPE_CA, stream);
   }
 
   auto GetInputView() { return inputView; }
@@ -348,8 +252,6 @@ public:
 
   auto GetBackgroundAverages() { return *ba; }
 
-  auto GetnormT() { return *normT; }
-
 private:
   index_t numPulses;
   index_t numSamples;
@@ -360,19 +262,18 @@ private:
   index_t numChannels;
   const index_t cfarMaskX = 13;
   const index_t cfarMaskY = 5;
+  const index_t cfarGuardX = 1;
+  const index_t cfarGuardY = 1;
 
   static const constexpr float pfa = 1e-5f;
 
-  tensor_t<typename ComplexType::value_type, 3> *normT = nullptr;
   tensor_t<typename ComplexType::value_type, 3> *ba = nullptr;
   tensor_t<int, 3> *dets = nullptr;
   tensor_t<typename ComplexType::value_type, 1> *cancelMask = nullptr;
   tensor_t<typename ComplexType::value_type, 3> *xPow = nullptr;
   tensor_t<ComplexType, 1> *waveformView = nullptr;
-  tensor_t<typename ComplexType::value_type, 0> *norms = nullptr;
   tensor_t<ComplexType, 3> *inputView = nullptr;
   tensor_t<ComplexType, 3> *tpcView = nullptr;
-  tensor_t<typename ComplexType::value_type, 2> *cfarMaskView = nullptr;
 
   cudaStream_t stream;
 };
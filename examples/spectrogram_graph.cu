@@ -31,6 +31,7 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #include "matx.h"
+#include "matx_signal.h"
 #include "matx_viz.h"
 #include <cassert>
 #include <cstdio>
@@ -57,7 +58,6 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
 
   auto gil = pybind11::scoped_interpreter{};
 
-  using complex = cuda::std::complex<float>;
   cudaGraph_t graph;
   cudaGraphExec_t instance;
 
@@ -88,8 +88,7 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
   tensor_t<float, 1> noise({N});
   tensor_t<float, 1> x({N});
   tensor_t<float, 1> freqs(half_win);
-  tensor_t<complex, 2> fftStackedMatrix(
-      {(N - noverlap) / nstep, nfft / 2 + 1});
+  tensor_t<float, 2> Sxx_frames({(N - noverlap) / nstep, nfft / 2 + 1});
   tensor_t<float, 1> s_time({(N - noverlap) / nstep});
 
   randomGenerator_t<float> randData({N}, 0);
@@ -121,15 +120,12 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char **argv)
                linspace_x(half_win, 0.0f, static_cast<float>(nfft) / 2.0f))
         .run(stream);
 
-    // Create overlapping matrix of segments.
-    auto stackedMatrix = x.OverlapView({nperseg}, {nstep});
-    // FFT along rows
-    fft(fftStackedMatrix, stackedMatrix, stream);
-    // Absolute value
-    (fftStackedMatrix = conj(fftStackedMatrix) * fftStackedMatrix)
-        .run(stream);
-    // Get real part and transpose
-    auto Sxx = fftStackedMatrix.RealView().Permute({1, 0});
+    // Power of the FFT of each overlapping segment, with a rectangular
+    // window
+    signal::spectrogram(Sxx_frames, x, ones<float>({nperseg}), nperseg,
+                        noverlap, stream);
+    // Transpose to frequency by time
+    auto Sxx = Sxx_frames.Permute({1, 0});
 
     // Spectral time axis
     (s_time = linspace_x(s_time_shape, static_cast<float>(nperseg) / 2.0f,
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define AMBGFUN_BLOCK_SIZE 256
+
+namespace matx {
+namespace signal {
+
+/**
+ * Sample i of a signal, or zero past its end
+ */
+template <typename T, typename InType>
+__host__ __device__ inline T AmbgInput(InType &x, index_t i, index_t len)
+{
+  return i < len ? static_cast<T>(x(i)) : T(0);
+}
+
+/**
+ * Element c of row r of the 2D ambiguity buffer, conjugated so a forward FFT
+ * along the row has the magnitude of the unnormalized inverse FFT:
+ * conj(y[c] conj(x[c - (xlen - 1) + r])). Columns past xlen are the zero
+ * padding of the FFT.
+ */
+template <typename T, typename XType, typename YType>
+__host__ __device__ inline T Ambg2DInput(XType &x, YType &y, index_t xlen,
+                                         index_t ylen, index_t r, index_t c)
+{
+  const index_t xc = c - (xlen - 1) + r;
+  if (c >= xlen || xc < 0 || xc >= xlen) {
+    return T(0);
+  }
+
+  return cuda::std::conj(AmbgInput<T>(y, c, ylen)) * static_cast<T>(x(xc));
+}
+
+/**
+ * Rotate bin k of the zero-delay cut's x spectrum by the Doppler cut, with
+ * the frequency of bin k taken as -fs / 2 + k fs / n, and conjugate it so the
+ * next forward FFT gives the conjugated, unscaled inverse
+ */
+template <typename T>
+__host__ __device__ inline T AmbgDelayRotate(const T &v, index_t k, index_t n,
+                                             double fs, double cut)
+{
+  using R = value_type_t<T>;
+  const double f = -fs / 2.0 + static_cast<double>(k) * fs /
+                                   static_cast<double>(n);
+  double s, c;
+  sincos(2.0 * M_PI * f * cut, &s, &c);
+  return cuda::std::conj(v * T{static_cast<R>(c), static_cast<R>(s)});
+}
+
+/**
+ * Magnitude of element (j + shift) mod n of a row, scaled. A shift of
+ * (n + 1) / 2 is an fftshift and n / 2 is an ifftshift.
+ */
+template <typename T>
+__host__ __device__ inline value_type_t<T>
+AmbgMagnitude(const T *row, index_t j, index_t n, index_t shift, double scale)
+{
+  return static_cast<value_type_t<T>>(
+      static_cast<double>(cuda::std::abs(row[(j + shift) % n])) * scale);
+}
+
+/**
+ * Scale that normalizes the output by the energies of x and y
+ */
+__host__ __device__ inline double AmbgScale(const float *ex, const float *ey,
+                                            double scale)
+{
+  return scale / sqrt(static_cast<double>(*ex) * static_cast<double>(*ey));
+}
+
+/**
+ * Fill the 2D ambiguity buffer in a single pass, including its zero padding.
+ * Rows are on the x grid dimension since there can be more than 65535.
+ */
+template <typename T, typename XType, typename YType>
+__global__ void AmbgLoad2D(T *buf, XType x, YType y, index_t xlen,
+                           index_t ylen, index_t nfreq)
+{
+  const index_t r = blockIdx.x;
+  const index_t c = static_cast<index_t>(blockIdx.y) * blockDim.x +
+                    threadIdx.x;
+  if (c >= nfreq) {
+    return;
+  }
+
+  buf[r * nfreq + c] = Ambg2DInput<T>(x, y, xlen, ylen, r, c);
+}
+
+/**
+ * Load a zero-padded signal into an FFT row, mixed up by omega radians per
+ * sample
+ */
+template <typename T, typename InType>
+__global__ void AmbgLoadRow(T *buf, InType x, index_t len, index_t n,
+                            double omega)
+{
+  using R = value_type_t<T>;
+  const index_t i = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (i >= n) {
+    return;
+  }
+
+  T v = AmbgInput<T>(x, i, len);
+  if (omega != 0.0 && i < len) {
+    double s, c;
+    sincos(omega * static_cast<double>(i), &s, &c);
+    v *= T{static_cast<R>(c), static_cast<R>(s)};
+  }
+  buf[i] = v;
+}
+
+template <typename T>
+__global__ void AmbgDelayShift(T *buf, index_t n, double fs, double cut)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k >= n) {
+    return;
+  }
+
+  buf[k] = AmbgDelayRotate(buf[k], k, n, fs, cut);
+}
+
+/**
+ * Multiply the zero-padded y by the conjugated, shifted x and conjugate the
+ * product for the final forward FFT of the zero-Doppler cut
+ */
+template <typename T, typename YType>
+__global__ void AmbgDelayMul(T *buf, YType y, index_t ylen, index_t n)
+{
+  const index_t m = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (m >= n) {
+    return;
+  }
+
+  buf[m] = cuda::std::conj(AmbgInput<T>(y, m, ylen) * buf[m]);
+}
+
+/**
+ * Cross spectrum of the two rows of the zero-delay buffer, conjugated into
+ * the first row for the final forward FFT
+ */
+template <typename T> __global__ void AmbgDopplerMul(T *buf, index_t n)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k >= n) {
+    return;
+  }
+
+  buf[k] = cuda::std::conj(buf[k] * cuda::std::conj(buf[n + k]));
+}
+
+/**
+ * Write the shifted magnitude of each row of the FFT buffer straight into the
+ * real output
+ */
+template <typename OutType, typename T>
+__global__ void AmbgMag(OutType amf, const T *buf, index_t n, index_t shift,
+                        const float *ex, const float *ey, double scale)
+{
+  const index_t r = blockIdx.x;
+  const index_t j = static_cast<index_t>(blockIdx.y) * blockDim.x +
+                    threadIdx.x;
+  if (j >= n) {
+    return;
+  }
+
+  amf(r, j) = static_cast<typename OutType::scalar_type>(AmbgMagnitude(
+      buf + r * n, j, n, shift, AmbgScale(ex, ey, scale)));
+}
+
+}; // namespace signal
+}; // namespace matx
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cmath>
+#include <stdint.h>
+
+#define CFAR_BLOCK_SIZE 256
+#define CFAR_ROWS_PER_BLOCK (CFAR_BLOCK_SIZE / 32)
+
+namespace matx {
+namespace signal {
+
+/**
+ * CFAR detector variants
+ */
+typedef enum {
+  CFAR_TYPE_CA, ///< Cell averaging over all reference cells
+  CFAR_TYPE_GO, ///< Greater of the leading and lagging averages
+  CFAR_TYPE_SO, ///< Smaller of the leading and lagging averages
+  CFAR_TYPE_OS, ///< Ordered statistic of the reference cells
+} cfarType_t;
+
+/**
+ * CFAR window and threshold settings, passed by value to kernels
+ */
+struct cfarWindow_t {
+  index_t guard_r; // Guard half-width along rows (slow axis)
+  index_t guard_c; // Guard half-width along columns (fast axis)
+  index_t ref_r;   // Reference cells beyond the guard along rows
+  index_t ref_c;   // Reference cells beyond the guard along columns
+  cfarType_t type;
+  double pfa;
+  double os_rank; // Fraction of the reference cells giving the OS rank
+};
+
+template <typename TensorType>
+__host__ __device__ inline decltype(auto) CfarElem(TensorType &t, index_t b,
+                                                   index_t r, index_t c)
+{
+  if constexpr (TensorType::Rank() == 2) {
+    return t(r, c);
+  }
+  else {
+    return t(b, r, c);
+  }
+}
+
+/**
+ * Sum of the inclusive rectangle [r0, r1] x [c0, c1] from a summed-area table
+ * with a leading row and column of zeros. Empty rectangles sum to zero.
+ */
+__host__ __device__ inline double CfarRectSum(const double *sat, index_t ld,
+                                              index_t r0, index_t r1,
+                                              index_t c0, index_t c1)
+{
+  if (r0 > r1 || c0 > c1) {
+    return 0.0;
+  }
+
+  return sat[(r1 + 1) * ld + c1 + 1] - sat[r0 * ld + c1 + 1] -
+         sat[(r1 + 1) * ld + c0] + sat[r0 * ld + c0];
+}
+
+__host__ __device__ inline index_t CfarRectArea(index_t r0, index_t r1,
+                                                index_t c0, index_t c1)
+{
+  return (r0 > r1 || c0 > c1) ? 0 : (r1 - r0 + 1) * (c1 - c0 + 1);
+}
+
+/**
+ * Threshold multiplier for n reference cells. For CA, GO and SO this is the
+ * cell-averaging result alpha = n * (pfa^(-1/n) - 1), using the number of
+ * cells that formed the average. For OS the k-th smallest of n cells has
+ * Pfa = prod_{i<k} (n - i) / (n - i + alpha), which is solved by bisection.
+ */
+__host__ __device__ inline double CfarAlpha(cfarType_t type, index_t n,
+                                            index_t k, double pfa)
+{
+  if (n <= 0) {
+    return 0.0;
+  }
+
+  const double dn = static_cast<double>(n);
+  if (type != CFAR_TYPE_OS) {
+    return dn * (pow(pfa, -1.0 / dn) - 1.0);
+  }
+
+  const double target = log(pfa);
+  auto log_pfa = [&](double alpha) {
+    double l = 0.0;
+    for (index_t i = 0; i < k; i++) {
+      const double m = static_cast<double>(n - i);
+      l += log(m / (m + alpha));
+    }
+    return l;
+  };
+
+  double lo = 0.0;
+  double hi = 1.0;
+  while (log_pfa(hi) > target && hi < 1e30) {
+    hi *= 2.0;
+  }
+
+  for (int it = 0; it < 64; it++) {
+    const double mid = 0.5 * (lo + hi);
+    if (log_pfa(mid) > target) {
+      lo = mid;
+    }
+    else {
+      hi = mid;
+    }
+  }
+
+  return 0.5 * (lo + hi);
+}
+
+/**
+ * Evaluate one cell under test. Window bounds are clipped to the data, and the
+ * number of reference cells is computed from the clipped rectangles, so edge
+ * cells are normalized by exactly the cells they average. CA, GO and SO are
+ * O(1) per cell from the summed-area table. OS has to look at the reference
+ * values themselves and is O(n^2) in the number of reference cells.
+ *
+ * @returns
+ *   Background estimate, with the threshold multiplier in alpha
+ */
+template <typename InType>
+__host__ __device__ inline double
+CfarCell(InType &x, const double *sat, index_t b, index_t rows, index_t cols,
+         index_t r, index_t c, const cfarWindow_t &w, double &alpha)
+{
+  const index_t ld = cols + 1;
+  const index_t wr0 = r - w.guard_r - w.ref_r < 0 ? 0 : r - w.guard_r - w.ref_r;
+  const index_t wr1 = r + w.guard_r + w.ref_r >= rows
+                          ? rows - 1
+                          : r + w.guard_r + w.ref_r;
+  const index_t wc0 = c - w.guard_c - w.ref_c < 0 ? 0 : c - w.guard_c - w.ref_c;
+  const index_t wc1 = c + w.guard_c + w.ref_c >= cols
+                          ? cols - 1
+                          : c + w.guard_c + w.ref_c;
+  const index_t gr0 = r - w.guard_r < 0 ? 0 : r - w.guard_r;
+  const index_t gr1 = r + w.guard_r >= rows ? rows - 1 : r + w.guard_r;
+  const index_t gc0 = c - w.guard_c < 0 ? 0 : c - w.guard_c;
+  const index_t gc1 = c + w.guard_c >= cols ? cols - 1 : c + w.guard_c;
+
+  if (w.type == CFAR_TYPE_CA) {
+    const index_t n =
+        CfarRectArea(wr0, wr1, wc0, wc1) - CfarRectArea(gr0, gr1, gc0, gc1);
+    const double s = CfarRectSum(sat, ld, wr0, wr1, wc0, wc1) -
+                     CfarRectSum(sat, ld, gr0, gr1, gc0, gc1);
+    alpha = CfarAlpha(w.type, n, 0, w.pfa);
+    return n > 0 ? s / static_cast<double>(n) : 0.0;
+  }
+
+  if (w.type == CFAR_TYPE_GO || w.type == CFAR_TYPE_SO) {
+    // Leading and lagging halves along the fast axis, excluding the column of
+    // the cell under test
+    const index_t nl = CfarRectArea(wr0, wr1, wc0, c - 1) -
+                       CfarRectArea(gr0, gr1, gc0, c - 1);
+    const index_t nt = CfarRectArea(wr0, wr1, c + 1, wc1) -
+                       CfarRectArea(gr0, gr1, c + 1, gc1);
+    const double sl = CfarRectSum(sat, ld, wr0, wr1, wc0, c - 1) -
+                      CfarRectSum(sat, ld, gr0, gr1, gc0, c - 1);
+    const double st = CfarRectSum(sat, ld, wr0, wr1, c + 1, wc1) -
+                      CfarRectSum(sat, ld, gr0, gr1, c + 1, gc1);
+
+    // At an edge only one side has reference cells
+    if (nl == 0 || nt == 0) {
+      const index_t n = nl + nt;
+      alpha = CfarAlpha(w.type, n, 0, w.pfa);
+      return n > 0 ? (sl + st) / static_cast<double>(n) : 0.0;
+    }
+
+    const double ml = sl / static_cast<double>(nl);
+    const double mt = st / static_cast<double>(nt);
+    const bool left = (w.type == CFAR_TYPE_GO) ? (ml >= mt) : (ml <= mt);
+    alpha = CfarAlpha(w.type, left ? nl : nt, 0, w.pfa);
+    return left ? ml : mt;
+  }
+
+  // Ordered statistic: the k-th smallest reference cell is the one with fewer
+  // than k smaller cells and at least k smaller-or-equal cells
+  const index_t n =
+      CfarRectArea(wr0, wr1, wc0, wc1) - CfarRectArea(gr0, gr1, gc0, gc1);
+  if (n <= 0) {
+    alpha = 0.0;
+    return 0.0;
+  }
+
+  index_t k = static_cast<index_t>(ceil(w.os_rank * static_cast<double>(n)));
+  k = k < 1 ? 1 : (k > n ? n : k);
+  alpha = CfarAlpha(w.type, n, k, w.pfa);
+
+  for (index_t i = wr0; i <= wr1; i++) {
+    for (index_t j = wc0; j <= wc1; j++) {
+      if (i >= gr0 && i <= gr1 && j >= gc0 && j <= gc1) {
+        continue;
+      }
+
+      const double v = static_cast<double>(CfarElem(x, b, i, j));
+      index_t less = 0, less_eq = 0;
+      for (index_t i2 = wr0; i2 <= wr1; i2++) {
+        for (index_t j2 = wc0; j2 <= wc1; j2++) {
+          if (i2 >= gr0 && i2 <= gr1 && j2 >= gc0 && j2 <= gc1) {
+            continue;
+          }
+
+          const double v2 = static_cast<double>(CfarElem(x, b, i2, j2));
+          less += v2 < v;
+          less_eq += v2 <= v;
+        }
+      }
+
+      if (less < k && less_eq >= k) {
+        return v;
+      }
+    }
+  }
+
+  return 0.0;
+}
+
+/**
+ * Column pass of the summed-area table. Each thread scans one column down the
+ * rows, so loads across a warp are coalesced. Thread 0 writes the leading
+ * column of zeros.
+ */
+template <typename InType>
+__global__ void CfarSatCols(double *sat, InType x, index_t rows, index_t cols)
+{
+  const index_t b = blockIdx.y;
+  const index_t j = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  const index_t ld = cols + 1;
+  if (j > cols) {
+    return;
+  }
+
+  double *s = sat + b * (rows + 1) * ld;
+  s[j] = 0.0;
+
+  double run = 0.0;
+  for (index_t r = 0; r < rows; r++) {
+    if (j > 0) {
+      run += static_cast<double>(CfarElem(x, b, r, j - 1));
+    }
+    s[(r + 1) * ld + j] = run;
+  }
+}
+
+/**
+ * Row pass of the summed-area table. Each warp scans one row in chunks of 32
+ * columns, carrying the running total between chunks.
+ */
+__global__ void CfarSatRows(double *sat, index_t rows, index_t cols)
+{
+  const index_t b = blockIdx.y;
+  const int lane = threadIdx.x & 31;
+  const index_t r = static_cast<index_t>(blockIdx.x) * CFAR_ROWS_PER_BLOCK +
+                    threadIdx.x / 32 + 1;
+  const index_t ld = cols + 1;
+  if (r > rows) {
+    return;
+  }
+
+  double *s = sat + b * (rows + 1) * ld + r * ld;
+  double carry = 0.0;
+  for (index_t c0 = 1; c0 <= cols; c0 += 32) {
+    const index_t c = c0 + lane;
+    double v = (c <= cols) ? s[c] : 0.0;
+
+#pragma unroll
+    for (int off = 1; off < 32; off *= 2) {
+      double n = __shfl_up_sync(~0, v, off);
+      if (lane >= off) {
+        v += n;
+      }
+    }
+
+    v += carry;
+    if (c <= cols) {
+      s[c] = v;
+    }
+    carry = __shfl_sync(~0, v, 31);
+  }
+}
+
+/**
+ * Evaluate every cell under test, writing a detection flag and optionally the
+ * background estimate
+ */
+template <typename DetType, typename BaType, typename InType>
+__global__ void CfarDetect(DetType dets, BaType ba, InType x, const double *sat,
+                           index_t rows, index_t cols, cfarWindow_t w,
+                           bool write_ba)
+{
+  const index_t b = blockIdx.z;
+  const index_t r = blockIdx.y;
+  const index_t c = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (c >= cols) {
+    return;
+  }
+
+  double alpha;
+  const double bg = CfarCell(x, sat + b * (rows + 1) * (cols + 1), b, rows,
+                             cols, r, c, w, alpha);
+  const double v = static_cast<double>(CfarElem(x, b, r, c));
+
+  CfarElem(dets, b, r, c) = (v > alpha * bg) ? 1 : 0;
+  if (write_ba) {
+    CfarElem(ba, b, r, c) =
+        static_cast<typename BaType::scalar_type>(bg);
+  }
+}
+
+}; // namespace signal
+}; // namespace matx
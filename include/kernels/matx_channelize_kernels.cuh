@@ -0,0 +1,84 @@
+#pragma once
+
+#include "kernels/matx_resample_kernels.cuh"
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define CHANNELIZE_BLOCK_SIZE 256
+
+namespace matx {
+namespace signal {
+
+/**
+ * Channel c of frame n of row b of a channelizer output, where the leading
+ * dimensions before the frames are batches
+ */
+template <typename TensorType>
+__device__ inline decltype(auto) ChannelizeElem(TensorType &t, index_t b,
+                                                index_t n, index_t c)
+{
+  constexpr int RANK = TensorType::Rank();
+  if constexpr (RANK == 2) {
+    return t(n, c);
+  }
+  else if constexpr (RANK == 3) {
+    return t(b, n, c);
+  }
+  else {
+    return t(b / t.Size(1), b % t.Size(1), n, c);
+  }
+}
+
+/**
+ * Polyphase FIR half of the channelizer. Frame n is taken at input sample
+ * t = t0 + n * decimation, and element c of the frame is the branch of
+ * phase p = (t - c) mod channels:
+ *
+ *   v[c] = sum_q h[q * channels + p] * x[t - q * channels - p]
+ *
+ * Indexing the branches this way folds both the reversal that turns the
+ * inverse DFT of the polyphase sum into a forward DFT and, when oversampled,
+ * the rotation by the frame time into the load, so the frames are ready for
+ * a batched forward FFT in place. phase0 is the position of sample t0 in the
+ * stream modulo channels.
+ *
+ * Threads in x walk the elements of a frame so the taps and input samples
+ * they read are contiguous. Frames are on the x grid dimension since there
+ * can be more than 65535 of them, and rows stride over the z dimension.
+ */
+template <typename T, typename OutType, typename InType, typename FiltType>
+__global__ void ChannelizePoly(OutType out, InType in, FiltType h,
+                               const T *hist, index_t hist_len, index_t len,
+                               index_t taps, index_t channels,
+                               index_t decimation, index_t t0, index_t phase0,
+                               index_t batches)
+{
+  using out_type = typename OutType::scalar_type;
+
+  const index_t n = blockIdx.x;
+  const index_t c = static_cast<index_t>(blockIdx.y) * blockDim.x +
+                    threadIdx.x;
+  if (c >= channels) {
+    return;
+  }
+
+  const index_t t = t0 + n * decimation;
+  const index_t p =
+      (phase0 + (n * decimation) % channels + channels - c) % channels;
+
+  for (index_t b = blockIdx.z; b < batches; b += gridDim.z) {
+    out_type acc = 0;
+    index_t i = t - p;
+    for (index_t k = p; k < taps; k += channels, i -= channels) {
+      acc += static_cast<out_type>(
+                 ResampleInput(in, hist, b, i, len, hist_len)) *
+             ResampleTap<out_type>(h(k));
+    }
+
+    ChannelizeElem(out, b, n, c) = acc;
+  }
+}
+
+}; // namespace signal
+}; // namespace matx
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define COV_DEV_COLS 32
+#define COV_DEV_ROWS 8
+#define COV_MEAN_COLS 32
+#define COV_MEAN_ROWS 8
+
+namespace matx {
+
+/**
+ * Type used for accumulating covariance sums. Half types accumulate in single
+ * precision.
+ */
+template <typename T>
+using cov_accum_t = std::conditional_t<
+    is_complex_half_v<T>, cuda::std::complex<float>,
+    std::conditional_t<is_matx_half_v<T>, float, T>>;
+
+template <typename Acc, typename T>
+__host__ __device__ inline Acc CovToAccum(T v)
+{
+  return static_cast<Acc>(v);
+}
+
+template <typename T> __host__ __device__ inline T CovConj(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return cuda::std::conj(v);
+  }
+  else {
+    return v;
+  }
+}
+
+template <typename TensorType>
+__host__ __device__ inline decltype(auto) CovElem(TensorType &t, index_t b,
+                                                  index_t r, index_t c)
+{
+  if constexpr (TensorType::Rank() == 2) {
+    return t(r, c);
+  }
+  else if constexpr (TensorType::Rank() == 3) {
+    return t(b, r, c);
+  }
+  else {
+    return t(b / t.Size(1), b % t.Size(1), r, c);
+  }
+}
+
+/**
+ * Column means of each batch of A. Threads in x map to columns so loads are
+ * coalesced, and threads in y split the rows and are reduced in shared memory.
+ * Blocks in y stride over the batches.
+ */
+template <typename Acc, typename InType>
+__global__ void CovMeans(Acc *means, InType a, index_t m, index_t n,
+                         index_t batches)
+{
+  __shared__ alignas(alignof(Acc))
+      uint8_t s_raw[COV_MEAN_ROWS * COV_MEAN_COLS * sizeof(Acc)];
+  Acc *s_sum = reinterpret_cast<Acc *>(s_raw);
+
+  const index_t col = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                      threadIdx.x;
+
+  for (index_t b = blockIdx.y; b < batches; b += gridDim.y) {
+    Acc sum = 0;
+    if (col < n) {
+      for (index_t r = threadIdx.y; r < m; r += blockDim.y) {
+        sum += CovToAccum<Acc>(CovElem(a, b, r, col));
+      }
+    }
+
+    s_sum[threadIdx.y * blockDim.x + threadIdx.x] = sum;
+    __syncthreads();
+
+    if (threadIdx.y == 0 && col < n) {
+      for (unsigned int r = 1; r < blockDim.y; r++) {
+        sum += s_sum[r * blockDim.x + threadIdx.x];
+      }
+
+      means[b * n + col] = sum / static_cast<value_type_t<Acc>>(m);
+    }
+    __syncthreads();
+  }
+}
+
+/**
+ * Deviations from the column means of each batch of A, written as a
+ * contiguous m x n matrix per batch in the accumulation type. Threads in x map
+ * to columns so reads and writes are coalesced. Blocks in y stride over the
+ * rows and blocks in z over the batches.
+ */
+template <typename Acc, typename InType>
+__global__ void CovDeviations(Acc *d, InType a, const Acc *means, index_t m,
+                              index_t n, index_t batches)
+{
+  const index_t c = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (c >= n) {
+    return;
+  }
+
+  for (index_t b = blockIdx.z; b < batches; b += gridDim.z) {
+    for (index_t r = static_cast<index_t>(blockIdx.y) * blockDim.y +
+                     threadIdx.y;
+         r < m; r += static_cast<index_t>(gridDim.y) * blockDim.y) {
+      d[(b * m + r) * n + c] =
+          CovToAccum<Acc>(CovElem(a, b, r, c)) - means[b * n + c];
+    }
+  }
+}
+
+/**
+ * Write the covariance of each batch into C from the product P of the
+ * deviations, a contiguous n x n matrix per batch. When only the lower
+ * triangle of P was computed, the upper triangle is its conjugate. When P is
+ * C itself, only the upper triangle is written.
+ */
+template <typename Acc, typename OutType>
+__global__ void CovMirror(OutType c, const Acc *p, index_t n, index_t batches,
+                          bool lower_only, bool in_place)
+{
+  using T = typename OutType::scalar_type;
+  const index_t j = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (j >= n) {
+    return;
+  }
+
+  for (index_t b = blockIdx.z; b < batches; b += gridDim.z) {
+    const Acc *pb = p + b * n * n;
+    for (index_t i = static_cast<index_t>(blockIdx.y) * blockDim.y +
+                     threadIdx.y;
+         i < n; i += static_cast<index_t>(gridDim.y) * blockDim.y) {
+      if (i >= j || !lower_only) {
+        if (!in_place) {
+          CovElem(c, b, i, j) = static_cast<T>(pb[i * n + j]);
+        }
+      }
+      else {
+        CovElem(c, b, i, j) = static_cast<T>(CovConj(pb[j * n + i]));
+      }
+    }
+  }
+}
+
+}; // namespace matx
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define CZT_BLOCK_SIZE 256
+
+namespace matx {
+namespace signal {
+
+/**
+ * Element i of row b of a tensor whose leading dimensions are batches
+ */
+template <typename TensorType>
+__host__ __device__ inline decltype(auto) CztElem(TensorType &t, index_t b,
+                                                  index_t i)
+{
+  constexpr int RANK = TensorType::Rank();
+  if constexpr (RANK == 1) {
+    return t(i);
+  }
+  else if constexpr (RANK == 2) {
+    return t(b, i);
+  }
+  else if constexpr (RANK == 3) {
+    return t(b / t.Size(1), b % t.Size(1), i);
+  }
+  else {
+    return t(b / (t.Size(1) * t.Size(2)), (b / t.Size(2)) % t.Size(1),
+             b % t.Size(2), i);
+  }
+}
+
+/**
+ * Sample i of the chirp-modulated input, x[i] A^-i W^(i^2 / 2), zero-padded
+ * past the n input samples to the length of the convolution
+ */
+template <typename C, typename InType>
+__host__ __device__ inline C CztInput(InType &in, const C *pre, index_t b,
+                                      index_t i, index_t n)
+{
+  if (i >= n) {
+    return C(0);
+  }
+
+  return static_cast<C>(CztElem(in, b, i)) * pre[i];
+}
+
+/**
+ * Output k of the transform from bin k of the forward FFT of the conjugated
+ * convolution spectrum. post[k] is W^(k^2 / 2) with the 1 / L of the inverse
+ * FFT folded in, so the conjugate gives the scaled inverse.
+ */
+template <typename C>
+__host__ __device__ inline C CztOutput(const C *row, const C *post, index_t k)
+{
+  return post[k] * cuda::std::conj(row[k]);
+}
+
+/**
+ * Load the chirp-modulated, zero-padded rows into the FFT buffer. Threads in
+ * x walk a row, and rows stride over the y grid dimension.
+ */
+template <typename C, typename InType>
+__global__ void CztLoad(C *buf, InType in, const C *pre, index_t n, index_t l,
+                        index_t rows)
+{
+  const index_t i = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (i >= l) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    buf[b * l + i] = CztInput(in, pre, b, i, n);
+  }
+}
+
+/**
+ * Multiply by the spectrum of the chirp filter and conjugate, so the next
+ * forward FFT computes the conjugated, unscaled inverse
+ */
+template <typename C>
+__global__ void CztMul(C *buf, const C *spec, index_t l, index_t rows)
+{
+  const index_t i = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (i >= l) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    buf[b * l + i] = cuda::std::conj(buf[b * l + i] * spec[i]);
+  }
+}
+
+template <typename C, typename OutType>
+__global__ void CztStore(OutType out, const C *buf, const C *post, index_t m,
+                         index_t l, index_t rows)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k >= m) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    CztElem(out, b, k) = CztOutput(buf + b * l, post, k);
+  }
+}
+
+}; // namespace signal
+}; // namespace matx
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define DCT_BLOCK_SIZE 256
+
+namespace matx {
+namespace signal {
+
+/**
+ * DCT variants, with the same unnormalized definitions as scipy.fft.dct
+ */
+typedef enum {
+  DCT_TYPE_II,  ///< y[k] = 2 sum x[n] cos(pi k (2n + 1) / 2N)
+  DCT_TYPE_III, ///< y[k] = x[0] + 2 sum_{n>0} x[n] cos(pi n (2k + 1) / 2N)
+  DCT_TYPE_IV,  ///< y[k] = 2 sum x[n] cos(pi (2n + 1) (2k + 1) / 4N)
+} dctType_t;
+
+/**
+ * Element i of row b of a tensor whose leading dimensions are batches
+ */
+template <typename TensorType>
+__host__ __device__ inline decltype(auto) DctElem(TensorType &t, index_t b,
+                                                  index_t i)
+{
+  constexpr int RANK = TensorType::Rank();
+  if constexpr (RANK == 1) {
+    return t(i);
+  }
+  else if constexpr (RANK == 2) {
+    return t(b, i);
+  }
+  else if constexpr (RANK == 3) {
+    return t(b / t.Size(1), b % t.Size(1), i);
+  }
+  else {
+    return t(b / (t.Size(1) * t.Size(2)), (b / t.Size(2)) % t.Size(1),
+             b % t.Size(2), i);
+  }
+}
+
+/**
+ * Position of element n of the even/odd reordered sequence used by DCT-II
+ * and DCT-III: even samples in order followed by odd samples reversed
+ */
+__host__ __device__ inline index_t DctReorder(index_t n, index_t N)
+{
+  return n < (N + 1) / 2 ? 2 * n : 2 * (N - 1 - n) + 1;
+}
+
+/**
+ * DCT-II of bin k from the N-point FFT V of the reordered input, of which
+ * only the nonredundant half is stored: y[k] = 2 Re(e^(-j pi k / 2N) V[k]).
+ * The factor of 2 is folded into the twiddle.
+ */
+template <typename C>
+__host__ __device__ inline value_type_t<C>
+DctIIOutput(const C *spec, const C *tw, index_t k, index_t N)
+{
+  const C v = k <= N / 2 ? spec[k] : cuda::std::conj(spec[N - k]);
+  return (tw[k] * v).real();
+}
+
+/**
+ * Half spectrum bin k whose inverse real FFT, reordered, is the DCT-III of
+ * x: U[k] = (x[k] - j x[N - k]) e^(j pi k / 2N), with x[N] = 0. The twiddle
+ * also undoes the 1 / N scaling of the inverse FFT.
+ */
+template <typename C, typename InType>
+__host__ __device__ inline C DctIIIInput(InType &in, const C *tw, index_t b,
+                                         index_t k, index_t N)
+{
+  using R = value_type_t<C>;
+  const R im = k > 0 ? static_cast<R>(DctElem(in, b, N - k)) : R(0);
+  return C{static_cast<R>(DctElem(in, b, k)), -im} * tw[k];
+}
+
+/**
+ * Element n of the N / 2-point complex sequence whose FFT gives the DCT-IV:
+ * z[n] = (x[2n] + j x[N - 1 - 2n]) e^(-j pi (4n + 1) / 4N)
+ */
+template <typename C, typename InType>
+__host__ __device__ inline C DctIVInput(InType &in, const C *tw, index_t b,
+                                        index_t n, index_t N)
+{
+  using R = value_type_t<C>;
+  return C{static_cast<R>(DctElem(in, b, 2 * n)),
+           static_cast<R>(DctElem(in, b, N - 1 - 2 * n))} *
+         tw[n];
+}
+
+/**
+ * Write outputs 2k and N - 1 - 2k of the DCT-IV from bin k of the FFT of the
+ * DCT-IV input, rotated by 2 e^(-j pi k / N)
+ */
+template <typename C, typename OutType>
+__host__ __device__ inline void DctIVOutput(OutType &out, const C *spec,
+                                            const C *tw, index_t b, index_t k,
+                                            index_t N)
+{
+  const C v = spec[k] * tw[N / 2 + k];
+  DctElem(out, b, 2 * k) = v.real();
+  DctElem(out, b, N - 1 - 2 * k) = -v.imag();
+}
+
+/**
+ * Load the reordered input of a DCT-II into the real FFT buffer. Threads in
+ * x walk a row, and rows stride over the y grid dimension.
+ */
+template <typename R, typename InType>
+__global__ void DctIIPre(R *buf, InType in, index_t N, index_t rows)
+{
+  const index_t n = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (n >= N) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    buf[b * N + n] = static_cast<R>(DctElem(in, b, DctReorder(n, N)));
+  }
+}
+
+template <typename C, typename OutType>
+__global__ void DctIIPost(OutType out, const C *spec, const C *tw, index_t N,
+                          index_t rows)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k >= N) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    DctElem(out, b, k) = DctIIOutput(spec + b * (N / 2 + 1), tw, k, N);
+  }
+}
+
+template <typename C, typename InType>
+__global__ void DctIIIPre(C *spec, InType in, const C *tw, index_t N,
+                          index_t rows)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k > N / 2) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    spec[b * (N / 2 + 1) + k] = DctIIIInput(in, tw, b, k, N);
+  }
+}
+
+/**
+ * Undo the even/odd reordering of the inverse FFT of a DCT-III
+ */
+template <typename R, typename OutType>
+__global__ void DctIIIPost(OutType out, const R *buf, index_t N, index_t rows)
+{
+  const index_t n = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (n >= N) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    DctElem(out, b, DctReorder(n, N)) = buf[b * N + n];
+  }
+}
+
+template <typename C, typename InType>
+__global__ void DctIVPre(C *spec, InType in, const C *tw, index_t N,
+                         index_t rows)
+{
+  const index_t n = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (n >= N / 2) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    spec[b * (N / 2) + n] = DctIVInput(in, tw, b, n, N);
+  }
+}
+
+template <typename C, typename OutType>
+__global__ void DctIVPost(OutType out, const C *spec, const C *tw, index_t N,
+                          index_t rows)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k >= N / 2) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < rows; b += gridDim.y) {
+    DctIVOutput(out, spec + b * (N / 2), tw, b, k, N);
+  }
+}
+
+}; // namespace signal
+}; // namespace matx
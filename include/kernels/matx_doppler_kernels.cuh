@@ -0,0 +1,191 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define DOPPLER_BLOCK_SIZE 256
+#define DOPPLER_TILE_DIM 32
+#define DOPPLER_TILE_ROWS 8
+
+namespace matx {
+namespace signal {
+
+/**
+ * Element k along the transform axis of a tensor viewed as
+ * [outer, axis, inner], where o indexes the dimensions before the axis and j
+ * the dimensions after it. Only the axis may differ in size between the input
+ * and output, so the same indices address both.
+ */
+template <typename TensorType>
+__host__ __device__ inline decltype(auto)
+DopplerElem(TensorType &t, int axis, index_t o, index_t k, index_t j)
+{
+  constexpr int RANK = TensorType::Rank();
+  index_t idx[RANK];
+  for (int d = RANK - 1; d > axis; d--) {
+    idx[d] = j % t.Size(d);
+    j /= t.Size(d);
+  }
+  idx[axis] = k;
+  for (int d = axis - 1; d >= 0; d--) {
+    idx[d] = o % t.Size(d);
+    o /= t.Size(d);
+  }
+
+  if constexpr (RANK == 1) {
+    return t(idx[0]);
+  }
+  else if constexpr (RANK == 2) {
+    return t(idx[0], idx[1]);
+  }
+  else if constexpr (RANK == 3) {
+    return t(idx[0], idx[1], idx[2]);
+  }
+  else {
+    return t(idx[0], idx[1], idx[2], idx[3]);
+  }
+}
+
+/**
+ * Windowed sample k of a transform, or zero in the padding past the input
+ */
+template <typename T, typename InType, typename W>
+__host__ __device__ inline T DopplerInput(InType &in, const W *win, int axis,
+                                          index_t o, index_t k, index_t j,
+                                          index_t len)
+{
+  if (k >= len) {
+    return T(0);
+  }
+
+  return static_cast<T>(DopplerElem(in, axis, o, k, j)) * win[k];
+}
+
+/**
+ * Load the windowed input into the FFT buffer, one contiguous row of nfft
+ * samples per transform, when the axis is not the last dimension. A tile of
+ * the input is read along the inner dimension, which is contiguous in memory,
+ * and written transposed through shared memory so the writes to the buffer
+ * are contiguous too. Tiles along the inner dimension are on the x grid
+ * dimension, and tiles along the axis and the outer index stride over y and
+ * z.
+ */
+template <typename T, typename InType, typename W>
+__global__ void DopplerLoad(T *buf, InType in, const W *win, int axis,
+                            index_t len, index_t nfft, index_t inner,
+                            index_t outer)
+{
+  extern __shared__ float smem[]; // Cast to the complex type below
+  T *tile = reinterpret_cast<T *>(&smem[0]);
+
+  const index_t j0 = static_cast<index_t>(blockIdx.x) * DOPPLER_TILE_DIM;
+  for (index_t o = blockIdx.z; o < outer; o += gridDim.z) {
+    for (index_t k0 = static_cast<index_t>(blockIdx.y) * DOPPLER_TILE_DIM;
+         k0 < nfft; k0 += static_cast<index_t>(gridDim.y) * DOPPLER_TILE_DIM) {
+      for (index_t r = threadIdx.y; r < DOPPLER_TILE_DIM;
+           r += DOPPLER_TILE_ROWS) {
+        const index_t j = j0 + threadIdx.x;
+        const index_t k = k0 + r;
+        if (j < inner && k < nfft) {
+          tile[r * (DOPPLER_TILE_DIM + 1) + threadIdx.x] =
+              DopplerInput<T>(in, win, axis, o, k, j, len);
+        }
+      }
+
+      __syncthreads();
+
+      for (index_t r = threadIdx.y; r < DOPPLER_TILE_DIM;
+           r += DOPPLER_TILE_ROWS) {
+        const index_t j = j0 + r;
+        const index_t k = k0 + threadIdx.x;
+        if (j < inner && k < nfft) {
+          buf[(o * inner + j) * nfft + k] =
+              tile[threadIdx.x * (DOPPLER_TILE_DIM + 1) + r];
+        }
+      }
+
+      __syncthreads();
+    }
+  }
+}
+
+/**
+ * Write the FFT buffer back along the axis of the output, the reverse of
+ * DopplerLoad
+ */
+template <typename T, typename OutType>
+__global__ void DopplerStore(OutType out, const T *buf, int axis, index_t nfft,
+                             index_t inner, index_t outer)
+{
+  extern __shared__ float smem[];
+  T *tile = reinterpret_cast<T *>(&smem[0]);
+
+  const index_t j0 = static_cast<index_t>(blockIdx.x) * DOPPLER_TILE_DIM;
+  for (index_t o = blockIdx.z; o < outer; o += gridDim.z) {
+    for (index_t k0 = static_cast<index_t>(blockIdx.y) * DOPPLER_TILE_DIM;
+         k0 < nfft; k0 += static_cast<index_t>(gridDim.y) * DOPPLER_TILE_DIM) {
+      for (index_t r = threadIdx.y; r < DOPPLER_TILE_DIM;
+           r += DOPPLER_TILE_ROWS) {
+        const index_t j = j0 + r;
+        const index_t k = k0 + threadIdx.x;
+        if (j < inner && k < nfft) {
+          tile[r * (DOPPLER_TILE_DIM + 1) + threadIdx.x] =
+              buf[(o * inner + j) * nfft + k];
+        }
+      }
+
+      __syncthreads();
+
+      for (index_t r = threadIdx.y; r < DOPPLER_TILE_DIM;
+           r += DOPPLER_TILE_ROWS) {
+        const index_t j = j0 + threadIdx.x;
+        const index_t k = k0 + r;
+        if (j < inner && k < nfft) {
+          DopplerElem(out, axis, o, k, j) =
+              tile[threadIdx.x * (DOPPLER_TILE_DIM + 1) + r];
+        }
+      }
+
+      __syncthreads();
+    }
+  }
+}
+
+/**
+ * Load the windowed input into the FFT buffer when the axis is the last
+ * dimension, so no transpose is needed. Threads in x walk a row, and rows
+ * stride over the y grid dimension.
+ */
+template <typename T, typename InType, typename W>
+__global__ void DopplerLoadRows(T *buf, InType in, const W *win, int axis,
+                                index_t len, index_t nfft, index_t outer)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k >= nfft) {
+    return;
+  }
+
+  for (index_t o = blockIdx.y; o < outer; o += gridDim.y) {
+    buf[o * nfft + k] = DopplerInput<T>(in, win, axis, o, k, 0, len);
+  }
+}
+
+template <typename T, typename OutType>
+__global__ void DopplerStoreRows(OutType out, const T *buf, int axis,
+                                 index_t nfft, index_t outer)
+{
+  const index_t k = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (k >= nfft) {
+    return;
+  }
+
+  for (index_t o = blockIdx.y; o < outer; o += gridDim.y) {
+    DopplerElem(out, axis, o, k, 0) = buf[o * nfft + k];
+  }
+}
+
+}; // namespace signal
+}; // namespace matx
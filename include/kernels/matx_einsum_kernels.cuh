@@ -0,0 +1,189 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <stdint.h>
+
+#define EINSUM_BLOCK_SIZE 256
+#define EINSUM_TILE 16
+#define EINSUM_MAX_LABELS (2 * MATX_MAX_RANK)
+
+namespace matx {
+
+/**
+ * Loop nest of a contraction that doesn't map to a GEMM, passed by value to
+ * the kernel. The outer loops run over the output labels and the inner loops
+ * over the summed labels, with the stride of each label in each tensor, or
+ * zero where the tensor doesn't have the label. A label repeated within a
+ * tensor has the sum of its strides, which walks the diagonal.
+ */
+struct EinsumLoops_t {
+  int out_rank;
+  index_t out_size[EINSUM_MAX_LABELS];
+  index_t out_stride_a[EINSUM_MAX_LABELS];
+  index_t out_stride_b[EINSUM_MAX_LABELS];
+  index_t out_stride_c[EINSUM_MAX_LABELS];
+  int sum_rank;
+  index_t sum_size[EINSUM_MAX_LABELS];
+  index_t sum_stride_a[EINSUM_MAX_LABELS];
+  index_t sum_stride_b[EINSUM_MAX_LABELS];
+  index_t out_total;
+  index_t sum_total;
+  int tile_m;         // Output label only in A, or -1
+  int tile_n;         // Output label only in B, or -1
+  index_t rest_total; // Product of the output labels outside the tile
+};
+
+/**
+ * Contract one output element. The summed labels are walked as an odometer,
+ * innermost label first, so each step only adds a stride to the offsets.
+ */
+template <typename TC, typename TA, typename TB>
+__host__ __device__ inline TC EinsumElem(const TA *a, const TB *b,
+                                         const EinsumLoops_t &l, index_t ao,
+                                         index_t bo)
+{
+  index_t idx[EINSUM_MAX_LABELS] = {0};
+  TC acc = 0;
+  for (index_t s = 0; s < l.sum_total; s++) {
+    acc += static_cast<TC>(a[ao] * b[bo]);
+
+    for (int d = l.sum_rank - 1; d >= 0; d--) {
+      ao += l.sum_stride_a[d];
+      bo += l.sum_stride_b[d];
+      if (++idx[d] < l.sum_size[d]) {
+        break;
+      }
+
+      ao -= l.sum_stride_a[d] * l.sum_size[d];
+      bo -= l.sum_stride_b[d] * l.sum_size[d];
+      idx[d] = 0;
+    }
+  }
+
+  return acc;
+}
+
+/**
+ * Offsets into A and B of one linear index of the summed labels
+ */
+__host__ __device__ inline void EinsumSumOffset(const EinsumLoops_t &l,
+                                                index_t s, index_t &ao,
+                                                index_t &bo)
+{
+  ao = 0;
+  bo = 0;
+  for (int d = l.sum_rank - 1; d >= 0; d--) {
+    const index_t i = s % l.sum_size[d];
+    s /= l.sum_size[d];
+    ao += i * l.sum_stride_a[d];
+    bo += i * l.sum_stride_b[d];
+  }
+}
+
+/**
+ * One thread per output element, striding over the grid when there are more
+ * elements than threads
+ */
+template <typename TC, typename TA, typename TB>
+__global__ void EinsumLoop(TC *c, const TA *a, const TB *b, EinsumLoops_t l)
+{
+  for (index_t o = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       o < l.out_total; o += static_cast<index_t>(gridDim.x) * blockDim.x) {
+    index_t ao = 0, bo = 0, co = 0;
+    index_t r = o;
+    for (int d = l.out_rank - 1; d >= 0; d--) {
+      const index_t i = r % l.out_size[d];
+      r /= l.out_size[d];
+      ao += i * l.out_stride_a[d];
+      bo += i * l.out_stride_b[d];
+      co += i * l.out_stride_c[d];
+    }
+
+    c[co] = EinsumElem<TC>(a, b, l, ao, bo);
+  }
+}
+
+/**
+ * Tiled loop nest for contractions whose output has a label only in A and a
+ * label only in B. Each block computes a square tile of those two labels for
+ * one index of the other output labels. The summed labels are flattened into
+ * one index and walked a tile at a time, with the A and B tiles staged in
+ * shared memory so each element loaded is used by a whole row or column of
+ * the output tile. Blocks stride over all three grid dimensions.
+ */
+template <typename TC, typename TA, typename TB>
+__global__ void EinsumTiled(TC *c, const TA *a, const TB *b, EinsumLoops_t l)
+{
+  constexpr int TD = EINSUM_TILE;
+  __shared__ alignas(alignof(TA)) uint8_t sa_raw[TD * (TD + 1) * sizeof(TA)];
+  __shared__ alignas(alignof(TB)) uint8_t sb_raw[TD * (TD + 1) * sizeof(TB)];
+  TA *s_a = reinterpret_cast<TA *>(sa_raw);
+  TB *s_b = reinterpret_cast<TB *>(sb_raw);
+
+  const int tx = threadIdx.x;
+  const int ty = threadIdx.y;
+  const index_t size_m = l.out_size[l.tile_m];
+  const index_t size_n = l.out_size[l.tile_n];
+
+  for (index_t o = blockIdx.z; o < l.rest_total; o += gridDim.z) {
+    index_t ao = 0, bo = 0, co = 0;
+    index_t r = o;
+    for (int d = l.out_rank - 1; d >= 0; d--) {
+      if (d == l.tile_m || d == l.tile_n) {
+        continue;
+      }
+
+      const index_t i = r % l.out_size[d];
+      r /= l.out_size[d];
+      ao += i * l.out_stride_a[d];
+      bo += i * l.out_stride_b[d];
+      co += i * l.out_stride_c[d];
+    }
+
+    for (index_t m0 = static_cast<index_t>(blockIdx.y) * TD; m0 < size_m;
+         m0 += static_cast<index_t>(gridDim.y) * TD) {
+      for (index_t n0 = static_cast<index_t>(blockIdx.x) * TD; n0 < size_n;
+           n0 += static_cast<index_t>(gridDim.x) * TD) {
+        const index_t row = m0 + ty;
+        const index_t col = n0 + tx;
+        const index_t a_row = ao + row * l.out_stride_a[l.tile_m];
+        const index_t b_col = bo + col * l.out_stride_b[l.tile_n];
+        TC acc = 0;
+
+        for (index_t k0 = 0; k0 < l.sum_total; k0 += TD) {
+          index_t sao, sbo;
+          if (row < size_m && k0 + tx < l.sum_total) {
+            EinsumSumOffset(l, k0 + tx, sao, sbo);
+            s_a[ty * (TD + 1) + tx] = a[a_row + sao];
+          }
+          else {
+            s_a[ty * (TD + 1) + tx] = static_cast<TA>(0);
+          }
+
+          if (col < size_n && k0 + ty < l.sum_total) {
+            EinsumSumOffset(l, k0 + ty, sao, sbo);
+            s_b[ty * (TD + 1) + tx] = b[b_col + sbo];
+          }
+          else {
+            s_b[ty * (TD + 1) + tx] = static_cast<TB>(0);
+          }
+          __syncthreads();
+
+#pragma unroll
+          for (int k = 0; k < TD; k++) {
+            acc += static_cast<TC>(s_a[ty * (TD + 1) + k] *
+                                   s_b[k * (TD + 1) + tx]);
+          }
+          __syncthreads();
+        }
+
+        if (row < size_m && col < size_n) {
+          c[co + row * l.out_stride_c[l.tile_m] +
+            col * l.out_stride_c[l.tile_n]] = acc;
+        }
+      }
+    }
+  }
+}
+
+}; // namespace matx
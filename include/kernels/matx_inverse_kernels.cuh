@@ -0,0 +1,152 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+// Largest matrix dimension inverted with the batched small-matrix kernel
+#define MATX_SMALL_INV_MAX_N 32
+
+namespace matx {
+
+template <typename T> __device__ inline auto SmallInvAbs(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return cuda::std::abs(v);
+  }
+  else {
+    return fabs(v);
+  }
+}
+
+template <typename TensorType>
+__device__ inline decltype(auto) SmallInvElem(TensorType &t, index_t b,
+                                              index_t r, index_t c)
+{
+  if constexpr (TensorType::Rank() == 2) {
+    return t(r, c);
+  }
+  else if constexpr (TensorType::Rank() == 3) {
+    return t(b, r, c);
+  }
+  else {
+    return t(b / t.Size(1), b % t.Size(1), r, c);
+  }
+}
+
+/**
+ * Number of matrices each block inverts for a padded size N. Each matrix uses
+ * one warp and N x (N + 1) elements of shared memory.
+ */
+template <typename T, int N> constexpr int SmallInvMatsPerBlock()
+{
+  constexpr size_t bytes = N * (N + 1) * sizeof(T);
+  return bytes >= 16384 ? 1 : (16384 / bytes > 8 ? 8 : 16384 / bytes);
+}
+
+/**
+ * Batched in-place Gauss-Jordan inverse with partial pivoting for matrices up
+ * to N x N. Each warp inverts one matrix from shared memory, with lane i owning
+ * row i during elimination. Matrices with n < N are padded with the identity,
+ * so a handful of compile-time sizes cover every n up to
+ * MATX_SMALL_INV_MAX_N. A singular matrix sets *info to 1.
+ */
+template <typename T, int N, typename OutType, typename InType>
+__global__ void SmallInverse(OutType a_inv, InType a, index_t n,
+                             index_t batches, int *info)
+{
+  static_assert(N <= 32, "Small inverse kernel supports at most 32x32");
+  using real_t = decltype(SmallInvAbs(T{}));
+  constexpr int LD = N + 1; // Pad rows to avoid bank conflicts
+  constexpr int MATS = SmallInvMatsPerBlock<T, N>();
+
+  // Raw storage since complex types can't be declared __shared__ directly
+  __shared__ alignas(alignof(T)) uint8_t s_raw[MATS * N * LD * sizeof(T)];
+
+  const int lane = threadIdx.x & 31;
+  const int warp = threadIdx.x / 32;
+  const index_t b = static_cast<index_t>(blockIdx.x) * MATS + warp;
+  if (b >= batches) {
+    return;
+  }
+
+  T *M = reinterpret_cast<T *>(s_raw) + warp * N * LD;
+
+  for (int r = 0; r < N; r++) {
+    if (lane < N) {
+      if (r < n && lane < n) {
+        M[r * LD + lane] = SmallInvElem(a, b, r, lane);
+      }
+      else {
+        M[r * LD + lane] = (r == lane) ? T(1) : T(0);
+      }
+    }
+  }
+  __syncwarp();
+
+  int perm[N];
+
+  for (int k = 0; k < N; k++) {
+    // Pivot search across lanes, keeping the lowest row on ties
+    real_t pv = (lane >= k && lane < N) ? SmallInvAbs(M[lane * LD + k])
+                                        : real_t(-1);
+    int p = lane;
+#pragma unroll
+    for (int off = 16; off > 0; off /= 2) {
+      real_t opv = __shfl_xor_sync(~0, pv, off);
+      int op = __shfl_xor_sync(~0, p, off);
+      if (opv > pv || (opv == pv && op < p)) {
+        pv = opv;
+        p = op;
+      }
+    }
+
+    perm[k] = p;
+    if (pv == real_t(0) && lane == 0) {
+      atomicExch(info, 1);
+    }
+
+    if (p != k && lane < N) {
+      T tmp = M[k * LD + lane];
+      M[k * LD + lane] = M[p * LD + lane];
+      M[p * LD + lane] = tmp;
+    }
+    __syncwarp();
+
+    T piv = M[k * LD + k];
+    __syncwarp();
+
+    if (lane < N) {
+      M[k * LD + lane] = ((lane == k) ? T(1) : M[k * LD + lane]) / piv;
+    }
+    __syncwarp();
+
+    if (lane < N && lane != k) {
+      T f = M[lane * LD + k];
+#pragma unroll
+      for (int j = 0; j < N; j++) {
+        M[lane * LD + j] =
+            ((j == k) ? T(0) : M[lane * LD + j]) - f * M[k * LD + j];
+      }
+    }
+    __syncwarp();
+  }
+
+  // Undo the row interchanges by swapping columns in reverse order
+  for (int k = N - 1; k >= 0; k--) {
+    if (perm[k] != k && lane < N) {
+      T tmp = M[lane * LD + k];
+      M[lane * LD + k] = M[lane * LD + perm[k]];
+      M[lane * LD + perm[k]] = tmp;
+    }
+  }
+  __syncwarp();
+
+  for (int r = 0; r < n; r++) {
+    if (lane < n) {
+      SmallInvElem(a_inv, b, r, lane) = M[r * LD + lane];
+    }
+  }
+}
+
+}; // namespace matx
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cfloat>
+#include <cuda/std/complex>
+#include <stdint.h>
+
+// Largest Hermitian matrix handled by the batched Jacobi eigen kernel
+#define MATX_JACOBI_EIG_MAX_N 64
+#define MATX_JACOBI_MAX_SWEEPS 20
+#define JACOBI_BLOCK_SIZE 256
+#define JACOBI_MAX_SHARED_BYTES (46 * 1024)
+
+namespace matx {
+
+template <typename T> __host__ __device__ inline auto JacobiAbs(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return cuda::std::abs(v);
+  }
+  else {
+    return v < T(0) ? -v : v;
+  }
+}
+
+template <typename T> __host__ __device__ inline auto JacobiReal(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return v.real();
+  }
+  else {
+    return v;
+  }
+}
+
+template <typename T> __host__ __device__ inline T JacobiConj(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return cuda::std::conj(v);
+  }
+  else {
+    return v;
+  }
+}
+
+template <typename T> __host__ __device__ constexpr auto JacobiEps()
+{
+  using real_t = value_type_t<T>;
+  if constexpr (sizeof(real_t) == sizeof(float)) {
+    return static_cast<real_t>(FLT_EPSILON);
+  }
+  else {
+    return static_cast<real_t>(DBL_EPSILON);
+  }
+}
+
+/**
+ * Compute the Jacobi rotation that zeroes the off-diagonal of the 2x2
+ * Hermitian matrix [app apq; conj(apq) aqq]
+ *
+ * The rotation is J = [c s; -conj(s) c] on rows/columns p and q, so that
+ * J^H * A * J is diagonal in (p, q). For complex types s carries the phase of
+ * apq.
+ *
+ * @param app
+ *   Diagonal element p
+ * @param aqq
+ *   Diagonal element q
+ * @param apq
+ *   Off-diagonal element
+ * @param c
+ *   Cosine output
+ * @param s
+ *   Sine output
+ */
+template <typename T>
+__host__ __device__ inline void JacobiRotation(value_type_t<T> app,
+                                               value_type_t<T> aqq, T apq,
+                                               value_type_t<T> &c, T &s)
+{
+  using real_t = value_type_t<T>;
+  real_t b = JacobiAbs(apq);
+  if (b == real_t(0)) {
+    c = 1;
+    s = 0;
+    return;
+  }
+
+  real_t tau = (aqq - app) / (real_t(2) * b);
+  real_t atau = JacobiAbs(tau);
+  real_t t;
+  if (atau > real_t(1e15)) {
+    t = real_t(1) / (real_t(2) * tau);
+  }
+  else {
+    t = (tau >= real_t(0) ? real_t(1) : real_t(-1)) /
+        (atau + static_cast<real_t>(cuda::std::sqrt(real_t(1) + tau * tau)));
+  }
+
+  c = real_t(1) / static_cast<real_t>(cuda::std::sqrt(real_t(1) + t * t));
+  s = (t * c) * (apq / b);
+}
+
+/**
+ * Round-robin pairing used for parallel Jacobi sweeps. In each of the n - 1
+ * steps of a sweep the n indices (n even) are split into n / 2 disjoint pairs,
+ * and every pair appears exactly once per sweep.
+ */
+__host__ __device__ inline void JacobiPair(int n, int step, int k, int &p,
+                                           int &q)
+{
+  int a, b;
+  if (k == 0) {
+    a = step;
+    b = n - 1;
+  }
+  else {
+    a = (step + k) % (n - 1);
+    b = (step - k + n - 1) % (n - 1);
+  }
+
+  p = a < b ? a : b;
+  q = a < b ? b : a;
+}
+
+/**
+ * Dynamic shared memory used by JacobiEig for an n x n matrix: the working
+ * matrix, the eigenvectors and one sine per rotation of a step
+ */
+template <typename T> constexpr size_t JacobiEigSharedBytes(index_t n)
+{
+  const size_t np = static_cast<size_t>(n + (n & 1));
+  return (2 * np * (np + 1) + np / 2) * sizeof(T);
+}
+
+template <typename TensorType>
+__device__ inline decltype(auto) JacobiElem(TensorType &t, index_t b,
+                                            index_t r, index_t c)
+{
+  if constexpr (TensorType::Rank() == 2) {
+    return t(r, c);
+  }
+  else if constexpr (TensorType::Rank() == 3) {
+    return t(b, r, c);
+  }
+  else {
+    return t(b / t.Size(1), b % t.Size(1), r, c);
+  }
+}
+
+template <typename TensorType>
+__device__ inline decltype(auto) JacobiVecElem(TensorType &t, index_t b,
+                                               index_t i)
+{
+  if constexpr (TensorType::Rank() == 1) {
+    return t(i);
+  }
+  else if constexpr (TensorType::Rank() == 2) {
+    return t(b, i);
+  }
+  else {
+    return t(b / t.Size(1), b % t.Size(1), i);
+  }
+}
+
+/**
+ * Batched Hermitian eigen decomposition with parallel cyclic Jacobi
+ *
+ * Each block decomposes one matrix of size n <= MATX_JACOBI_EIG_MAX_N held
+ * in JacobiEigSharedBytes<T>(n) bytes of dynamic shared memory. Every step
+ * computes n / 2 disjoint rotations, applies them to the rows, then to the
+ * columns and eigenvectors. Eigenvalues are written in ascending order with
+ * the matching eigenvectors in the columns of out, the same layout as the
+ * cuSolver path. When vectors is false the eigenvectors aren't accumulated
+ * and out isn't written. Only the triangle selected by lower is read from a.
+ */
+template <typename T, typename W, typename OutType, typename WType,
+          typename InType>
+__global__ void JacobiEig(OutType out, WType w, InType a, int n, bool lower,
+                          bool vectors)
+{
+  using real_t = value_type_t<T>;
+  constexpr int NMAX = MATX_JACOBI_EIG_MAX_N;
+
+  // Shared memory has to be declared with the same type in every instantiation
+  extern __shared__ char s_jacobi[];
+  __shared__ real_t s_c[NMAX / 2];
+  __shared__ real_t s_red[JACOBI_BLOCK_SIZE / 32];
+  __shared__ int s_order[NMAX];
+  __shared__ bool s_done;
+
+  const index_t b = blockIdx.x;
+  const int tid = threadIdx.x;
+  const int np = n + (n & 1); // Pad to an even size with an isolated index
+  const int LD = np + 1;      // Pad rows to avoid bank conflicts
+
+  T *A = reinterpret_cast<T *>(s_jacobi);
+  T *V = A + np * LD;
+  T *s_s = V + np * LD;
+
+  for (int idx = tid; idx < np * np; idx += blockDim.x) {
+    int r = idx / np;
+    int c = idx % np;
+    T val = 0;
+    if (r < n && c < n) {
+      bool in_tri = lower ? (r >= c) : (r <= c);
+      val = in_tri ? static_cast<T>(JacobiElem(a, b, r, c))
+                   : JacobiConj(static_cast<T>(JacobiElem(a, b, c, r)));
+      if (r == c) {
+        val = JacobiReal(val);
+      }
+    }
+
+    A[r * LD + c] = val;
+    if (vectors) {
+      V[r * LD + c] = (r == c) ? T(1) : T(0);
+    }
+  }
+  __syncthreads();
+
+  for (int sweep = 0; sweep < MATX_JACOBI_MAX_SWEEPS; sweep++) {
+    // Check convergence on the off-diagonal norm relative to the full norm
+    real_t off = 0, tot = 0;
+    for (int idx = tid; idx < np * np; idx += blockDim.x) {
+      int r = idx / np;
+      int c = idx % np;
+      real_t v = JacobiAbs(A[r * LD + c]);
+      tot += v * v;
+      if (r != c) {
+        off += v * v;
+      }
+    }
+
+    for (int o = 16; o > 0; o /= 2) {
+      off += __shfl_xor_sync(~0, off, o);
+      tot += __shfl_xor_sync(~0, tot, o);
+    }
+
+    if ((tid & 31) == 0) {
+      s_red[tid / 32] = off;
+    }
+    __syncthreads();
+    if (tid == 0) {
+      real_t soff = 0;
+      for (unsigned int i = 0; i < blockDim.x / 32; i++) {
+        soff += s_red[i];
+      }
+      s_red[0] = soff;
+    }
+    __syncthreads();
+    off = s_red[0];
+    __syncthreads();
+
+    if ((tid & 31) == 0) {
+      s_red[tid / 32] = tot;
+    }
+    __syncthreads();
+    if (tid == 0) {
+      real_t stot = 0;
+      for (unsigned int i = 0; i < blockDim.x / 32; i++) {
+        stot += s_red[i];
+      }
+      s_done = off <= JacobiEps<T>() * JacobiEps<T>() * stot;
+    }
+    __syncthreads();
+
+    if (s_done) {
+      break;
+    }
+
+    for (int step = 0; step < np - 1; step++) {
+      if (tid < np / 2) {
+        int p, q;
+        JacobiPair(np, step, tid, p, q);
+        JacobiRotation(JacobiReal(A[p * LD + p]), JacobiReal(A[q * LD + q]),
+                       A[p * LD + q], s_c[tid], s_s[tid]);
+      }
+      __syncthreads();
+
+      // A = J^H * A
+      for (int idx = tid; idx < np / 2 * np; idx += blockDim.x) {
+        int k = idx / np;
+        int col = idx % np;
+        int p, q;
+        JacobiPair(np, step, k, p, q);
+        real_t c = s_c[k];
+        T s = s_s[k];
+        T ap = A[p * LD + col];
+        T aq = A[q * LD + col];
+        A[p * LD + col] = c * ap - s * aq;
+        A[q * LD + col] = JacobiConj(s) * ap + c * aq;
+      }
+      __syncthreads();
+
+      // A = A * J, V = V * J
+      for (int idx = tid; idx < np / 2 * np; idx += blockDim.x) {
+        int k = idx / np;
+        int row = idx % np;
+        int p, q;
+        JacobiPair(np, step, k, p, q);
+        real_t c = s_c[k];
+        T s = s_s[k];
+        T ap = A[row * LD + p];
+        T aq = A[row * LD + q];
+        A[row * LD + p] = c * ap - JacobiConj(s) * aq;
+        A[row * LD + q] = s * ap + c * aq;
+
+        if (!vectors) {
+          continue;
+        }
+
+        T vp = V[row * LD + p];
+        T vq = V[row * LD + q];
+        V[row * LD + p] = c * vp - JacobiConj(s) * vq;
+        V[row * LD + q] = s * vp + c * vq;
+      }
+      __syncthreads();
+    }
+  }
+
+  // Sort eigenvalues in ascending order
+  if (tid == 0) {
+    for (int i = 0; i < n; i++) {
+      s_order[i] = i;
+    }
+
+    for (int i = 1; i < n; i++) {
+      int cur = s_order[i];
+      real_t val = JacobiReal(A[cur * LD + cur]);
+      int j = i - 1;
+      while (j >= 0 && JacobiReal(A[s_order[j] * LD + s_order[j]]) > val) {
+        s_order[j + 1] = s_order[j];
+        j--;
+      }
+      s_order[j + 1] = cur;
+    }
+  }
+  __syncthreads();
+
+  if (vectors) {
+    for (int idx = tid; idx < n * n; idx += blockDim.x) {
+      int r = idx / n;
+      int c = idx % n;
+      JacobiElem(out, b, r, c) = V[r * LD + s_order[c]];
+    }
+  }
+
+  for (int i = tid; i < n; i += blockDim.x) {
+    JacobiVecElem(w, b, i) =
+        static_cast<W>(JacobiReal(A[s_order[i] * LD + s_order[i]]));
+  }
+}
+
+}; // namespace matx
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define OS_BLOCK_SIZE 256
+
+namespace matx {
+namespace signal {
+
+template <typename TensorType>
+__host__ __device__ inline decltype(auto) OsElem(TensorType &t, index_t ch,
+                                                 index_t i)
+{
+  if constexpr (TensorType::Rank() == 1) {
+    return t(i);
+  }
+  else {
+    return t(ch, i);
+  }
+}
+
+/**
+ * Sample g of a channel's stream, counted from the first sample of the current
+ * call. Negative indices reach back into the taps - 1 samples carried over
+ * from the previous call, and indices past the end of the call are zero.
+ */
+template <typename T, typename InType>
+__host__ __device__ inline T OsInput(InType &in, const T *hist, index_t ch,
+                                     index_t g, index_t len, index_t taps)
+{
+  if (g < 0) {
+    return hist[ch * (taps - 1) + taps - 1 + g];
+  }
+
+  if (g >= len) {
+    return T(0);
+  }
+
+  return static_cast<T>(OsElem(in, ch, g));
+}
+
+/**
+ * Load the overlapped input blocks into the FFT buffer. Block b of a channel
+ * starts taps - 1 samples before its first output, so each row is the
+ * previous block's tail followed by nfft - taps + 1 new samples.
+ */
+template <typename T, typename InType>
+__global__ void OsLoad(T *buf, InType in, const T *hist, index_t len,
+                       index_t taps, index_t nfft, index_t blocks)
+{
+  const index_t row = blockIdx.x;
+  const index_t k = static_cast<index_t>(blockIdx.y) * blockDim.x +
+                    threadIdx.x;
+  if (k >= nfft) {
+    return;
+  }
+
+  const index_t ch = row / blocks;
+  const index_t g = (row % blocks) * (nfft - taps + 1) + k - (taps - 1);
+  buf[row * nfft + k] = OsInput(in, hist, ch, g, len, taps);
+}
+
+/**
+ * Save the last taps - 1 input samples of each channel for the next call.
+ * This runs before any output is written so the input can be overwritten in
+ * place.
+ */
+template <typename T, typename InType>
+__global__ void OsSaveTail(T *hist_next, InType in, const T *hist,
+                           index_t len, index_t taps, index_t channels)
+{
+  const index_t idx = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                      threadIdx.x;
+  if (idx >= channels * (taps - 1)) {
+    return;
+  }
+
+  const index_t ch = idx / (taps - 1);
+  const index_t j = idx % (taps - 1);
+  hist_next[idx] = OsInput(in, hist, ch, len - (taps - 1) + j, len, taps);
+}
+
+/**
+ * Write the valid nfft - taps + 1 outputs of each filtered block, discarding
+ * the first taps - 1 samples that wrapped around
+ */
+template <typename T, typename OutType>
+__global__ void OsStore(OutType out, const T *buf, index_t len, index_t taps,
+                        index_t nfft, index_t blocks)
+{
+  const index_t row = blockIdx.x;
+  const index_t j = static_cast<index_t>(blockIdx.y) * blockDim.x +
+                    threadIdx.x;
+  const index_t valid = nfft - taps + 1;
+  const index_t g = (row % blocks) * valid + j;
+  if (j >= valid || g >= len) {
+    return;
+  }
+
+  OsElem(out, row / blocks, g) = buf[row * nfft + taps - 1 + j];
+}
+
+}; // namespace signal
+}; // namespace matx
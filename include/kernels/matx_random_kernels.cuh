@@ -0,0 +1,37 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <stdint.h>
+
+#define RANDOM_BLOCK_SIZE 256
+
+namespace matx {
+
+/**
+ * Fill contiguous memory from a random view. Each thread generates one Philox
+ * block and writes every value in it, striding over the grid when there are
+ * more blocks than threads.
+ */
+template <typename T, typename RandomView>
+__global__ void RandomFill(T *out, RandomView r, index_t total)
+{
+  constexpr int V = RandomView::VALUES;
+  const index_t blocks = (total + V - 1) / V;
+
+  for (index_t blk = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                     threadIdx.x;
+       blk < blocks; blk += static_cast<index_t>(gridDim.x) * blockDim.x) {
+    T vals[V];
+    r.GenerateBlock(blk, vals);
+
+    const index_t base = blk * V;
+#pragma unroll
+    for (int v = 0; v < V; v++) {
+      if (base + v < total) {
+        out[base + v] = vals[v];
+      }
+    }
+  }
+}
+
+}; // namespace matx
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define RESAMPLE_BLOCK_SIZE 256
+
+namespace matx {
+namespace signal {
+
+/**
+ * Element i of row b of a tensor whose leading dimensions are batches
+ */
+template <typename TensorType>
+__host__ __device__ inline decltype(auto) ResampleElem(TensorType &t, index_t b,
+                                                       index_t i)
+{
+  constexpr int RANK = TensorType::Rank();
+  if constexpr (RANK == 1) {
+    return t(i);
+  }
+  else if constexpr (RANK == 2) {
+    return t(b, i);
+  }
+  else if constexpr (RANK == 3) {
+    return t(b / t.Size(1), b % t.Size(1), i);
+  }
+  else {
+    return t(b / (t.Size(1) * t.Size(2)), (b / t.Size(2)) % t.Size(1),
+             b % t.Size(2), i);
+  }
+}
+
+/**
+ * Input sample i of row b, counted from the start of the current call.
+ * Negative indices read the hist_len samples carried over from the previous
+ * call, and anything before those or past the end of the input is zero.
+ */
+template <typename T, typename InType>
+__host__ __device__ inline T ResampleInput(InType &in, const T *hist,
+                                           index_t b, index_t i, index_t len,
+                                           index_t hist_len)
+{
+  if (i >= len || i < -hist_len) {
+    return T(0);
+  }
+
+  if (i < 0) {
+    return hist[b * hist_len + hist_len + i];
+  }
+
+  return static_cast<T>(ResampleElem(in, b, i));
+}
+
+/**
+ * Convert a filter tap to the arithmetic type of the data. Real taps stay
+ * real so complex data is scaled rather than multiplied as complex.
+ */
+template <typename T, typename F>
+__host__ __device__ inline auto ResampleTap(const F &v)
+{
+  if constexpr (is_complex_v<F>) {
+    return static_cast<T>(v);
+  }
+  else {
+    return static_cast<value_type_t<T>>(v);
+  }
+}
+
+/**
+ * One output of the polyphase resampler. Output n sits at index m of the
+ * upsampled input, so only the taps of phase m % up line up with nonzero
+ * samples, and those are applied directly to the original input without
+ * inserting zeros.
+ */
+template <typename T, typename InType, typename FiltType>
+__host__ __device__ inline T
+ResamplePolyOutput(InType &in, FiltType &h, const T *hist, index_t hist_len,
+                   index_t b, index_t len, index_t taps, index_t up, index_t m)
+{
+  T acc = 0;
+  index_t i = m / up;
+  for (index_t k = m % up; k < taps; k += up, i--) {
+    acc += ResampleInput(in, hist, b, i, len, hist_len) *
+           ResampleTap<T>(h(k));
+  }
+
+  return acc * static_cast<value_type_t<T>>(up);
+}
+
+/**
+ * Polyphase resampler computing only the retained outputs. Threads in x walk
+ * the outputs of a row, so neighbouring threads read neighbouring inputs, and
+ * rows stride over the y grid dimension.
+ */
+template <typename T, typename OutType, typename InType, typename FiltType>
+__global__ void ResamplePoly(OutType out, InType in, FiltType h, const T *hist,
+                             index_t hist_len, index_t len, index_t taps,
+                             index_t up, index_t down, index_t m0,
+                             index_t nout, index_t batches)
+{
+  const index_t n = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                    threadIdx.x;
+  if (n >= nout) {
+    return;
+  }
+
+  for (index_t b = blockIdx.y; b < batches; b += gridDim.y) {
+    ResampleElem(out, b, n) = ResamplePolyOutput(
+        in, h, hist, hist_len, b, len, taps, up, m0 + n * down);
+  }
+}
+
+/**
+ * Save the last hist_len inputs of every row for the next call of a
+ * streaming resampler
+ */
+template <typename T, typename InType>
+__global__ void ResampleSaveTail(T *hist_next, InType in, const T *hist,
+                                 index_t hist_len, index_t len,
+                                 index_t batches)
+{
+  const index_t idx = static_cast<index_t>(blockIdx.x) * blockDim.x +
+                      threadIdx.x;
+  if (idx >= batches * hist_len) {
+    return;
+  }
+
+  const index_t b = idx / hist_len;
+  const index_t j = idx % hist_len;
+  hist_next[idx] = ResampleInput(in, hist, b, len - hist_len + j, len,
+                                 hist_len);
+}
+
+}; // namespace signal
+}; // namespace matx
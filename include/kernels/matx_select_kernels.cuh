@@ -0,0 +1,110 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cub/cub.cuh>
+#include <stdint.h>
+#include <utility>
+
+#define SELECT_BLOCK_SIZE 256
+#define SELECT_ITEMS_PER_THREAD 8
+#define SELECT_TILE_SIZE (SELECT_BLOCK_SIZE * SELECT_ITEMS_PER_THREAD)
+
+namespace matx {
+
+/**
+ * Element of an operator at a row-major linear index
+ */
+template <typename Op>
+__host__ __device__ inline decltype(auto) SelectElem(Op &op, index_t l)
+{
+  constexpr int RANK = Op::Rank();
+  if constexpr (RANK == 0) {
+    return op();
+  }
+  else {
+    index_t idx[RANK];
+    for (int d = RANK - 1; d >= 0; d--) {
+      idx[d] = l % op.Size(d);
+      l /= op.Size(d);
+    }
+
+    return apply_indices(op, idx, std::make_index_sequence<RANK>{});
+  }
+}
+
+/**
+ * Whether element l of a mask selects the element, or zero past the end of
+ * the mask
+ */
+template <typename MaskType>
+__host__ __device__ inline int SelectFlag(MaskType &mask, index_t l,
+                                          index_t n)
+{
+  return (l < n && static_cast<bool>(SelectElem(mask, l))) ? 1 : 0;
+}
+
+/**
+ * Count the elements each tile of the mask selects. A tile is
+ * SELECT_ITEMS_PER_THREAD rounds of SELECT_BLOCK_SIZE consecutive elements.
+ */
+template <typename MaskType>
+__global__ void SelectCount(index_t *counts, MaskType mask, index_t n)
+{
+  const index_t base = static_cast<index_t>(blockIdx.x) * SELECT_TILE_SIZE;
+  index_t total = 0;
+  for (int r = 0; r < SELECT_ITEMS_PER_THREAD; r++) {
+    const index_t l = base + r * SELECT_BLOCK_SIZE + threadIdx.x;
+    total += __syncthreads_count(SelectFlag(mask, l, n));
+  }
+
+  if (threadIdx.x == 0) {
+    counts[blockIdx.x] = total;
+  }
+}
+
+/**
+ * Write the selected elements of each tile, or their linear indices when FIND
+ * is set, starting at the tile's offset from the exclusive scan of the tile
+ * counts. Each round is scanned across the block so the output keeps the
+ * order of the input. Elements past the end of out are dropped, and the last
+ * tile writes the total count.
+ */
+template <bool FIND, typename OutType, typename CountType, typename InType,
+          typename MaskType>
+__global__ void SelectWrite(OutType out, CountType count, InType in,
+                            MaskType mask, const index_t *offsets,
+                            const index_t *counts, index_t n)
+{
+  using BlockScan = cub::BlockScan<index_t, SELECT_BLOCK_SIZE>;
+  __shared__ typename BlockScan::TempStorage scan;
+
+  const index_t base = static_cast<index_t>(blockIdx.x) * SELECT_TILE_SIZE;
+  const index_t cap = out.Size(0);
+  index_t offset = offsets[blockIdx.x];
+  for (int r = 0; r < SELECT_ITEMS_PER_THREAD; r++) {
+    const index_t l = base + r * SELECT_BLOCK_SIZE + threadIdx.x;
+    const index_t flag = SelectFlag(mask, l, n);
+    index_t pos, round;
+    BlockScan(scan).ExclusiveSum(flag, pos, round);
+    __syncthreads();
+
+    if (flag && offset + pos < cap) {
+      if constexpr (FIND) {
+        out(offset + pos) = static_cast<typename OutType::scalar_type>(l);
+      }
+      else {
+        out(offset + pos) =
+            static_cast<typename OutType::scalar_type>(SelectElem(in, l));
+      }
+    }
+
+    offset += round;
+  }
+
+  if (blockIdx.x == gridDim.x - 1 && threadIdx.x == 0) {
+    count() = static_cast<typename CountType::scalar_type>(
+        offsets[blockIdx.x] + counts[blockIdx.x]);
+  }
+}
+
+}; // namespace matx
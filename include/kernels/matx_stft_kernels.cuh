@@ -0,0 +1,90 @@
+#pragma once
+
+#include "matx_type_utils.h"
+#include <cuda/std/complex>
+#include <stdint.h>
+
+#define STFT_BLOCK_SIZE 256
+
+namespace matx {
+namespace signal {
+
+/**
+ * Element f of the flattened (batch..., frame) dimensions and column k of a
+ * tensor whose last dimension is the window or frequency axis
+ */
+template <typename TensorType>
+__device__ inline decltype(auto) StftElem(TensorType &t, index_t f, index_t k)
+{
+  constexpr int RANK = TensorType::Rank();
+  if constexpr (RANK == 2) {
+    return t(f, k);
+  }
+  else if constexpr (RANK == 3) {
+    return t(f / t.Size(1), f % t.Size(1), k);
+  }
+  else {
+    const index_t fr = t.Size(2);
+    return t(f / (t.Size(1) * fr), (f / fr) % t.Size(1), f % fr, k);
+  }
+}
+
+/**
+ * Load each frame of an overlapped view into a contiguous FFT buffer with the
+ * window applied, zero padding frames shorter than the FFT. Threads in x walk
+ * a frame, so both the overlapped loads and the buffer stores are coalesced.
+ * Frames are on the x grid dimension since there can be more than 65535.
+ */
+template <typename BufType, typename FrameType, typename WinType>
+__global__ void StftLoadFrames(BufType *buf, FrameType frames, WinType win,
+                               int nperseg, int nfft)
+{
+  const index_t f = blockIdx.x;
+  const int k = static_cast<int>(blockIdx.y * blockDim.x + threadIdx.x);
+  if (k >= nfft) {
+    return;
+  }
+
+  BufType v = 0;
+  if (k < nperseg) {
+    v = static_cast<BufType>(StftElem(frames, f, k)) *
+        static_cast<value_type_t<BufType>>(win(k));
+  }
+
+  buf[f * nfft + k] = v;
+}
+
+/**
+ * Write the power of each FFT bin, |X|^2, to the output
+ */
+template <typename OutType, typename SpecType>
+__global__ void StftPower(OutType out, const SpecType *spec, int nbins)
+{
+  const index_t f = blockIdx.x;
+  const int k = static_cast<int>(blockIdx.y * blockDim.x + threadIdx.x);
+  if (k >= nbins) {
+    return;
+  }
+
+  const SpecType v = spec[f * nbins + k];
+  StftElem(out, f, k) = v.real() * v.real() + v.imag() * v.imag();
+}
+
+/**
+ * Copy complex FFT bins to an output view that can't be written by cuFFT
+ * directly
+ */
+template <typename OutType, typename SpecType>
+__global__ void StftCopy(OutType out, const SpecType *spec, int nbins)
+{
+  const index_t f = blockIdx.x;
+  const int k = static_cast<int>(blockIdx.y * blockDim.x + threadIdx.x);
+  if (k >= nbins) {
+    return;
+  }
+
+  StftElem(out, f, k) = spec[f * nbins + k];
+}
+
+}; // namespace signal
+}; // namespace matx
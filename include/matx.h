@@ -45,11 +45,15 @@
 #include "matx_conv.h"
 #include "matx_corr.h"
 #include "matx_matmul.h"
+#include "matx_einsum.h"
 #include "matx_reduce.h"
 #include "matx_inverse.h"
 #include "matx_solver.h"
+#include "matx_host_solver.h"
+#include "matx_host_fft.h"
 #include "matx_cov.h"
 #include "matx_cub.h"
+#include "matx_select.h"
 
 
 using fcomplex = cuda::std::complex<float>;
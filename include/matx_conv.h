@@ -38,17 +38,18 @@
 #include <type_traits>
 
 #include "kernels/matx_conv_kernels.cuh"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
 #include "matx_tensor.h"
 
 namespace matx {
 
-template <typename T, int RANK, typename InType, typename FilterType>
-inline void matxDirectConv1DInternal(tensor_t<T, RANK> o, InType i,
-                                     FilterType filter, matxConvCorrMode_t mode,
-                                     cudaStream_t stream)
+template <typename OutType, typename InType, typename FilterType>
+inline void matxDirectConv1DLaunch(OutType o, InType i, FilterType filter,
+                                   matxConvCorrMode_t mode, cudaStream_t stream)
 {
+  constexpr int RANK = OutType::Rank();
   using strip_input_t = typename InType::scalar_type;
   using strip_filter_t = typename FilterType::scalar_type;
   MATX_ASSERT(RANK == InType::Rank(), matxInvalidDim);
@@ -73,20 +74,20 @@ inline void matxDirectConv1DInternal(tensor_t<T, RANK> o, InType i,
 
   if constexpr (RANK == 1) {
     dim3 gsize(num_blocks, 1);
-    Conv1D<tensor_t<T, RANK>, InType, FilterType>
+    Conv1D<OutType, InType, FilterType>
         <<<gsize, BLOCK_SIZE_NON_RECURSIVE, shmsize, stream>>>(
             o, i, filter, sig_len, filter.Size(0), mode);
   }
   else if constexpr (RANK == 2) {
     dim3 gsize(num_blocks, static_cast<int>(i.Size(0)));
-    Conv1D<tensor_t<T, RANK>, InType, FilterType>
+    Conv1D<OutType, InType, FilterType>
         <<<gsize, BLOCK_SIZE_NON_RECURSIVE, shmsize, stream>>>(
             o, i, filter, sig_len, filter.Size(0), mode);
   }
   else if constexpr (RANK == 3) {
     dim3 gsize(num_blocks, static_cast<int>(i.Size(1)),
                static_cast<int>(i.Size(0)));
-    Conv1D<tensor_t<T, RANK>, InType, FilterType>
+    Conv1D<OutType, InType, FilterType>
         <<<gsize, BLOCK_SIZE_NON_RECURSIVE, shmsize, stream>>>(
             o, i, filter, sig_len, filter.Size(0), mode);
   }
@@ -94,12 +95,34 @@ inline void matxDirectConv1DInternal(tensor_t<T, RANK> o, InType i,
     static_assert(RANK == 4);
     dim3 gsize(num_blocks, static_cast<int>(i.Size(2)),
                static_cast<int>(i.Size(0) * i.Size(1)));
-    Conv1D<tensor_t<T, RANK>, InType, FilterType>
+    Conv1D<OutType, InType, FilterType>
         <<<gsize, BLOCK_SIZE_NON_RECURSIVE, shmsize, stream>>>(
             o, i, filter, sig_len, filter.Size(0), mode);
   }
 }
 
+// Launch with 32-bit offsets into the views when they all fit
+template <typename T, int RANK, typename InType, typename FilterType>
+inline void matxDirectConv1DInternal(tensor_t<T, RANK> o, InType i,
+                                     FilterType filter, matxConvCorrMode_t mode,
+                                     cudaStream_t stream)
+{
+  if constexpr (sizeof(index_t) > sizeof(int32_t)) {
+    index_t sizes[RANK];
+    for (int d = 0; d < RANK; d++) {
+      sizes[d] = o.Size(d);
+    }
+
+    if (Fits32(RANK, sizes, o, i, filter)) {
+      matxDirectConv1DLaunch(NarrowOp<int32_t>(o), NarrowOp<int32_t>(i),
+                             NarrowOp<int32_t>(filter), mode, stream);
+      return;
+    }
+  }
+
+  matxDirectConv1DLaunch(o, i, filter, mode, stream);
+}
+
 // Entry point that allows swappable inputs, and also optimizes shared memory by
 // passing in the shortest signal as the filter. Note the swap parameter does
 // not do anything for convolution, so we never swap unless it's a correlation
@@ -107,6 +130,8 @@ template <typename T, int RANK, typename In1Type, typename In2Type>
 inline void conv1d(tensor_t<T, RANK> o, In1Type i1, In2Type i2,
                    matxConvCorrMode_t mode, cudaStream_t stream)
 {
+  deferred_flush(stream);
+
   if constexpr (In1Type::Rank() < In2Type::Rank()) {
     matxDirectConv1DInternal(o, i2, i1, mode, stream);
   }
@@ -124,11 +149,11 @@ inline void conv1d(tensor_t<T, RANK> o, In1Type i1, In2Type i2,
   }
 }
 
-template <typename T, int RANK, typename InType, typename FilterType>
-void matxDirectConv2DInternal(tensor_t<T, RANK> &o, InType &i,
-                              FilterType &filter, matxConvCorrMode_t mode,
-                              cudaStream_t stream)
+template <typename OutType, typename InType, typename FilterType>
+void matxDirectConv2DLaunch(OutType o, InType i, FilterType filter,
+                            matxConvCorrMode_t mode, cudaStream_t stream)
 {
+  constexpr int RANK = OutType::Rank();
   MATX_ASSERT(RANK == InType::Rank(), matxInvalidDim);
   MATX_ASSERT(FilterType::Rank() == 2, matxInvalidDim);
 
@@ -144,7 +169,7 @@ void matxDirectConv2DInternal(tensor_t<T, RANK> &o, InType &i,
         static_cast<int>(std::ceil(static_cast<double>(o.Size(1)) / 32.0)),
         static_cast<int>(std::ceil(static_cast<double>(o.Size(0)) / 32.0)), 1);
     dim3 bsize(32, 32);
-    Conv2D<tensor_t<T, RANK>, InType, FilterType>
+    Conv2D<OutType, InType, FilterType>
         <<<gsize, bsize, shmsize, stream>>>(o, i, filter, mode);
   }
   else if constexpr (RANK == 3) {
@@ -154,7 +179,7 @@ void matxDirectConv2DInternal(tensor_t<T, RANK> &o, InType &i,
                    std::ceil(static_cast<double>(o.Size(1)) / 32.0)),
                static_cast<unsigned int>(o.Size(0)));
     dim3 bsize(32, 32);
-    Conv2D<tensor_t<T, RANK>, InType, FilterType>
+    Conv2D<OutType, InType, FilterType>
         <<<gsize, bsize, shmsize, stream>>>(o, i, filter, mode);
   }
   else {
@@ -165,17 +190,41 @@ void matxDirectConv2DInternal(tensor_t<T, RANK> &o, InType &i,
                    std::ceil(static_cast<double>(o.Size(1)) / 32.0)),
                static_cast<unsigned int>(o.Size(0) * o.Size(1)));
     dim3 bsize(32, 32);
-    Conv2D<tensor_t<T, RANK>, InType, FilterType>
+    Conv2D<OutType, InType, FilterType>
         <<<gsize, bsize, shmsize, stream>>>(o, i, filter, mode);
   }
 }
 
+// Launch with 32-bit offsets into the views when they all fit
+template <typename T, int RANK, typename InType, typename FilterType>
+void matxDirectConv2DInternal(tensor_t<T, RANK> &o, InType &i,
+                              FilterType &filter, matxConvCorrMode_t mode,
+                              cudaStream_t stream)
+{
+  if constexpr (sizeof(index_t) > sizeof(int32_t)) {
+    index_t sizes[RANK];
+    for (int d = 0; d < RANK; d++) {
+      sizes[d] = o.Size(d);
+    }
+
+    if (Fits32(RANK, sizes, o, i, filter)) {
+      matxDirectConv2DLaunch(NarrowOp<int32_t>(o), NarrowOp<int32_t>(i),
+                             NarrowOp<int32_t>(filter), mode, stream);
+      return;
+    }
+  }
+
+  matxDirectConv2DLaunch(o, i, filter, mode, stream);
+}
+
 // Entry point that allows swappable inputs, and also optimizes shared memory by
 // passing in the shortest signal as the filter
 template <typename T, int RANK, typename In1Type, typename In2Type>
 inline void conv2d(tensor_t<T, RANK> o, In1Type i1, In2Type i2,
                    matxConvCorrMode_t mode, cudaStream_t stream)
 {
+  deferred_flush(stream);
+
   if constexpr (In1Type::Rank() < In2Type::Rank()) {
     matxDirectConv2DInternal(o, i2, i1, mode, stream);
   }
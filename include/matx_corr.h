@@ -38,6 +38,7 @@
 #include <type_traits>
 
 #include "matx_conv.h"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
 #include "matx_tensor.h"
@@ -51,6 +52,8 @@ void corr(tensor_t<T, RANK> &o, In1Type &i1, In2Type &i2,
           matxConvCorrMode_t mode, matxConvCorrMethod_t method,
           cudaStream_t stream)
 {
+  deferred_flush(stream);
+
   if (mode != MATX_C_MODE_FULL) {
     MATX_THROW(matxNotSupported,
                "Only full correlation mode supported at this time");
@@ -33,11 +33,15 @@
 
 #pragma once
 
+#include "cublas_v2.h"
+#include "kernels/matx_cov_kernels.cuh"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
-#include "matx_matmul.h"
+#include "matx_host_solver.h"
 #include "matx_tensor.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <numeric>
 
@@ -49,12 +53,17 @@ namespace matx {
  */
 struct CovParams_t {
   void *A;
+  index_t m;
+  index_t n;
+  index_t batches;
   MatXDataType_t dtype;
   cudaStream_t stream;
 };
 
 template <typename T1, int RANK> class matxCovHandle_t {
 public:
+  using acc_t = cov_accum_t<T1>;
+
   /**
    * Construct a handle for computing a covariance matrix
    *
@@ -63,6 +72,15 @@ public:
    * data. For complex matrices the output will match Python with the E[XX']
    * convention.
    *
+   * The column means are computed with a reduction rather than a GEMM
+   * against a matrix of ones, and a single pass writes the deviations from
+   * the means. For a single matrix the covariance is a SYRK (HERK for
+   * complex types) of the deviations, which computes only the lower triangle
+   * before it's mirrored. Batches use one strided-batched GEMM of the
+   * deviations with their conjugate transpose, taken by cuBLAS rather than
+   * stored. Half types keep the deviations and the product in single
+   * precision, and the product is written to C as it's converted.
+   *
    * @tparam T1
    *    Data type of A and C matrices
    * @tparam RANK
@@ -85,34 +103,21 @@ public:
     MATX_ASSERT(a.Size(RANK - 1) == c.Size(RANK - 1), matxInvalidSize);
 
     // Ensure batch dimensions are equal
-    for (int i = 2; i < RANK - 2; i++) {
+    for (int i = 0; i < RANK - 2; i++) {
       MATX_ASSERT(a.Size(i) == c.Size(i), matxInvalidSize);
     }
 
     // This must come before the things below to properly set class parameters
     params_ = GetCovParams(c, a);
 
-    onesM = new tensor_t<T1, 2>({a.Size(RANK - 2), a.Size(RANK - 2)});
-    means = new tensor_t<T1, RANK>(a.Shape());
-    devs = new tensor_t<T1, RANK>(a.Shape());
-
-    // Transposed view of deviations
-    tensorShape_t<RANK> tmp;
-    for (int i = 0; i < RANK; i++) {
-      tmp.SetSize(i, a.Size(RANK - i - 1));
-    }
-
-    devsT = new tensor_t<T1, RANK>(tmp);
-
-    onesMM = new matxMatMulHandle_t<T1, T1, T1, RANK, PROVIDER_TYPE_CUBLASLT>(
-        *means, *onesM, a);
-    covMM = new matxMatMulHandle_t<T1, T1, T1, RANK, PROVIDER_TYPE_CUBLASLT>(
-        c, *devsT, *devs);
+    matxAlloc((void **)&means, params_.batches * params_.n * sizeof(acc_t),
+              MATX_DEVICE_MEMORY);
+    matxAlloc((void **)&devs,
+              params_.batches * params_.m * params_.n * sizeof(acc_t),
+              MATX_DEVICE_MEMORY);
 
-    // Populate our ones matrix
-    exec(set(*onesM,
-             ones(tensorShape_t<2>({a.Size(RANK - 2), a.Size(RANK - 2)}))),
-         0);
+    MATX_ASSERT(cublasCreate(&handle) == CUBLAS_STATUS_SUCCESS,
+                matxMatMulError);
   }
 
   static CovParams_t GetCovParams([[maybe_unused]] tensor_t<T1, RANK> &c,
@@ -121,6 +126,12 @@ public:
     CovParams_t params;
     params.dtype = TypeToInt<T1>();
     params.A = a.Data();
+    params.m = a.Size(RANK - 2);
+    params.n = a.Size(RANK - 1);
+    params.batches = 1;
+    for (int i = 0; i < RANK - 2; i++) {
+      params.batches *= a.Size(i);
+    }
 
     return params;
   }
@@ -134,75 +145,182 @@ public:
    */
   ~matxCovHandle_t()
   {
-    delete onesM;
-    delete means;
-    delete devs;
-    delete onesMM;
-    delete covMM;
+    matxFree(means);
+    matxFree(devs);
+    if (prod != nullptr) {
+      matxFree(prod);
+    }
+    cublasDestroy(handle);
   }
 
-/**
- * Compute a covariance matrix
- *
- * Computes a covariance matrix using columns as data sets and rows as
- * observations. The resultant matrix C is a symmetric positive semi-definite
- * matrix where the diagonals are the variances, and off-diagonals are
- * covariances.
- *
- * Passing a tensor of rank > 2 acts as batching dimensions
- *
- *
- * @tparam T1
- *   Type of beta
- * @param c
- *   Output covariance matrix
- * @param a
- *   Input tensor A
- * @param stream
- *   CUDA stream
- *
- */
+  matxCovHandle_t(const matxCovHandle_t &) = delete;
+  matxCovHandle_t &operator=(const matxCovHandle_t &) = delete;
+
+  /**
+   * Compute a covariance matrix
+   *
+   * Computes a covariance matrix using columns as data sets and rows as
+   * observations. The resultant matrix C is a symmetric positive semi-definite
+   * matrix where the diagonals are the variances, and off-diagonals are
+   * covariances.
+   *
+   * Passing a tensor of rank > 2 acts as batching dimensions
+   *
+   *
+   * @tparam T1
+   *   Type of beta
+   * @param c
+   *   Output covariance matrix
+   * @param a
+   *   Input tensor A
+   * @param stream
+   *   CUDA stream
+   *
+   */
 #ifdef DOXYGEN_ONLY
-    inline void Exec(tensor_t &c, 
-          tensor_t &a, cudaStream_t stream {
+  inline void Exec(tensor_t &c, tensor_t &a, cudaStream_t stream)
+  {
 #else
   inline void Exec(tensor_t<T1, RANK> &c, tensor_t<T1, RANK> &a,
                    cudaStream_t stream)
   {
 #endif
-    // Calculate a matrix of means
-    onesMM->Exec(*means, *onesM, a, stream,
-                 1.0f / static_cast<float>(a.Size(RANK - 2)));
-
-    // Subtract the means from the observations to get the deviations
-    exec(set(*devs, a - *means), stream);
-
-    if constexpr (is_complex_v<T1>) {
-      // This step is not really necessary since BLAS can do it for us, but
-      // until we have a way to detect a Hermitian property on a matrix, we need
-      // to have this in a temporary variable. Note that we use the Python
-      // convention of E[XX'] instead of MATLAB's E[X'X]. Both are "correct",
-      // but we need to match python output
-      exec(set(*devsT, hermitianT(*devs)), stream);
+    const index_t m = params_.m;
+    const index_t n = params_.n;
+    const index_t batches = params_.batches;
+    constexpr index_t max_grid = 65535;
+
+    // Batches beyond the grid limit are strided over inside the kernels
+    dim3 mean_block(COV_MEAN_COLS, COV_MEAN_ROWS);
+    dim3 mean_grid(
+        static_cast<unsigned int>((n + COV_MEAN_COLS - 1) / COV_MEAN_COLS),
+        static_cast<unsigned int>(std::min(batches, max_grid)));
+    CovMeans<acc_t><<<mean_grid, mean_block, 0, stream>>>(means, a, m, n,
+                                                          batches);
+
+    dim3 dev_block(COV_DEV_COLS, COV_DEV_ROWS);
+    dim3 dev_grid(
+        static_cast<unsigned int>((n + COV_DEV_COLS - 1) / COV_DEV_COLS),
+        static_cast<unsigned int>(
+            std::min((m + COV_DEV_ROWS - 1) / COV_DEV_ROWS, max_grid)),
+        static_cast<unsigned int>(std::min(batches, max_grid)));
+    CovDeviations<acc_t><<<dev_grid, dev_block, 0, stream>>>(devs, a, means,
+                                                             m, n, batches);
+
+    // A contiguous C of the accumulation type holds the product directly,
+    // and anything else goes through a workspace
+    const bool in_place = std::is_same_v<acc_t, T1> && c.IsLinear();
+    acc_t *p = reinterpret_cast<acc_t *>(c.Data());
+    if (!in_place) {
+      if (prod == nullptr) {
+        matxAlloc((void **)&prod, batches * n * n * sizeof(acc_t),
+                  MATX_DEVICE_MEMORY);
+      }
+      p = prod;
+    }
+
+    // Note that we use the Python convention of E[XX'] instead of MATLAB's
+    // E[X'X]. Both are "correct", but we need to match python output
+    const bool lower_only = batches == 1;
+    Product(p, stream);
+
+    if (!in_place || lower_only) {
+      dim3 mir_block(COV_DEV_COLS, COV_DEV_ROWS);
+      dim3 mir_grid(
+          static_cast<unsigned int>((n + COV_DEV_COLS - 1) / COV_DEV_COLS),
+          static_cast<unsigned int>(
+              std::min((n + COV_DEV_ROWS - 1) / COV_DEV_ROWS, max_grid)),
+          static_cast<unsigned int>(std::min(batches, max_grid)));
+      CovMirror<acc_t><<<mir_grid, mir_block, 0, stream>>>(
+          c, p, n, batches, lower_only, in_place);
+    }
+  }
+
+private:
+  /**
+   * Product of the deviations with their conjugate transpose, scaled by
+   * 1 / (m - 1), into a contiguous n x n matrix per batch. The deviations are
+   * row-major, so cuBLAS sees each batch as the column-major n x m matrix
+   * D^T, and the column-major product D^T conj(D) reads as D^H D row-major.
+   * A single matrix gets only its lower triangle from SYRK or HERK.
+   */
+  void Product(acc_t *p, cudaStream_t stream)
+  {
+    const int m = static_cast<int>(params_.m);
+    const int n = static_cast<int>(params_.n);
+    const int batches = static_cast<int>(params_.batches);
+    const long long mn = static_cast<long long>(m) * n;
+    const long long nn = static_cast<long long>(n) * n;
+    const value_type_t<acc_t> scale =
+        static_cast<value_type_t<acc_t>>(1) /
+        static_cast<value_type_t<acc_t>>(m - 1);
+    const value_type_t<acc_t> zero = 0;
+    const acc_t alpha = scale;
+    const acc_t beta = 0;
+    cublasStatus_t ret;
+
+    cublasSetStream(handle, stream);
+    if (batches == 1) {
+      if constexpr (std::is_same_v<acc_t, float>) {
+        ret = cublasSsyrk(handle, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_N, n, m,
+                          &scale, devs, n, &zero, p, n);
+      }
+      else if constexpr (std::is_same_v<acc_t, double>) {
+        ret = cublasDsyrk(handle, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_N, n, m,
+                          &scale, devs, n, &zero, p, n);
+      }
+      else if constexpr (std::is_same_v<acc_t, cuda::std::complex<float>>) {
+        ret = cublasCherk(handle, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_N, n, m,
+                          &scale, reinterpret_cast<const cuComplex *>(devs),
+                          n, &zero, reinterpret_cast<cuComplex *>(p), n);
+      }
+      else {
+        ret = cublasZherk(handle, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_N, n, m,
+                          &scale,
+                          reinterpret_cast<const cuDoubleComplex *>(devs), n,
+                          &zero, reinterpret_cast<cuDoubleComplex *>(p), n);
+      }
     }
     else {
-      transpose(*devsT, *devs, stream);
+      if constexpr (std::is_same_v<acc_t, float>) {
+        ret = cublasSgemmStridedBatched(handle, CUBLAS_OP_N, CUBLAS_OP_T, n, n,
+                                        m, &alpha, devs, n, mn, devs, n, mn,
+                                        &beta, p, n, nn, batches);
+      }
+      else if constexpr (std::is_same_v<acc_t, double>) {
+        ret = cublasDgemmStridedBatched(handle, CUBLAS_OP_N, CUBLAS_OP_T, n, n,
+                                        m, &alpha, devs, n, mn, devs, n, mn,
+                                        &beta, p, n, nn, batches);
+      }
+      else if constexpr (std::is_same_v<acc_t, cuda::std::complex<float>>) {
+        ret = cublasCgemmStridedBatched(
+            handle, CUBLAS_OP_N, CUBLAS_OP_C, n, n, m,
+            reinterpret_cast<const cuComplex *>(&alpha),
+            reinterpret_cast<const cuComplex *>(devs), n, mn,
+            reinterpret_cast<const cuComplex *>(devs), n, mn,
+            reinterpret_cast<const cuComplex *>(&beta),
+            reinterpret_cast<cuComplex *>(p), n, nn, batches);
+      }
+      else {
+        ret = cublasZgemmStridedBatched(
+            handle, CUBLAS_OP_N, CUBLAS_OP_C, n, n, m,
+            reinterpret_cast<const cuDoubleComplex *>(&alpha),
+            reinterpret_cast<const cuDoubleComplex *>(devs), n, mn,
+            reinterpret_cast<const cuDoubleComplex *>(devs), n, mn,
+            reinterpret_cast<const cuDoubleComplex *>(&beta),
+            reinterpret_cast<cuDoubleComplex *>(p), n, nn, batches);
+      }
     }
 
-    // Multiply by itself and scale by N-1 for the final covariance
-    covMM->Exec(c, *devsT, *devs, stream,
-                1.0f / static_cast<float>(a.Size(RANK - 2) - 1));
-      }    
-
-  private:
-    // Member variables
-    matxMatMulHandle_t<T1, T1, T1, RANK, PROVIDER_TYPE_CUBLASLT> *onesMM;
-    matxMatMulHandle_t<T1, T1, T1, RANK, PROVIDER_TYPE_CUBLASLT> *covMM;
-    tensor_t<T1, 2> *onesM;
-    tensor_t<T1, RANK> *means;
-    tensor_t<T1, RANK> *devs;
-    tensor_t<T1, RANK> *devsT;
-    CovParams_t params_;
+    MATX_ASSERT(ret == CUBLAS_STATUS_SUCCESS, matxMatMulError);
+  }
+
+  // Member variables
+  cublasHandle_t handle;
+  acc_t *means;
+  acc_t *devs;
+  acc_t *prod = nullptr;
+  CovParams_t params_;
 };
 
 /**
@@ -225,7 +343,9 @@ struct CovParamsKeyHash {
 struct CovParamsKeyEq {
   bool operator()(const CovParams_t &l, const CovParams_t &t) const noexcept
   {
-    return l.A == t.A && l.stream == t.stream && l.dtype == t.dtype;
+    return l.A == t.A && l.m == t.m && l.n == t.n &&
+           l.batches == t.batches && l.stream == t.stream &&
+           l.dtype == t.dtype;
   }
 };
 
@@ -257,6 +377,8 @@ template <typename T1, int RANK>
 void cov(tensor_t<T1, RANK> c, tensor_t<T1, RANK> a,
          cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params = matxCovHandle_t<T1, RANK>::GetCovParams(c, a);
   params.stream = stream;
@@ -275,4 +397,118 @@ void cov(tensor_t<T1, RANK> c, tensor_t<T1, RANK> a,
   }
 }
 
+/**
+ * Compute a covariance matrix on the host
+ *
+ * Host version of cov(). The rows of A are split across threads, and each
+ * thread subtracts the column means from a block of rows as it copies them
+ * into a contiguous buffer, then accumulates the upper triangle of the
+ * block's contribution. The partial sums are added together and mirrored
+ * into the lower triangle.
+ *
+ * @tparam T1
+ *    Data type of A matrix
+ * @tparam RANK
+ *    Rank of A matrix
+ *
+ * @param c
+ *   Covariance matrix output view
+ * @param a
+ *   Covariance matrix input view
+ * @param exec
+ *   Host executor
+ */
+template <typename T1, int RANK>
+void cov(tensor_t<T1, RANK> c, tensor_t<T1, RANK> a,
+         const matxHostExecutor_t &exec)
+{
+  using acc_t = cov_accum_t<T1>;
+  constexpr index_t RB = 64;
+
+  static_assert(RANK >= 2);
+  MATX_ASSERT(c.Size(RANK - 1) == c.Size(RANK - 2), matxInvalidSize);
+  MATX_ASSERT(a.Size(RANK - 1) == c.Size(RANK - 1), matxInvalidSize);
+
+  if (HostGraphRecord(exec, {HostRead(a), HostWrite(c)},
+                      [c, a](const matxHostExecutor_t &e) { cov(c, a, e); })) {
+    return;
+  }
+
+  const index_t m = a.Size(RANK - 2);
+  const index_t n = a.Size(RANK - 1);
+  const int threads = exec.GetNumThreads();
+
+  index_t batches = 1;
+  for (int i = 0; i < RANK - 2; i++) {
+    batches *= a.Size(i);
+  }
+
+  std::vector<acc_t> means(n);
+  std::vector<std::vector<acc_t>> partial(threads);
+  std::vector<std::vector<acc_t>> dev(threads);
+
+  for (index_t b = 0; b < batches; b++) {
+    std::fill(means.begin(), means.end(), acc_t(0));
+    for (index_t r = 0; r < m; r++) {
+      for (index_t j = 0; j < n; j++) {
+        means[j] += CovToAccum<acc_t>(CovElem(a, b, r, j));
+      }
+    }
+
+    for (auto &mu : means) {
+      mu = mu / static_cast<value_type_t<acc_t>>(m);
+    }
+
+    // The parallel for can run fewer chunks than threads, so every partial
+    // is cleared up front rather than by the chunk that uses it
+    for (int t = 0; t < threads; t++) {
+      partial[t].assign(n * n, acc_t(0));
+    }
+
+    index_t row_blocks = (m + RB - 1) / RB;
+    matxHostParallelFor(row_blocks, threads, [&](int tid, index_t start,
+                                                 index_t end) {
+      auto &p = partial[tid];
+      auto &d = dev[tid];
+      d.resize(RB * n);
+
+      for (index_t rb = start; rb < end; rb++) {
+        index_t r0 = rb * RB;
+        index_t rows = std::min(RB, m - r0);
+        for (index_t r = 0; r < rows; r++) {
+          for (index_t j = 0; j < n; j++) {
+            d[r * n + j] =
+                CovToAccum<acc_t>(CovElem(a, b, r0 + r, j)) - means[j];
+          }
+        }
+
+        // Upper triangle of d^H * d
+        for (index_t r = 0; r < rows; r++) {
+          const acc_t *drow = &d[r * n];
+          for (index_t i = 0; i < n; i++) {
+            acc_t di = CovConj(drow[i]);
+            acc_t *prow = &p[i * n];
+            for (index_t j = i; j < n; j++) {
+              prow[j] += di * drow[j];
+            }
+          }
+        }
+      }
+    });
+
+    for (index_t i = 0; i < n; i++) {
+      for (index_t j = i; j < n; j++) {
+        acc_t sum = 0;
+        for (int t = 0; t < threads; t++) {
+          sum += partial[t][i * n + j];
+        }
+
+        sum = sum / static_cast<value_type_t<acc_t>>(m - 1);
+        CovElem(c, b, i, j) = static_cast<T1>(sum);
+        CovElem(c, b, j, i) = static_cast<T1>(CovConj(sum));
+      }
+    }
+  }
+}
+
 } // end namespace matx
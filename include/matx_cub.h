@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
 #include "matx_tensor.h"
@@ -495,6 +496,8 @@ void sort(tensor_t<T1, RANK> &a_out, const tensor_t<T1, RANK> &a,
           const SortDirection_t dir = SORT_DIR_ASC,
           const cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params =
       matxCubPlan_t<T1, T1, RANK, CUB_OP_RADIX_SORT>::GetCubParams(a_out, a);
@@ -537,6 +540,8 @@ template <typename T1, int RANK>
 void cumsum(tensor_t<T1, RANK> &a_out, const tensor_t<T1, RANK> &a,
             const cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params =
       matxCubPlan_t<T1, T1, RANK, CUB_OP_INC_SUM>::GetCubParams(a_out, a);
@@ -586,6 +591,8 @@ template <typename T1, int RANK>
 void hist(tensor_t<int, RANK> &a_out, const tensor_t<T1, RANK> &a,
           const T1 lower, const T1 upper, const cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params =
       matxCubPlan_t<T1, int, RANK, CUB_OP_HIST_EVEN>::GetCubParams(a_out, a);
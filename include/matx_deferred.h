@@ -0,0 +1,706 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "matx_allocator.h"
+#include "matx_error.h"
+#include "matx_exec_kernel.h"
+#include "matx_tensor.h"
+#include "matx_type_utils.h"
+
+namespace matx {
+
+template <class I1, class Op> class matxUnaryOp;
+template <class I1, class I2, class Op> class matxBinaryOp;
+template <typename T, int RANK> class ConstVal;
+template <typename Generator1D, int Dim, int RANK> class matxGenerator1D_t;
+
+/**
+ * Whether an operator only reads tensors at the same index as the element it
+ * computes. Scalars, constants and 1D generators read no tensors, and unary
+ * and binary operators are element-wise when their inputs are. Everything
+ * else is assumed to read at other indices.
+ */
+template <typename T>
+struct is_deferred_elementwise : std::bool_constant<!is_matx_op<T>()> {
+};
+template <typename T, int RANK>
+struct is_deferred_elementwise<tensor_t<T, RANK>> : std::true_type {
+};
+template <typename T, int RANK>
+struct is_deferred_elementwise<tensor_ref_t<T, RANK>> : std::true_type {
+};
+template <typename T, int RANK>
+struct is_deferred_elementwise<ConstVal<T, RANK>> : std::true_type {
+};
+template <typename Generator1D, int Dim, int RANK>
+struct is_deferred_elementwise<matxGenerator1D_t<Generator1D, Dim, RANK>>
+    : std::true_type {
+};
+template <class I1, class Op>
+struct is_deferred_elementwise<matxUnaryOp<I1, Op>>
+    : is_deferred_elementwise<I1> {
+};
+template <class I1, class I2, class Op>
+struct is_deferred_elementwise<matxBinaryOp<I1, I2, Op>>
+    : std::bool_constant<is_deferred_elementwise<I1>::value &&
+                         is_deferred_elementwise<I2>::value> {
+};
+
+/**
+ * Whether a statement can be fused with its neighbours: an element-wise
+ * assignment into a rank 1 to 4 view
+ */
+template <typename T> struct is_deferred_fusable : std::false_type {
+};
+template <class T, int RANK, class Op>
+struct is_deferred_fusable<set<T, RANK, Op>>
+    : std::bool_constant<RANK >= 1 && RANK <= 4 &&
+                         is_deferred_elementwise<Op>::value> {
+};
+
+/**
+ * Memory touched by a tensor view, used to infer dependencies between queued
+ * statements. Two views are the same access when every field matches.
+ */
+struct DeferredView_t {
+  uintptr_t base;
+  uintptr_t lo;
+  uintptr_t hi;
+  int rank;
+  index_t size[MATX_MAX_RANK];
+  index_t stride[MATX_MAX_RANK];
+
+  bool Overlaps(const DeferredView_t &v) const
+  {
+    return lo < v.hi && v.lo < hi;
+  }
+
+  bool operator==(const DeferredView_t &v) const
+  {
+    if (base != v.base || rank != v.rank) {
+      return false;
+    }
+
+    for (int i = 0; i < rank; i++) {
+      if (size[i] != v.size[i] || stride[i] != v.stride[i]) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /* Whether more than one index maps to the same element */
+  bool Aliased() const
+  {
+    for (int i = 0; i < rank; i++) {
+      if (size[i] > 1 && stride[i] == 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+template <typename TensorType>
+DeferredView_t DeferredMakeView(const TensorType &t)
+{
+  using T = typename TensorType::scalar_type;
+  constexpr int RANK = TensorType::Rank();
+  DeferredView_t v{};
+  v.base = reinterpret_cast<uintptr_t>(t.Data());
+  v.lo = v.base;
+  v.hi = v.base + sizeof(T);
+  v.rank = RANK;
+  if constexpr (RANK > 0) {
+    for (int i = 0; i < RANK; i++) {
+      v.size[i] = t.Size(i);
+      v.stride[i] = t.Stride(i);
+      const index_t ext = (t.Size(i) - 1) * t.Stride(i) *
+                          static_cast<index_t>(sizeof(T));
+      if (ext < 0) {
+        v.lo -= static_cast<uintptr_t>(-ext);
+      }
+      else {
+        v.hi += static_cast<uintptr_t>(ext);
+      }
+    }
+  }
+
+  return v;
+}
+
+/**
+ * Collect the views of every tensor read by an element-wise operator
+ */
+template <typename Op>
+void DeferredReads(const Op &, std::vector<DeferredView_t> &);
+template <typename T, int RANK>
+void DeferredReads(const tensor_t<T, RANK> &t,
+                   std::vector<DeferredView_t> &reads);
+template <typename T, int RANK>
+void DeferredReads(const tensor_ref_t<T, RANK> &t,
+                   std::vector<DeferredView_t> &reads);
+template <class I1, class Op>
+void DeferredReads(const matxUnaryOp<I1, Op> &op,
+                   std::vector<DeferredView_t> &reads);
+template <class I1, class I2, class Op>
+void DeferredReads(const matxBinaryOp<I1, I2, Op> &op,
+                   std::vector<DeferredView_t> &reads);
+
+template <typename Op>
+void DeferredReads(const Op &, std::vector<DeferredView_t> &)
+{
+}
+
+template <typename T, int RANK>
+void DeferredReads(const tensor_t<T, RANK> &t,
+                   std::vector<DeferredView_t> &reads)
+{
+  reads.push_back(DeferredMakeView(t));
+}
+
+template <typename T, int RANK>
+void DeferredReads(const tensor_ref_t<T, RANK> &t,
+                   std::vector<DeferredView_t> &reads)
+{
+  reads.push_back(DeferredMakeView(t));
+}
+
+template <class I1, class Op>
+void DeferredReads(const matxUnaryOp<I1, Op> &op,
+                   std::vector<DeferredView_t> &reads)
+{
+  op.VisitInputs([&](const auto &in) { DeferredReads(in, reads); });
+}
+
+template <class I1, class I2, class Op>
+void DeferredReads(const matxBinaryOp<I1, I2, Op> &op,
+                   std::vector<DeferredView_t> &reads)
+{
+  op.VisitInputs([&](const auto &in) { DeferredReads(in, reads); });
+}
+
+/**
+ * Device entry point of one statement of a fused group. Each statement is
+ * called through a pointer to its instantiation of DeferredApply with the
+ * operator stored in device memory. Which statements share a group is only
+ * known when the queue is flushed, so the fused kernel can't be instantiated
+ * over their types.
+ */
+typedef void (*DeferredFn_t)(void *op, const index_t *idx);
+
+struct DeferredEntry_t {
+  const DeferredFn_t *fn; // Device variable holding the entry point
+  size_t offset;
+};
+
+template <class Op> __device__ void DeferredApply(void *p, const index_t *idx)
+{
+  Op &op = *static_cast<Op *>(p);
+  if constexpr (Op::Rank() == 1) {
+    op(idx[0]);
+  }
+  else if constexpr (Op::Rank() == 2) {
+    op(idx[0], idx[1]);
+  }
+  else if constexpr (Op::Rank() == 3) {
+    op(idx[0], idx[1], idx[2]);
+  }
+  else {
+    op(idx[0], idx[1], idx[2], idx[3]);
+  }
+}
+
+/* Entry point of each statement type, initialized when the module loads so
+ * the host only needs the variable's address and never reads it back */
+template <class Op> __device__ DeferredFn_t deferred_fn_v = DeferredApply<Op>;
+
+/**
+ * Run a fused group of element-wise statements in one pass. Each thread owns
+ * one index of the common shape and runs every statement at that index in
+ * queue order, so a temporary written by one statement is read back by the
+ * same thread while it's still in cache.
+ */
+template <int RANK>
+__launch_bounds__(256) __global__
+    void matxDeferredFusedKernel(const DeferredEntry_t *entries, int count,
+                                 char *ops, index_t size0, index_t size1,
+                                 index_t size2, index_t size3, index_t total)
+{
+  index_t tid = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (tid >= total) {
+    return;
+  }
+
+  const index_t size[4] = {size0, size1, size2, size3};
+  index_t idx[RANK];
+  for (int d = RANK - 1; d >= 0; d--) {
+    idx[d] = tid % size[d];
+    tid /= size[d];
+  }
+
+  for (int e = 0; e < count; e++) {
+    (*entries[e].fn)(ops + entries[e].offset, idx);
+  }
+}
+
+/**
+ * Statement waiting in a deferred queue
+ */
+class matxDeferredNode_t {
+public:
+  virtual ~matxDeferredNode_t() = default;
+
+  /* Launch the statement by itself */
+  virtual void Launch(cudaStream_t stream) = 0;
+
+  /* Device address of the function that runs the statement at one index */
+  virtual const DeferredFn_t *Fn() const = 0;
+
+  /* Host copy of the operator, and its size and alignment */
+  virtual const void *OpData() const = 0;
+  virtual size_t OpBytes() const = 0;
+  virtual size_t OpAlign() const = 0;
+
+  bool fusable_ = false;
+  int rank_ = 0;
+  index_t size_[4] = {1, 1, 1, 1};
+  DeferredView_t write_{};
+  std::vector<DeferredView_t> reads_;
+};
+
+template <class Op> class matxDeferredOpNode_t : public matxDeferredNode_t {
+public:
+  matxDeferredOpNode_t(const Op &op) : op_(op)
+  {
+    if constexpr (is_deferred_fusable<Op>::value) {
+      write_ = DeferredMakeView(op_.Output());
+      fusable_ = !write_.Aliased();
+      rank_ = Op::Rank();
+      for (int i = 0; i < rank_; i++) {
+        size_[i] = op_.Size(i);
+      }
+      op_.VisitInputs([&](const auto &in) { DeferredReads(in, reads_); });
+    }
+  }
+
+  void Launch(cudaStream_t stream) override { exec(op_, stream); }
+
+  const DeferredFn_t *Fn() const override
+  {
+    if constexpr (is_deferred_fusable<Op>::value) {
+      // Looked up once per statement type. Only the symbol's address is
+      // needed, so nothing is copied and the device isn't synchronized.
+      static const DeferredFn_t *fn = [] {
+        void *addr = nullptr;
+        MATX_ASSERT(cudaGetSymbolAddress(&addr, deferred_fn_v<Op>) ==
+                        cudaSuccess,
+                    matxCudaError);
+        return static_cast<const DeferredFn_t *>(addr);
+      }();
+
+      return fn;
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  const void *OpData() const override { return &op_; }
+  size_t OpBytes() const override { return sizeof(Op); }
+  size_t OpAlign() const override { return alignof(Op); }
+
+private:
+  Op op_;
+};
+
+/**
+ * Queue of statements deferred on a stream
+ *
+ * While deferred execution is active on a stream, run() on an operator
+ * statement adds it to the stream's queue instead of launching it. Flush()
+ * launches the queue in order, fusing runs of adjacent element-wise
+ * assignments over the same shape into one kernel that makes a single pass
+ * over the index space.
+ *
+ * Dependencies are inferred from the views each statement writes and reads.
+ * A statement joins the current group only if every access it makes to
+ * memory written or read by the group is through the identical view, so each
+ * element it depends on is produced by the same thread. Any other overlap,
+ * such as a shifted slice or a broadcast read of a tensor written in the
+ * group, starts a new group. Statements that aren't element-wise, such as
+ * CHAIN, IF or operators that read across indices, are launched on their own
+ * as they would be by run().
+ */
+class matxDeferredQueue_t {
+public:
+  matxDeferredQueue_t(cudaStream_t stream) : stream_(stream) {}
+
+  ~matxDeferredQueue_t() { matxFree(buf_); }
+
+  /**
+   * Add a statement to the queue
+   *
+   * @param op
+   *   Statement to defer
+   */
+  template <class Op> void Enqueue(const Op &op)
+  {
+    nodes_.push_back(std::make_unique<matxDeferredOpNode_t<Op>>(op));
+  }
+
+  /**
+   * Launch every queued statement in order and empty the queue
+   *
+   * Statements can call into the library while they launch, such as a lazy
+   * reduction running reduce() in PreRun. The queue reports itself as
+   * flushing during the launches so that those calls run immediately rather
+   * than being queued behind, or flushing, the statements being launched.
+   */
+  void Flush()
+  {
+    if (flushing_) {
+      return;
+    }
+
+    flushing_ = true;
+    try {
+      size_t i = 0;
+      while (i < nodes_.size()) {
+        size_t end = i + 1;
+        if (nodes_[i]->fusable_) {
+          while (end < nodes_.size() && CanFuse(i, end)) {
+            end++;
+          }
+        }
+
+        if (end - i == 1) {
+          nodes_[i]->Launch(stream_);
+        }
+        else {
+          LaunchFused(i, end);
+        }
+
+        i = end;
+      }
+    }
+    catch (...) {
+      nodes_.clear();
+      flushing_ = false;
+      throw;
+    }
+
+    nodes_.clear();
+    flushing_ = false;
+  }
+
+  /**
+   * Whether the queue is launching its statements
+   */
+  bool Flushing() const { return flushing_; }
+
+  /**
+   * Number of statements waiting in the queue
+   */
+  size_t Size() const { return nodes_.size(); }
+
+private:
+  /* Whether node n can join the group of nodes [begin, n) */
+  bool CanFuse(size_t begin, size_t n) const
+  {
+    const matxDeferredNode_t &node = *nodes_[n];
+    const matxDeferredNode_t &first = *nodes_[begin];
+    if (!node.fusable_ || node.rank_ != first.rank_) {
+      return false;
+    }
+
+    for (int d = 0; d < node.rank_; d++) {
+      if (node.size_[d] != first.size_[d]) {
+        return false;
+      }
+    }
+
+    auto conflict = [](const DeferredView_t &a, const DeferredView_t &b) {
+      return a.Overlaps(b) && !(a == b);
+    };
+
+    for (size_t g = begin; g < n; g++) {
+      const matxDeferredNode_t &prev = *nodes_[g];
+      if (conflict(node.write_, prev.write_)) {
+        return false;
+      }
+
+      for (const auto &r : node.reads_) {
+        if (conflict(r, prev.write_)) {
+          return false;
+        }
+      }
+
+      for (const auto &r : prev.reads_) {
+        if (conflict(node.write_, r)) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  void LaunchFused(size_t begin, size_t end)
+  {
+    const size_t count = end - begin;
+    auto align = [](size_t v, size_t a) { return (v + a - 1) / a * a; };
+
+    // Entries followed by the operators, uploaded in one copy
+    const size_t ops_start =
+        align(count * sizeof(DeferredEntry_t), alignof(std::max_align_t));
+    std::vector<DeferredEntry_t> entries(count);
+    size_t bytes = 0;
+    for (size_t e = 0; e < count; e++) {
+      const matxDeferredNode_t &node = *nodes_[begin + e];
+      bytes = align(bytes, node.OpAlign());
+      entries[e] = {node.Fn(), bytes};
+      bytes += node.OpBytes();
+    }
+
+    std::vector<char> host(ops_start + bytes);
+    memcpy(host.data(), entries.data(), count * sizeof(DeferredEntry_t));
+    for (size_t e = 0; e < count; e++) {
+      const matxDeferredNode_t &node = *nodes_[begin + e];
+      memcpy(host.data() + ops_start + entries[e].offset, node.OpData(),
+             node.OpBytes());
+    }
+
+    if (host.size() > buf_bytes_) {
+      matxFree(buf_);
+      matxAlloc(&buf_, host.size(), MATX_DEVICE_MEMORY);
+      buf_bytes_ = host.size();
+    }
+
+    // Pageable copies are staged before returning, so host can go out of
+    // scope while the copy is in flight
+    cudaMemcpyAsync(buf_, host.data(), host.size(), cudaMemcpyHostToDevice,
+                    stream_);
+
+    const matxDeferredNode_t &first = *nodes_[begin];
+    index_t total = 1;
+    for (int d = 0; d < first.rank_; d++) {
+      total *= first.size_[d];
+    }
+
+    switch (first.rank_) {
+    case 1:
+      LaunchFusedKernel<1>(static_cast<int>(count), ops_start, first.size_,
+                           total);
+      break;
+    case 2:
+      LaunchFusedKernel<2>(static_cast<int>(count), ops_start, first.size_,
+                           total);
+      break;
+    case 3:
+      LaunchFusedKernel<3>(static_cast<int>(count), ops_start, first.size_,
+                           total);
+      break;
+    default:
+      LaunchFusedKernel<4>(static_cast<int>(count), ops_start, first.size_,
+                           total);
+      break;
+    }
+  }
+
+  template <int RANK>
+  void LaunchFusedKernel(int count, size_t ops_start, const index_t *s,
+                         index_t total)
+  {
+    const auto *entries = static_cast<const DeferredEntry_t *>(buf_);
+    dim3 threads(256);
+    dim3 blocks(static_cast<unsigned int>((total + 255) / 256));
+    char *ops = static_cast<char *>(buf_) + ops_start;
+    matxDeferredFusedKernel<RANK><<<blocks, threads, 0, stream_>>>(
+        entries, count, ops, s[0], s[1], s[2], s[3], total);
+  }
+
+  cudaStream_t stream_;
+  std::vector<std::unique_ptr<matxDeferredNode_t>> nodes_;
+  void *buf_ = nullptr;
+  size_t buf_bytes_ = 0;
+  bool flushing_ = false;
+};
+
+/* Queues of the streams with deferred execution active */
+inline std::unordered_map<cudaStream_t, std::unique_ptr<matxDeferredQueue_t>> &
+DeferredQueues()
+{
+  static std::unordered_map<cudaStream_t,
+                            std::unique_ptr<matxDeferredQueue_t>>
+      queues;
+  return queues;
+}
+
+inline std::mutex &DeferredMutex()
+{
+  static std::mutex mtx;
+  return mtx;
+}
+
+/* Number of streams with deferred execution active. Every library call checks
+ * for a queue to flush, so this keeps the mutex off that path when nothing is
+ * deferred. */
+inline std::atomic<int> &DeferredActive()
+{
+  static std::atomic<int> active{0};
+  return active;
+}
+
+/**
+ * Get the deferred queue of a stream
+ *
+ * @param stream
+ *   CUDA stream
+ * @returns
+ *   Queue of the stream, or nullptr when deferred execution isn't active on it
+ * or the queue is launching its statements
+ */
+inline matxDeferredQueue_t *GetDeferredQueue(cudaStream_t stream)
+{
+  if (DeferredActive().load(std::memory_order_acquire) == 0) {
+    return nullptr;
+  }
+
+  std::unique_lock lck(DeferredMutex());
+  auto &queues = DeferredQueues();
+  if (queues.empty()) {
+    return nullptr;
+  }
+
+  auto el = queues.find(stream);
+  if (el == queues.end() || el->second->Flushing()) {
+    return nullptr;
+  }
+
+  return el->second.get();
+}
+
+/**
+ * Start deferring statements on a stream
+ *
+ * Until deferred_end() is called, run() on an operator statement in this
+ * stream is queued instead of launched. Queued statements are launched, with
+ * adjacent element-wise statements fused, at deferred_flush() or
+ * deferred_end(). Other work such as FFTs, GEMMs or reductions is not queued:
+ * those calls flush the stream's queue before launching, so they see the
+ * results of the statements queued before them. Results read on the host
+ * still need a deferred_flush() or deferred_end() before the stream is
+ * synchronized. Queued statements reference the tensors they use without
+ * owning them, so those tensors must stay alive until the queue is flushed.
+ *
+ * Fusing saves launches and passes over the index space, but every statement
+ * still writes its output, including temporaries that no later statement or
+ * caller reads, since the queue can't tell which tensors are dead.
+ *
+ * @param stream
+ *   CUDA stream
+ */
+inline void deferred_begin(cudaStream_t stream = 0)
+{
+  std::unique_lock lck(DeferredMutex());
+  auto &queues = DeferredQueues();
+  MATX_ASSERT_STR(queues.find(stream) == queues.end(), matxInvalidParameter,
+                  "Deferred execution is already active on this stream");
+  queues[stream] = std::make_unique<matxDeferredQueue_t>(stream);
+  DeferredActive().fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * Launch the statements deferred on a stream
+ *
+ * @param stream
+ *   CUDA stream
+ */
+inline void deferred_flush(cudaStream_t stream = 0)
+{
+  auto q = GetDeferredQueue(stream);
+  if (q != nullptr) {
+    q->Flush();
+  }
+}
+
+/**
+ * Launch the statements deferred on a stream and stop deferring
+ *
+ * @param stream
+ *   CUDA stream
+ */
+inline void deferred_end(cudaStream_t stream = 0)
+{
+  deferred_flush(stream);
+
+  std::unique_lock lck(DeferredMutex());
+  if (DeferredQueues().erase(stream) > 0) {
+    DeferredActive().fetch_sub(1, std::memory_order_release);
+  }
+}
+
+/**
+ * Defer statements on a stream for the lifetime of the object
+ *
+ * Calls deferred_begin() on construction and deferred_end() on destruction.
+ */
+class matxDeferredScope_t {
+public:
+  matxDeferredScope_t(cudaStream_t stream = 0) : stream_(stream)
+  {
+    deferred_begin(stream_);
+  }
+
+  ~matxDeferredScope_t() { deferred_end(stream_); }
+
+  matxDeferredScope_t(const matxDeferredScope_t &) = delete;
+  matxDeferredScope_t &operator=(const matxDeferredScope_t &) = delete;
+
+private:
+  cudaStream_t stream_;
+};
+
+} // end namespace matx
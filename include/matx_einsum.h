@@ -0,0 +1,530 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "kernels/matx_einsum_kernels.cuh"
+#include "matx_cache.h"
+#include "matx_deferred.h"
+#include "matx_error.h"
+#include "matx_matmul.h"
+#include "matx_tensor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace matx {
+
+/**
+ * Parameters of an einsum contraction. The operands are ordered C, A, B, so
+ * the output is always first.
+ */
+struct EinsumParams_t {
+  std::string spec;
+  int rank[3];
+  index_t size[3][MATX_MAX_RANK];
+  index_t stride[3][MATX_MAX_RANK];
+  MatXDataType_t dtype[3];
+  cudaStream_t stream;
+};
+
+/**
+ * Whether a contraction of these types can run as a GEMM. cuBLASLt needs all
+ * three types to match, and complex half types are excluded since matmul
+ * makes contiguous planar copies of them, which strided views don't survive.
+ */
+template <typename TC, typename TA, typename TB>
+constexpr bool EinsumGemmTypes()
+{
+  return std::is_same_v<TC, TA> && std::is_same_v<TC, TB> &&
+         !is_complex_half_v<TC> &&
+         (std::is_floating_point_v<TC> || is_complex_v<TC> ||
+          is_matx_half_v<TC>);
+}
+
+/**
+ * Plan for an einsum contraction
+ *
+ * Each label of the spec is sorted by the tensors it appears in: labels in
+ * all three are batch dimensions, labels in the output and one input are the
+ * M or N dimension of a GEMM, and labels in both inputs only are summed as
+ * K. When the labels of each group are laid out in every tensor so they merge
+ * into one dimension with a single stride, the contraction is a strided
+ * batched GEMM on rank 3 views of the original memory, and no permutes are
+ * materialized. Anything else, such as a label repeated within a tensor, a
+ * label summed within one input, or groups whose strides don't merge, runs as
+ * a loop nest. When the output has a label only in A and a label only in B,
+ * the loop nest is tiled over those two labels and the flattened summed
+ * labels, with the input tiles staged in shared memory. Otherwise it runs one
+ * thread per output element.
+ */
+class matxEinsumPlan_t {
+public:
+  /**
+   * Construct an einsum plan
+   *
+   * @param params
+   *   Spec and tensor layouts to plan for
+   * @param gemm
+   *   Whether the types allow a GEMM
+   */
+  matxEinsumPlan_t(const EinsumParams_t &params, bool gemm)
+  {
+    const std::string &spec = params.spec;
+    const auto arrow = spec.find("->");
+    const auto comma = spec.find(',');
+    MATX_ASSERT_STR(arrow != std::string::npos, matxInvalidParameter,
+                    "einsum spec must name the output labels after \"->\"");
+    MATX_ASSERT_STR(comma != std::string::npos && comma < arrow &&
+                        spec.find(',', comma + 1) == std::string::npos,
+                    matxInvalidParameter,
+                    "einsum spec must have exactly two inputs");
+
+    const std::string names[3] = {spec.substr(arrow + 2),
+                                  spec.substr(0, comma),
+                                  spec.substr(comma + 1, arrow - comma - 1)};
+
+    // Inputs first so the output can only use labels they define
+    for (int t : {1, 2, 0}) {
+      MATX_ASSERT_STR(static_cast<int>(names[t].size()) == params.rank[t],
+                      matxInvalidDim,
+                      "einsum spec doesn't match the rank of a tensor");
+
+      for (int i = 0; i < params.rank[t]; i++) {
+        auto l = Find(names[t][i]);
+        if (l == labels_.end()) {
+          MATX_ASSERT_STR(t != 0, matxInvalidParameter,
+                          "einsum output label is not in either input");
+          labels_.push_back({names[t][i], params.size[t][i], {0}, {0}});
+          l = labels_.end() - 1;
+        }
+
+        MATX_ASSERT_STR(l->size == params.size[t][i], matxInvalidSize,
+                        "einsum label has different sizes in two tensors");
+        l->count[t]++;
+        l->stride[t] += params.stride[t][i];
+      }
+    }
+
+    loops_.out_rank = params.rank[0];
+    loops_.out_total = 1;
+    for (int i = 0; i < params.rank[0]; i++) {
+      const auto l = Find(names[0][i]);
+      MATX_ASSERT_STR(l->count[0] == 1, matxInvalidParameter,
+                      "einsum output labels can't repeat");
+      loops_.out_size[i] = l->size;
+      loops_.out_stride_a[i] = l->stride[1];
+      loops_.out_stride_b[i] = l->stride[2];
+      loops_.out_stride_c[i] = l->stride[0];
+      loops_.out_total *= l->size;
+    }
+
+    loops_.sum_rank = 0;
+    loops_.sum_total = 1;
+    for (const auto &l : labels_) {
+      if (l.count[0] == 0) {
+        loops_.sum_size[loops_.sum_rank] = l.size;
+        loops_.sum_stride_a[loops_.sum_rank] = l.stride[1];
+        loops_.sum_stride_b[loops_.sum_rank] = l.stride[2];
+        loops_.sum_rank++;
+        loops_.sum_total *= l.size;
+      }
+    }
+
+    // The innermost output labels that index only A or only B are the rows
+    // and columns of the tiled loop nest
+    loops_.tile_m = -1;
+    loops_.tile_n = -1;
+    for (int i = params.rank[0] - 1; i >= 0; i--) {
+      const bool in_a = loops_.out_stride_a[i] != 0;
+      const bool in_b = loops_.out_stride_b[i] != 0;
+      if (loops_.out_size[i] <= 1) {
+        continue;
+      }
+
+      if (loops_.tile_m < 0 && in_a && !in_b) {
+        loops_.tile_m = i;
+      }
+      else if (loops_.tile_n < 0 && in_b && !in_a) {
+        loops_.tile_n = i;
+      }
+    }
+
+    loops_.rest_total = loops_.out_total;
+    if (loops_.tile_m >= 0 && loops_.tile_n >= 0) {
+      loops_.rest_total /= loops_.out_size[loops_.tile_m] *
+                           loops_.out_size[loops_.tile_n];
+    }
+
+    gemm_ = gemm && PlanGemm(names);
+  }
+
+  /**
+   * Whether the contraction runs as a batched GEMM
+   */
+  bool IsGemm() const noexcept { return gemm_; }
+
+  /**
+   * Execute the contraction
+   *
+   * @param c
+   *   Output tensor
+   * @param a
+   *   First input tensor
+   * @param b
+   *   Second input tensor
+   * @param stream
+   *   CUDA stream
+   */
+  template <typename TC, int RC, typename TA, int RA, typename TB, int RB>
+  void Exec(tensor_t<TC, RC> &c, const tensor_t<TA, RA> &a,
+            const tensor_t<TB, RB> &b, cudaStream_t stream)
+  {
+    if constexpr (EinsumGemmTypes<TC, TA, TB>()) {
+      if (gemm_) {
+        tensor_t<TC, 3> lhs(swap_ ? b.Data() : a.Data(),
+                            tensorShape_t<3>(shape_[0]), strides_[0]);
+        tensor_t<TC, 3> rhs(swap_ ? a.Data() : b.Data(),
+                            tensorShape_t<3>(shape_[1]), strides_[1]);
+        tensor_t<TC, 3> out(c.Data(), tensorShape_t<3>(shape_[2]),
+                            strides_[2]);
+        matmul(out, lhs, rhs, stream);
+        return;
+      }
+    }
+
+    if (loops_.tile_m >= 0 && loops_.tile_n >= 0) {
+      const auto tiles = [](index_t size) {
+        return static_cast<unsigned int>(
+            std::min<index_t>((size + EINSUM_TILE - 1) / EINSUM_TILE, 65535));
+      };
+      dim3 grid(tiles(loops_.out_size[loops_.tile_n]),
+                tiles(loops_.out_size[loops_.tile_m]),
+                static_cast<unsigned int>(
+                    std::min<index_t>(loops_.rest_total, 65535)));
+      dim3 block(EINSUM_TILE, EINSUM_TILE);
+      EinsumTiled<<<grid, block, 0, stream>>>(c.Data(), a.Data(), b.Data(),
+                                              loops_);
+      return;
+    }
+
+    const index_t blocks =
+        std::min<index_t>((loops_.out_total + EINSUM_BLOCK_SIZE - 1) /
+                              EINSUM_BLOCK_SIZE,
+                          65535);
+    EinsumLoop<<<static_cast<unsigned int>(blocks), EINSUM_BLOCK_SIZE, 0,
+                 stream>>>(c.Data(), a.Data(), b.Data(), loops_);
+  }
+
+private:
+  struct Label {
+    char name;
+    index_t size;
+    index_t stride[3]; // Sum of the strides of each use in C, A, B
+    int count[3];      // Number of uses in C, A, B
+  };
+
+  std::vector<Label>::iterator Find(char name)
+  {
+    return std::find_if(labels_.begin(), labels_.end(),
+                        [name](const Label &l) { return l.name == name; });
+  }
+
+  /**
+   * Merge a group of labels, ordered outermost first, into one dimension of
+   * tensor t. This only works when each label steps over all of the labels
+   * inside it. An empty group is a dimension of size 1 with a stride of 0,
+   * which is fixed up once the rest of the matrix is known.
+   */
+  bool Merge(const std::vector<const Label *> &group, int t, index_t &size,
+             index_t &stride) const
+  {
+    size = 1;
+    stride = group.empty() ? 0 : group.back()->stride[t];
+    for (size_t i = group.size(); i-- > 0;) {
+      if (group[i]->stride[t] != stride * size) {
+        return false;
+      }
+
+      size *= group[i]->size;
+    }
+
+    return true;
+  }
+
+  /**
+   * Pick strides for the size 1 dimensions of a rows x cols matrix, then check
+   * that the matrix is row or column major with a valid leading dimension.
+   * Since a size 1 dimension is never stepped over, its stride can be anything
+   * that makes the layout valid.
+   */
+  static bool FixMatrix(index_t rows, index_t cols, index_t &sr, index_t &sc,
+                        bool row_major_only)
+  {
+    if (cols == 1) {
+      sc = 1;
+    }
+    if (rows == 1) {
+      sr = (sc == 1) ? cols : 1;
+    }
+
+    return (sc == 1 && sr >= cols) ||
+           (!row_major_only && sr == 1 && sc >= rows);
+  }
+
+  bool PlanGemm(const std::string (&names)[3])
+  {
+    // Repeated labels take diagonals, and a label summed inside one input
+    // reduces it before the product
+    for (const auto &l : labels_) {
+      if (l.count[0] > 1 || l.count[1] > 1 || l.count[2] > 1 ||
+          (l.count[0] == 0 && (l.count[1] == 0 || l.count[2] == 0))) {
+        return false;
+      }
+    }
+
+    // Batch, M, N, K. The output groups keep the order of the output labels,
+    // and K keeps the order of A. Size 1 labels don't change the layout.
+    std::vector<const Label *> groups[4];
+    for (int g = 0; g < 4; g++) {
+      for (char name : names[g == 3 ? 1 : 0]) {
+        const auto &l = *Find(name);
+        const int group = l.count[0] == 0               ? 3
+                          : (l.count[1] && l.count[2]) ? 0
+                          : l.count[1]                 ? 1
+                                                       : 2;
+        if (group == g && l.size > 1) {
+          groups[g].push_back(&l);
+        }
+      }
+    }
+
+    index_t nb, m, n, k;
+    index_t batch[3], am, ak, bk, bn, cm, cn;
+    if (!Merge(groups[0], 0, nb, batch[0]) ||
+        !Merge(groups[0], 1, nb, batch[1]) ||
+        !Merge(groups[0], 2, nb, batch[2]) || !Merge(groups[1], 1, m, am) ||
+        !Merge(groups[1], 0, m, cm) || !Merge(groups[2], 2, n, bn) ||
+        !Merge(groups[2], 0, n, cn) || !Merge(groups[3], 1, k, ak) ||
+        !Merge(groups[3], 2, k, bk)) {
+      return false;
+    }
+
+    if (nb > INT32_MAX || (nb > 1 && batch[0] == 0)) {
+      return false;
+    }
+
+    // C must be row major. When it's column major, compute C' = B'A' instead,
+    // which is the same memory viewed as N x M.
+    swap_ = !(n == 1 || cn == 1) && (m == 1 || cm == 1);
+    if (swap_) {
+      std::swap(m, n);
+      std::swap(am, bn);
+      std::swap(ak, bk);
+      std::swap(cm, cn);
+      std::swap(batch[1], batch[2]);
+    }
+
+    if (!FixMatrix(m, k, am, ak, false) || !FixMatrix(k, n, bk, bn, false) ||
+        !FixMatrix(m, n, cm, cn, true)) {
+      return false;
+    }
+
+    const index_t shapes[3][3] = {{nb, m, k}, {nb, k, n}, {nb, m, n}};
+    const index_t strides[3][3] = {
+        {batch[1], am, ak}, {batch[2], bk, bn}, {batch[0], cm, cn}};
+    std::copy(&shapes[0][0], &shapes[0][0] + 9, &shape_[0][0]);
+    std::copy(&strides[0][0], &strides[0][0] + 9, &strides_[0][0]);
+
+    return true;
+  }
+
+  std::vector<Label> labels_;
+  EinsumLoops_t loops_;
+  bool gemm_ = false;
+  bool swap_ = false; // The GEMM computes C' = B'A'
+  index_t shape_[3][3];   // GEMM A, B, C views as [batch, rows, cols]
+  index_t strides_[3][3];
+};
+
+/**
+ * Crude hash on einsum to get a reasonably good delta for collisions. This
+ * doesn't need to be perfect, but fast enough to not slow down lookups, and
+ * different enough so the common einsum parameters change
+ */
+struct EinsumParamsKeyHash {
+  std::size_t operator()(const EinsumParams_t &k) const noexcept
+  {
+    std::size_t h = std::hash<std::string>()(k.spec) +
+                    std::hash<index_t>()((size_t)k.stream);
+    for (int t = 0; t < 3; t++) {
+      for (int i = 0; i < k.rank[t]; i++) {
+        h += std::hash<index_t>()(k.size[t][i]);
+      }
+    }
+
+    return h;
+  }
+};
+
+/**
+ * Test einsum parameters for equality. Unlike the hash, all parameters must
+ * match.
+ */
+struct EinsumParamsKeyEq {
+  bool operator()(const EinsumParams_t &l, const EinsumParams_t &t) const
+      noexcept
+  {
+    if (l.spec != t.spec || l.stream != t.stream) {
+      return false;
+    }
+
+    for (int o = 0; o < 3; o++) {
+      if (l.rank[o] != t.rank[o] || l.dtype[o] != t.dtype[o]) {
+        return false;
+      }
+
+      for (int i = 0; i < l.rank[o]; i++) {
+        if (l.size[o][i] != t.size[o][i] || l.stride[o][i] != t.stride[o][i]) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+};
+
+// Static cache of einsum plans
+static matxCache_t<EinsumParams_t, EinsumParamsKeyHash, EinsumParamsKeyEq>
+    einsum_cache;
+
+/**
+ * Record the sizes, strides and type of one einsum operand
+ */
+template <typename T, int RANK>
+void EinsumSetOperand(EinsumParams_t &params, int t,
+                      const tensor_t<T, RANK> &op)
+{
+  static_assert(RANK <= MATX_MAX_RANK, "Rank exceeds MATX_MAX_RANK");
+  params.rank[t] = RANK;
+  params.dtype[t] = TypeToInt<T>();
+  for (int i = 0; i < RANK; i++) {
+    params.size[t][i] = op.Size(i);
+    params.stride[t][i] = op.Stride(i);
+  }
+}
+
+/**
+ * Get a cached einsum plan for the spec and the layouts of the tensors,
+ * creating it if it doesn't exist
+ */
+template <typename TC, int RC, typename TA, int RA, typename TB, int RB>
+matxEinsumPlan_t *GetEinsumPlan(const tensor_t<TC, RC> &c,
+                                const std::string &spec,
+                                const tensor_t<TA, RA> &a,
+                                const tensor_t<TB, RB> &b, cudaStream_t stream)
+{
+  EinsumParams_t params;
+  params.spec = spec;
+  params.stream = stream;
+  EinsumSetOperand(params, 0, c);
+  EinsumSetOperand(params, 1, a);
+  EinsumSetOperand(params, 2, b);
+
+  auto ret = einsum_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    auto tmp = new matxEinsumPlan_t{params, EinsumGemmTypes<TC, TA, TB>()};
+    einsum_cache.Insert(params, static_cast<void *>(tmp));
+    return tmp;
+  }
+
+  return static_cast<matxEinsumPlan_t *>(ret.value());
+}
+
+/**
+ * Tensor contraction in Einstein notation
+ *
+ * Contracts two tensors as described by a spec such as "cpk,bk->cpb", where
+ * each letter labels a dimension of A, B and C in order. Labels missing from
+ * the output are summed over, and labels shared by all three tensors are
+ * batch dimensions. The output labels after "->" are required, and the spec
+ * can't have spaces.
+ *
+ * Contractions that can be written as a strided batched GEMM on the memory of
+ * the tensors as they are, including permuted views, run through matmul()
+ * without copying anything. This needs A, B and C to have the same floating
+ * point or complex type, each group of batch, M, N or K labels to be
+ * contiguous with each other in every tensor, and every label to be in
+ * exactly two of the tensors, or all three. Other contractions, including
+ * traces and diagonals from repeated labels, run as a loop nest. The loop
+ * nest is tiled in shared memory when the output has a label only in A and a
+ * label only in B, and otherwise runs one thread per output element. Plans
+ * are cached on the spec and the sizes and strides of the tensors.
+ *
+ * @tparam TC
+ *   Data type of C tensor
+ * @tparam RC
+ *   Rank of C tensor
+ * @tparam TA
+ *   Data type of A tensor
+ * @tparam RA
+ *   Rank of A tensor
+ * @tparam TB
+ *   Data type of B tensor
+ * @tparam RB
+ *   Rank of B tensor
+ *
+ * @param c
+ *   Output tensor
+ * @param spec
+ *   Labels of A and B separated by a comma, then "->" and the labels of C
+ * @param a
+ *   First input tensor
+ * @param b
+ *   Second input tensor
+ * @param stream
+ *   CUDA stream
+ */
+template <typename TC, int RC, typename TA, int RA, typename TB, int RB>
+void einsum(tensor_t<TC, RC> c, const std::string &spec,
+            const tensor_t<TA, RA> &a, const tensor_t<TB, RB> &b,
+            cudaStream_t stream = 0)
+{
+  deferred_flush(stream);
+
+  GetEinsumPlan(c, spec, a, b, stream)->Exec(c, a, b, stream);
+}
+
+}; // namespace matx
@@ -31,6 +31,8 @@
 /////////////////////////////////////////////////////////////////////////////////
 
 #pragma once
+#include <algorithm>
+#include <array>
 #include <type_traits>
 
 #include "matx_error.h"
@@ -40,54 +42,90 @@ namespace matx {
 
 template <class Op> __global__ void matxOpT0Kernel(Op op) { op(); }
 
-template <class Op>
-__launch_bounds__(256) __global__ void matxOpT1Kernel(Op op, index_t size)
+template <class Op, typename I>
+__launch_bounds__(256) __global__ void matxOpT1Kernel(Op op, I size)
 {
-  index_t idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  I idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
   if (idx < size) {
     op(idx);
   }
 }
 
-template <class Op>
-__launch_bounds__(256) __global__
-    void matxOpT2Kernel(Op op, index_t size0, index_t size1)
+template <class Op, typename I>
+__launch_bounds__(256) __global__ void matxOpT2Kernel(Op op, I size0, I size1)
 {
-  index_t idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-  index_t idy = static_cast<index_t>(blockIdx.y) * blockDim.y + threadIdx.y;
+  I idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+  I idy = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
   if (idx < size1 && idy < size0) {
     op(idy, idx);
   }
 }
 
-template <class Op>
+template <class Op, typename I>
 __launch_bounds__(256) __global__
-    void matxOpT3Kernel(Op op, index_t size0, index_t size1, index_t size2)
+    void matxOpT3Kernel(Op op, I size0, I size1, I size2)
 {
-  index_t idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-  index_t idy = static_cast<index_t>(blockIdx.y) * blockDim.y + threadIdx.y;
-  index_t idz = static_cast<index_t>(blockIdx.z) * blockDim.z + threadIdx.z;
+  I idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+  I idy = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
+  I idz = static_cast<I>(blockIdx.z) * blockDim.z + threadIdx.z;
   if (idx < size2 && idy < size1 && idz < size0) {
     op(idz, idy, idx);
   }
 }
 
-template <class Op>
+template <class Op, typename I>
 __launch_bounds__(256) __global__
-    void matxOpT4Kernel(Op op, index_t size0, index_t size1, index_t size2,
-                        index_t size3)
+    void matxOpT4Kernel(Op op, I size0, I size1, I size2, I size3)
 {
-  index_t idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-  index_t nmy = static_cast<index_t>(blockIdx.y) * blockDim.y + threadIdx.y;
-  index_t idy = nmy % size2;
-  index_t idz = nmy / size2;
-  index_t idw = static_cast<index_t>(blockIdx.z) * blockDim.z + threadIdx.z;
+  I idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+  I nmy = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
+  I idy = nmy % size2;
+  I idz = nmy / size2;
+  I idw = static_cast<I>(blockIdx.z) * blockDim.z + threadIdx.z;
   if (idx < size3 && idy < size2 && idz < size1 && idw < size0) {
     op(idw, idz, idy, idx);
   }
 }
 
-template <class Op> void exec(Op op, cudaStream_t stream = 0)
+/**
+ * Kernel for ranks above 4. The two innermost dimensions map to x and y, and
+ * the leading dimensions are flattened into one batch index on z. Each thread
+ * decodes the batch index into the leading indices once per batch it visits,
+ * striding over the batches when there are more than the grid holds.
+ */
+template <class Op, typename I, int RANK>
+__launch_bounds__(256) __global__
+    void matxOpTNKernel(Op op, std::array<I, RANK> sizes, I batch)
+{
+  I idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+  I idy = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
+  if (idx >= sizes[RANK - 1] || idy >= sizes[RANK - 2]) {
+    return;
+  }
+
+  for (I b = static_cast<I>(blockIdx.z) * blockDim.z + threadIdx.z; b < batch;
+       b += static_cast<I>(gridDim.z) * blockDim.z) {
+    I id[RANK];
+    id[RANK - 1] = idx;
+    id[RANK - 2] = idy;
+
+    I rem = b;
+#pragma unroll
+    for (int d = RANK - 3; d >= 0; d--) {
+      id[d] = rem % sizes[d];
+      rem /= sizes[d];
+    }
+
+    apply_indices(op, id, std::make_index_sequence<RANK>{});
+  }
+}
+
+/**
+ * Launch the kernel for the rank of an operator, with the kernel's index
+ * arithmetic done in I
+ */
+template <typename I = index_t, class Op>
+void ExecKernel(Op op, cudaStream_t stream)
 {
   dim3 threads, blocks;
 
@@ -98,36 +136,148 @@ template <class Op> void exec(Op op, cudaStream_t stream = 0)
     matxOpT0Kernel<<<blocks, threads, 0, stream>>>(op);
   }
   else if constexpr (op.Rank() == 1) {
-    index_t size0 = op.Size(0);
+    I size0 = static_cast<I>(op.Size(0));
 
     get_grid_dims(blocks, threads, size0, 256);
     matxOpT1Kernel<<<blocks, threads, 0, stream>>>(op, size0);
   }
   else if constexpr (op.Rank() == 2) {
-    index_t size0 = op.Size(0);
-    index_t size1 = op.Size(1);
+    I size0 = static_cast<I>(op.Size(0));
+    I size1 = static_cast<I>(op.Size(1));
 
     get_grid_dims(blocks, threads, size0, size1, 256);
     matxOpT2Kernel<<<blocks, threads, 0, stream>>>(op, size0, size1);
   }
   else if constexpr (op.Rank() == 3) {
-    index_t size0 = op.Size(0);
-    index_t size1 = op.Size(1);
-    index_t size2 = op.Size(2);
+    I size0 = static_cast<I>(op.Size(0));
+    I size1 = static_cast<I>(op.Size(1));
+    I size2 = static_cast<I>(op.Size(2));
 
     get_grid_dims(blocks, threads, size0, size1, size2, 256);
     matxOpT3Kernel<<<blocks, threads, 0, stream>>>(op, size0, size1, size2);
   }
   else if constexpr (op.Rank() == 4) {
 
-    index_t size0 = op.Size(0);
-    index_t size1 = op.Size(1);
-    index_t size2 = op.Size(2);
-    index_t size3 = op.Size(3);
+    I size0 = static_cast<I>(op.Size(0));
+    I size1 = static_cast<I>(op.Size(1));
+    I size2 = static_cast<I>(op.Size(2));
+    I size3 = static_cast<I>(op.Size(3));
 
     get_grid_dims(blocks, threads, size0, size1, size2, size3, 256);
     matxOpT4Kernel<<<blocks, threads, 0, stream>>>(op, size0, size1, size2,
                                                    size3);
   }
+  else if constexpr (Op::Rank() > 4) {
+    constexpr int RANK = Op::Rank();
+    static_assert(RANK <= MATX_MAX_RANK, "Rank exceeds MATX_MAX_RANK");
+
+    std::array<I, RANK> sizes;
+    I batch = 1;
+    for (int i = 0; i < RANK; i++) {
+      sizes[i] = static_cast<I>(op.Size(i));
+      if (i < RANK - 2) {
+        batch *= sizes[i];
+      }
+    }
+
+    get_grid_dims(blocks, threads, batch, sizes[RANK - 2], sizes[RANK - 1],
+                  256);
+    blocks.z = std::min(blocks.z, 65535u);
+    matxOpTNKernel<Op, I, RANK>
+        <<<blocks, threads, 0, stream>>>(op, sizes, batch);
+  }
+}
+
+/**
+ * Launch an operator at the rank left after merging its dimensions, trying
+ * each rank from NR up. A rank equal to the operator's means nothing was
+ * merged, which is only worth a launch of its own when it narrows the index
+ * type. Operators that can't be merged are only rebuilt at their own rank.
+ */
+template <int NR, typename I, class Op>
+bool ExecCollapsed(const Op &op, const matxCollapse_t &c, cudaStream_t stream)
+{
+  if constexpr (NR <= Op::Rank()) {
+    if constexpr (NR == Op::Rank() || is_collapsible_op<Op>::value) {
+      if (c.Rank() == NR) {
+        ExecKernel<I>(op.template Collapse<NR, I>(c), stream);
+        return true;
+      }
+    }
+
+    return ExecCollapsed<NR + 1, I>(op, c, stream);
+  }
+  else {
+    return false;
+  }
+}
+
+/**
+ * Launch an operator whose reductions have already been run
+ */
+template <class Op> void ExecOp(const Op &op, cudaStream_t stream)
+{
+  constexpr bool narrow = sizeof(index_t) > sizeof(int32_t);
+
+  if constexpr (Op::Rank() >= 1) {
+    index_t sizes[Op::Rank()];
+    for (int i = 0; i < Op::Rank(); i++) {
+      sizes[i] = op.Size(i);
+    }
+
+    matxCollapse_t c(Op::Rank(), sizes, is_collapsible_op<Op>::value);
+    if constexpr (has_collapse<Op>::value) {
+      op.CollapseCheck(c);
+      if constexpr (narrow) {
+        if (c.Fits32() && ExecCollapsed<1, int32_t>(op, c, stream)) {
+          return;
+        }
+      }
+
+      if (c.Rank() < Op::Rank() && ExecCollapsed<1, index_t>(op, c, stream)) {
+        return;
+      }
+    }
+    else if constexpr (narrow) {
+      if (c.Fits32()) {
+        ExecKernel<int32_t>(op, stream);
+        return;
+      }
+    }
+  }
+
+  ExecKernel(op, stream);
+}
+
+/**
+ * Execute an operator on a stream
+ *
+ * Element-wise statements whose views are all contiguous across adjacent
+ * dimensions are launched with those dimensions merged, down to a flat
+ * rank-1 loop when every view is contiguous, so threads decode fewer indices
+ * and multiply by fewer strides. In an INDEX_64_BIT build, operators whose
+ * sizes fit in an int32_t are launched with 32-bit kernel indices, and the
+ * views they hold are rebuilt to compute their offsets in 32 bits when those
+ * fit too. 64-bit indices are only used when something doesn't fit.
+ *
+ * Statements above rank 4 are merged the same way, and whatever rank is left
+ * above 4 is launched with its leading dimensions flattened into one batch
+ * dimension of the grid.
+ *
+ * Reductions used as operators inside the statement are run first, each into
+ * a small buffer allocated on the stream, and the statement is then launched
+ * as a single element-wise kernel that reads the reduced values from those
+ * buffers.
+ *
+ * @param op
+ *   Operator to execute
+ * @param stream
+ *   CUDA stream
+ */
+template <class Op> void exec(Op op, cudaStream_t stream = 0)
+{
+  PreRunOp(op, stream);
+  ExecOp(op, stream);
+  PostRunOp(op, stream);
 }
 } // end namespace matx
@@ -36,6 +36,7 @@
 #include <cufftXt.h>
 
 #include "matx_cache.h"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
 #include "matx_tensor.h"
@@ -115,11 +116,11 @@ public:
     // cuFFT doesn't scale IFFT the same as MATLAB/Python. Scale it here to
     // match
     if (params_.fft_rank == 1) {
-      (o = o * 1.0 / static_cast<double>(params_.n[0])).run(stream);
+      exec(o = o * 1.0 / static_cast<double>(params_.n[0]), stream);
     }
     else {
-      (o = o * 1.0 / static_cast<double>(params_.n[0] * params_.n[1]))
-          .run(stream);
+      exec(o = o * 1.0 / static_cast<double>(params_.n[0] * params_.n[1]),
+           stream);
     }
   }
 
@@ -1217,7 +1218,7 @@ tensor_t<T2, RANK>
       ends[RANK - 1] = i.Lsize();
       auto i_pad_part_v = i_new.Slice(starts, ends);
 
-      (i_new = static_cast<promote_half_t<T2>>(0)).run(stream);
+      exec(i_new = static_cast<promote_half_t<T2>>(0), stream);
       copy(i_pad_part_v, i, stream);
       return i_new;
     }
@@ -1253,6 +1254,8 @@ template <typename T1, typename T2, int RANK>
 void fft(tensor_t<T1, RANK> &o, const tensor_t<T2, RANK> &i,
          cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   auto i_new = GetFFTInputView(o, i, stream);
 
   // Get parameters required by these tensors
@@ -1304,6 +1307,8 @@ template <typename T1, typename T2, int RANK>
 void ifft(tensor_t<T1, RANK> &o, const tensor_t<T2, RANK> &i,
           cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   auto i_new = GetFFTInputView(o, i, stream);
 
   // Get parameters required by these tensors
@@ -1352,6 +1357,8 @@ template <typename T1, typename T2, int RANK>
 void fft2(tensor_t<T1, RANK> &o, const tensor_t<T2, RANK> &i,
           cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params = matxFFTPlan_t<T1, T2>::GetFFTParams(o, i, 2);
   params.stream = stream;
@@ -1393,6 +1400,8 @@ template <typename T1, typename T2, int RANK>
 void ifft2(tensor_t<T1, RANK> &o, const tensor_t<T2, RANK> &i,
            cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params = matxFFTPlan_t<T1, T2>::GetFFTParams(o, i, 2);
   params.stream = stream;
@@ -33,6 +33,7 @@
 #pragma once
 
 #include "matx_conv.h"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
 #include "matx_filter_kernels.cuh"
@@ -482,6 +483,8 @@ void filter(tensor_t<OutType, RANK> o, InType i,
             const std::array<FilterType, NR> h_rec,
             const std::array<FilterType, NNR> h_nonrec, cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params = FilterParams_t();
   auto rhash = PodArrayToHash<FilterType, NR>(h_rec);
@@ -0,0 +1,707 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "matx_error.h"
+#include "matx_tensor.h"
+#include "matx_type_utils.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace matx {
+
+class matxHostGraph_t;
+
+/**
+ * Executor for running work on the host
+ *
+ * Host functions read and write tensor memory directly from the CPU, so all
+ * tensors passed with this executor must be host-accessible (managed or host
+ * memory), and any device work producing the inputs must be complete before
+ * the call.
+ *
+ * An executor returned by matxHostGraph_t::BeginCapture() records calls into
+ * the graph instead of running them, as does any executor used while a
+ * matxHostGraphScope_t is alive on the calling thread.
+ */
+struct matxHostExecutor_t {
+  /* Number of worker threads. 0 uses all hardware threads */
+  int num_threads = 0;
+
+  /* Graph being captured, or nullptr to run calls immediately */
+  matxHostGraph_t *graph = nullptr;
+
+  int GetNumThreads() const
+  {
+    if (num_threads > 0) {
+      return num_threads;
+    }
+
+    int hw = static_cast<int>(std::thread::hardware_concurrency());
+    return hw > 0 ? hw : 1;
+  }
+};
+
+class matxHostPool_t;
+
+/* Pool the calling thread is running tasks for, if any */
+inline matxHostPool_t *&HostPoolCurrent()
+{
+  static thread_local matxHostPool_t *pool = nullptr;
+  return pool;
+}
+
+/* Task queue the calling thread owns in its pool */
+inline int &HostPoolSlot()
+{
+  static thread_local int slot = -1;
+  return slot;
+}
+
+/* Graph capturing the host calls made by the calling thread, if any */
+inline matxHostGraph_t *&HostGraphCurrent()
+{
+  static thread_local matxHostGraph_t *graph = nullptr;
+  return graph;
+}
+
+/**
+ * Persistent worker threads with work stealing
+ *
+ * Each worker, plus one extra slot for the thread that replays a graph, owns
+ * a queue of tasks. Tasks are pushed to the queue of the thread submitting
+ * them and taken from the back of the owner's queue, so a thread keeps
+ * working on the data it just touched. A thread with an empty queue steals
+ * from the front of another queue, which holds the oldest and usually
+ * largest pieces of work.
+ */
+class matxHostPool_t {
+public:
+  /**
+   * Start a pool
+   *
+   * @param num_threads
+   *   Number of worker threads
+   */
+  matxHostPool_t(int num_threads)
+      : queues_(static_cast<size_t>(num_threads) + 1)
+  {
+    workers_.reserve(static_cast<size_t>(num_threads));
+    for (int t = 0; t < num_threads; t++) {
+      workers_.emplace_back([this, t]() { Worker(t); });
+    }
+  }
+
+  /**
+   * Stop and join the workers
+   */
+  ~matxHostPool_t()
+  {
+    {
+      std::lock_guard lck(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto &w : workers_) {
+      w.join();
+    }
+  }
+
+  matxHostPool_t(const matxHostPool_t &) = delete;
+  matxHostPool_t &operator=(const matxHostPool_t &) = delete;
+
+  /**
+   * Number of worker threads
+   */
+  int NumThreads() const { return static_cast<int>(workers_.size()); }
+
+  /**
+   * Slot used by a thread outside the pool while it helps run tasks
+   */
+  int ExternalSlot() const { return NumThreads(); }
+
+  /**
+   * Queue a task from a thread running tasks for this pool
+   *
+   * @param task
+   *   Task to run
+   */
+  void Submit(std::function<void()> task)
+  {
+    auto &q = queues_[static_cast<size_t>(HostPoolSlot())];
+    {
+      std::lock_guard lck(q.mtx);
+      q.tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard lck(mtx_);
+      pending_++;
+    }
+    cv_.notify_one();
+  }
+
+  /**
+   * Run one queued task, taking it from the slot's own queue if possible and
+   * stealing one otherwise
+   *
+   * @param slot
+   *   Queue owned by the calling thread
+   * @returns
+   *   false if every queue was empty
+   */
+  bool RunOne(int slot)
+  {
+    std::function<void()> task;
+    if (!Pop(slot, task)) {
+      return false;
+    }
+
+    pending_--;
+    task();
+    return true;
+  }
+
+  /**
+   * Fork-join version of matxHostParallelFor. Chunks after the first are
+   * queued for other threads to steal, and the calling thread runs the first
+   * chunk and then helps with queued tasks until its chunks are done.
+   */
+  template <typename F> void ParallelFor(index_t n, int num_threads, F &&f)
+  {
+    const int nt = static_cast<int>(std::min<index_t>(num_threads, n));
+    if (nt <= 1) {
+      if (n > 0) {
+        f(0, 0, n);
+      }
+      return;
+    }
+
+    const index_t chunk = (n + nt - 1) / nt;
+    std::atomic<int> left{0};
+    for (int t = 1; t < nt; t++) {
+      const index_t start = t * chunk;
+      const index_t end = std::min(n, start + chunk);
+      if (start >= end) {
+        break;
+      }
+
+      left++;
+      Submit([&f, &left, t, start, end]() {
+        f(t, start, end);
+        left--;
+      });
+    }
+
+    f(0, 0, std::min(n, chunk));
+    while (left.load() > 0) {
+      if (!RunOne(HostPoolSlot())) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+private:
+  struct Queue {
+    std::mutex mtx;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  bool Pop(int slot, std::function<void()> &task)
+  {
+    const size_t nq = queues_.size();
+    for (size_t k = 0; k < nq; k++) {
+      const size_t idx = (static_cast<size_t>(slot) + k) % nq;
+      auto &q = queues_[idx];
+      std::lock_guard lck(q.mtx);
+      if (q.tasks.empty()) {
+        continue;
+      }
+
+      if (k == 0) {
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+      }
+      else {
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+      }
+
+      return true;
+    }
+
+    return false;
+  }
+
+  void Worker(int t)
+  {
+    HostPoolCurrent() = this;
+    HostPoolSlot() = t;
+    while (true) {
+      if (RunOne(t)) {
+        continue;
+      }
+
+      std::unique_lock lck(mtx_);
+      cv_.wait(lck, [this] { return stop_ || pending_.load() > 0; });
+      if (stop_ && pending_.load() == 0) {
+        return;
+      }
+    }
+  }
+
+  std::vector<Queue> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::atomic<int> pending_{0};
+  bool stop_ = false;
+};
+
+/**
+ * Run a function over [0, n) split into contiguous chunks on up to num_threads
+ * threads. The function is called as f(thread_id, start, end), and the calling
+ * thread processes the first chunk. When called from a task of a
+ * matxHostPool_t, such as a node of a graph being replayed, the chunks run on
+ * the pool's threads instead of new ones.
+ *
+ * @param n
+ *   Number of items
+ * @param num_threads
+ *   Maximum number of threads
+ * @param f
+ *   Function to call on each chunk
+ */
+template <typename F>
+inline void matxHostParallelFor(index_t n, int num_threads, F &&f)
+{
+  auto pool = HostPoolCurrent();
+  if (pool != nullptr) {
+    pool->ParallelFor(n, num_threads, f);
+    return;
+  }
+
+  int nt = static_cast<int>(std::min<index_t>(num_threads, n));
+  if (nt <= 1) {
+    if (n > 0) {
+      f(0, 0, n);
+    }
+    return;
+  }
+
+  index_t chunk = (n + nt - 1) / nt;
+  std::vector<std::thread> workers;
+  workers.reserve(nt - 1);
+  for (int t = 1; t < nt; t++) {
+    index_t start = t * chunk;
+    index_t end = std::min(n, start + chunk);
+    if (start >= end) {
+      break;
+    }
+
+    workers.emplace_back([&f, t, start, end]() { f(t, start, end); });
+  }
+
+  f(0, 0, std::min(n, chunk));
+  for (auto &w : workers) {
+    w.join();
+  }
+}
+
+/**
+ * Memory read or written by a node of a host graph
+ */
+struct matxHostAccess_t {
+  uintptr_t lo;
+  uintptr_t hi;
+  bool write;
+
+  /* Whether this access and a are ordered: they overlap and one is a write */
+  bool Conflicts(const matxHostAccess_t &a) const
+  {
+    return (write || a.write) && lo < a.hi && a.lo < hi;
+  }
+};
+
+template <typename T, int RANK>
+matxHostAccess_t HostAccess(const tensor_t<T, RANK> &t, bool write)
+{
+  matxHostAccess_t a;
+  a.lo = reinterpret_cast<uintptr_t>(t.Data());
+  a.hi = a.lo + sizeof(T);
+  a.write = write;
+  if constexpr (RANK > 0) {
+    for (int i = 0; i < RANK; i++) {
+      const index_t ext = (t.Size(i) - 1) * t.Stride(i) *
+                          static_cast<index_t>(sizeof(T));
+      if (ext < 0) {
+        a.lo -= static_cast<uintptr_t>(-ext);
+      }
+      else {
+        a.hi += static_cast<uintptr_t>(ext);
+      }
+    }
+  }
+
+  return a;
+}
+
+/**
+ * Tensor read by a node of a host graph
+ */
+template <typename T, int RANK>
+matxHostAccess_t HostRead(const tensor_t<T, RANK> &t)
+{
+  return HostAccess(t, false);
+}
+
+/**
+ * Tensor written by a node of a host graph
+ */
+template <typename T, int RANK>
+matxHostAccess_t HostWrite(const tensor_t<T, RANK> &t)
+{
+  return HostAccess(t, true);
+}
+
+/**
+ * Plan used by a node of a host graph. Plans keep their own scratch space,
+ * so nodes that share one are ordered like writes to the same memory.
+ */
+inline matxHostAccess_t HostUse(const void *plan)
+{
+  const auto lo = reinterpret_cast<uintptr_t>(plan);
+  return matxHostAccess_t{lo, lo + 1, true};
+}
+
+/**
+ * Recorded DAG of host calls
+ *
+ * The host counterpart of capturing a stream into a CUDA graph. Between
+ * BeginCapture() and EndCapture(), host calls made with the returned executor
+ * are recorded as nodes instead of running, as are all host calls made inside
+ * a matxHostGraphScope_t. Each node keeps copies of the
+ * views it uses and the executor's thread count, so the partitioning of its
+ * work is fixed when it's recorded. Edges are inferred from the memory each
+ * node reads and writes: a node depends on every earlier node it has a
+ * read-after-write, write-after-read or write-after-write overlap with.
+ *
+ * Replay() runs the nodes on a persistent pool of threads. A node is queued
+ * as soon as its dependencies finish, so independent nodes run concurrently,
+ * and the parallel loops inside each node are split into tasks on the same
+ * pool rather than spawning threads, with idle threads stealing work. The
+ * plans used by a node are looked up or created when it's recorded, so
+ * replaying never builds a plan, and nodes that share a plan are ordered
+ * since the plan's scratch space can only be used by one at a time.
+ *
+ * Recorded calls run in the order of the graph, not the order they were
+ * made in, so a graph must only be replayed while the tensors it uses are
+ * alive and not being used by other work.
+ */
+class matxHostGraph_t {
+public:
+  using node_fn = std::function<void(const matxHostExecutor_t &)>;
+
+  matxHostGraph_t() = default;
+  matxHostGraph_t(const matxHostGraph_t &) = delete;
+  matxHostGraph_t &operator=(const matxHostGraph_t &) = delete;
+
+  /**
+   * Start recording calls
+   *
+   * @param exec
+   *   Executor whose thread count is used by the recorded calls and sizes the
+   *   replay pool
+   * @returns
+   *   Executor to pass to the calls to record
+   */
+  matxHostExecutor_t BeginCapture(const matxHostExecutor_t &exec = {})
+  {
+    MATX_ASSERT_STR(!capturing_, matxInvalidParameter,
+                    "Host graph is already capturing");
+    nodes_.clear();
+    pool_.reset();
+    capturing_ = true;
+    exec_ = exec;
+    exec_.graph = nullptr;
+
+    matxHostExecutor_t rec = exec_;
+    rec.graph = this;
+    return rec;
+  }
+
+  /**
+   * Stop recording calls and start the threads used to replay them
+   */
+  void EndCapture()
+  {
+    MATX_ASSERT_STR(capturing_, matxInvalidParameter,
+                    "Host graph is not capturing");
+    capturing_ = false;
+    pool_ = std::make_unique<matxHostPool_t>(exec_.GetNumThreads());
+  }
+
+  /**
+   * Record a node. Called by host functions given a capturing executor, and
+   * can be called directly to add other host work to the graph.
+   *
+   * @param access
+   *   Memory read and written by the node
+   * @param fn
+   *   Function to run, called with the executor given to BeginCapture()
+   */
+  void AddNode(std::vector<matxHostAccess_t> access, node_fn fn)
+  {
+    MATX_ASSERT_STR(capturing_, matxInvalidParameter,
+                    "Host graph is not capturing");
+
+    Node node;
+    node.fn = std::move(fn);
+    node.access = std::move(access);
+    const size_t id = nodes_.size();
+    for (size_t p = 0; p < id; p++) {
+      if (Depends(node, nodes_[p])) {
+        nodes_[p].succ.push_back(id);
+        node.preds++;
+      }
+    }
+
+    nodes_.push_back(std::move(node));
+  }
+
+  /**
+   * Run the recorded nodes and wait for them to finish. The calling thread
+   * helps run them.
+   */
+  void Replay()
+  {
+    MATX_ASSERT_STR(!capturing_ && pool_ != nullptr, matxInvalidParameter,
+                    "Host graph must be captured before it's replayed");
+
+    const size_t n = nodes_.size();
+    std::vector<std::atomic<int>> preds(n);
+    for (size_t i = 0; i < n; i++) {
+      preds[i] = nodes_[i].preds;
+    }
+
+    std::atomic<size_t> done{0};
+    std::exception_ptr err;
+    std::mutex err_mtx;
+    std::function<void(size_t)> run_node = [&](size_t i) {
+      try {
+        nodes_[i].fn(exec_);
+      }
+      catch (...) {
+        std::lock_guard lck(err_mtx);
+        if (!err) {
+          err = std::current_exception();
+        }
+      }
+
+      for (size_t s : nodes_[i].succ) {
+        if (preds[s].fetch_sub(1) == 1) {
+          pool_->Submit([&run_node, s]() { run_node(s); });
+        }
+      }
+      done++;
+    };
+
+    // The calling thread takes the pool's external slot until the graph is
+    // done, and stops capturing so the nodes it runs aren't recorded into a
+    // scope it's in
+    auto prev_pool = HostPoolCurrent();
+    auto prev_slot = HostPoolSlot();
+    auto prev_graph = HostGraphCurrent();
+    HostPoolCurrent() = pool_.get();
+    HostPoolSlot() = pool_->ExternalSlot();
+    HostGraphCurrent() = nullptr;
+    for (size_t i = 0; i < n; i++) {
+      if (nodes_[i].preds == 0) {
+        pool_->Submit([&run_node, i]() { run_node(i); });
+      }
+    }
+
+    while (done.load() < n) {
+      if (!pool_->RunOne(pool_->ExternalSlot())) {
+        std::this_thread::yield();
+      }
+    }
+
+    HostPoolCurrent() = prev_pool;
+    HostPoolSlot() = prev_slot;
+    HostGraphCurrent() = prev_graph;
+    if (err) {
+      std::rethrow_exception(err);
+    }
+  }
+
+  /**
+   * Number of recorded nodes
+   */
+  size_t Size() const { return nodes_.size(); }
+
+  /**
+   * Number of edges between recorded nodes
+   */
+  size_t NumEdges() const
+  {
+    size_t edges = 0;
+    for (const auto &node : nodes_) {
+      edges += node.succ.size();
+    }
+
+    return edges;
+  }
+
+private:
+  struct Node {
+    node_fn fn;
+    std::vector<matxHostAccess_t> access;
+    std::vector<size_t> succ;
+    int preds = 0;
+  };
+
+  static bool Depends(const Node &a, const Node &b)
+  {
+    for (const auto &x : a.access) {
+      for (const auto &y : b.access) {
+        if (x.Conflicts(y)) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  std::vector<Node> nodes_;
+  std::unique_ptr<matxHostPool_t> pool_;
+  matxHostExecutor_t exec_;
+  bool capturing_ = false;
+};
+
+/**
+ * Scope capturing host calls into a graph
+ *
+ * Starts capturing on construction and ends it on destruction. While the
+ * scope is alive, every host call made on the thread that created it is
+ * recorded into the graph, whatever executor it's given, so code written
+ * against a plain matxHostExecutor_t, such as run(), copy(), matmul() and the
+ * reductions, can be captured without changes. The recorded calls run with
+ * the executor given to the scope. Scopes nest, with the innermost one
+ * capturing.
+ *
+ * @code
+ *   matxHostGraph_t graph;
+ *   {
+ *     matxHostGraphScope_t scope{graph};
+ *     (b = a * 2.0f).run(matxHostExecutor_t{});
+ *     matmul(c, b, b, matxHostExecutor_t{});
+ *     sum(s, c, matxHostExecutor_t{});
+ *   }
+ *   graph.Replay();
+ * @endcode
+ */
+class matxHostGraphScope_t {
+public:
+  /**
+   * Start capturing
+   *
+   * @param graph
+   *   Graph to record into
+   * @param exec
+   *   Executor passed to matxHostGraph_t::BeginCapture()
+   */
+  matxHostGraphScope_t(matxHostGraph_t &graph,
+                       const matxHostExecutor_t &exec = {})
+      : graph_(graph), prev_(HostGraphCurrent())
+  {
+    graph_.BeginCapture(exec);
+    HostGraphCurrent() = &graph_;
+  }
+
+  /**
+   * Stop capturing
+   */
+  ~matxHostGraphScope_t()
+  {
+    HostGraphCurrent() = prev_;
+    graph_.EndCapture();
+  }
+
+  matxHostGraphScope_t(const matxHostGraphScope_t &) = delete;
+  matxHostGraphScope_t &operator=(const matxHostGraphScope_t &) = delete;
+
+private:
+  matxHostGraph_t &graph_;
+  matxHostGraph_t *prev_;
+};
+
+/**
+ * Record a host call into the graph being captured by exec, or by the
+ * innermost matxHostGraphScope_t on the calling thread
+ *
+ * Host functions start with this, and return without running when it
+ * returns true.
+ *
+ * @param exec
+ *   Executor passed to the host function
+ * @param access
+ *   Memory read and written by the call
+ * @param fn
+ *   Function that makes the call with the executor it's given
+ * @returns
+ *   true if the call was recorded
+ */
+template <typename F>
+bool HostGraphRecord(const matxHostExecutor_t &exec,
+                     std::vector<matxHostAccess_t> access, F &&fn)
+{
+  auto graph = exec.graph != nullptr ? exec.graph : HostGraphCurrent();
+  if (graph == nullptr) {
+    return false;
+  }
+
+  graph->AddNode(std::move(access), std::forward<F>(fn));
+  return true;
+}
+
+} // end namespace matx
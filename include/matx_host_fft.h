@@ -0,0 +1,438 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "matx_cache.h"
+#include "matx_error.h"
+#include "matx_host_solver.h"
+#include "matx_tensor.h"
+#include "matx_type_utils.h"
+#include <cmath>
+#include <vector>
+
+namespace matx {
+
+template <typename TensorType>
+inline decltype(auto) HostFFTElem(TensorType &t, index_t b, index_t i)
+{
+  constexpr int RANK = TensorType::Rank();
+  if constexpr (RANK == 1) {
+    return t(i);
+  }
+  else if constexpr (RANK == 2) {
+    return t(b, i);
+  }
+  else if constexpr (RANK == 3) {
+    return t(b / t.Size(1), b % t.Size(1), i);
+  }
+  else {
+    return t(b / (t.Size(1) * t.Size(2)), (b / t.Size(2)) % t.Size(1),
+             b % t.Size(2), i);
+  }
+}
+
+/**
+ * 1D complex FFT plan for the host
+ *
+ * Power of two sizes use an iterative radix-2 transform with precomputed
+ * twiddles and bit-reversal indices. Any other size uses Bluestein's algorithm
+ * on top of a power of two transform, with the chirp and its spectrum
+ * computed once when the plan is created. Transforms are done in place on
+ * contiguous rows, and batches of rows are split across the executor's
+ * threads.
+ *
+ * @tparam T
+ *   Complex data type
+ */
+template <typename T> class matxHostFFTPlan1D_t {
+public:
+  using real_t = value_type_t<T>;
+
+  /**
+   * Construct a host FFT plan
+   *
+   * @param n
+   *   Size of the transform
+   */
+  matxHostFFTPlan1D_t(index_t n) : n_(n)
+  {
+    static_assert(is_complex_v<T>, "Host FFT plans must be complex");
+    MATX_ASSERT(n > 0, matxInvalidSize);
+
+    m_ = 1;
+    while (m_ < n_) {
+      m_ *= 2;
+    }
+
+    if (m_ != n_) {
+      while (m_ < 2 * n_ - 1) {
+        m_ *= 2;
+      }
+    }
+
+    tw_.resize(static_cast<size_t>(m_ / 2 > 0 ? m_ / 2 : 1));
+    for (index_t k = 0; k < m_ / 2; k++) {
+      const double ph =
+          -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(m_);
+      tw_[k] = T(static_cast<real_t>(cos(ph)), static_cast<real_t>(sin(ph)));
+    }
+
+    int bits = 0;
+    while ((index_t{1} << bits) < m_) {
+      bits++;
+    }
+
+    rev_.resize(static_cast<size_t>(m_));
+    for (index_t i = 0; i < m_; i++) {
+      index_t r = 0;
+      for (int b = 0; b < bits; b++) {
+        r |= ((i >> b) & 1) << (bits - 1 - b);
+      }
+      rev_[i] = r;
+    }
+
+    if (m_ != n_) {
+      // Chirp exp(-j*pi*k^2/n), with k^2 reduced mod 2n to keep the phase
+      // accurate for large k
+      chirp_.resize(static_cast<size_t>(n_));
+      for (index_t k = 0; k < n_; k++) {
+        const index_t k2 = (k * k) % (2 * n_);
+        const double ph =
+            -M_PI * static_cast<double>(k2) / static_cast<double>(n_);
+        chirp_[k] =
+            T(static_cast<real_t>(cos(ph)), static_cast<real_t>(sin(ph)));
+      }
+
+      chirp_fft_.assign(static_cast<size_t>(m_), T(0));
+      chirp_fft_[0] = HostConj(chirp_[0]);
+      for (index_t k = 1; k < n_; k++) {
+        chirp_fft_[k] = HostConj(chirp_[k]);
+        chirp_fft_[m_ - k] = HostConj(chirp_[k]);
+      }
+      Radix2(chirp_fft_.data());
+    }
+  }
+
+  /**
+   * Size of scratch space needed per thread, in elements of T
+   */
+  index_t WorkSize() const { return m_ != n_ ? m_ : 0; }
+
+  /**
+   * Forward transform of one row in place
+   *
+   * @param x
+   *   Row of n elements
+   * @param work
+   *   Scratch space of WorkSize() elements
+   */
+  void Forward(T *x, T *work) const
+  {
+    if (m_ == n_) {
+      Radix2(x);
+      return;
+    }
+
+    for (index_t k = 0; k < n_; k++) {
+      work[k] = x[k] * chirp_[k];
+    }
+    std::fill(work + n_, work + m_, T(0));
+
+    Radix2(work);
+    for (index_t k = 0; k < m_; k++) {
+      work[k] = HostConj(work[k] * chirp_fft_[k]);
+    }
+
+    // Inverse transform of the product through the forward transform
+    Radix2(work);
+    const real_t scale = real_t(1) / static_cast<real_t>(m_);
+    for (index_t k = 0; k < n_; k++) {
+      x[k] = HostConj(work[k]) * scale * chirp_[k];
+    }
+  }
+
+  /**
+   * Inverse transform of one row in place, scaled by 1 / n to match ifft()
+   *
+   * @param x
+   *   Row of n elements
+   * @param work
+   *   Scratch space of WorkSize() elements
+   */
+  void Inverse(T *x, T *work) const
+  {
+    for (index_t k = 0; k < n_; k++) {
+      x[k] = HostConj(x[k]);
+    }
+
+    Forward(x, work);
+
+    const real_t scale = real_t(1) / static_cast<real_t>(n_);
+    for (index_t k = 0; k < n_; k++) {
+      x[k] = HostConj(x[k]) * scale;
+    }
+  }
+
+  /**
+   * Transform a batch of contiguous rows in place
+   *
+   * @param x
+   *   Rows of n elements, dist elements apart
+   * @param batch
+   *   Number of rows
+   * @param dist
+   *   Distance between the start of each row
+   * @param inverse
+   *   Run the inverse transform
+   * @param exec
+   *   Host executor
+   */
+  void Exec(T *x, index_t batch, index_t dist, bool inverse,
+            const matxHostExecutor_t &exec) const
+  {
+    matxHostParallelFor(batch, exec.GetNumThreads(),
+                        [&](int, index_t start, index_t end) {
+                          std::vector<T> work(static_cast<size_t>(WorkSize()));
+                          for (index_t b = start; b < end; b++) {
+                            if (inverse) {
+                              Inverse(x + b * dist, work.data());
+                            }
+                            else {
+                              Forward(x + b * dist, work.data());
+                            }
+                          }
+                        });
+  }
+
+private:
+  void Radix2(T *x) const
+  {
+    for (index_t i = 0; i < m_; i++) {
+      const index_t j = rev_[i];
+      if (i < j) {
+        std::swap(x[i], x[j]);
+      }
+    }
+
+    for (index_t len = 2; len <= m_; len *= 2) {
+      const index_t half = len / 2;
+      const index_t step = m_ / len;
+      for (index_t i = 0; i < m_; i += len) {
+        for (index_t k = 0; k < half; k++) {
+          const T u = x[i + k];
+          const T v = x[i + k + half] * tw_[k * step];
+          x[i + k] = u + v;
+          x[i + k + half] = u - v;
+        }
+      }
+    }
+  }
+
+  index_t n_; // Transform size
+  index_t m_; // Radix-2 size, n or the Bluestein convolution size
+  std::vector<T> tw_;
+  std::vector<index_t> rev_;
+  std::vector<T> chirp_;
+  std::vector<T> chirp_fft_;
+};
+
+/**
+ * Parameters needed to create a host FFT plan
+ */
+struct HostFftParams_t {
+  index_t n;
+  MatXDataType_t dtype;
+};
+
+struct HostFftParamsKeyHash {
+  std::size_t operator()(const HostFftParams_t &k) const noexcept
+  {
+    return std::hash<index_t>()(k.n) + std::hash<index_t>()(k.dtype);
+  }
+};
+
+struct HostFftParamsKeyEq {
+  bool operator()(const HostFftParams_t &l,
+                  const HostFftParams_t &t) const noexcept
+  {
+    return l.n == t.n && l.dtype == t.dtype;
+  }
+};
+
+// Static cache of host FFT plans
+static matxCache_t<HostFftParams_t, HostFftParamsKeyHash, HostFftParamsKeyEq>
+    hfft_cache;
+
+/**
+ * Get a cached host FFT plan of size n
+ *
+ * @tparam T
+ *   Complex data type
+ * @param n
+ *   Size of the transform
+ * @returns
+ *   Plan owned by the cache
+ */
+template <typename T> matxHostFFTPlan1D_t<T> *GetHostFFTPlan(index_t n)
+{
+  HostFftParams_t params;
+  params.n = n;
+  params.dtype = TypeToInt<T>();
+
+  auto ret = hfft_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    auto tmp = new matxHostFFTPlan1D_t<T>{n};
+    hfft_cache.Insert(params, static_cast<void *>(tmp));
+    return tmp;
+  }
+
+  return static_cast<matxHostFFTPlan1D_t<T> *>(ret.value());
+}
+
+template <typename T1, typename T2, int RANK>
+void InternalHostFFT(tensor_t<T1, RANK> &o, const tensor_t<T2, RANK> &i,
+                     bool inverse, const matxHostExecutor_t &exec)
+{
+  static_assert(is_complex_v<T1>, "Host FFT output must be complex");
+  static_assert(is_complex_v<T2> || std::is_same_v<value_type_t<T1>, T2>,
+                "Host FFT input must be complex or the matching real type");
+
+  for (int d = 0; d < RANK - 1; d++) {
+    MATX_ASSERT(o.Size(d) == i.Size(d), matxInvalidSize);
+  }
+
+  // A real input gives the one-sided spectrum, the same as the R2C device
+  // transform
+  const index_t nout = o.Size(RANK - 1);
+  const index_t nfft = is_complex_v<T2> ? nout : (nout - 1) * 2;
+  const index_t nin = std::min(nfft, i.Size(RANK - 1));
+  MATX_ASSERT(nfft > 0, matxInvalidSize);
+
+  index_t batches = 1;
+  for (int d = 0; d < RANK - 1; d++) {
+    batches *= o.Size(d);
+  }
+
+  // The plan is created when recording, so replays only look it up. It's
+  // read-only during a transform, so nodes using it can run concurrently.
+  auto plan = GetHostFFTPlan<T1>(nfft);
+  if (HostGraphRecord(exec, {HostRead(i), HostWrite(o)},
+                      [o, i, inverse](const matxHostExecutor_t &e) mutable {
+                        InternalHostFFT(o, i, inverse, e);
+                      })) {
+    return;
+  }
+
+  matxHostParallelFor(
+      batches, exec.GetNumThreads(), [&](int, index_t start, index_t end) {
+        std::vector<T1> row(static_cast<size_t>(nfft));
+        std::vector<T1> work(static_cast<size_t>(plan->WorkSize()));
+        for (index_t b = start; b < end; b++) {
+          // Copy in with zero padding or truncation to the transform size
+          for (index_t k = 0; k < nin; k++) {
+            row[k] = static_cast<T1>(HostFFTElem(i, b, k));
+          }
+          std::fill(row.begin() + nin, row.end(), T1(0));
+
+          if (inverse) {
+            plan->Inverse(row.data(), work.data());
+          }
+          else {
+            plan->Forward(row.data(), work.data());
+          }
+
+          for (index_t k = 0; k < nout; k++) {
+            HostFFTElem(o, b, k) = row[k];
+          }
+        }
+      });
+}
+
+/**
+ * Run a 1D FFT on the host
+ *
+ * Host version of fft(). The size of the FFT is taken from the last dimension
+ * of the output the same way as the device version, and the input is
+ * zero-padded or truncated to that size without a temporary tensor. Real
+ * inputs produce the nfft / 2 + 1 one-sided bins. The input and output may
+ * be the same tensor.
+ *
+ * @tparam T1
+ *   Output view data type
+ * @tparam T2
+ *   Input view data type
+ * @tparam RANK
+ *   Rank of input and output tensors
+ * @param o
+ *   Output tensor
+ * @param i
+ *   Input tensor
+ * @param exec
+ *   Host executor
+ */
+template <typename T1, typename T2, int RANK>
+void fft(tensor_t<T1, RANK> &o, const tensor_t<T2, RANK> &i,
+         const matxHostExecutor_t &exec)
+{
+  InternalHostFFT(o, i, false, exec);
+}
+
+/**
+ * Run a 1D inverse FFT on the host
+ *
+ * Host version of ifft(). The output is scaled by 1 / n to match the device
+ * version.
+ *
+ * @tparam T1
+ *   Output view data type
+ * @tparam T2
+ *   Input view data type
+ * @tparam RANK
+ *   Rank of input and output tensors
+ * @param o
+ *   Output tensor
+ * @param i
+ *   Input tensor
+ * @param exec
+ *   Host executor
+ */
+template <typename T1, typename T2, int RANK>
+void ifft(tensor_t<T1, RANK> &o, const tensor_t<T2, RANK> &i,
+          const matxHostExecutor_t &exec)
+{
+  static_assert(is_complex_v<T2>, "Host inverse FFT input must be complex");
+  InternalHostFFT(o, i, true, exec);
+}
+
+} // end namespace matx
@@ -0,0 +1,1797 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#pragma once
+
+#include "kernels/matx_jacobi_kernels.cuh"
+#include "matx_cache.h"
+#include "matx_error.h"
+#include "matx_host_executor.h"
+#include "matx_solver.h"
+#include "matx_tensor.h"
+#include "matx_type_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace matx {
+
+/* Panel width used by the blocked host factorizations */
+static constexpr index_t MATX_HOST_SOLVER_BLOCK = 64;
+
+template <typename T> inline T HostConj(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return cuda::std::conj(v);
+  }
+  else {
+    return v;
+  }
+}
+
+template <typename T> inline value_type_t<T> HostAbs(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return cuda::std::abs(v);
+  }
+  else {
+    return std::abs(v);
+  }
+}
+
+template <typename T> inline value_type_t<T> HostReal(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return v.real();
+  }
+  else {
+    return v;
+  }
+}
+
+template <typename T> inline value_type_t<T> HostImag(const T &v)
+{
+  if constexpr (is_complex_v<T>) {
+    return v.imag();
+  }
+  else {
+    return 0;
+  }
+}
+
+/**
+ * Operation applied to a host GEMM input
+ */
+enum matxHostGemmOp_t { MATX_HOST_OP_N, MATX_HOST_OP_C };
+
+/**
+ * Row-major host GEMM
+ *
+ * Computes C = alpha * op(A) * op(B) + beta * C on the calling thread, where
+ * op is either nothing or the conjugate transpose. C is m x n, and the inner
+ * dimension is k. Callers split work across threads by passing sub-blocks of
+ * C.
+ *
+ * @param opa
+ *   Operation on A
+ * @param opb
+ *   Operation on B
+ * @param m
+ *   Rows of C
+ * @param n
+ *   Columns of C
+ * @param k
+ *   Inner dimension
+ * @param alpha
+ *   Scale of product
+ * @param A
+ *   A matrix
+ * @param lda
+ *   Row stride of A
+ * @param B
+ *   B matrix
+ * @param ldb
+ *   Row stride of B
+ * @param beta
+ *   Scale of C
+ * @param C
+ *   C matrix
+ * @param ldc
+ *   Row stride of C
+ */
+template <typename T>
+inline void matxHostGemm(matxHostGemmOp_t opa, matxHostGemmOp_t opb, index_t m,
+                         index_t n, index_t k, T alpha, const T *A,
+                         index_t lda, const T *B, index_t ldb, T beta, T *C,
+                         index_t ldc)
+{
+  constexpr index_t KB = 256;
+
+  auto a_el = [&](index_t i, index_t p) {
+    return opa == MATX_HOST_OP_N ? A[i * lda + p] : HostConj(A[p * lda + i]);
+  };
+
+  if (beta != T(1)) {
+    for (index_t i = 0; i < m; i++) {
+      for (index_t j = 0; j < n; j++) {
+        C[i * ldc + j] = beta == T(0) ? T(0) : beta * C[i * ldc + j];
+      }
+    }
+  }
+
+  if (opb == MATX_HOST_OP_N) {
+    // Rank-1 updates along rows of B keep the inner loop contiguous
+    for (index_t p0 = 0; p0 < k; p0 += KB) {
+      index_t p1 = std::min(k, p0 + KB);
+      for (index_t i = 0; i < m; i++) {
+        T *crow = C + i * ldc;
+        for (index_t p = p0; p < p1; p++) {
+          T av = alpha * a_el(i, p);
+          const T *brow = B + p * ldb;
+          for (index_t j = 0; j < n; j++) {
+            crow[j] += av * brow[j];
+          }
+        }
+      }
+    }
+  }
+  else {
+    // Dot products along rows of B
+    for (index_t i = 0; i < m; i++) {
+      T *crow = C + i * ldc;
+      for (index_t j = 0; j < n; j++) {
+        const T *brow = B + j * ldb;
+        T acc = 0;
+        for (index_t p = 0; p < k; p++) {
+          acc += a_el(i, p) * HostConj(brow[p]);
+        }
+        crow[j] += alpha * acc;
+      }
+    }
+  }
+}
+
+/**
+ * Dense solver base class for host solvers. Each batch is copied into a
+ * contiguous row-major workspace, factored there, and copied back out. Batches
+ * are spread across threads when there are enough of them, and otherwise the
+ * panel and trailing updates of each factorization are threaded.
+ */
+template <typename T> class matxHostSolver_t {
+public:
+  /**
+   * Get a reference to one element of a batched matrix
+   */
+  template <typename TensorType>
+  static inline decltype(auto) MatElem(TensorType &t, index_t b, index_t r,
+                                       index_t c)
+  {
+    constexpr int RANK = TensorType::Rank();
+    if constexpr (RANK == 2) {
+      return t(r, c);
+    }
+    else if constexpr (RANK == 3) {
+      return t(b, r, c);
+    }
+    else {
+      return t(b / t.Size(1), b % t.Size(1), r, c);
+    }
+  }
+
+  /**
+   * Get a reference to one element of a batched vector
+   */
+  template <typename TensorType>
+  static inline decltype(auto) VecElem(TensorType &t, index_t b, index_t i)
+  {
+    constexpr int RANK = TensorType::Rank();
+    if constexpr (RANK == 1) {
+      return t(i);
+    }
+    else if constexpr (RANK == 2) {
+      return t(b, i);
+    }
+    else {
+      return t(b / t.Size(1), b % t.Size(1), i);
+    }
+  }
+
+  /**
+   * Factor every batch by calling f(batch, workspace, threads), which returns
+   * a LAPACK-style info value. Any non-zero info raises matxSolverError after
+   * all threads finish.
+   */
+  template <typename F> void RunBatches(F &&f)
+  {
+    std::vector<int> info(batches_, 0);
+
+    if (batches_ >= static_cast<size_t>(num_threads_)) {
+      matxHostParallelFor(static_cast<index_t>(batches_), num_threads_,
+                          [&](int tid, index_t start, index_t end) {
+                            for (index_t b = start; b < end; b++) {
+                              info[b] = f(b, workspace_[tid].data(), 1);
+                            }
+                          });
+    }
+    else {
+      for (size_t b = 0; b < batches_; b++) {
+        info[b] = f(b, workspace_[0].data(), num_threads_);
+      }
+    }
+
+    for (auto i : info) {
+      MATX_ASSERT_STR(i == 0, matxSolverError,
+                      "Host factorization failed on a singular or "
+                      "non-positive-definite matrix");
+    }
+  }
+
+protected:
+  void AllocateWorkspace(size_t batches, int num_threads, size_t elems)
+  {
+    batches_ = batches;
+    num_threads_ = num_threads;
+
+    // One workspace per thread when batching, or a single shared one otherwise
+    size_t slots = std::min(batches_, static_cast<size_t>(num_threads_));
+    workspace_.resize(std::max<size_t>(slots, 1));
+    for (auto &w : workspace_) {
+      w.resize(elems);
+    }
+  }
+
+  size_t batches_;
+  int num_threads_;
+  std::vector<std::vector<T>> workspace_;
+};
+
+/**
+ * Parameters needed to execute a host factorization
+ */
+struct HostSolverParams_t {
+  int64_t m;
+  int64_t n;
+  size_t batch_size;
+  int num_threads;
+  MatXDataType_t dtype;
+};
+
+/**
+ * Crude hash to get a reasonably good delta for collisions. This doesn't need
+ * to be perfect, but fast enough to not slow down lookups, and different enough
+ * so the common solver parameters change
+ */
+struct HostSolverParamsKeyHash {
+  std::size_t operator()(const HostSolverParams_t &k) const noexcept
+  {
+    return (std::hash<index_t>()(k.m)) + (std::hash<index_t>()(k.n)) +
+           (std::hash<index_t>()(k.batch_size));
+  }
+};
+
+/**
+ * Test host solver parameters for equality. Unlike the hash, all parameters
+ * must match.
+ */
+struct HostSolverParamsKeyEq {
+  bool operator()(const HostSolverParams_t &l,
+                  const HostSolverParams_t &t) const noexcept
+  {
+    return l.n == t.n && l.m == t.m && l.batch_size == t.batch_size &&
+           l.num_threads == t.num_threads && l.dtype == t.dtype;
+  }
+};
+
+template <typename T, int RANK>
+inline HostSolverParams_t GetHostSolverParams(const tensor_t<T, RANK> &a,
+                                              const matxHostExecutor_t &exec)
+{
+  HostSolverParams_t params;
+  params.batch_size = matxDnSolver_t::GetNumBatches(a);
+  params.m = a.Size(RANK - 2);
+  params.n = a.Size(RANK - 1);
+  params.num_threads = exec.GetNumThreads();
+  params.dtype = TypeToInt<T>();
+
+  return params;
+}
+
+/***************************************** CHOLESKY
+ * *********************************************/
+
+template <typename T1, int RANK>
+class matxHostCholSolverPlan_t : public matxHostSolver_t<T1> {
+public:
+  /**
+   * Plan for a blocked, right-looking host Cholesky factorization
+   *
+   * Factors A = L * L^H (lower) or A = U^H * U (upper). Each step factors a
+   * diagonal block and the panel below it, then updates the trailing lower
+   * triangle with a GEMM. Only the selected triangle of the output is written.
+   *
+   * @tparam T1
+   *  Data type of A matrix
+   * @tparam RANK
+   *  Rank of A matrix
+   *
+   * @param a
+   *   Input tensor view
+   * @param exec
+   *   Host executor
+   */
+  matxHostCholSolverPlan_t(const tensor_t<T1, RANK> &a,
+                           const matxHostExecutor_t &exec)
+  {
+    static_assert(RANK >= 2);
+
+    params = GetHostSolverParams(a, exec);
+    this->AllocateWorkspace(params.batch_size, params.num_threads,
+                            params.n * params.n);
+  }
+
+  void Exec(tensor_t<T1, RANK> &out, const tensor_t<T1, RANK> &a,
+            cublasFillMode_t uplo = CUBLAS_FILL_MODE_UPPER)
+  {
+    // Ensure matrix is square
+    MATX_ASSERT(a.Size(RANK - 1) == a.Size(RANK - 2), matxInvalidSize);
+
+    // Ensure output size matches input
+    for (int i = 0; i < RANK; i++) {
+      MATX_ASSERT(out.Size(i) == a.Size(i), matxInvalidSize);
+    }
+
+    const index_t n = params.n;
+    const bool upper = uplo == CUBLAS_FILL_MODE_UPPER;
+    const bool inplace = out.Data() == a.Data();
+
+    this->RunBatches([&](index_t b, T1 *w, int threads) {
+      // Factor the lower triangle. The upper case uses the conjugate of the
+      // upper triangle, since U = L^H.
+      for (index_t r = 0; r < n; r++) {
+        for (index_t c = 0; c <= r; c++) {
+          w[r * n + c] = upper ? HostConj(this->MatElem(a, b, c, r))
+                               : this->MatElem(a, b, r, c);
+        }
+      }
+
+      int info = Factor(w, n, threads);
+      if (info != 0) {
+        return info;
+      }
+
+      for (index_t r = 0; r < n; r++) {
+        for (index_t c = 0; c < n; c++) {
+          if (c <= r) {
+            if (upper) {
+              this->MatElem(out, b, c, r) = HostConj(w[r * n + c]);
+            }
+            else {
+              this->MatElem(out, b, r, c) = w[r * n + c];
+            }
+          }
+          else if (!inplace) {
+            // Leave the unused triangle as a copy of the input, as cuSolver
+            // does
+            if (upper) {
+              this->MatElem(out, b, c, r) = this->MatElem(a, b, c, r);
+            }
+            else {
+              this->MatElem(out, b, r, c) = this->MatElem(a, b, r, c);
+            }
+          }
+        }
+      }
+
+      return 0;
+    });
+  }
+
+  /**
+   * Factor a contiguous n x n matrix in place into its lower Cholesky factor
+   *
+   * @returns
+   *   0 on success, or j+1 if the leading minor of order j+1 is not positive
+   * definite
+   */
+  static int Factor(T1 *A, index_t n, int threads)
+  {
+    using real_t = value_type_t<T1>;
+    constexpr index_t NB = MATX_HOST_SOLVER_BLOCK;
+
+    for (index_t k = 0; k < n; k += NB) {
+      index_t kb = std::min(NB, n - k);
+
+      // Diagonal block
+      for (index_t j = k; j < k + kb; j++) {
+        real_t d = HostReal(A[j * n + j]);
+        for (index_t p = k; p < j; p++) {
+          real_t v = HostAbs(A[j * n + p]);
+          d -= v * v;
+        }
+
+        if (!(d > 0)) {
+          return static_cast<int>(j + 1);
+        }
+
+        A[j * n + j] = std::sqrt(d);
+        for (index_t i = j + 1; i < k + kb; i++) {
+          T1 s = A[i * n + j];
+          for (index_t p = k; p < j; p++) {
+            s -= A[i * n + p] * HostConj(A[j * n + p]);
+          }
+          A[i * n + j] = s / A[j * n + j];
+        }
+      }
+
+      index_t tstart = k + kb;
+      index_t tn = n - tstart;
+      if (tn == 0) {
+        break;
+      }
+
+      // Panel below the diagonal block: each row is an independent triangular
+      // solve against the diagonal block
+      matxHostParallelFor(tn, threads, [&](int, index_t start, index_t end) {
+        for (index_t i = tstart + start; i < tstart + end; i++) {
+          for (index_t j = k; j < k + kb; j++) {
+            T1 s = A[i * n + j];
+            for (index_t p = k; p < j; p++) {
+              s -= A[i * n + p] * HostConj(A[j * n + p]);
+            }
+            A[i * n + j] = s / A[j * n + j];
+          }
+        }
+      });
+
+      // Trailing update of the lower triangle, one block row at a time
+      index_t nrb = (tn + NB - 1) / NB;
+      matxHostParallelFor(nrb, threads, [&](int, index_t start, index_t end) {
+        for (index_t rb = start; rb < end; rb++) {
+          index_t i0 = tstart + rb * NB;
+          index_t i1 = std::min(n, i0 + NB);
+          matxHostGemm<T1>(MATX_HOST_OP_N, MATX_HOST_OP_C, i1 - i0, i1 - tstart,
+                           kb, T1(-1), A + i0 * n + k, n, A + tstart * n + k,
+                           n, T1(1), A + i0 * n + tstart, n);
+        }
+      });
+    }
+
+    return 0;
+  }
+
+  ~matxHostCholSolverPlan_t() {}
+
+private:
+  HostSolverParams_t params;
+};
+
+// Static caches of host Cholesky plans
+static matxCache_t<HostSolverParams_t, HostSolverParamsKeyHash,
+                   HostSolverParamsKeyEq>
+    hchol_cache;
+
+/**
+ * Perform a Cholesky decomposition on the host using a cached plan
+ *
+ * Host version of chol(). Tensors are row-major on the host as well, so no
+ * transposes are needed. The input and output parameters may be the same
+ * tensor. In that case, the input is destroyed and the output is stored
+ * in-place.
+ *
+ * @tparam T1
+ *   Data type of matrix A
+ * @tparam RANK
+ *   Rank of matrix A
+ *
+ * @param out
+ *   Output tensor
+ * @param a
+ *   Input tensor
+ * @param exec
+ *   Host executor
+ * @param uplo
+ *   Part of matrix to fill
+ */
+template <typename T1, int RANK>
+void chol(tensor_t<T1, RANK> &out, const tensor_t<T1, RANK> &a,
+          const matxHostExecutor_t &exec,
+          cublasFillMode_t uplo = CUBLAS_FILL_MODE_UPPER)
+{
+  auto params = GetHostSolverParams(a, exec);
+
+  // Get cache or new Cholesky plan if it doesn't exist
+  matxHostCholSolverPlan_t<T1, RANK> *plan;
+  auto ret = hchol_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    plan = new matxHostCholSolverPlan_t{a, exec};
+    hchol_cache.Insert(params, static_cast<void *>(plan));
+  }
+  else {
+    plan = static_cast<matxHostCholSolverPlan_t<T1, RANK> *>(ret.value());
+  }
+
+  if (HostGraphRecord(exec, {HostRead(a), HostWrite(out), HostUse(plan)},
+                      [plan, out, a, uplo](const matxHostExecutor_t &) mutable {
+                        plan->Exec(out, a, uplo);
+                      })) {
+    return;
+  }
+
+  plan->Exec(out, a, uplo);
+}
+
+/***************************************** LU FACTORIZATION
+ * *********************************************/
+
+template <typename T1, int RANK>
+class matxHostLUSolverPlan_t : public matxHostSolver_t<T1> {
+public:
+  /**
+   * Plan for a blocked, right-looking host LU factorization with partial
+   * pivoting
+   *
+   * Factors P * A = L * U. Each step factors a panel of columns with row
+   * pivoting, solves for the block row of U, and updates the trailing matrix
+   * with a GEMM. Pivots are 1-based, matching cuSolver.
+   *
+   * @tparam T1
+   *  Data type of A matrix
+   * @tparam RANK
+   *  Rank of A matrix
+   *
+   * @param a
+   *   Input tensor view
+   * @param exec
+   *   Host executor
+   */
+  matxHostLUSolverPlan_t(const tensor_t<T1, RANK> &a,
+                         const matxHostExecutor_t &exec)
+  {
+    static_assert(RANK >= 2);
+
+    params = GetHostSolverParams(a, exec);
+    this->AllocateWorkspace(params.batch_size, params.num_threads,
+                            params.m * params.n);
+  }
+
+  void Exec(tensor_t<T1, RANK> &out, tensor_t<int64_t, RANK - 1> &piv,
+            const tensor_t<T1, RANK> &a)
+  {
+    // Ensure output size matches input
+    for (int i = 0; i < RANK; i++) {
+      MATX_ASSERT(out.Size(i) == a.Size(i), matxInvalidSize);
+    }
+
+    const index_t m = params.m;
+    const index_t n = params.n;
+    const index_t r = std::min(m, n);
+    MATX_ASSERT(piv.Size(RANK - 2) >= r, matxInvalidSize);
+
+    this->RunBatches([&](index_t b, T1 *w, int threads) {
+      for (index_t i = 0; i < m; i++) {
+        for (index_t j = 0; j < n; j++) {
+          w[i * n + j] = this->MatElem(a, b, i, j);
+        }
+      }
+
+      std::vector<int64_t> p(r);
+      int info = Factor(w, m, n, p.data(), threads);
+
+      for (index_t i = 0; i < m; i++) {
+        for (index_t j = 0; j < n; j++) {
+          this->MatElem(out, b, i, j) = w[i * n + j];
+        }
+      }
+
+      for (index_t i = 0; i < r; i++) {
+        this->VecElem(piv, b, i) = p[i];
+      }
+
+      return info;
+    });
+  }
+
+  /**
+   * Factor a contiguous m x n matrix in place
+   *
+   * @returns
+   *   0 on success, or j+1 if U(j, j) is exactly zero
+   */
+  static int Factor(T1 *A, index_t m, index_t n, int64_t *piv, int threads)
+  {
+    constexpr index_t NB = MATX_HOST_SOLVER_BLOCK;
+    const index_t r = std::min(m, n);
+    int info = 0;
+
+    for (index_t k = 0; k < r; k += NB) {
+      index_t kb = std::min(NB, r - k);
+
+      // Panel factorization with partial pivoting. Full rows are swapped, which
+      // also applies the interchanges to the columns outside the panel.
+      for (index_t j = k; j < k + kb; j++) {
+        index_t p = j;
+        auto pmax = HostAbs(A[j * n + j]);
+        for (index_t i = j + 1; i < m; i++) {
+          auto v = HostAbs(A[i * n + j]);
+          if (v > pmax) {
+            pmax = v;
+            p = i;
+          }
+        }
+
+        piv[j] = p + 1;
+        if (pmax == 0) {
+          if (info == 0) {
+            info = static_cast<int>(j + 1);
+          }
+          continue;
+        }
+
+        if (p != j) {
+          std::swap_ranges(A + j * n, A + (j + 1) * n, A + p * n);
+        }
+
+        T1 d = A[j * n + j];
+        for (index_t i = j + 1; i < m; i++) {
+          T1 l = A[i * n + j] / d;
+          A[i * n + j] = l;
+          for (index_t c = j + 1; c < k + kb; c++) {
+            A[i * n + c] -= l * A[j * n + c];
+          }
+        }
+      }
+
+      index_t tstart = k + kb;
+      if (tstart >= n) {
+        continue;
+      }
+
+      // Block row of U: unit lower triangular solve, split across columns
+      index_t tn = n - tstart;
+      matxHostParallelFor(tn, threads, [&](int, index_t start, index_t end) {
+        for (index_t j = k; j < k + kb; j++) {
+          for (index_t i = j + 1; i < k + kb; i++) {
+            T1 l = A[i * n + j];
+            for (index_t c = tstart + start; c < tstart + end; c++) {
+              A[i * n + c] -= l * A[j * n + c];
+            }
+          }
+        }
+      });
+
+      // Trailing update
+      if (tstart < m) {
+        matxHostParallelFor(
+            m - tstart, threads, [&](int, index_t start, index_t end) {
+              matxHostGemm<T1>(MATX_HOST_OP_N, MATX_HOST_OP_N, end - start, tn,
+                               kb, T1(-1), A + (tstart + start) * n + k, n,
+                               A + k * n + tstart, n, T1(1),
+                               A + (tstart + start) * n + tstart, n);
+            });
+      }
+    }
+
+    return info;
+  }
+
+  ~matxHostLUSolverPlan_t() {}
+
+private:
+  HostSolverParams_t params;
+};
+
+// Static caches of host LU plans
+static matxCache_t<HostSolverParams_t, HostSolverParamsKeyHash,
+                   HostSolverParamsKeyEq>
+    hlu_cache;
+
+/**
+ * Perform a LU decomposition on the host using a cached plan
+ *
+ * Host version of lu(). The input and output parameters may be the same
+ * tensor. In that case, the input is destroyed and the output is stored
+ * in-place.
+ *
+ * @tparam T1
+ *   Data type of matrix A
+ * @tparam RANK
+ *   Rank of matrix A
+ *
+ * @param out
+ *   Output tensor view
+ * @param piv
+ *   Output of pivot indices
+ * @param a
+ *   Input matrix A
+ * @param exec
+ *   Host executor
+ */
+template <typename T1, int RANK>
+void lu(tensor_t<T1, RANK> &out, tensor_t<int64_t, RANK - 1> &piv,
+        const tensor_t<T1, RANK> &a, const matxHostExecutor_t &exec)
+{
+  auto params = GetHostSolverParams(a, exec);
+
+  // Get cache or new LU plan if it doesn't exist
+  matxHostLUSolverPlan_t<T1, RANK> *plan;
+  auto ret = hlu_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    plan = new matxHostLUSolverPlan_t{a, exec};
+    hlu_cache.Insert(params, static_cast<void *>(plan));
+  }
+  else {
+    plan = static_cast<matxHostLUSolverPlan_t<T1, RANK> *>(ret.value());
+  }
+
+  if (HostGraphRecord(
+          exec,
+          {HostRead(a), HostWrite(out), HostWrite(piv), HostUse(plan)},
+          [plan, out, piv, a](const matxHostExecutor_t &) mutable {
+            plan->Exec(out, piv, a);
+          })) {
+    return;
+  }
+
+  plan->Exec(out, piv, a);
+}
+
+/**
+ * Compute the determinant of a matrix on the host
+ *
+ * Computes the LU decomposition, then multiplies the diagonal elements of U.
+ * The sign is corrected for the row interchanges in the pivots.
+ *
+ * @tparam T1
+ *   Data type of matrix A
+ * @tparam RANK
+ *   Rank of matrix A
+ *
+ * @param out
+ *   Output tensor view
+ * @param a
+ *   Input matrix A
+ * @param exec
+ *   Host executor
+ */
+template <typename T1, int RANK>
+void det(tensor_t<T1, RANK - 2> &out, const tensor_t<T1, RANK> &a,
+         const matxHostExecutor_t &exec)
+{
+  MATX_ASSERT(a.Size(RANK - 1) == a.Size(RANK - 2), matxInvalidSize);
+
+  tensorShape_t<RANK - 1> s;
+
+  // Set batching dimensions of piv
+  for (int i = 0; i < RANK - 2; i++) {
+    s.SetSize(i, a.Size(i));
+  }
+
+  s.SetSize(RANK - 2, a.Size(RANK - 1));
+
+  tensor_t<int64_t, RANK - 1> piv{s};
+  tensor_t<T1, RANK> ac{a.Shape()};
+
+  lu(ac, piv, a, exec);
+
+  // Multiplying out the diagonal is a node of its own when recording, after
+  // the factorization
+  auto diag = [out, ac, piv](const matxHostExecutor_t &) mutable {
+    const index_t n = ac.Size(RANK - 1);
+    const index_t batches = matxDnSolver_t::GetNumBatches(ac);
+    for (index_t b = 0; b < batches; b++) {
+      T1 d = 1;
+      for (index_t i = 0; i < n; i++) {
+        d *= matxHostSolver_t<T1>::MatElem(ac, b, i, i);
+        if (matxHostSolver_t<T1>::VecElem(piv, b, i) != i + 1) {
+          d = -d;
+        }
+      }
+
+      if constexpr (RANK == 2) {
+        out() = d;
+      }
+      else if constexpr (RANK == 3) {
+        out(b) = d;
+      }
+      else {
+        out(b / ac.Size(1), b % ac.Size(1)) = d;
+      }
+    }
+  };
+
+  if (HostGraphRecord(exec, {HostRead(ac), HostRead(piv), HostWrite(out)},
+                      diag)) {
+    return;
+  }
+
+  diag(exec);
+}
+
+/***************************************** QR FACTORIZATION
+ * *********************************************/
+
+template <typename T1, int RANK>
+class matxHostQRSolverPlan_t : public matxHostSolver_t<T1> {
+public:
+  /**
+   * Plan for a blocked host Householder QR factorization
+   *
+   * Factors A = Q * R using the same compact storage as cuSolver: R is in the
+   * upper triangle, the Householder vectors are below the diagonal, and tau
+   * holds their scale factors. Reflectors for each panel are accumulated in
+   * compact WY form, I - V * T * V^H, so the trailing update is two GEMMs.
+   *
+   * @tparam T1
+   *  Data type of A matrix
+   * @tparam RANK
+   *  Rank of A matrix
+   *
+   * @param a
+   *   Input tensor view
+   * @param exec
+   *   Host executor
+   */
+  matxHostQRSolverPlan_t(const tensor_t<T1, RANK> &a,
+                         const matxHostExecutor_t &exec)
+  {
+    static_assert(RANK >= 2);
+
+    params = GetHostSolverParams(a, exec);
+
+    // Matrix, V, T, W and tau
+    const index_t m = params.m;
+    const index_t n = params.n;
+    constexpr index_t NB = MATX_HOST_SOLVER_BLOCK;
+    this->AllocateWorkspace(params.batch_size, params.num_threads,
+                            m * n + m * NB + NB * NB + NB * n +
+                                std::min(m, n));
+  }
+
+  void Exec(tensor_t<T1, RANK> &out, tensor_t<T1, RANK - 1> &tau,
+            const tensor_t<T1, RANK> &a)
+  {
+    // Ensure output size matches input
+    for (int i = 0; i < RANK; i++) {
+      MATX_ASSERT(out.Size(i) == a.Size(i), matxInvalidSize);
+    }
+
+    const index_t m = params.m;
+    const index_t n = params.n;
+    const index_t r = std::min(m, n);
+    MATX_ASSERT(tau.Size(RANK - 2) >= r, matxInvalidSize);
+
+    this->RunBatches([&](index_t b, T1 *w, int threads) {
+      for (index_t i = 0; i < m; i++) {
+        for (index_t j = 0; j < n; j++) {
+          w[i * n + j] = this->MatElem(a, b, i, j);
+        }
+      }
+
+      T1 *t = w + m * n + m * MATX_HOST_SOLVER_BLOCK +
+              MATX_HOST_SOLVER_BLOCK * MATX_HOST_SOLVER_BLOCK +
+              MATX_HOST_SOLVER_BLOCK * n;
+      Factor(w, m, n, t, w + m * n, threads);
+
+      for (index_t i = 0; i < m; i++) {
+        for (index_t j = 0; j < n; j++) {
+          this->MatElem(out, b, i, j) = w[i * n + j];
+        }
+      }
+
+      for (index_t i = 0; i < r; i++) {
+        this->VecElem(tau, b, i) = t[i];
+      }
+
+      return 0;
+    });
+  }
+
+  /**
+   * Factor a contiguous m x n matrix in place
+   *
+   * @param A
+   *   Matrix
+   * @param m
+   *   Rows
+   * @param n
+   *   Columns
+   * @param tau
+   *   Output reflector scales
+   * @param work
+   *   Scratch space of m * NB + NB * NB + NB * n elements
+   * @param threads
+   *   Threads to use for the trailing update
+   */
+  static void Factor(T1 *A, index_t m, index_t n, T1 *tau, T1 *work,
+                     int threads)
+  {
+    using real_t = value_type_t<T1>;
+    constexpr index_t NB = MATX_HOST_SOLVER_BLOCK;
+    const index_t r = std::min(m, n);
+    T1 *V = work;
+    T1 *T = V + m * NB;
+    T1 *W = T + NB * NB;
+
+    for (index_t k = 0; k < r; k += NB) {
+      index_t kb = std::min(NB, r - k);
+
+      // Panel: generate each reflector and apply it to the rest of the panel
+      for (index_t j = k; j < k + kb; j++) {
+        T1 alpha = A[j * n + j];
+        real_t xnorm2 = 0;
+        for (index_t i = j + 1; i < m; i++) {
+          real_t v = HostAbs(A[i * n + j]);
+          xnorm2 += v * v;
+        }
+
+        if (xnorm2 == 0 && HostImag(alpha) == 0) {
+          tau[j] = 0;
+          continue;
+        }
+
+        real_t anorm = HostAbs(alpha);
+        real_t beta = std::sqrt(anorm * anorm + xnorm2);
+        if (HostReal(alpha) >= 0) {
+          beta = -beta;
+        }
+
+        tau[j] = (T1(beta) - alpha) / T1(beta);
+        T1 scal = T1(1) / (alpha - T1(beta));
+        for (index_t i = j + 1; i < m; i++) {
+          A[i * n + j] *= scal;
+        }
+        A[j * n + j] = beta;
+
+        // A := (I - conj(tau) v v^H) A on the remaining panel columns
+        T1 ct = HostConj(tau[j]);
+        for (index_t c = j + 1; c < k + kb; c++) {
+          T1 s = A[j * n + c];
+          for (index_t i = j + 1; i < m; i++) {
+            s += HostConj(A[i * n + j]) * A[i * n + c];
+          }
+          s *= ct;
+          A[j * n + c] -= s;
+          for (index_t i = j + 1; i < m; i++) {
+            A[i * n + c] -= A[i * n + j] * s;
+          }
+        }
+      }
+
+      index_t tstart = k + kb;
+      if (tstart >= n) {
+        continue;
+      }
+
+      // Explicit V with a unit diagonal and zeros above it
+      const index_t vm = m - k;
+      for (index_t i = 0; i < vm; i++) {
+        for (index_t c = 0; c < kb; c++) {
+          V[i * kb + c] =
+              i < c ? T1(0) : (i == c ? T1(1) : A[(k + i) * n + k + c]);
+        }
+      }
+
+      // Upper triangular T such that H(k)...H(k+kb-1) = I - V T V^H
+      for (index_t i = 0; i < kb; i++) {
+        for (index_t c = 0; c < kb; c++) {
+          T[c * kb + i] = 0;
+        }
+
+        T[i * kb + i] = tau[k + i];
+        if (tau[k + i] == T1(0)) {
+          continue;
+        }
+
+        for (index_t c = 0; c < i; c++) {
+          T1 s = 0;
+          for (index_t row = i; row < vm; row++) {
+            s += HostConj(V[row * kb + c]) * V[row * kb + i];
+          }
+          T[c * kb + i] = -tau[k + i] * s;
+        }
+
+        // T(0:i, i) = T(0:i, 0:i) * T(0:i, i)
+        for (index_t c = 0; c < i; c++) {
+          T1 s = 0;
+          for (index_t p = c; p < i; p++) {
+            s += T[c * kb + p] * T[p * kb + i];
+          }
+          T[c * kb + i] = s;
+        }
+      }
+
+      // Trailing update A := (I - V T^H V^H) A, split across columns
+      const index_t tn = n - tstart;
+      matxHostParallelFor(tn, threads, [&](int, index_t start, index_t end) {
+        index_t cn = end - start;
+        T1 *Ac = A + k * n + tstart + start;
+        T1 *Wc = W + start;
+
+        // W = V^H A
+        matxHostGemm<T1>(MATX_HOST_OP_C, MATX_HOST_OP_N, kb, cn, vm, T1(1), V,
+                         kb, Ac, n, T1(0), Wc, tn);
+
+        // W = T^H W, working from the bottom row up so it can be in place
+        for (index_t i = kb - 1; i >= 0; i--) {
+          for (index_t c = 0; c < cn; c++) {
+            T1 s = 0;
+            for (index_t p = 0; p <= i; p++) {
+              s += HostConj(T[p * kb + i]) * Wc[p * tn + c];
+            }
+            Wc[i * tn + c] = s;
+          }
+        }
+
+        // A = A - V W
+        matxHostGemm<T1>(MATX_HOST_OP_N, MATX_HOST_OP_N, vm, cn, kb, T1(-1), V,
+                         kb, Wc, tn, T1(1), Ac, n);
+      });
+    }
+  }
+
+  ~matxHostQRSolverPlan_t() {}
+
+private:
+  HostSolverParams_t params;
+};
+
+// Static caches of host QR plans
+static matxCache_t<HostSolverParams_t, HostSolverParamsKeyHash,
+                   HostSolverParamsKeyEq>
+    hqr_cache;
+
+/**
+ * Perform a QR decomposition on the host using a cached plan
+ *
+ * Host version of qr(). The input and output parameters may be the same
+ * tensor. In that case, the input is destroyed and the output is stored
+ * in-place.
+ *
+ * @tparam T1
+ *   Data type of matrix A
+ * @tparam RANK
+ *   Rank of matrix A
+ *
+ * @param out
+ *   Output tensor view
+ * @param tau
+ *   Output of reflection scalar values
+ * @param a
+ *   Input tensor A
+ * @param exec
+ *   Host executor
+ */
+template <typename T1, int RANK>
+void qr(tensor_t<T1, RANK> &out, tensor_t<T1, RANK - 1> &tau,
+        const tensor_t<T1, RANK> &a, const matxHostExecutor_t &exec)
+{
+  auto params = GetHostSolverParams(a, exec);
+
+  // Get cache or new QR plan if it doesn't exist
+  matxHostQRSolverPlan_t<T1, RANK> *plan;
+  auto ret = hqr_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    plan = new matxHostQRSolverPlan_t{a, exec};
+    hqr_cache.Insert(params, static_cast<void *>(plan));
+  }
+  else {
+    plan = static_cast<matxHostQRSolverPlan_t<T1, RANK> *>(ret.value());
+  }
+
+  if (HostGraphRecord(
+          exec,
+          {HostRead(a), HostWrite(out), HostWrite(tau), HostUse(plan)},
+          [plan, out, tau, a](const matxHostExecutor_t &) mutable {
+            plan->Exec(out, tau, a);
+          })) {
+    return;
+  }
+
+  plan->Exec(out, tau, a);
+}
+
+/***************************************** EIGEN DECOMPOSITION
+ * *********************************************/
+
+template <typename T1, int RANK>
+class matxHostEigSolverPlan_t : public matxHostSolver_t<T1> {
+public:
+  /**
+   * Plan for a host Hermitian eigen decomposition using cyclic Jacobi
+   *
+   * Each sweep visits every pair of indices once using the same round-robin
+   * ordering as the batched device kernel, so the n / 2 rotations of a step
+   * are disjoint and applied together. Jacobi is accurate for small
+   * eigenvalues and works entirely in a cache-resident copy of the matrix,
+   * which makes it a good fit for batches of small matrices.
+   *
+   * @tparam T1
+   *  Data type of A matrix
+   * @tparam RANK
+   *  Rank of A matrix
+   *
+   * @param a
+   *   Input tensor view
+   * @param exec
+   *   Host executor
+   */
+  matxHostEigSolverPlan_t(const tensor_t<T1, RANK> &a,
+                          const matxHostExecutor_t &exec)
+  {
+    static_assert(RANK >= 2);
+
+    params = GetHostSolverParams(a, exec);
+
+    // Matrix, eigenvectors, and the sines and cosines of one step
+    const index_t np = params.n + (params.n & 1);
+    this->AllocateWorkspace(params.batch_size, params.num_threads,
+                            2 * np * np + np);
+  }
+
+  template <typename T2>
+  void Exec(tensor_t<T1, RANK> &out, tensor_t<T2, RANK - 1> &w,
+            const tensor_t<T1, RANK> &a,
+            cusolverEigMode_t jobz = CUSOLVER_EIG_MODE_VECTOR,
+            cublasFillMode_t uplo = CUBLAS_FILL_MODE_UPPER)
+  {
+    // Ensure matrix is square
+    MATX_ASSERT(a.Size(RANK - 1) == a.Size(RANK - 2), matxInvalidSize);
+
+    // Ensure output size matches input
+    for (int i = 0; i < RANK; i++) {
+      MATX_ASSERT(out.Size(i) == a.Size(i), matxInvalidSize);
+    }
+
+    const index_t n = params.n;
+    const index_t np = n + (n & 1);
+    const bool lower = uplo == CUBLAS_FILL_MODE_LOWER;
+    MATX_ASSERT(w.Size(RANK - 2) == n, matxInvalidSize);
+
+    this->RunBatches([&](index_t b, T1 *ws, int threads) {
+      T1 *A = ws;
+      T1 *V = ws + np * np;
+
+      // Build the full Hermitian matrix from the selected triangle
+      for (index_t r = 0; r < np; r++) {
+        for (index_t c = 0; c < np; c++) {
+          T1 val = 0;
+          if (r < n && c < n) {
+            bool in_tri = lower ? (r >= c) : (r <= c);
+            val = in_tri ? this->MatElem(a, b, r, c)
+                         : HostConj(this->MatElem(a, b, c, r));
+            if (r == c) {
+              val = HostReal(val);
+            }
+          }
+
+          A[r * np + c] = val;
+        }
+      }
+
+      Factor(A, V, np, ws + 2 * np * np, threads);
+
+      std::vector<index_t> order(n);
+      for (index_t i = 0; i < n; i++) {
+        order[i] = i;
+      }
+
+      std::stable_sort(order.begin(), order.end(), [&](index_t l, index_t r) {
+        return HostReal(A[l * np + l]) < HostReal(A[r * np + r]);
+      });
+
+      if (jobz == CUSOLVER_EIG_MODE_VECTOR) {
+        for (index_t r = 0; r < n; r++) {
+          for (index_t c = 0; c < n; c++) {
+            this->MatElem(out, b, r, c) = V[r * np + order[c]];
+          }
+        }
+      }
+
+      for (index_t i = 0; i < n; i++) {
+        this->VecElem(w, b, i) =
+            static_cast<T2>(HostReal(A[order[i] * np + order[i]]));
+      }
+
+      return 0;
+    });
+  }
+
+  /**
+   * Diagonalize a contiguous Hermitian matrix in place
+   *
+   * @param A
+   *   Full Hermitian matrix. Eigenvalues are on the diagonal on return
+   * @param V
+   *   Eigenvector output, one per column
+   * @param np
+   *   Matrix size, padded to an even number with zero rows and columns
+   * @param rot
+   *   Workspace of np elements for the rotations of a step
+   * @param threads
+   *   Number of threads used to apply the rotations of each step
+   * @returns
+   *   0
+   */
+  static int Factor(T1 *A, T1 *V, index_t np, T1 *rot, int threads)
+  {
+    using real_t = value_type_t<T1>;
+    const index_t pairs = np / 2;
+    const int n = static_cast<int>(np);
+    T1 *sines = rot;
+    T1 *cosines = rot + pairs;
+
+    // Threading a step only pays off once the rows are long enough
+    if (np < 4 * MATX_HOST_SOLVER_BLOCK) {
+      threads = 1;
+    }
+
+    for (index_t i = 0; i < np * np; i++) {
+      V[i] = 0;
+    }
+    for (index_t i = 0; i < np; i++) {
+      V[i * np + i] = 1;
+    }
+
+    const real_t eps = JacobiEps<T1>();
+    for (int sweep = 0; sweep < MATX_JACOBI_MAX_SWEEPS; sweep++) {
+      real_t off = 0, tot = 0;
+      for (index_t r = 0; r < np; r++) {
+        for (index_t c = 0; c < np; c++) {
+          real_t v = HostAbs(A[r * np + c]);
+          tot += v * v;
+          if (r != c) {
+            off += v * v;
+          }
+        }
+      }
+
+      if (off <= eps * eps * tot) {
+        break;
+      }
+
+      for (int step = 0; step < n - 1; step++) {
+        for (index_t k = 0; k < pairs; k++) {
+          int p, q;
+          real_t c;
+          JacobiPair(n, step, static_cast<int>(k), p, q);
+          JacobiRotation(HostReal(A[p * np + p]), HostReal(A[q * np + q]),
+                         A[p * np + q], c, sines[k]);
+          cosines[k] = c;
+        }
+
+        // A = J^H * A
+        matxHostParallelFor(pairs, threads, [&](int, index_t start,
+                                                index_t end) {
+          for (index_t k = start; k < end; k++) {
+            int p, q;
+            JacobiPair(n, step, static_cast<int>(k), p, q);
+            const real_t c = HostReal(cosines[k]);
+            const T1 s = sines[k];
+            for (index_t j = 0; j < np; j++) {
+              T1 ap = A[p * np + j];
+              T1 aq = A[q * np + j];
+              A[p * np + j] = c * ap - s * aq;
+              A[q * np + j] = HostConj(s) * ap + c * aq;
+            }
+          }
+        });
+
+        // A = A * J, V = V * J
+        matxHostParallelFor(pairs, threads, [&](int, index_t start,
+                                                index_t end) {
+          for (index_t k = start; k < end; k++) {
+            int p, q;
+            JacobiPair(n, step, static_cast<int>(k), p, q);
+            const real_t c = HostReal(cosines[k]);
+            const T1 s = sines[k];
+            for (index_t i = 0; i < np; i++) {
+              T1 ap = A[i * np + p];
+              T1 aq = A[i * np + q];
+              A[i * np + p] = c * ap - HostConj(s) * aq;
+              A[i * np + q] = s * ap + c * aq;
+
+              T1 vp = V[i * np + p];
+              T1 vq = V[i * np + q];
+              V[i * np + p] = c * vp - HostConj(s) * vq;
+              V[i * np + q] = s * vp + c * vq;
+            }
+          }
+        });
+      }
+    }
+
+    return 0;
+  }
+
+  ~matxHostEigSolverPlan_t() {}
+
+private:
+  HostSolverParams_t params;
+};
+
+// Static caches of host eigen plans
+static matxCache_t<HostSolverParams_t, HostSolverParamsKeyHash,
+                   HostSolverParamsKeyEq>
+    heig_cache;
+
+/**
+ * Perform a Hermitian eigen decomposition on the host using a cached plan
+ *
+ * Host version of eig() using cyclic Jacobi. Eigenvalues are returned in
+ * ascending order and eigenvectors in the columns of out, matching the device
+ * version. The input and output parameters may be the same tensor. In that
+ * case, the input is destroyed and the output is stored in-place.
+ *
+ * @tparam T1
+ *   Data type of matrix A
+ * @tparam RANK
+ *   Rank of matrix A
+ *
+ * @param out
+ *   Output tensor view
+ * @param w
+ *   Eigenvalues output
+ * @param a
+ *   Input matrix A
+ * @param exec
+ *   Host executor
+ * @param jobz
+ *   CUSOLVER_EIG_MODE_VECTOR to compute eigenvectors or
+ * CUSOLVER_EIG_MODE_NOVECTOR to not compute
+ * @param uplo
+ *   Where to store data in A
+ */
+template <typename T1, typename T2, int RANK>
+void eig(tensor_t<T1, RANK> &out, tensor_t<T2, RANK - 1> &w,
+         const tensor_t<T1, RANK> &a, const matxHostExecutor_t &exec,
+         cusolverEigMode_t jobz = CUSOLVER_EIG_MODE_VECTOR,
+         cublasFillMode_t uplo = CUBLAS_FILL_MODE_UPPER)
+{
+  auto params = GetHostSolverParams(a, exec);
+
+  // Get cache or new eigen plan if it doesn't exist
+  matxHostEigSolverPlan_t<T1, RANK> *plan;
+  auto ret = heig_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    plan = new matxHostEigSolverPlan_t{a, exec};
+    heig_cache.Insert(params, static_cast<void *>(plan));
+  }
+  else {
+    plan = static_cast<matxHostEigSolverPlan_t<T1, RANK> *>(ret.value());
+  }
+
+  if (HostGraphRecord(
+          exec,
+          {HostRead(a), HostWrite(out), HostWrite(w), HostUse(plan)},
+          [plan, out, w, a, jobz, uplo](const matxHostExecutor_t &) mutable {
+            plan->Exec(out, w, a, jobz, uplo);
+          })) {
+    return;
+  }
+
+  plan->Exec(out, w, a, jobz, uplo);
+}
+
+/***************************************** SVD
+ * *********************************************/
+
+template <typename T1, int RANK>
+class matxHostSVDSolverPlan_t : public matxHostSolver_t<T1> {
+public:
+  /**
+   * Plan for a host SVD using one-sided (Hestenes) Jacobi
+   *
+   * Pairs of columns are rotated until they are all mutually orthogonal, at
+   * which point the column norms are the singular values. Columns are kept
+   * contiguous in the workspace so the dot products and rotations stream
+   * through memory. Wide matrices are decomposed through their conjugate
+   * transpose.
+   *
+   * @tparam T1
+   *  Data type of A matrix
+   * @tparam RANK
+   *  Rank of A matrix
+   *
+   * @param a
+   *   Input tensor view
+   * @param exec
+   *   Host executor
+   */
+  matxHostSVDSolverPlan_t(const tensor_t<T1, RANK> &a,
+                          const matxHostExecutor_t &exec)
+  {
+    static_assert(RANK >= 2);
+
+    params = GetHostSolverParams(a, exec);
+
+    // Columns, right vectors, left vectors and rotations
+    const index_t rows = std::max(params.m, params.n);
+    const index_t cp = std::min(params.m, params.n) +
+                       (std::min(params.m, params.n) & 1);
+    this->AllocateWorkspace(params.batch_size, params.num_threads,
+                            cp * rows + cp * cp + rows * rows + cp);
+  }
+
+  template <typename T2, typename T3, typename T4>
+  void Exec(tensor_t<T2, RANK> &u, tensor_t<T3, RANK - 1> &s,
+            tensor_t<T4, RANK> &v, const tensor_t<T1, RANK> &a,
+            const char jobu = 'A', const char jobvt = 'A')
+  {
+    const index_t m = params.m;
+    const index_t n = params.n;
+    const bool trans = m < n;
+    const index_t rows = std::max(m, n);
+    const index_t cols = std::min(m, n);
+    const index_t cp = cols + (cols & 1);
+
+    MATX_ASSERT(s.Size(RANK - 2) >= cols, matxInvalidSize);
+    if (jobu != 'N') {
+      MATX_ASSERT(u.Size(RANK - 2) == m && u.Size(RANK - 1) <= m,
+                  matxInvalidSize);
+    }
+    if (jobvt != 'N') {
+      MATX_ASSERT(v.Size(RANK - 1) == n && v.Size(RANK - 2) <= n,
+                  matxInvalidSize);
+    }
+
+    // Full left vectors of the decomposed matrix are only needed for the
+    // columns past the rank, or for V^H when A is wide
+    const bool need_left = trans ? jobvt != 'N' : jobu != 'N';
+
+    this->RunBatches([&](index_t b, T1 *ws, int threads) {
+      using real_t = value_type_t<T1>;
+      T1 *X = ws;
+      T1 *V = X + cp * rows;
+      T1 *U = V + cp * cp;
+
+      // Columns of A, or of A^H for wide matrices, stored as rows
+      for (index_t j = 0; j < cp; j++) {
+        for (index_t i = 0; i < rows; i++) {
+          if (j >= cols) {
+            X[j * rows + i] = 0;
+          }
+          else {
+            X[j * rows + i] = trans ? HostConj(this->MatElem(a, b, j, i))
+                                    : this->MatElem(a, b, i, j);
+          }
+        }
+      }
+
+      Factor(X, V, rows, cp, ws + cp * rows + cp * cp + rows * rows, threads);
+
+      std::vector<real_t> sigma(cols);
+      std::vector<index_t> order(cols);
+      for (index_t j = 0; j < cols; j++) {
+        real_t nrm = 0;
+        for (index_t i = 0; i < rows; i++) {
+          real_t e = HostAbs(X[j * rows + i]);
+          nrm += e * e;
+        }
+
+        sigma[j] = std::sqrt(nrm);
+        order[j] = j;
+      }
+
+      std::stable_sort(order.begin(), order.end(), [&](index_t l, index_t r) {
+        return sigma[l] > sigma[r];
+      });
+
+      for (index_t k = 0; k < cols; k++) {
+        this->VecElem(s, b, k) = static_cast<T3>(sigma[order[k]]);
+      }
+
+      if (need_left) {
+        LeftVectors(U, X, sigma.data(), order.data(), rows, cols);
+      }
+
+      // The decomposed matrix is X = U * S * V^H. For wide A, X = A^H, so the
+      // roles of U and V swap.
+      if (jobu != 'N') {
+        for (index_t i = 0; i < m; i++) {
+          for (index_t k = 0; k < u.Size(RANK - 1); k++) {
+            this->MatElem(u, b, i, k) =
+                static_cast<T2>(trans ? V[order[k] * cp + i] : U[k * rows + i]);
+          }
+        }
+      }
+
+      if (jobvt != 'N') {
+        for (index_t k = 0; k < v.Size(RANK - 2); k++) {
+          for (index_t j = 0; j < n; j++) {
+            this->MatElem(v, b, k, j) = static_cast<T4>(
+                HostConj(trans ? U[k * rows + j] : V[order[k] * cp + j]));
+          }
+        }
+      }
+
+      return 0;
+    });
+  }
+
+  /**
+   * Orthogonalize the columns of a matrix in place with one-sided Jacobi
+   *
+   * @param X
+   *   Matrix with each of its cp columns stored contiguously. On return the
+   * columns are orthogonal, with norms equal to the singular values
+   * @param V
+   *   Right singular vector output, with each column stored contiguously
+   * @param rows
+   *   Length of each column
+   * @param cp
+   *   Number of columns, padded to an even number with zero columns
+   * @param rot
+   *   Workspace of cp elements for the rotations of a step
+   * @param threads
+   *   Number of threads used for the rotations of each step
+   * @returns
+   *   0
+   */
+  static int Factor(T1 *X, T1 *V, index_t rows, index_t cp, T1 *rot,
+                    int threads)
+  {
+    using real_t = value_type_t<T1>;
+    const index_t pairs = cp / 2;
+    const int n = static_cast<int>(cp);
+    T1 *sines = rot;
+    T1 *cosines = rot + pairs;
+
+    if (rows * pairs < MATX_HOST_SOLVER_BLOCK * MATX_HOST_SOLVER_BLOCK) {
+      threads = 1;
+    }
+
+    for (index_t i = 0; i < cp * cp; i++) {
+      V[i] = 0;
+    }
+    for (index_t i = 0; i < cp; i++) {
+      V[i * cp + i] = 1;
+    }
+
+    const real_t eps = JacobiEps<T1>();
+    for (int sweep = 0; sweep < MATX_JACOBI_MAX_SWEEPS; sweep++) {
+      bool rotated = false;
+
+      for (int step = 0; step < n - 1; step++) {
+        matxHostParallelFor(pairs, threads, [&](int, index_t start,
+                                                index_t end) {
+          for (index_t k = start; k < end; k++) {
+            int p, q;
+            JacobiPair(n, step, static_cast<int>(k), p, q);
+            T1 *xp = X + p * rows;
+            T1 *xq = X + q * rows;
+
+            real_t alpha = 0, beta = 0;
+            T1 gamma = 0;
+            for (index_t i = 0; i < rows; i++) {
+              alpha += HostReal(HostConj(xp[i]) * xp[i]);
+              beta += HostReal(HostConj(xq[i]) * xq[i]);
+              gamma += HostConj(xp[i]) * xq[i];
+            }
+
+            real_t c = 1;
+            T1 sn = 0;
+            if (HostAbs(gamma) > eps * std::sqrt(alpha * beta)) {
+              JacobiRotation(alpha, beta, gamma, c, sn);
+            }
+
+            cosines[k] = c;
+            sines[k] = sn;
+            if (sn == T1(0)) {
+              continue;
+            }
+
+            for (index_t i = 0; i < rows; i++) {
+              T1 ap = xp[i];
+              T1 aq = xq[i];
+              xp[i] = c * ap - HostConj(sn) * aq;
+              xq[i] = sn * ap + c * aq;
+            }
+
+            T1 *vp = V + p * cp;
+            T1 *vq = V + q * cp;
+            for (index_t i = 0; i < cp; i++) {
+              T1 ap = vp[i];
+              T1 aq = vq[i];
+              vp[i] = c * ap - HostConj(sn) * aq;
+              vq[i] = sn * ap + c * aq;
+            }
+          }
+        });
+
+        for (index_t k = 0; k < pairs; k++) {
+          rotated = rotated || sines[k] != T1(0);
+        }
+      }
+
+      if (!rotated) {
+        break;
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * Build all left singular vectors, one per contiguous row of U. Columns
+   * with a singular value of zero and the columns past the rank are completed
+   * to an orthonormal basis with Gram-Schmidt.
+   */
+  static void LeftVectors(T1 *U, const T1 *X, const value_type_t<T1> *sigma,
+                          const index_t *order, index_t rows, index_t cols)
+  {
+    using real_t = value_type_t<T1>;
+    const real_t tol = (cols > 0 ? sigma[order[0]] : real_t(0)) *
+                       JacobiEps<T1>() * static_cast<real_t>(rows);
+
+    std::vector<bool> have(rows, false);
+    for (index_t k = 0; k < cols; k++) {
+      const real_t sk = sigma[order[k]];
+      if (sk > tol && sk > real_t(0)) {
+        for (index_t i = 0; i < rows; i++) {
+          U[k * rows + i] = X[order[k] * rows + i] / sk;
+        }
+        have[k] = true;
+      }
+    }
+
+    // A basis vector whose projection onto the missing subspace is too short
+    // can never become usable, and the squared projections of all of them sum
+    // to the number of missing vectors, so some remaining candidate always
+    // clears this bound
+    const real_t min_nrm =
+        static_cast<real_t>(std::sqrt(0.5 / static_cast<double>(rows)));
+
+    index_t cand = 0;
+    for (index_t k = 0; k < rows; k++) {
+      if (have[k]) {
+        continue;
+      }
+
+      for (; cand < rows; cand++) {
+        T1 *uk = U + k * rows;
+        for (index_t i = 0; i < rows; i++) {
+          uk[i] = (i == cand) ? T1(1) : T1(0);
+        }
+
+        // Orthogonalize twice for stability
+        for (int pass = 0; pass < 2; pass++) {
+          for (index_t j = 0; j < rows; j++) {
+            if (!have[j]) {
+              continue;
+            }
+
+            T1 d = 0;
+            for (index_t i = 0; i < rows; i++) {
+              d += HostConj(U[j * rows + i]) * uk[i];
+            }
+            for (index_t i = 0; i < rows; i++) {
+              uk[i] -= d * U[j * rows + i];
+            }
+          }
+        }
+
+        real_t nrm = 0;
+        for (index_t i = 0; i < rows; i++) {
+          real_t e = HostAbs(uk[i]);
+          nrm += e * e;
+        }
+
+        nrm = std::sqrt(nrm);
+        if (nrm > min_nrm) {
+          for (index_t i = 0; i < rows; i++) {
+            uk[i] /= nrm;
+          }
+          have[k] = true;
+          cand++;
+          break;
+        }
+      }
+    }
+  }
+
+  ~matxHostSVDSolverPlan_t() {}
+
+private:
+  HostSolverParams_t params;
+};
+
+// Static caches of host SVD plans
+static matxCache_t<HostSolverParams_t, HostSolverParamsKeyHash,
+                   HostSolverParamsKeyEq>
+    hsvd_cache;
+
+/**
+ * Perform a SVD decomposition on the host using a cached plan
+ *
+ * Host version of svd() using one-sided Jacobi, which computes small singular
+ * values to high relative accuracy. On return A = U * diag(s) * v, where u
+ * holds the left singular vectors in its columns and v holds the conjugate
+ * transpose of the right singular vectors (V^H), with singular values in
+ * descending order. With jobu or jobvt set to 'N' the corresponding output is
+ * not written, and any other value writes as many columns of u or rows of v
+ * as the tensors hold.
+ *
+ * @tparam T1
+ *   Data type of matrix A
+ * @tparam RANK
+ *   Rank of matrix A
+ *
+ * @param u
+ *   U matrix output
+ * @param s
+ *   Sigma matrix output
+ * @param v
+ *   V^H matrix output
+ * @param a
+ *   Input matrix A
+ * @param exec
+ *   Host executor
+ * @param jobu
+ *   Specifies options for computing all or part of the matrix U
+ * @param jobvt
+ *   specifies options for computing all or part of the matrix V**H
+ */
+template <typename T1, typename T2, typename T3, typename T4, int RANK>
+void svd(tensor_t<T2, RANK> &u, tensor_t<T3, RANK - 1> &s,
+         tensor_t<T4, RANK> &v, const tensor_t<T1, RANK> &a,
+         const matxHostExecutor_t &exec, const char jobu = 'A',
+         const char jobvt = 'A')
+{
+  auto params = GetHostSolverParams(a, exec);
+
+  // Get cache or new SVD plan if it doesn't exist
+  matxHostSVDSolverPlan_t<T1, RANK> *plan;
+  auto ret = hsvd_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    plan = new matxHostSVDSolverPlan_t{a, exec};
+    hsvd_cache.Insert(params, static_cast<void *>(plan));
+  }
+  else {
+    plan = static_cast<matxHostSVDSolverPlan_t<T1, RANK> *>(ret.value());
+  }
+
+  if (HostGraphRecord(
+          exec,
+          {HostRead(a), HostWrite(u), HostWrite(s),
+           HostWrite(v), HostUse(plan)},
+          [plan, u, s, v, a, jobu, jobvt](const matxHostExecutor_t &) mutable {
+            plan->Exec(u, s, v, a, jobu, jobvt);
+          })) {
+    return;
+  }
+
+  plan->Exec(u, s, v, a, jobu, jobvt);
+}
+
+} // end namespace matx
@@ -33,6 +33,8 @@
 #pragma once
 
 #include "cublas_v2.h"
+#include "kernels/matx_inverse_kernels.cuh"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
 #include "matx_tensor.h"
@@ -73,6 +75,13 @@ public:
    * is supplied to give flexibility. To perform a matrix inversion the input
    * matrix must be square, and non-singular.
    *
+   * Matrices up to MATX_SMALL_INV_MAX_N on a side are inverted with a batched
+   * Gauss-Jordan kernel specialized on a compile-time size instead of cuBLAS,
+   * since the overhead of the batched cuBLAS calls dominates at those sizes.
+   * Those plans don't create a cuBLAS handle, and don't block on the
+   * singularity check: a singular input is reported by the next execution of
+   * the same plan.
+   *
    * @tparam T1
    *    Data type of A matrix
    * @tparam RANK
@@ -102,11 +111,26 @@ public:
       MATX_ASSERT(a.Size(i) == a_inv.Size(i), matxInvalidSize);
     }
 
+    params = GetInverseParams(a_inv, a);
+
+    if (params.n <= MATX_SMALL_INV_MAX_N) {
+      // Like the pointer arrays of the cuBLAS path, only the layout is kept
+      // so the plan doesn't hold a reference to the caller's memory
+      shape_ = a.Shape();
+      for (int i = 0; i < RANK; i++) {
+        a_strides_[i] = a.Stride(i);
+        a_inv_strides_[i] = a_inv.Stride(i);
+      }
+
+      matxAlloc((void **)&d_info, sizeof(*d_info), MATX_DEVICE_MEMORY);
+      matxAlloc((void **)&h_info, sizeof(*h_info), MATX_HOST_MEMORY);
+      cudaEventCreateWithFlags(&info_event, cudaEventDisableTiming);
+      return;
+    }
+
     MATX_ASSERT(cublasCreate(&handle) == CUBLAS_STATUS_SUCCESS,
                 matxInverseError);
 
-    params = GetInverseParams(a_inv, a);
-
     if constexpr (ALGO == MAT_INVERSE_ALGO_LU) {
       // cuBLAS requires a list of pointers to each matrix. Construct that list
       // here as our batch dims
@@ -190,7 +214,14 @@ public:
     matxFree(d_pivot);
     matxFree(d_info);
 
-    cublasDestroy(handle);
+    if (h_info != nullptr) {
+      matxFree(h_info);
+      cudaEventDestroy(info_event);
+    }
+
+    if (handle != nullptr) {
+      cublasDestroy(handle);
+    }
   }
 
   /**
@@ -209,6 +240,10 @@ public:
    */
   inline void Exec(cudaStream_t stream)
   {
+    if (params.n <= MATX_SMALL_INV_MAX_N) {
+      ExecSmall(stream);
+      return;
+    }
 
     cublasSetStream(handle, stream);
 
@@ -285,15 +320,78 @@ public:
   }
 
 private:
+  template <int N> inline void LaunchSmall(cudaStream_t stream)
+  {
+    constexpr int mats = SmallInvMatsPerBlock<T1, N>();
+    auto blocks = static_cast<unsigned int>(
+        (params.batch_size + mats - 1) / mats);
+    tensor_t<T1, RANK> a(static_cast<T1 *>(params.A), shape_, a_strides_);
+    tensor_t<T1, RANK> a_inv(static_cast<T1 *>(params.A_inv), shape_,
+                             a_inv_strides_);
+    SmallInverse<T1, N><<<blocks, mats * 32, 0, stream>>>(
+        a_inv, a, params.n, static_cast<index_t>(params.batch_size), d_info);
+  }
+
+  /**
+   * Check the singularity flag of the previous small inverse
+   *
+   * The flag is copied to pinned memory asynchronously at the end of each
+   * small inverse, so a singular input is reported by the next execution of
+   * the plan rather than stalling the stream on every call.
+   */
+  inline void CheckSmall()
+  {
+    if (!info_pending) {
+      return;
+    }
+
+    info_pending = false;
+    cudaEventSynchronize(info_event);
+    MATX_ASSERT(*h_info == 0, matxInverseError);
+  }
+
+  inline void ExecSmall(cudaStream_t stream)
+  {
+    CheckSmall();
+
+    cudaMemsetAsync(d_info, 0, sizeof(*d_info), stream);
+
+    // Round up to the nearest specialized size. Smaller matrices are padded
+    // with the identity inside the kernel.
+    if (params.n <= 4) {
+      LaunchSmall<4>(stream);
+    }
+    else if (params.n <= 8) {
+      LaunchSmall<8>(stream);
+    }
+    else if (params.n <= 16) {
+      LaunchSmall<16>(stream);
+    }
+    else {
+      LaunchSmall<32>(stream);
+    }
+
+    cudaMemcpyAsync(h_info, d_info, sizeof(*d_info), cudaMemcpyDeviceToHost,
+                    stream);
+    cudaEventRecord(info_event, stream);
+    info_pending = true;
+  }
+
   // Member variables
   cublasStatus_t ret = CUBLAS_STATUS_SUCCESS;
 
   InverseParams_t params;
-  cublasHandle_t handle;
-  int *d_pivot;
-  int *d_info;
-  T1 **d_A_array;
-  T1 **d_A_inv_array;
+  cublasHandle_t handle = nullptr;
+  tensorShape_t<RANK> shape_;
+  index_t a_strides_[RANK];
+  index_t a_inv_strides_[RANK];
+  int *d_pivot = nullptr;
+  int *d_info = nullptr;
+  int *h_info = nullptr;
+  cudaEvent_t info_event;
+  bool info_pending = false;
+  T1 **d_A_array = nullptr;
+  T1 **d_A_inv_array = nullptr;
 };
 
 /**
@@ -337,6 +435,8 @@ void inv(tensor_t<T1, RANK> a_inv, tensor_t<T1, RANK> a,
          cudaStream_t stream = 0)
 #endif
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params = matxInversePlan_t<T1, RANK, ALGO>::GetInverseParams(a_inv, a);
   params.stream = stream;
@@ -33,8 +33,10 @@
 #pragma once
 
 #include "cublas_v2.h"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
+#include "matx_host_executor.h"
 #include "matx_tensor.h"
 #include <cublasLt.h>
 
@@ -91,6 +93,9 @@ struct MatMulParams_t {
   index_t ldb;
   index_t ldc;
   int32_t batch; // Must be int32_t for cuBLASLt
+  int64_t a_batch_stride = 0; // Must be int64_t for cuBLASLt
+  int64_t b_batch_stride = 0;
+  int64_t c_batch_stride = 0;
   MatXMatMulProvider_t prov;
   cudaStream_t stream;
   MatXDataType_t dtype;
@@ -268,6 +273,25 @@ public:
       params.c_rows = params.a_rows;
       params.c_cols = params.b_cols;
       params.ldc = c_comp.Stride(RANK - 2);
+
+      // Batches are strided by the third dimension. Complex half matrices are
+      // converted to contiguous planar copies before the launch, so their
+      // batches are one matrix apart.
+      if constexpr (RANK >= 3) {
+        if constexpr (is_complex_half_v<T1>) {
+          params.a_batch_stride =
+              a_comp.Size(RANK - 2) * a_comp.Size(RANK - 1);
+          params.b_batch_stride =
+              b_comp.Size(RANK - 2) * b_comp.Size(RANK - 1);
+          params.c_batch_stride =
+              c_comp.Size(RANK - 2) * c_comp.Size(RANK - 1);
+        }
+        else {
+          params.a_batch_stride = a_comp.Stride(RANK - 3);
+          params.b_batch_stride = b_comp.Stride(RANK - 3);
+          params.c_batch_stride = c_comp.Stride(RANK - 3);
+        }
+      }
     }
     else if constexpr (PROV == PROVIDER_TYPE_CUTLASS) {
       params.opA = CUBLAS_OP_N;
@@ -477,6 +501,22 @@ private:
                     sizeof(params_.batch)) == CUBLAS_STATUS_SUCCESS,
                 matxMatMulError);
 
+    MATX_ASSERT(cublasLtMatrixLayoutSetAttribute(
+                    Adesc, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                    &params_.a_batch_stride,
+                    sizeof(params_.a_batch_stride)) == CUBLAS_STATUS_SUCCESS,
+                matxMatMulError);
+    MATX_ASSERT(cublasLtMatrixLayoutSetAttribute(
+                    Bdesc, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                    &params_.b_batch_stride,
+                    sizeof(params_.b_batch_stride)) == CUBLAS_STATUS_SUCCESS,
+                matxMatMulError);
+    MATX_ASSERT(cublasLtMatrixLayoutSetAttribute(
+                    Cdesc, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                    &params_.c_batch_stride,
+                    sizeof(params_.c_batch_stride)) == CUBLAS_STATUS_SUCCESS,
+                matxMatMulError);
+
     if constexpr (is_complex_half_v<T1> && is_complex_half_v<T2>) {
       size_t planarA = (params_.a_rows * params_.a_cols * sizeof(T1)) / 2;
       size_t planarB = (params_.b_rows * params_.b_cols * sizeof(T1)) / 2;
@@ -556,8 +596,8 @@ private:
       tensor_t<typename T2::value_type, RANK> b_planar(B, b_shape);
 
       // Convert A/B to planar layout
-      (a_planar = planar(a)).run(stream);
-      (b_planar = planar(b)).run(stream);
+      exec(a_planar = planar(a), stream);
+      exec(b_planar = planar(b), stream);
 
       a_adj.SetData(reinterpret_cast<T1 *>(A));
       b_adj.SetData(reinterpret_cast<T2 *>(B));
@@ -761,7 +801,7 @@ private:
           reinterpret_cast<typename T3::value_type *>(c_adj.Data()), c_shape);
 
       // Convert A/B to planar layout
-      (c = interleaved(c_planar)).run(stream);
+      exec(c = interleaved(c_planar), stream);
       matxFree(a_adj.Data());
       matxFree(b_adj.Data());
       matxFree(c_adj.Data());
@@ -873,7 +913,9 @@ struct MatMulParamsKeyEq {
            l.c_cols == t.c_cols && l.stream == t.stream && l.lda == t.lda &&
            l.ldb == t.ldb && l.ldc == t.ldc && l.batch == t.batch &&
            l.prov == t.prov && l.dtype == t.dtype && l.opA == t.opA &&
-           l.opB == t.opB;
+           l.opB == t.opB && l.a_batch_stride == t.a_batch_stride &&
+           l.b_batch_stride == t.b_batch_stride &&
+           l.c_batch_stride == t.c_batch_stride;
   }
 };
 
@@ -920,6 +962,8 @@ void matmul(tensor_t<T1, RANK> c, const tensor_t<T2, RANK> &a,
             const tensor_t<T3, RANK> &b, cudaStream_t stream = 0,
             float alpha = 1.0, float beta = 0.0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   auto params =
       matxMatMulHandle_t<T1, T2, T3, RANK, PROV>::GetGemmParams(c, a, b);
@@ -941,4 +985,165 @@ void matmul(tensor_t<T1, RANK> c, const tensor_t<T2, RANK> &a,
   }
 }
 
+/**
+ * Run a GEMM on the host
+ *
+ * Host version of matmul(). The rows of C, across all batches, are split
+ * across threads. Each row is accumulated a row of B at a time, so the inner
+ * loop is unit stride over B and C when they're row-major, and half types
+ * accumulate in single precision. The batch dimensions of rank 3 and 4 views
+ * must match.
+ *
+ * @tparam T1
+ *    Data type of C matrix
+ * @tparam T2
+ *    Data type of A matrix
+ * @tparam T3
+ *    Data type of B matrix
+ * @tparam RANK
+ *    Rank of A/B/C matrices
+ *
+ * @param c
+ *   C matrix view
+ * @param a
+ *   A matrix view
+ * @param b
+ *   B matrix view
+ * @param exec
+ *   Host executor
+ * @param alpha
+ *   Scalar multiplier to apply to matrix A
+ * @param beta
+ *   Scalar multiplier to apply to matrix C on input
+ */
+template <typename T1, typename T2, typename T3, int RANK>
+void matmul(tensor_t<T1, RANK> c, const tensor_t<T2, RANK> &a,
+            const tensor_t<T3, RANK> &b, const matxHostExecutor_t &exec,
+            float alpha = 1.0, float beta = 0.0)
+{
+  using acc_t = promote_half_t<T1>;
+
+  static_assert(RANK >= 2 && RANK <= 4, "Host GEMMs must be rank 2 to 4");
+  MATX_ASSERT(a.Size(RANK - 1) == b.Size(RANK - 2), matxInvalidSize);
+  MATX_ASSERT(c.Size(RANK - 2) == a.Size(RANK - 2), matxInvalidSize);
+  MATX_ASSERT(c.Size(RANK - 1) == b.Size(RANK - 1), matxInvalidSize);
+  for (int i = 0; i < RANK - 2; i++) {
+    MATX_ASSERT(a.Size(i) == c.Size(i) && b.Size(i) == c.Size(i),
+                matxInvalidSize);
+  }
+
+  if (HostGraphRecord(exec, {HostRead(a), HostRead(b), HostWrite(c)},
+                      [c, a, b, alpha, beta](const matxHostExecutor_t &e) {
+                        matmul(c, a, b, e, alpha, beta);
+                      })) {
+    return;
+  }
+
+  const index_t m = a.Size(RANK - 2);
+  const index_t k = a.Size(RANK - 1);
+  const index_t n = b.Size(RANK - 1);
+  const int threads = exec.GetNumThreads();
+
+  index_t batches = 1;
+  for (int i = 0; i < RANK - 2; i++) {
+    batches *= c.Size(i);
+  }
+
+  auto elem = [](auto &t, index_t bt, index_t r,
+                 index_t col) -> decltype(auto) {
+    if constexpr (RANK == 2) {
+      return t(r, col);
+    }
+    else if constexpr (RANK == 3) {
+      return t(bt, r, col);
+    }
+    else {
+      return t(bt / t.Size(1), bt % t.Size(1), r, col);
+    }
+  };
+
+  const acc_t al = static_cast<acc_t>(alpha);
+  const acc_t be = static_cast<acc_t>(beta);
+  std::vector<std::vector<acc_t>> rows(threads);
+  matxHostParallelFor(batches * m, threads, [&](int tid, index_t start,
+                                                index_t end) {
+    auto &acc = rows[tid];
+    acc.resize(n);
+
+    for (index_t r = start; r < end; r++) {
+      const index_t bt = r / m;
+      const index_t i = r % m;
+      std::fill(acc.begin(), acc.end(), acc_t(0));
+      for (index_t p = 0; p < k; p++) {
+        const acc_t av = static_cast<acc_t>(elem(a, bt, i, p));
+        for (index_t j = 0; j < n; j++) {
+          acc[j] += av * static_cast<acc_t>(elem(b, bt, p, j));
+        }
+      }
+
+      for (index_t j = 0; j < n; j++) {
+        auto &cv = elem(c, bt, i, j);
+        cv = static_cast<T1>(beta == 0.0f
+                                 ? al * acc[j]
+                                 : al * acc[j] + be * static_cast<acc_t>(cv));
+      }
+    }
+  });
+}
+
+
+/**
+ * Multiply small matrices with static sizes in the calling thread
+ *
+ * Computes C = A * B with loops whose bounds are all constants, so the
+ * compiler fully unrolls them. Unlike the other matmul() overloads, nothing is
+ * launched: each thread that calls this computes its own product, which
+ * suits many small independent products like per-element rotations or
+ * covariance blocks. When the views wrap local arrays, the whole product can
+ * stay in registers.
+ *
+ * @tparam T1
+ *    Data type of C matrix
+ * @tparam T2
+ *    Data type of A matrix
+ * @tparam T3
+ *    Data type of B matrix
+ * @tparam M
+ *    Rows of A and C
+ * @tparam N
+ *    Columns of B and C
+ * @tparam K
+ *    Columns of A and rows of B
+ *
+ * @param c
+ *   C matrix view
+ * @param a
+ *   A matrix view
+ * @param b
+ *   B matrix view
+ */
+template <typename T1, typename T2, typename T3, index_t M, index_t N,
+          index_t K>
+__host__ __device__ inline void matmul(const tensor_static_t<T1, M, N> &c,
+                                       const tensor_static_t<T2, M, K> &a,
+                                       const tensor_static_t<T3, K, N> &b)
+{
+  static_assert(M > 0 && N > 0 && K > 0,
+                "Small matrix multiplies require static sizes");
+
+#pragma unroll
+  for (index_t m = 0; m < M; m++) {
+#pragma unroll
+    for (index_t n = 0; n < N; n++) {
+      T1 acc = static_cast<T1>(a(m, 0) * b(0, n));
+#pragma unroll
+      for (index_t k = 1; k < K; k++) {
+        acc += static_cast<T1>(a(m, k) * b(k, n));
+      }
+
+      c(m, n) = acc;
+    }
+  }
+}
+
 } // end namespace matx
@@ -32,14 +32,27 @@
 
 #pragma once
 
+#include <array>
+#include <cmath>
 #include <cstdint>
 #include <type_traits>
+#include <vector>
 
+#include "kernels/matx_ambgfun_kernels.cuh"
+#include "kernels/matx_cfar_kernels.cuh"
+#include "kernels/matx_doppler_kernels.cuh"
+#include "kernels/matx_overlap_save_kernels.cuh"
 #include "matx_allocator.h"
+#include "matx_cache.h"
+#include "matx_deferred.h"
 #include "matx_error.h"
+#include "matx_fft.h"
+#include "matx_host_fft.h"
+#include "matx_host_solver.h"
 #include "matx_shape.h"
 #include "matx_tensor.h"
 #include "matx_type_utils.h"
+#include "matx_window.h"
 
 namespace matx {
 namespace signal {
@@ -50,271 +63,423 @@ typedef enum {
   AMGBFUN_CUT_TYPE_DOPPLER,
 } AMBGFunCutType_t;
 
-template <class O, class I1, class I2>
-class newYNorm : public BaseOp<newYNorm<O, I1, I2>> {
-private:
-  O out_;
-  I1 xnorm_;
-  I2 ynorm_;
-
+/**
+ * Ambiguity function plan
+ *
+ * Owns the FFT plans and workspace for one cut type and pair of signal
+ * lengths, so the ambiguity function can be computed repeatedly without
+ * allocating. The normalization by the signal energies is folded into the
+ * final pass, each cut is built in a single FFT buffer that is filled with
+ * its zero padding in the same pass, and the magnitude is written straight
+ * into the real output. Inverse FFTs are done as forward FFTs of conjugated
+ * data since only the magnitude is kept, which saves the scaling passes.
+ *
+ * Plans created with a stream run on the device, and plans created with a
+ * host executor run on the host with the host FFT.
+ *
+ * @tparam T
+ *   Complex signal type
+ */
+template <typename T> class matxAmbgFunPlan_t {
 public:
-  newYNorm(O out, I1 xnorm, I2 ynorm) : out_(out), xnorm_(xnorm), ynorm_(ynorm)
-  {
-  }
-
-  __device__ inline void operator()(index_t idy, index_t idx)
+  /**
+   * Construct a device ambiguity function plan
+   *
+   * @param xlen
+   *   Length of x
+   * @param ylen
+   *   Length of y. Same as xlen for the auto-ambiguity function
+   * @param cut
+   *   Type of cut
+   * @param stream
+   *   CUDA stream
+   */
+  matxAmbgFunPlan_t(index_t xlen, index_t ylen, AMBGFunCutType_t cut,
+                    cudaStream_t stream = 0)
+      : host_(false), stream_(stream)
   {
+    Init(xlen, ylen, cut);
 
-    index_t xcol = idx - (xnorm_.Size(xnorm_.Rank() - 1) - 1) + idy;
-    if (xcol >= 0 && xcol < (xnorm_.Size(xnorm_.Rank() - 1))) {
-      typename I1::type xnorm = xnorm_(xcol);
-      typename I2::type ynorm = ynorm_(idx);
+    matxAlloc((void **)&buf_, buf_size_ * sizeof(T), MATX_DEVICE_MEMORY);
+    matxAlloc((void **)&energy_, 2 * sizeof(float), MATX_DEVICE_MEMORY);
 
-      out_(idy, idx) = ynorm * cuda::std::conj(xnorm);
+    if (cut_ == AMGBFUN_CUT_TYPE_2D) {
+      tensor_t<T, 2> buf_v(buf_, {len_seq_ - 1, nfreq_});
+      fft_ = new matxFFTPlan1D_t<T, T>{buf_v, buf_v};
+    }
+    else if (cut_ == AMGBFUN_CUT_TYPE_DELAY) {
+      tensor_t<T, 1> buf_v(buf_, {nfreq_});
+      fft_ = new matxFFTPlan1D_t<T, T>{buf_v, buf_v};
     }
     else {
-      out_(idy, idx) = {0, 0};
+      // Both signals are transformed in one batch, and only the first row
+      // is transformed again
+      tensor_t<T, 2> buf_v(buf_, {2, n_});
+      tensor_t<T, 2> row_v(buf_, {1, n_});
+      fft_ = new matxFFTPlan1D_t<T, T>{buf_v, buf_v};
+      fft_row_ = new matxFFTPlan1D_t<T, T>{row_v, row_v};
     }
   }
 
-  __host__ __device__ inline index_t Size(uint32_t i) const
+  /**
+   * Construct a host ambiguity function plan
+   *
+   * @param xlen
+   *   Length of x
+   * @param ylen
+   *   Length of y. Same as xlen for the auto-ambiguity function
+   * @param cut
+   *   Type of cut
+   * @param exec
+   *   Host executor
+   */
+  matxAmbgFunPlan_t(index_t xlen, index_t ylen, AMBGFunCutType_t cut,
+                    const matxHostExecutor_t &exec)
+      : host_(true), stream_(0), exec_(exec)
   {
-    return out_.Size(i);
+    Init(xlen, ylen, cut);
+
+    hbuf_.resize(static_cast<size_t>(buf_size_));
+    buf_ = hbuf_.data();
+    hfft_ = GetHostFFTPlan<T>(n_);
   }
 
-  static inline constexpr __host__ __device__ int32_t Rank()
+  /**
+   * Ambiguity function plan destructor
+   *
+   * Frees the workspace and FFT plans
+   */
+  ~matxAmbgFunPlan_t()
   {
-    return O::Rank();
-  }
-};
+    if (host_) {
+      return;
+    }
 
-template <class O, class I1>
-class AmbgFftXOp : public BaseOp<AmbgFftXOp<O, I1>> {
-private:
-  O out_;
-  I1 x_;
-  double fs_;
-  double cut_;
-  double nfreq_;
+    delete fft_;
+    delete fft_row_;
+    matxFree(buf_);
+    matxFree(energy_);
+  }
 
-public:
-  AmbgFftXOp(O out, I1 x, double fs, double cut, double nfreq)
-      : out_(out), x_(x), fs_(fs), cut_(cut), nfreq_(nfreq)
+  /**
+   * Number of rows of the output. Each row is a Doppler shift for the 2D
+   * cut, and the cuts have one row.
+   */
+  index_t Rows() const
   {
+    return cut_ == AMGBFUN_CUT_TYPE_2D ? len_seq_ - 1 : 1;
   }
-  __device__ inline void operator()(index_t idx)
-  {
 
-    out_(idx) =
-        exp(cuda::std::complex<float>{
-            0, static_cast<float>(2.0 * M_PI *
-                                  (-fs_ / 2.0 + idx * fs_ / nfreq_) * cut_)}) *
-        x_(idx);
-  }
+  /**
+   * Number of columns of the output
+   */
+  index_t Cols() const { return n_; }
 
-  __host__ __device__ inline index_t Size(uint32_t i) const
+  /**
+   * Compute the cross-ambiguity function of x and y
+   *
+   * @param amf
+   *   Output of Rows() by Cols()
+   * @param x
+   *   First input signal
+   * @param y
+   *   Second input signal
+   * @param fs
+   *   Sampling frequency
+   * @param cut_val
+   *   Value to perform the cut at
+   */
+  template <typename OutType, typename XType, typename YType>
+  void Exec(tensor_t<OutType, 2> &amf, const XType &x, const YType &y,
+            double fs, float cut_val)
   {
-    return out_.Size(i);
+    MATX_ASSERT(x.Size(0) == xlen_ && y.Size(0) == ylen_, matxInvalidSize);
+    MATX_ASSERT(amf.Size(0) == Rows() && amf.Size(1) == Cols(),
+                matxInvalidSize);
+
+    if (host_) {
+      ExecHost(amf, x, y, fs, cut_val);
+    }
+    else {
+      ExecDevice(amf, x, y, fs, cut_val);
+    }
   }
-  static inline constexpr __host__ __device__ int32_t Rank()
+
+  /**
+   * Compute the ambiguity function of x
+   *
+   * @param amf
+   *   Output of Rows() by Cols()
+   * @param x
+   *   Input signal
+   * @param fs
+   *   Sampling frequency
+   * @param cut_val
+   *   Value to perform the cut at
+   */
+  template <typename OutType, typename XType>
+  void Exec(tensor_t<OutType, 2> &amf, const XType &x, double fs,
+            float cut_val)
   {
-    return O::Rank();
+    auto_ = true;
+    Exec(amf, x, x, fs, cut_val);
+    auto_ = false;
   }
-};
 
-template <class O, class I1> class AmbgDoppX : public BaseOp<AmbgDoppX<O, I1>> {
 private:
-  O out_;
-  I1 x_;
-  double fs_;
-  double cut_;
+  void Init(index_t xlen, index_t ylen, AMBGFunCutType_t cut)
+  {
+    static_assert(is_complex_v<T>, "Ambiguity function input must be complex");
+    MATX_ASSERT(xlen > 0 && ylen > 0, matxInvalidSize);
 
-public:
-  AmbgDoppX(O out, I1 x, double fs, double cut)
-      : out_(out), x_(x), fs_(fs), cut_(cut)
+    xlen_ = xlen;
+    ylen_ = ylen;
+    cut_ = cut;
+    len_seq_ = xlen + ylen;
+
+    // Doppler bins for the 2D and zero-delay cuts
+    nfreq_ = 1;
+    while (nfreq_ < len_seq_ - 1) {
+      nfreq_ *= 2;
+    }
+
+    if (cut == AMGBFUN_CUT_TYPE_2D) {
+      n_ = nfreq_;
+      buf_size_ = (len_seq_ - 1) * nfreq_;
+    }
+    else if (cut == AMGBFUN_CUT_TYPE_DELAY) {
+      n_ = nfreq_;
+      buf_size_ = nfreq_;
+    }
+    else {
+      n_ = len_seq_ - 1;
+      buf_size_ = 2 * n_;
+    }
+  }
+
+  template <typename OutType, typename XType, typename YType>
+  void ExecDevice(tensor_t<OutType, 2> &amf, const XType &x, const YType &y,
+                  double fs, float cut_val)
   {
+    const float *ex = energy_;
+    const float *ey = energy_;
+    tensor_t<float, 0> ex_v(energy_);
+    sum(ex_v, norm(x), stream_);
+    if (!auto_) {
+      tensor_t<float, 0> ey_v(energy_ + 1);
+      sum(ey_v, norm(y), stream_);
+      ey = energy_ + 1;
+    }
+
+    const index_t n = n_;
+    const unsigned int blocks =
+        static_cast<unsigned int>((n + AMBGFUN_BLOCK_SIZE - 1) /
+                                  AMBGFUN_BLOCK_SIZE);
+
+    if (cut_ == AMGBFUN_CUT_TYPE_2D) {
+      tensor_t<T, 2> buf_v(buf_, {len_seq_ - 1, n});
+      dim3 grid(static_cast<unsigned int>(len_seq_ - 1), blocks);
+      AmbgLoad2D<<<grid, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(buf_, x, y, xlen_,
+                                                           ylen_, n);
+      fft_->Forward(buf_v, buf_v, stream_);
+      AmbgMag<<<grid, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(
+          amf, buf_, n, (n + 1) / 2, ex, ey, 1.0);
+    }
+    else if (cut_ == AMGBFUN_CUT_TYPE_DELAY) {
+      tensor_t<T, 1> buf_v(buf_, {n});
+      AmbgLoadRow<<<blocks, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(buf_, x, xlen_,
+                                                              n, 0.0);
+      fft_->Forward(buf_v, buf_v, stream_);
+      AmbgDelayShift<<<blocks, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(
+          buf_, n, fs, static_cast<double>(cut_val));
+      fft_->Forward(buf_v, buf_v, stream_);
+      AmbgDelayMul<<<blocks, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(buf_, y, ylen_,
+                                                               n);
+      fft_->Forward(buf_v, buf_v, stream_);
+      AmbgMag<<<dim3(1, blocks), AMBGFUN_BLOCK_SIZE, 0, stream_>>>(
+          amf, buf_, n, n / 2, ex, ey, 1.0 / static_cast<double>(n));
+    }
+    else {
+      tensor_t<T, 2> buf_v(buf_, {2, n});
+      tensor_t<T, 2> row_v(buf_, {1, n});
+      AmbgLoadRow<<<blocks, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(buf_, y, ylen_,
+                                                              n, 0.0);
+      AmbgLoadRow<<<blocks, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(
+          buf_ + n, x, xlen_, n,
+          2.0 * M_PI * static_cast<double>(cut_val) / fs);
+      fft_->Forward(buf_v, buf_v, stream_);
+      AmbgDopplerMul<<<blocks, AMBGFUN_BLOCK_SIZE, 0, stream_>>>(buf_, n);
+      fft_row_->Forward(row_v, row_v, stream_);
+      AmbgMag<<<dim3(1, blocks), AMBGFUN_BLOCK_SIZE, 0, stream_>>>(
+          amf, buf_, n, (n + 1) / 2, ex, ey, 1.0 / static_cast<double>(n));
+    }
   }
-  __device__ inline void operator()(index_t idx)
+
+  template <typename OutType, typename XType, typename YType>
+  void ExecHost(tensor_t<OutType, 2> &amf, const XType &x, const YType &y,
+                double fs, float cut_val)
   {
+    double sx = 0.0, sy = 0.0;
+    for (index_t i = 0; i < xlen_; i++) {
+      sx += static_cast<double>(cuda::std::norm(static_cast<T>(x(i))));
+    }
+    for (index_t i = 0; i < ylen_ && !auto_; i++) {
+      sy += static_cast<double>(cuda::std::norm(static_cast<T>(y(i))));
+    }
+
+    const float ex = static_cast<float>(sx);
+    const float ey = auto_ ? ex : static_cast<float>(sy);
+    const index_t n = n_;
+    const int threads = exec_.GetNumThreads();
+    T *buf = buf_;
+
+    if (cut_ == AMGBFUN_CUT_TYPE_2D) {
+      const index_t rows = len_seq_ - 1;
+      const double scale = AmbgScale(&ex, &ey, 1.0);
+      matxHostParallelFor(rows, threads, [&](int, index_t start, index_t end) {
+        std::vector<T> work(static_cast<size_t>(hfft_->WorkSize()));
+        for (index_t r = start; r < end; r++) {
+          T *row = buf + r * n;
+          for (index_t c = 0; c < n; c++) {
+            row[c] = Ambg2DInput<T>(x, y, xlen_, ylen_, r, c);
+          }
+          hfft_->Forward(row, work.data());
+          for (index_t j = 0; j < n; j++) {
+            amf(r, j) = static_cast<OutType>(
+                AmbgMagnitude(row, j, n, (n + 1) / 2, scale));
+          }
+        }
+      });
+      return;
+    }
+
+    std::vector<T> work(static_cast<size_t>(hfft_->WorkSize()));
+    double scale;
+    index_t shift;
+    if (cut_ == AMGBFUN_CUT_TYPE_DELAY) {
+      for (index_t i = 0; i < n; i++) {
+        buf[i] = AmbgInput<T>(x, i, xlen_);
+      }
+      hfft_->Forward(buf, work.data());
+      for (index_t k = 0; k < n; k++) {
+        buf[k] = AmbgDelayRotate(buf[k], k, n, fs, static_cast<double>(cut_val));
+      }
+      hfft_->Forward(buf, work.data());
+      for (index_t m = 0; m < n; m++) {
+        buf[m] = HostConj(AmbgInput<T>(y, m, ylen_) * buf[m]);
+      }
+
+      scale = 1.0 / static_cast<double>(n);
+      shift = n / 2;
+    }
+    else {
+      using R = value_type_t<T>;
+      const double omega = 2.0 * M_PI * static_cast<double>(cut_val) / fs;
+      for (index_t i = 0; i < n; i++) {
+        const double ph = omega * static_cast<double>(i);
+        buf[i] = AmbgInput<T>(y, i, ylen_);
+        buf[n + i] = AmbgInput<T>(x, i, xlen_) *
+                     T{static_cast<R>(cos(ph)), static_cast<R>(sin(ph))};
+      }
+      hfft_->Exec(buf, 2, n, false, exec_);
+      for (index_t k = 0; k < n; k++) {
+        buf[k] = HostConj(buf[k] * HostConj(buf[n + k]));
+      }
+
+      scale = 1.0 / static_cast<double>(n);
+      shift = (n + 1) / 2;
+    }
 
-    out_(idx) = exp(cuda::std::complex<float>{
-                    0, static_cast<float>(2.0 * M_PI * idx / fs_ * cut_)}) *
-                x_(idx);
+    hfft_->Forward(buf, work.data());
+    scale = AmbgScale(&ex, &ey, scale);
+    for (index_t j = 0; j < n; j++) {
+      amf(0, j) = static_cast<OutType>(AmbgMagnitude(buf, j, n, shift, scale));
+    }
   }
 
-  __host__ __device__ inline index_t Size(uint32_t i) const
+  bool host_;
+  bool auto_ = false;
+  cudaStream_t stream_;
+  matxHostExecutor_t exec_;
+  AMBGFunCutType_t cut_;
+  index_t xlen_;
+  index_t ylen_;
+  index_t len_seq_;
+  index_t nfreq_;
+  index_t n_;        // FFT size of the cut
+  index_t buf_size_; // Elements in the FFT workspace
+  T *buf_ = nullptr;
+  float *energy_ = nullptr;
+  matxFFTPlan1D_t<T, T> *fft_ = nullptr;
+  matxFFTPlan1D_t<T, T> *fft_row_ = nullptr;
+  std::vector<T> hbuf_;
+  matxHostFFTPlan1D_t<T> *hfft_ = nullptr;
+};
+
+/**
+ * Parameters needed to cache an ambiguity function plan
+ */
+struct AmbgFunParams_t {
+  index_t xlen;
+  index_t ylen;
+  AMBGFunCutType_t cut;
+  MatXDataType_t dtype;
+  cudaStream_t stream;
+};
+
+struct AmbgFunParamsKeyHash {
+  std::size_t operator()(const AmbgFunParams_t &k) const noexcept
   {
-    return out_.Size(i);
+    return std::hash<index_t>()(k.xlen) + std::hash<index_t>()(k.ylen) +
+           std::hash<index_t>()(k.cut) + std::hash<index_t>()((size_t)k.stream);
   }
-  static inline constexpr __host__ __device__ int32_t Rank()
+};
+
+struct AmbgFunParamsKeyEq {
+  bool operator()(const AmbgFunParams_t &l,
+                  const AmbgFunParams_t &t) const noexcept
   {
-    return O::Rank();
+    return l.xlen == t.xlen && l.ylen == t.ylen && l.cut == t.cut &&
+           l.dtype == t.dtype && l.stream == t.stream;
   }
 };
 
+// Static cache of ambiguity function plans
+static matxCache_t<AmbgFunParams_t, AmbgFunParamsKeyHash, AmbgFunParamsKeyEq>
+    ambgfun_cache;
+
 template <typename T1, typename T2, int RANK>
 void InternalAmbgFun(tensor_t<T2, 2> &amf, tensor_t<T1, RANK> x,
-                     std::optional<tensor_t<T1, RANK>> y,
-                     [[maybe_unused]] double fs, AMBGFunCutType_t cut,
-                     [[maybe_unused]] float cut_val, cudaStream_t stream = 0)
+                     std::optional<tensor_t<T1, RANK>> y, double fs,
+                     AMBGFunCutType_t cut, float cut_val,
+                     cudaStream_t stream = 0)
 {
-  T1 *x_normdiv, *y_normdiv;
-  float *x_norm, *y_norm;
-
-  MATX_ASSERT(is_cuda_complex_v<T1>, matxInvalidType);
-  tensor_t<T1, RANK> ry(x);
-
-  matxAlloc(reinterpret_cast<void **>(&x_normdiv),
-            sizeof(T1) * x.Size(RANK - 1), MATX_ASYNC_DEVICE_MEMORY, stream);
-  matxAlloc(reinterpret_cast<void **>(&x_norm), sizeof(*x_norm),
-            MATX_ASYNC_DEVICE_MEMORY, stream);
-
-  auto x_normdiv_v = tensor_t<T1, 1>(x_normdiv, x.Shape());
-  auto x_norm_v = tensor_t<float, 0>(x_norm);
+  static_assert(RANK == 1, "Ambiguity function inputs must be rank 1");
 
-  reduce(x_norm_v, norm(x), reduceOpSum<float>(), 0);
-  (x_norm_v = sqrt(x_norm_v)).run(stream);
-  (x_normdiv_v = x / x_norm_v).run(stream);
+  deferred_flush(stream);
 
-  tensor_t<T1, RANK> y_normdiv_v(x_normdiv_v.Data(), x_normdiv_v.Shape());
+  AmbgFunParams_t params;
+  params.xlen = x.Size(0);
+  params.ylen = y ? y.value().Size(0) : x.Size(0);
+  params.cut = cut;
+  params.dtype = TypeToInt<T1>();
+  params.stream = stream;
 
-  if (y) {
-    ry.Shallow(y.value());
-    matxAlloc(reinterpret_cast<void **>(&y_normdiv),
-              sizeof(T1) * ry.Size(RANK - 1), MATX_ASYNC_DEVICE_MEMORY, stream);
-    matxAlloc(reinterpret_cast<void **>(&y_norm), sizeof(*y_norm),
-              MATX_ASYNC_DEVICE_MEMORY, stream);
-    y_normdiv_v.Shallow(tensor_t<T1, RANK>(y_normdiv, ry.Shape()));
-    auto y_norm_v = tensor_t<float, 0>(y_norm);
-
-    reduce(y_norm_v, norm(ry), reduceOpSum<float>(), 0);
-    (y_normdiv_v = ry / y_norm_v).run(stream);
-  }
-
-  index_t len_seq = x_normdiv_v.Size(RANK - 1) + y_normdiv_v.Size(RANK - 1);
-  uint32_t nfreq = static_cast<uint32_t>(
-      powf(2.0, static_cast<float>(std::ceil(std::log2(len_seq - 1)))));
-  index_t xlen = x_normdiv_v.Size(RANK - 1);
-
-  if (cut == AMGBFUN_CUT_TYPE_2D) {
-    T1 *new_ynorm;
-    matxAlloc(reinterpret_cast<void **>(&new_ynorm),
-              sizeof(T1) * (len_seq - 1) * xlen, MATX_ASYNC_DEVICE_MEMORY,
-              stream);
-    auto new_ynorm_v = tensor_t<T1, 2>(new_ynorm, {len_seq - 1, xlen});
-
-    newYNorm(new_ynorm_v, x_normdiv_v, y_normdiv_v).run(stream);
-
-    T1 *fft_data, *amf_tmp;
-    matxAlloc(reinterpret_cast<void **>(&fft_data),
-              sizeof(*fft_data) * nfreq * (len_seq - 1),
-              MATX_ASYNC_DEVICE_MEMORY, stream);
-    auto fullfft = tensor_t<T1, 2>(fft_data, {{(len_seq - 1), nfreq}});
-    auto partfft = fullfft.Slice({0, 0}, {(len_seq - 1), xlen});
-
-    (fullfft = 0).run(stream);
-    copy(partfft, new_ynorm_v, stream);
-
-    ifft(fullfft, fullfft, stream);
-
-    // We need to temporarily allocate a complex output version of AMF since we
-    // have no way to convert complex to real in an operator currently
-    matxAlloc(reinterpret_cast<void **>(&amf_tmp),
-              sizeof(*amf_tmp) * nfreq * (len_seq - 1),
-              MATX_ASYNC_DEVICE_MEMORY, stream);
-    auto amf_tmp_v = tensor_t<T1, 2>(amf_tmp, {{(len_seq - 1), nfreq}});
-    (amf_tmp_v = (float)nfreq * abs(fftshift1D(fullfft))).run(stream);
-    copy(amf, amf_tmp_v.RealView(), stream);
-
-    matxFree(fft_data);
-    matxFree(amf_tmp);
-  }
-  else if (cut == AMGBFUN_CUT_TYPE_DELAY) {
-    T1 *fft_data_x, *fft_data_y, *amf_tmp;
-    matxAlloc(reinterpret_cast<void **>(&fft_data_x),
-              sizeof(*fft_data_x) * nfreq, MATX_ASYNC_DEVICE_MEMORY, stream);
-    matxAlloc(reinterpret_cast<void **>(&fft_data_y),
-              sizeof(*fft_data_y) * nfreq, MATX_ASYNC_DEVICE_MEMORY, stream);
-    auto fullfft_x = tensor_t<T1, 1>(fft_data_x, {nfreq});
-    auto partfft_x = fullfft_x.Slice({0}, {xlen});
-    (fullfft_x = 0).run(stream);
-    copy(partfft_x, x_normdiv_v, stream);
-
-    fft(fullfft_x, fullfft_x, stream);
-    AmbgFftXOp(fullfft_x, fullfft_x, fs, cut_val, (float)nfreq).run(stream);
-    ifft(fullfft_x, fullfft_x, stream);
-
-    auto fullfft_y = tensor_t<T1, 1>(fft_data_y, {nfreq});
-    (fullfft_y = 0).run(stream);
-
-    auto partfft_y = fullfft_y.Slice({0}, {xlen});
-    copy(partfft_y, y_normdiv_v, stream);
-    (fullfft_y = fullfft_y * conj(fullfft_x)).run(stream);
-    ifft(fullfft_y, fullfft_y, stream);
-
-    // This allocation should not be necessary, but we're getting compiler
-    // errors when cloning/slicing
-    matxAlloc(reinterpret_cast<void **>(&amf_tmp),
-              sizeof(*amf_tmp) * fullfft_y.Size(0), MATX_ASYNC_DEVICE_MEMORY,
-              stream);
-    auto amf_tmp_v = tensor_t<T1, 1>(amf_tmp, {fullfft_y.Size(0)});
-
-    (amf_tmp_v = (float)nfreq * abs(ifftshift1D(fullfft_y))).run(stream);
-
-    auto amfv = tensor_t<T1, 2>(amf_tmp_v.Data(), {1, amf.Size(1)});
-    copy(amf, amfv.RealView(), stream);
-
-    matxFree(amf_tmp);
-    matxFree(fft_data_x);
-    matxFree(fft_data_y);
-  }
-  else if (cut == AMGBFUN_CUT_TYPE_DOPPLER) {
-    T1 *fft_data_x, *fft_data_y, *amf_tmp;
-    matxAlloc(reinterpret_cast<void **>(&fft_data_x),
-              sizeof(*fft_data_x) * (len_seq - 1), MATX_ASYNC_DEVICE_MEMORY,
-              stream);
-    matxAlloc(reinterpret_cast<void **>(&fft_data_y),
-              sizeof(*fft_data_y) * (len_seq - 1), MATX_ASYNC_DEVICE_MEMORY,
-              stream);
-    auto fullfft_y = tensor_t<T1, 1>(fft_data_y, {len_seq - 1});
-    auto partfft_y = fullfft_y.Slice({0}, {y_normdiv_v.Size(0)});
-
-    (fullfft_y = 0).run(stream);
-    copy(partfft_y, y_normdiv_v, stream);
-    fft(fullfft_y, fullfft_y, stream);
-
-    auto fullfft_x = tensor_t<T1, 1>(fft_data_x, {len_seq - 1});
-    (fullfft_x = 0).run(stream);
-
-    auto partfft_x = tensor_t<T1, 1>(fft_data_x, {x_normdiv_v.Size(0)});
-
-    AmbgDoppX(partfft_x, x_normdiv_v, fs, cut_val).run(stream);
-    fft(fullfft_x, fullfft_x, stream);
-
-    // This allocation should not be necessary, but we're getting compiler
-    // errors when cloning/slicing
-    matxAlloc(reinterpret_cast<void **>(&amf_tmp),
-              sizeof(*amf_tmp) * fullfft_x.Size(0), MATX_ASYNC_DEVICE_MEMORY,
-              stream);
-    auto amf_tmp_v = tensor_t<T1, 1>(amf_tmp, {fullfft_x.Size(0)});
-    (fullfft_y = fullfft_y * conj(fullfft_x)).run(stream);
-    ifft(fullfft_y, fullfft_y, stream);
-
-    (amf_tmp_v = abs(fftshift1D(fullfft_y))).run(stream);
-
-    auto amfv = tensor_t<T1, 2>(amf_tmp_v.Data(), {1, amf.Size(1)});
-    copy(amf, amfv.RealView(), stream);
-    matxFree(amf_tmp);
-    matxFree(fft_data_x);
-    matxFree(fft_data_y);
-  }
-
-  matxFree(x_normdiv);
-  matxFree(x_norm);
+  matxAmbgFunPlan_t<T1> *plan;
+  auto ret = ambgfun_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    plan = new matxAmbgFunPlan_t<T1>{params.xlen, params.ylen, cut, stream};
+    ambgfun_cache.Insert(params, static_cast<void *>(plan));
+  }
+  else {
+    plan = static_cast<matxAmbgFunPlan_t<T1> *>(ret.value());
+  }
 
   if (y) {
-    matxFree(y_normdiv);
-    matxFree(y_norm);
+    plan->Exec(amf, x, y.value(), fs, cut_val);
+  }
+  else {
+    plan->Exec(amf, x, fs, cut_val);
   }
 }
 
@@ -399,5 +564,1005 @@ inline void ambgfun(tensor_t<T2, 2> &amf, tensor_t<T1, RANK> x,
   std::optional<tensor_t<T1, RANK>> nil = std::nullopt;
   InternalAmbgFun(amf, x, nil, fs, cut, cut_val, stream);
 }
+
+/**
+ * Cross-ambiguity function on the host
+ *
+ * Host version of ambgfun(). To compute many ambiguity functions of the same
+ * size, create a matxAmbgFunPlan_t once and execute it repeatedly.
+ *
+ * @param amf
+ *   2D output matrix where rows are the Doppler (Hz) shift and columns are the
+ * delay in seconds.
+ * @param x
+ *   First input signal
+ * @param y
+ *   Second input signal
+ * @param fs
+ *   Sampling frequency
+ * @param cut
+ *   Type of cut
+ * @param cut_val
+ *   Value to perform the cut at
+ * @param exec
+ *   Host executor
+ *
+ */
+template <typename T1, typename T2, int RANK>
+inline void ambgfun(tensor_t<T2, 2> &amf, tensor_t<T1, RANK> x,
+                    tensor_t<T1, RANK> y, double fs, AMBGFunCutType_t cut,
+                    float cut_val, const matxHostExecutor_t &exec)
+{
+  static_assert(RANK == 1, "Ambiguity function inputs must be rank 1");
+  matxAmbgFunPlan_t<T1> plan{x.Size(0), y.Size(0), cut, exec};
+  plan.Exec(amf, x, y, fs, cut_val);
+}
+
+/**
+ * Ambiguity function on the host
+ *
+ * Host version of ambgfun()
+ *
+ * @param amf
+ *   2D output matrix where rows are the Doppler (Hz) shift and columns are the
+ * delay in seconds.
+ * @param x
+ *   Input signal
+ * @param fs
+ *   Sampling frequency
+ * @param cut
+ *   Type of cut
+ * @param cut_val
+ *   Value to perform the cut at
+ * @param exec
+ *   Host executor
+ *
+ */
+template <typename T1, typename T2, int RANK>
+inline void ambgfun(tensor_t<T2, 2> &amf, tensor_t<T1, RANK> x, double fs,
+                    AMBGFunCutType_t cut, float cut_val,
+                    const matxHostExecutor_t &exec)
+{
+  static_assert(RANK == 1, "Ambiguity function inputs must be rank 1");
+  matxAmbgFunPlan_t<T1> plan{x.Size(0), x.Size(0), cut, exec};
+  plan.Exec(amf, x, fs, cut_val);
+}
+
+template <typename DetType, typename BaType, typename T, int RANK>
+void InternalCfar(tensor_t<DetType, RANK> &dets, tensor_t<BaType, RANK> &ba,
+                  bool write_ba, const tensor_t<T, RANK> &xpow,
+                  const cfarWindow_t &w, cudaStream_t stream)
+{
+  static_assert(RANK == 2 || RANK == 3, "CFAR input must be rank 2 or 3");
+
+  deferred_flush(stream);
+
+  const index_t rows = xpow.Size(RANK - 2);
+  const index_t cols = xpow.Size(RANK - 1);
+  const index_t batches = (RANK == 3) ? xpow.Size(0) : 1;
+  for (int i = 0; i < RANK; i++) {
+    MATX_ASSERT(dets.Size(i) == xpow.Size(i), matxInvalidSize);
+    MATX_ASSERT(!write_ba || ba.Size(i) == xpow.Size(i), matxInvalidSize);
+  }
+  MATX_ASSERT(rows <= 65535 && batches <= 65535, matxInvalidSize);
+
+  double *sat;
+  matxAlloc(reinterpret_cast<void **>(&sat),
+            sizeof(*sat) * batches * (rows + 1) * (cols + 1),
+            MATX_ASYNC_DEVICE_MEMORY, stream);
+
+  dim3 col_grid(static_cast<unsigned int>((cols + CFAR_BLOCK_SIZE) /
+                                          CFAR_BLOCK_SIZE),
+                static_cast<unsigned int>(batches));
+  CfarSatCols<<<col_grid, CFAR_BLOCK_SIZE, 0, stream>>>(sat, xpow, rows, cols);
+
+  dim3 row_grid(static_cast<unsigned int>(
+                    (rows + CFAR_ROWS_PER_BLOCK - 1) / CFAR_ROWS_PER_BLOCK),
+                static_cast<unsigned int>(batches));
+  CfarSatRows<<<row_grid, CFAR_BLOCK_SIZE, 0, stream>>>(sat, rows, cols);
+
+  dim3 det_grid(static_cast<unsigned int>((cols + CFAR_BLOCK_SIZE - 1) /
+                                          CFAR_BLOCK_SIZE),
+                static_cast<unsigned int>(rows),
+                static_cast<unsigned int>(batches));
+  CfarDetect<<<det_grid, CFAR_BLOCK_SIZE, 0, stream>>>(dets, ba, xpow, sat,
+                                                      rows, cols, w, write_ba);
+
+  matxFree(sat);
+}
+
+template <typename DetType, typename BaType, typename T, int RANK>
+void InternalCfar(tensor_t<DetType, RANK> &dets, tensor_t<BaType, RANK> &ba,
+                  bool write_ba, const tensor_t<T, RANK> &xpow,
+                  const cfarWindow_t &w, const matxHostExecutor_t &exec)
+{
+  static_assert(RANK == 2 || RANK == 3, "CFAR input must be rank 2 or 3");
+
+  const index_t rows = xpow.Size(RANK - 2);
+  const index_t cols = xpow.Size(RANK - 1);
+  const index_t batches = (RANK == 3) ? xpow.Size(0) : 1;
+  for (int i = 0; i < RANK; i++) {
+    MATX_ASSERT(dets.Size(i) == xpow.Size(i), matxInvalidSize);
+    MATX_ASSERT(!write_ba || ba.Size(i) == xpow.Size(i), matxInvalidSize);
+  }
+
+  const index_t plane = (rows + 1) * (cols + 1);
+  std::vector<double> sat(batches * plane);
+  const int threads = exec.GetNumThreads();
+
+  matxHostParallelFor(batches, threads, [&](int, index_t start, index_t end) {
+    for (index_t b = start; b < end; b++) {
+      double *s = sat.data() + b * plane;
+      for (index_t j = 0; j <= cols; j++) {
+        s[j] = 0.0;
+      }
+
+      for (index_t r = 0; r < rows; r++) {
+        double run = 0.0;
+        s[(r + 1) * (cols + 1)] = 0.0;
+        for (index_t c = 0; c < cols; c++) {
+          run += static_cast<double>(CfarElem(xpow, b, r, c));
+          s[(r + 1) * (cols + 1) + c + 1] = s[r * (cols + 1) + c + 1] + run;
+        }
+      }
+    }
+  });
+
+  matxHostParallelFor(batches * rows, threads,
+                      [&](int, index_t start, index_t end) {
+                        for (index_t i = start; i < end; i++) {
+                          const index_t b = i / rows;
+                          const index_t r = i % rows;
+                          for (index_t c = 0; c < cols; c++) {
+                            double alpha;
+                            const double bg =
+                                CfarCell(xpow, sat.data() + b * plane, b, rows,
+                                         cols, r, c, w, alpha);
+                            const double v =
+                                static_cast<double>(CfarElem(xpow, b, r, c));
+
+                            CfarElem(dets, b, r, c) =
+                                static_cast<DetType>((v > alpha * bg) ? 1 : 0);
+                            if (write_ba) {
+                              CfarElem(ba, b, r, c) = static_cast<BaType>(bg);
+                            }
+                          }
+                        }
+                      });
+}
+
+/**
+ * Constant false alarm rate (CFAR) detector
+ *
+ * Estimates the background power around each cell under test from a window of
+ * reference cells, excluding a block of guard cells around the cell, and
+ * declares a detection where the cell exceeds the background times a threshold
+ * multiplier derived from the probability of false alarm. The window is given
+ * as half-widths: guard cells on each side of the cell under test, and
+ * reference cells beyond the guard cells, for the row and column axes.
+ *
+ * A summed-area table of the input is built once per matrix, so the CA, GO and
+ * SO detectors evaluate every cell in constant time regardless of the window
+ * size. Windows are clipped at the edges, and each cell is normalized by the
+ * number of reference cells it actually uses. GO and SO compare the leading and
+ * trailing halves of the window along the column (fast) axis. OS uses the
+ * reference cell at rank ceil(os_rank * n), and is O(n^2) in the number of
+ * reference cells.
+ *
+ * @tparam DetType
+ *   Detection output type
+ * @tparam BaType
+ *   Background estimate type
+ * @tparam T
+ *   Input type
+ * @tparam RANK
+ *   Rank of tensors. Rank 3 inputs are batched over the first dimension
+ *
+ * @param dets
+ *   Detection output, 1 where a target is declared and 0 elsewhere
+ * @param ba
+ *   Background estimate output
+ * @param xpow
+ *   Input power
+ * @param guard
+ *   Guard cell half-widths along rows and columns
+ * @param ref
+ *   Reference cells beyond the guard cells along rows and columns
+ * @param pfa
+ *   Probability of false alarm
+ * @param type
+ *   Detector type
+ * @param stream
+ *   CUDA stream
+ * @param os_rank
+ *   Fraction of the reference cells giving the order statistic for OS
+ *
+ */
+template <typename DetType, typename BaType, typename T, int RANK>
+inline void cfar(tensor_t<DetType, RANK> &dets, tensor_t<BaType, RANK> &ba,
+                 const tensor_t<T, RANK> &xpow, std::array<index_t, 2> guard,
+                 std::array<index_t, 2> ref, double pfa,
+                 cfarType_t type = CFAR_TYPE_CA, cudaStream_t stream = 0,
+                 double os_rank = 0.75)
+{
+  cfarWindow_t w{guard[0], guard[1], ref[0], ref[1], type, pfa, os_rank};
+  InternalCfar(dets, ba, true, xpow, w, stream);
+}
+
+/**
+ * Constant false alarm rate (CFAR) detector
+ *
+ * Same as the version above, without writing out the background estimate.
+ *
+ * @tparam DetType
+ *   Detection output type
+ * @tparam T
+ *   Input type
+ * @tparam RANK
+ *   Rank of tensors. Rank 3 inputs are batched over the first dimension
+ *
+ * @param dets
+ *   Detection output, 1 where a target is declared and 0 elsewhere
+ * @param xpow
+ *   Input power
+ * @param guard
+ *   Guard cell half-widths along rows and columns
+ * @param ref
+ *   Reference cells beyond the guard cells along rows and columns
+ * @param pfa
+ *   Probability of false alarm
+ * @param type
+ *   Detector type
+ * @param stream
+ *   CUDA stream
+ * @param os_rank
+ *   Fraction of the reference cells giving the order statistic for OS
+ *
+ */
+template <typename DetType, typename T, int RANK>
+inline void cfar(tensor_t<DetType, RANK> &dets, const tensor_t<T, RANK> &xpow,
+                 std::array<index_t, 2> guard, std::array<index_t, 2> ref,
+                 double pfa, cfarType_t type = CFAR_TYPE_CA,
+                 cudaStream_t stream = 0, double os_rank = 0.75)
+{
+  cfarWindow_t w{guard[0], guard[1], ref[0], ref[1], type, pfa, os_rank};
+  tensor_t<T, RANK> nil(xpow);
+  InternalCfar(dets, nil, false, xpow, w, stream);
+}
+
+/**
+ * Constant false alarm rate (CFAR) detector on the host
+ *
+ * Host version of cfar(). Tensors must be host-accessible, and matrices and
+ * rows are spread across the executor's threads.
+ *
+ * @tparam DetType
+ *   Detection output type
+ * @tparam BaType
+ *   Background estimate type
+ * @tparam T
+ *   Input type
+ * @tparam RANK
+ *   Rank of tensors. Rank 3 inputs are batched over the first dimension
+ *
+ * @param dets
+ *   Detection output, 1 where a target is declared and 0 elsewhere
+ * @param ba
+ *   Background estimate output
+ * @param xpow
+ *   Input power
+ * @param guard
+ *   Guard cell half-widths along rows and columns
+ * @param ref
+ *   Reference cells beyond the guard cells along rows and columns
+ * @param pfa
+ *   Probability of false alarm
+ * @param type
+ *   Detector type
+ * @param exec
+ *   Host executor
+ * @param os_rank
+ *   Fraction of the reference cells giving the order statistic for OS
+ *
+ */
+template <typename DetType, typename BaType, typename T, int RANK>
+inline void cfar(tensor_t<DetType, RANK> &dets, tensor_t<BaType, RANK> &ba,
+                 const tensor_t<T, RANK> &xpow, std::array<index_t, 2> guard,
+                 std::array<index_t, 2> ref, double pfa, cfarType_t type,
+                 const matxHostExecutor_t &exec, double os_rank = 0.75)
+{
+  cfarWindow_t w{guard[0], guard[1], ref[0], ref[1], type, pfa, os_rank};
+  InternalCfar(dets, ba, true, xpow, w, exec);
+}
+
+/**
+ * Constant false alarm rate (CFAR) detector on the host
+ *
+ * Host version of cfar() without the background estimate output.
+ *
+ * @tparam DetType
+ *   Detection output type
+ * @tparam T
+ *   Input type
+ * @tparam RANK
+ *   Rank of tensors. Rank 3 inputs are batched over the first dimension
+ *
+ * @param dets
+ *   Detection output, 1 where a target is declared and 0 elsewhere
+ * @param xpow
+ *   Input power
+ * @param guard
+ *   Guard cell half-widths along rows and columns
+ * @param ref
+ *   Reference cells beyond the guard cells along rows and columns
+ * @param pfa
+ *   Probability of false alarm
+ * @param type
+ *   Detector type
+ * @param exec
+ *   Host executor
+ * @param os_rank
+ *   Fraction of the reference cells giving the order statistic for OS
+ *
+ */
+template <typename DetType, typename T, int RANK>
+inline void cfar(tensor_t<DetType, RANK> &dets, const tensor_t<T, RANK> &xpow,
+                 std::array<index_t, 2> guard, std::array<index_t, 2> ref,
+                 double pfa, cfarType_t type, const matxHostExecutor_t &exec,
+                 double os_rank = 0.75)
+{
+  cfarWindow_t w{guard[0], guard[1], ref[0], ref[1], type, pfa, os_rank};
+  tensor_t<T, RANK> nil(xpow);
+  InternalCfar(dets, nil, false, xpow, w, exec);
+}
+
+/**
+ * Streaming pulse compression with overlap-save
+ *
+ * A stateful matched filter for continuous ingest. The filter spectrum is
+ * computed once when the plan is created, and each call to Exec() filters an
+ * arbitrarily long chunk of every channel in overlap-save blocks of a fixed FFT
+ * size. The last taps - 1 input samples of each channel are carried to the
+ * next call, so a stream split into chunks of any size gives the same output
+ * as the whole stream filtered at once.
+ *
+ * The filter is the conjugated, time-reversed waveform normalized to unit
+ * energy, so sample n of the output is
+ *
+ *   y[n] = sum_k conj(w[k]) * x[n - (taps - 1) + k] / ||w||
+ *
+ * and an echo starting at input sample n peaks at output sample
+ * n + taps - 1. Samples before the first call are treated as zero.
+ *
+ * The plan owns its FFT buffer, the filter spectrum and the carried state, so
+ * Exec() does not allocate. Plans created with a stream run on the device
+ * using the cached cuFFT plans, and plans created with a host executor run on
+ * the host FFT backend. All memory passed to a host plan must be
+ * host-accessible.
+ *
+ * @tparam T
+ *   Complex data type
+ */
+template <typename T> class matxPulseCompressionPlan_t {
+public:
+  /**
+   * Construct a device pulse compression plan
+   *
+   * @param waveform
+   *   Transmitted waveform. Read on the host when the plan is created, so it
+   * must be host-accessible and complete
+   * @param channels
+   *   Number of independent channels
+   * @param max_len
+   *   Largest number of samples per channel expected in one call. Longer
+   * calls are split into several passes
+   * @param nfft
+   *   FFT size of each block, at least the waveform length. 0 picks the
+   * power of two with the lowest cost per output sample
+   * @param stream
+   *   CUDA stream used for all work
+   */
+  matxPulseCompressionPlan_t(const tensor_t<T, 1> &waveform, index_t channels,
+                             index_t max_len, index_t nfft = 0,
+                             cudaStream_t stream = 0)
+      : host_(false), stream_(stream)
+  {
+    Init(waveform, channels, max_len, nfft);
+  }
+
+  /**
+   * Construct a host pulse compression plan
+   *
+   * @param waveform
+   *   Transmitted waveform
+   * @param channels
+   *   Number of independent channels
+   * @param max_len
+   *   Largest number of samples per channel expected in one call
+   * @param nfft
+   *   FFT size of each block, or 0 to pick one
+   * @param exec
+   *   Host executor
+   */
+  matxPulseCompressionPlan_t(const tensor_t<T, 1> &waveform, index_t channels,
+                             index_t max_len, index_t nfft,
+                             const matxHostExecutor_t &exec)
+      : host_(true), stream_(0), exec_(exec)
+  {
+    Init(waveform, channels, max_len, nfft);
+  }
+
+  // The plan owns its device buffers, so a copy would free them twice
+  matxPulseCompressionPlan_t(const matxPulseCompressionPlan_t &) = delete;
+  matxPulseCompressionPlan_t &
+  operator=(const matxPulseCompressionPlan_t &) = delete;
+
+  /**
+   * Pulse compression plan destructor
+   *
+   * Frees the device buffers. Host buffers are released with the plan.
+   */
+  ~matxPulseCompressionPlan_t()
+  {
+    if (!host_) {
+      matxFree(buf_);
+      matxFree(spec_);
+      matxFree(hist_);
+      matxFree(hist_next_);
+    }
+  }
+
+  /**
+   * Pick the power of two FFT size with the lowest cost per valid output
+   * sample, without going past the size that covers a whole call in one
+   * block. The cost is the transform work plus a fixed overhead per block, so
+   * short filters don't end up with tiny blocks.
+   */
+  static index_t TuneFFTSize(index_t taps, index_t max_len)
+  {
+    const index_t limit = taps + max_len - 1;
+    index_t best = 0;
+    double best_cost = 0.0;
+    for (index_t n = 1;; n *= 2) {
+      if (n >= taps) {
+        const double dn = static_cast<double>(n);
+        const double cost = (dn * (std::log2(dn) + 1.0) + 256.0) /
+                            static_cast<double>(n - taps + 1);
+        if (best == 0 || cost < best_cost) {
+          best = n;
+          best_cost = cost;
+        }
+      }
+
+      if (n >= limit) {
+        break;
+      }
+    }
+
+    return best;
+  }
+
+  /**
+   * Clear the carried input, as if the stream were starting again
+   */
+  void Reset()
+  {
+    const index_t hl = channels_ * (taps_ - 1);
+    if (host_) {
+      std::fill(hist_, hist_ + hl, T(0));
+    }
+    else if (hl > 0) {
+      cudaMemsetAsync(hist_, 0, hl * sizeof(T), stream_);
+    }
+  }
+
+  index_t FFTSize() const { return nfft_; }
+  index_t Taps() const { return taps_; }
+
+  /**
+   * Filter the next chunk of every channel
+   *
+   * @tparam RANK
+   *   Rank of the chunk. Rank 1 for a single channel, or rank 2 as channels
+   * by samples
+   *
+   * @param out
+   *   Output chunk. May be the same tensor as the input
+   * @param in
+   *   Input chunk
+   */
+  template <int RANK>
+  void Exec(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in)
+  {
+    static_assert(RANK == 1 || RANK == 2,
+                  "Pulse compression input must be rank 1 or 2");
+    MATX_ASSERT(out.Size(RANK - 1) == in.Size(RANK - 1), matxInvalidSize);
+    if constexpr (RANK == 1) {
+      MATX_ASSERT(channels_ == 1, matxInvalidSize);
+    }
+    else {
+      MATX_ASSERT(in.Size(0) == channels_ && out.Size(0) == channels_,
+                  matxInvalidSize);
+    }
+
+    const index_t len = in.Size(RANK - 1);
+    const index_t pass = max_blocks_ * (nfft_ - taps_ + 1);
+    for (index_t start = 0; start < len; start += pass) {
+      index_t firsts[RANK] = {0};
+      index_t ends[RANK];
+      std::fill_n(ends, RANK, matxEnd);
+      firsts[RANK - 1] = start;
+      ends[RANK - 1] = std::min(len, start + pass);
+
+      auto in_pass = in.Slice(firsts, ends);
+      auto out_pass = out.Slice(firsts, ends);
+      if (host_) {
+        ExecHost(out_pass, in_pass);
+      }
+      else {
+        ExecDevice(out_pass, in_pass);
+      }
+    }
+  }
+
+private:
+  void Init(const tensor_t<T, 1> &waveform, index_t channels, index_t max_len,
+            index_t nfft)
+  {
+    static_assert(is_complex_v<T>, "Pulse compression data must be complex");
+
+    taps_ = waveform.Size(0);
+    channels_ = channels;
+    MATX_ASSERT(taps_ > 0 && channels_ > 0 && max_len > 0, matxInvalidSize);
+
+    nfft_ = nfft > 0 ? nfft : TuneFFTSize(taps_, max_len);
+    MATX_ASSERT(nfft_ >= taps_, matxInvalidSize);
+
+    const index_t valid = nfft_ - taps_ + 1;
+    max_blocks_ = (max_len + valid - 1) / valid;
+
+    // Matched filter spectrum, computed once on the host
+    using real_t = value_type_t<T>;
+    real_t energy = 0;
+    for (index_t k = 0; k < taps_; k++) {
+      energy += HostAbs(waveform(k)) * HostAbs(waveform(k));
+    }
+    MATX_ASSERT_STR(energy > real_t(0), matxInvalidSize,
+                    "Pulse compression waveform has no energy");
+
+    const real_t scale = real_t(1) / std::sqrt(energy);
+    std::vector<T> h(static_cast<size_t>(nfft_), T(0));
+    for (index_t m = 0; m < taps_; m++) {
+      h[m] = HostConj(static_cast<T>(waveform(taps_ - 1 - m))) * scale;
+    }
+
+    auto hplan = GetHostFFTPlan<T>(nfft_);
+    std::vector<T> work(static_cast<size_t>(hplan->WorkSize()));
+    hplan->Forward(h.data(), work.data());
+
+    const index_t rows = channels_ * max_blocks_;
+    const index_t hl = std::max<index_t>(channels_ * (taps_ - 1), 1);
+    if (host_) {
+      hbuf_.resize(static_cast<size_t>(rows * nfft_));
+      hspec_ = std::move(h);
+      hhist_.assign(static_cast<size_t>(hl), T(0));
+      hhist_next_.assign(static_cast<size_t>(hl), T(0));
+
+      buf_ = hbuf_.data();
+      spec_ = hspec_.data();
+      hist_ = hhist_.data();
+      hist_next_ = hhist_next_.data();
+    }
+    else {
+      matxAlloc((void **)&buf_, rows * nfft_ * sizeof(T), MATX_DEVICE_MEMORY);
+      matxAlloc((void **)&spec_, nfft_ * sizeof(T), MATX_DEVICE_MEMORY);
+      matxAlloc((void **)&hist_, hl * sizeof(T), MATX_DEVICE_MEMORY);
+      matxAlloc((void **)&hist_next_, hl * sizeof(T), MATX_DEVICE_MEMORY);
+
+      cudaMemcpy(spec_, h.data(), nfft_ * sizeof(T), cudaMemcpyHostToDevice);
+      cudaMemset(hist_, 0, hl * sizeof(T));
+    }
+  }
+
+  template <int RANK>
+  void ExecDevice(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in)
+  {
+    deferred_flush(stream_);
+
+    const index_t len = in.Size(RANK - 1);
+    const index_t valid = nfft_ - taps_ + 1;
+    const index_t blocks = (len + valid - 1) / valid;
+    const index_t rows = channels_ * blocks;
+
+    dim3 block(OS_BLOCK_SIZE);
+    dim3 load_grid(static_cast<unsigned int>(rows),
+                   static_cast<unsigned int>((nfft_ + OS_BLOCK_SIZE - 1) /
+                                             OS_BLOCK_SIZE));
+    OsLoad<<<load_grid, block, 0, stream_>>>(buf_, in, hist_, len, taps_,
+                                             nfft_, blocks);
+
+    // The carried samples are saved before any output is written, since the
+    // output may overwrite the input
+    const index_t hl = channels_ * (taps_ - 1);
+    if (hl > 0) {
+      OsSaveTail<<<static_cast<unsigned int>((hl + OS_BLOCK_SIZE - 1) /
+                                             OS_BLOCK_SIZE),
+                   block, 0, stream_>>>(hist_next_, in, hist_, len, taps_,
+                                        channels_);
+      std::swap(hist_, hist_next_);
+    }
+
+    tensor_t<T, 2> bv(buf_, {rows, nfft_});
+    tensor_t<T, 1> sv(spec_, {nfft_});
+    fft(bv, bv, stream_);
+    exec(bv = bv * sv.template Clone<2>({rows, matxKeepDim}), stream_);
+    ifft(bv, bv, stream_);
+
+    dim3 store_grid(static_cast<unsigned int>(rows),
+                    static_cast<unsigned int>((valid + OS_BLOCK_SIZE - 1) /
+                                              OS_BLOCK_SIZE));
+    OsStore<<<store_grid, block, 0, stream_>>>(out, buf_, len, taps_, nfft_,
+                                               blocks);
+  }
+
+  template <int RANK>
+  void ExecHost(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in)
+  {
+    const index_t len = in.Size(RANK - 1);
+    const index_t valid = nfft_ - taps_ + 1;
+    const index_t blocks = (len + valid - 1) / valid;
+    const index_t rows = channels_ * blocks;
+    const int threads = exec_.GetNumThreads();
+
+    // Every block is loaded and the carried samples saved before any output
+    // is written, since the output may overwrite the input
+    matxHostParallelFor(rows, threads, [&](int, index_t start, index_t end) {
+      for (index_t row = start; row < end; row++) {
+        const index_t ch = row / blocks;
+        const index_t g0 = (row % blocks) * valid - (taps_ - 1);
+        for (index_t k = 0; k < nfft_; k++) {
+          buf_[row * nfft_ + k] = OsInput(in, hist_, ch, g0 + k, len, taps_);
+        }
+      }
+    });
+
+    const index_t hl = channels_ * (taps_ - 1);
+    for (index_t idx = 0; idx < hl; idx++) {
+      const index_t ch = idx / (taps_ - 1);
+      const index_t j = idx % (taps_ - 1);
+      hist_next_[idx] =
+          OsInput(in, hist_, ch, len - (taps_ - 1) + j, len, taps_);
+    }
+    std::swap(hist_, hist_next_);
+
+    auto hplan = GetHostFFTPlan<T>(nfft_);
+    matxHostParallelFor(rows, threads, [&](int, index_t start, index_t end) {
+      std::vector<T> work(static_cast<size_t>(hplan->WorkSize()));
+      for (index_t row = start; row < end; row++) {
+        T *x = buf_ + row * nfft_;
+        hplan->Forward(x, work.data());
+        for (index_t k = 0; k < nfft_; k++) {
+          x[k] = x[k] * spec_[k];
+        }
+        hplan->Inverse(x, work.data());
+
+        const index_t ch = row / blocks;
+        const index_t g0 = (row % blocks) * valid;
+        for (index_t j = 0; j < valid && g0 + j < len; j++) {
+          OsElem(out, ch, g0 + j) = x[taps_ - 1 + j];
+        }
+      }
+    });
+  }
+
+  bool host_;
+  cudaStream_t stream_;
+  matxHostExecutor_t exec_;
+  index_t taps_;
+  index_t channels_;
+  index_t nfft_;
+  index_t max_blocks_; // Blocks per channel in one pass
+  T *buf_;
+  T *spec_;
+  T *hist_;
+  T *hist_next_;
+  std::vector<T> hbuf_;
+  std::vector<T> hspec_;
+  std::vector<T> hhist_;
+  std::vector<T> hhist_next_;
+};
+
+
+/**
+ * Doppler processing plan
+ *
+ * Windows and transforms every line of a tensor along one axis, such as the
+ * pulses of a radar data cube. The window is read from a cached coefficient
+ * table and applied while the lines are loaded into a contiguous FFT buffer,
+ * so there is no separate windowing pass and no permuted copy of the input.
+ * When the axis is not the last dimension, the load and the store back into
+ * the output are tiled transposes through shared memory so both sides stay
+ * coalesced. Lines shorter than the FFT size are zero-padded.
+ *
+ * The plan owns the FFT buffer and the cuFFT plan for one number of lines and
+ * FFT size, so repeated calls don't allocate.
+ *
+ * @tparam T
+ *   Complex data type
+ */
+template <typename T> class matxDopplerPlan_t {
+public:
+  /**
+   * Construct a Doppler processing plan
+   *
+   * @param rows
+   *   Number of lines transformed, the product of every dimension but the
+   * axis
+   * @param nfft
+   *   FFT size, the size of the output along the axis
+   * @param stream
+   *   CUDA stream
+   */
+  matxDopplerPlan_t(index_t rows, index_t nfft, cudaStream_t stream = 0)
+      : rows_(rows), nfft_(nfft), stream_(stream)
+  {
+    static_assert(is_complex_v<T>, "Doppler processing data must be complex");
+    MATX_ASSERT(rows_ > 0 && nfft_ > 0, matxInvalidSize);
+
+    matxAlloc((void **)&buf_, rows_ * nfft_ * sizeof(T), MATX_DEVICE_MEMORY);
+
+    tensor_t<T, 2> buf_v(buf_, {rows_, nfft_});
+    fft_ = new matxFFTPlan1D_t<T, T>{buf_v, buf_v};
+  }
+
+  /**
+   * Doppler processing plan destructor
+   *
+   * Frees the FFT buffer and plan
+   */
+  ~matxDopplerPlan_t()
+  {
+    delete fft_;
+    matxFree(buf_);
+  }
+
+  /**
+   * Window and transform every line of the input along an axis
+   *
+   * @tparam RANK
+   *   Rank of the tensors
+   *
+   * @param out
+   *   Output tensor. Same size as the input except along the axis, where it
+   * is the FFT size. May overlap the input
+   * @param in
+   *   Input tensor
+   * @param axis
+   *   Dimension to transform along
+   * @param win
+   *   Window type, without parameters, applied along the axis
+   */
+  template <int RANK>
+  void Exec(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, int axis,
+            windowType_t win)
+  {
+    MATX_ASSERT(axis >= 0 && axis < RANK, matxInvalidDim);
+    Exec(out, in, axis, GetWindowTable<value_type_t<T>>(win, in.Size(axis)));
+  }
+
+  /**
+   * Window and transform every line of the input along an axis with a
+   * window table, such as a Kaiser, Chebyshev or Taylor window from
+   * GetWindowTable()
+   *
+   * @tparam RANK
+   *   Rank of the tensors
+   *
+   * @param out
+   *   Output tensor. Same size as the input except along the axis, where it
+   * is the FFT size. May overlap the input
+   * @param in
+   *   Input tensor
+   * @param axis
+   *   Dimension to transform along
+   * @param win
+   *   Window coefficients, with the length of the input along the axis. Must
+   * be accessible from the device
+   */
+  template <int RANK>
+  void Exec(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, int axis,
+            const tensor_t<value_type_t<T>, 1> &win)
+  {
+    MATX_ASSERT(axis >= 0 && axis < RANK, matxInvalidDim);
+
+    const index_t len = in.Size(axis);
+    index_t outer = 1;
+    index_t inner = 1;
+    for (int d = 0; d < RANK; d++) {
+      if (d != axis) {
+        MATX_ASSERT(out.Size(d) == in.Size(d), matxInvalidSize);
+      }
+      if (d < axis) {
+        outer *= in.Size(d);
+      }
+      else if (d > axis) {
+        inner *= in.Size(d);
+      }
+    }
+    MATX_ASSERT(outer * inner == rows_ && out.Size(axis) == nfft_ &&
+                    len <= nfft_ && win.Size(0) == len,
+                matxInvalidSize);
+
+    const value_type_t<T> *w = win.Data();
+
+    if (inner == 1) {
+      dim3 grid(static_cast<unsigned int>((nfft_ + DOPPLER_BLOCK_SIZE - 1) /
+                                          DOPPLER_BLOCK_SIZE),
+                static_cast<unsigned int>(std::min<index_t>(outer, 65535)));
+      DopplerLoadRows<<<grid, DOPPLER_BLOCK_SIZE, 0, stream_>>>(
+          buf_, in, w, axis, len, nfft_, outer);
+
+      tensor_t<T, 2> buf_v(buf_, {rows_, nfft_});
+      fft_->Forward(buf_v, buf_v, stream_);
+
+      DopplerStoreRows<<<grid, DOPPLER_BLOCK_SIZE, 0, stream_>>>(
+          out, buf_, axis, nfft_, outer);
+    }
+    else {
+      const size_t shm =
+          DOPPLER_TILE_DIM * (DOPPLER_TILE_DIM + 1) * sizeof(T);
+      dim3 block(DOPPLER_TILE_DIM, DOPPLER_TILE_ROWS);
+      dim3 grid(static_cast<unsigned int>((inner + DOPPLER_TILE_DIM - 1) /
+                                          DOPPLER_TILE_DIM),
+                static_cast<unsigned int>(std::min<index_t>(
+                    (nfft_ + DOPPLER_TILE_DIM - 1) / DOPPLER_TILE_DIM, 65535)),
+                static_cast<unsigned int>(std::min<index_t>(outer, 65535)));
+      DopplerLoad<<<grid, block, shm, stream_>>>(buf_, in, w, axis, len, nfft_,
+                                                 inner, outer);
+
+      tensor_t<T, 2> buf_v(buf_, {rows_, nfft_});
+      fft_->Forward(buf_v, buf_v, stream_);
+
+      DopplerStore<<<grid, block, shm, stream_>>>(out, buf_, axis, nfft_,
+                                                  inner, outer);
+    }
+  }
+
+private:
+  index_t rows_;
+  index_t nfft_;
+  cudaStream_t stream_;
+  T *buf_;
+  matxFFTPlan1D_t<T, T> *fft_;
+};
+
+/**
+ * Parameters needed to cache a Doppler processing plan
+ */
+struct DopplerParams_t {
+  index_t rows;
+  index_t nfft;
+  MatXDataType_t dtype;
+  cudaStream_t stream;
+};
+
+struct DopplerParamsKeyHash {
+  std::size_t operator()(const DopplerParams_t &k) const noexcept
+  {
+    return std::hash<index_t>()(k.rows) + std::hash<index_t>()(k.nfft) +
+           std::hash<index_t>()((size_t)k.stream);
+  }
+};
+
+struct DopplerParamsKeyEq {
+  bool operator()(const DopplerParams_t &l,
+                  const DopplerParams_t &t) const noexcept
+  {
+    return l.rows == t.rows && l.nfft == t.nfft && l.dtype == t.dtype &&
+           l.stream == t.stream;
+  }
+};
+
+// Static cache of Doppler processing plans
+static matxCache_t<DopplerParams_t, DopplerParamsKeyHash, DopplerParamsKeyEq>
+    doppler_cache;
+
+/**
+ * Get the cached Doppler processing plan for a shape, creating it on first
+ * use
+ */
+template <typename T, int RANK>
+matxDopplerPlan_t<T> *GetDopplerPlan(const tensor_t<T, RANK> &out,
+                                     const tensor_t<T, RANK> &in, int axis,
+                                     cudaStream_t stream)
+{
+  MATX_ASSERT(axis >= 0 && axis < RANK, matxInvalidDim);
+  MATX_ASSERT(in.Size(axis) > 0, matxInvalidSize);
+
+  DopplerParams_t params;
+  params.rows = in.TotalSize() / in.Size(axis);
+  params.nfft = out.Size(axis);
+  params.dtype = TypeToInt<T>();
+  params.stream = stream;
+
+  auto ret = doppler_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    auto tmp = new matxDopplerPlan_t<T>{params.rows, params.nfft, stream};
+    doppler_cache.Insert(params, static_cast<void *>(tmp));
+    return tmp;
+  }
+
+  return static_cast<matxDopplerPlan_t<T> *>(ret.value());
+}
+
+/**
+ * Doppler processing
+ *
+ * Applies a window along one axis of a tensor and FFTs every line along that
+ * axis, zero-padding each line to the size of the output along the axis. For
+ * a radar data cube of channels by pulses by range bins, transforming along
+ * axis 1 gives range-Doppler maps without permuting the cube. The window
+ * coefficients are computed once and cached, and the plan is created on the
+ * first call with a given shape and reused after that, the same as fft().
+ *
+ * @tparam T
+ *   Complex data type
+ * @tparam RANK
+ *   Rank of the tensors
+ *
+ * @param out
+ *   Output tensor. Same size as the input except along the axis, which is the
+ * FFT size and at least the input size. May overlap the input
+ * @param in
+ *   Input tensor
+ * @param axis
+ *   Dimension to window and transform along
+ * @param win
+ *   Window type. Windows that take a parameter need the overload taking a
+ * window table
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK>
+void doppler(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, int axis,
+             windowType_t win = WINDOW_TYPE_HAMMING, cudaStream_t stream = 0)
+{
+  deferred_flush(stream);
+
+  GetDopplerPlan(out, in, axis, stream)->Exec(out, in, axis, win);
+}
+
+/**
+ * Doppler processing with a window table
+ *
+ * Same as the version above, with the window given as coefficients, such as
+ * a cached Taylor window from GetWindowTable().
+ *
+ * @tparam T
+ *   Complex data type
+ * @tparam RANK
+ *   Rank of the tensors
+ *
+ * @param out
+ *   Output tensor. Same size as the input except along the axis, which is the
+ * FFT size and at least the input size. May overlap the input
+ * @param in
+ *   Input tensor
+ * @param axis
+ *   Dimension to window and transform along
+ * @param win
+ *   Window coefficients, with the length of the input along the axis
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK>
+void doppler(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, int axis,
+             const tensor_t<value_type_t<T>, 1> &win, cudaStream_t stream = 0)
+{
+  deferred_flush(stream);
+
+  GetDopplerPlan(out, in, axis, stream)->Exec(out, in, axis, win);
+}
+
 }; // namespace signal
 }; // namespace matx
@@ -32,80 +32,182 @@
 
 #pragma once
 
+#include "kernels/matx_random_kernels.cuh"
+#include "matx_deferred.h"
 #include "matx_error.h"
 #include "matx_shape.h"
 #include "matx_tensor_ops.h"
+#include <algorithm>
 #include <cuda/std/complex>
-#include <curand_kernel.h>
 #include <type_traits>
 
 namespace matx {
 
 /**
  * Random number distribution
+ *
+ * UNIFORM is on the interval (0, 1], NORMAL has zero mean and unit variance,
+ * EXPONENTIAL has unit rate, and RAYLEIGH has unit scale. For complex types
+ * the real and imaginary parts are drawn independently.
  */
-enum Distribution_t { UNIFORM, NORMAL };
+enum Distribution_t { UNIFORM, NORMAL, EXPONENTIAL, RAYLEIGH };
 
-template <typename Gen>
-__global__ void curand_setup_kernel(Gen *states, uint64_t seed, index_t size)
-{
-  index_t idx = (index_t)blockIdx.x * blockDim.x + threadIdx.x;
-  if (idx < size)
-    curand_init(seed, idx, 0, &states[idx]);
+static constexpr uint32_t PHILOX_M4x32_0 = 0xD2511F53;
+static constexpr uint32_t PHILOX_M4x32_1 = 0xCD9E8D57;
+static constexpr uint32_t PHILOX_W32_0 = 0x9E3779B9;
+static constexpr uint32_t PHILOX_W32_1 = 0xBB67AE85;
+static constexpr int PHILOX_ROUNDS = 10;
+
+/**
+ * Output of a single Philox4x32 block. Each block provides four independent
+ * 32-bit words
+ */
+struct philox4x32_t {
+  uint32_t x, y, z, w;
 };
 
-template <typename Gen>
-__inline__ __device__ void get_random(float &val, Gen *state,
-                                      Distribution_t dist)
+__inline__ __host__ __device__ uint32_t philox_mulhilo(uint32_t a, uint32_t b,
+                                                       uint32_t &hi)
 {
-  if (dist == UNIFORM) {
-    val = curand_uniform(state);
-  }
-  else {
-    val = curand_normal(state);
+#ifdef __CUDA_ARCH__
+  hi = __umulhi(a, b);
+  return a * b;
+#else
+  uint64_t p = static_cast<uint64_t>(a) * b;
+  hi = static_cast<uint32_t>(p >> 32);
+  return static_cast<uint32_t>(p);
+#endif
+}
+
+/**
+ * Philox4x32-10 counter-based generator
+ *
+ * Maps a 128-bit counter and a 64-bit key to four 32-bit random words with no
+ * state carried between calls. Only integer operations are used, so host and
+ * device produce bit-identical words for the same inputs.
+ *
+ * @param ctr
+ *   128-bit counter
+ * @param key0
+ *   Lower 32 bits of the key
+ * @param key1
+ *   Upper 32 bits of the key
+ * @returns
+ *   Four random words
+ */
+__inline__ __host__ __device__ philox4x32_t philox4x32_10(philox4x32_t ctr,
+                                                          uint32_t key0,
+                                                          uint32_t key1)
+{
+#ifdef __CUDA_ARCH__
+#pragma unroll
+#endif
+  for (int r = 0; r < PHILOX_ROUNDS; r++) {
+    uint32_t hi0, hi1;
+    uint32_t lo0 = philox_mulhilo(PHILOX_M4x32_0, ctr.x, hi0);
+    uint32_t lo1 = philox_mulhilo(PHILOX_M4x32_1, ctr.z, hi1);
+    ctr = {hi1 ^ ctr.y ^ key0, lo1, hi0 ^ ctr.w ^ key1, lo0};
+    key0 += PHILOX_W32_0;
+    key1 += PHILOX_W32_1;
   }
-};
 
-template <typename Gen>
-__inline__ __device__ void get_random(double &val, Gen *state,
-                                      Distribution_t dist)
+  return ctr;
+}
+
+/* Conversions from random words to (0, 1], matching cuRAND's ranges */
+__inline__ __host__ __device__ float philox_to_float(uint32_t x)
 {
-  if (dist == UNIFORM) {
-    val = curand_uniform_double(state);
+  return static_cast<float>(x) * 2.3283064e-10f + (2.3283064e-10f / 2.0f);
+}
+
+__inline__ __host__ __device__ double philox_to_double(uint32_t x, uint32_t y)
+{
+  uint64_t z = ((static_cast<uint64_t>(x) << 32) | y) >> 11;
+  return static_cast<double>(z) * 1.1102230246251565e-16 +
+         (1.1102230246251565e-16 / 2.0);
+}
+
+/**
+ * Convert a pair of uniforms to a pair of independent samples from the given
+ * distribution. Normal samples use the Box-Muller transform.
+ */
+template <typename T>
+__inline__ __host__ __device__ void
+philox_transform(T u0, T u1, T &out0, T &out1, Distribution_t dist)
+{
+  constexpr T two_pi = static_cast<T>(6.283185307179586);
+
+  switch (dist) {
+  case NORMAL: {
+    T r = cuda::std::sqrt(static_cast<T>(-2) * cuda::std::log(u0));
+    out0 = r * cuda::std::cos(two_pi * u1);
+    out1 = r * cuda::std::sin(two_pi * u1);
+    break;
   }
-  else {
-    val = curand_normal_double(state);
+  case EXPONENTIAL:
+    out0 = -cuda::std::log(u0);
+    out1 = -cuda::std::log(u1);
+    break;
+  case RAYLEIGH:
+    out0 = cuda::std::sqrt(static_cast<T>(-2) * cuda::std::log(u0));
+    out1 = cuda::std::sqrt(static_cast<T>(-2) * cuda::std::log(u1));
+    break;
+  default:
+    out0 = u0;
+    out1 = u1;
+    break;
   }
+}
+
+/**
+ * Number of values of type T produced by one Philox block. Each block is 128
+ * bits and every real component uses 32 bits for single precision or 64 bits
+ * for double precision, so no words of a block go unused.
+ */
+template <typename T>
+inline constexpr int philox_values_v = static_cast<int>(16 / sizeof(T));
+
+/**
+ * Get all random values from one Philox block
+ *
+ * Normal samples come in Box-Muller pairs, so each pair of words gives two
+ * values rather than one value and a discarded sample.
+ */
+__inline__ __host__ __device__ void
+get_random(float *vals, const philox4x32_t &r, Distribution_t dist)
+{
+  philox_transform(philox_to_float(r.x), philox_to_float(r.y), vals[0],
+                   vals[1], dist);
+  philox_transform(philox_to_float(r.z), philox_to_float(r.w), vals[2],
+                   vals[3], dist);
 };
 
-template <typename Gen>
-__inline__ __device__ void get_random(cuda::std::complex<float> &val,
-                                      Gen *state, Distribution_t dist)
+__inline__ __host__ __device__ void
+get_random(double *vals, const philox4x32_t &r, Distribution_t dist)
 {
-  if (dist == UNIFORM) {
-    val.real(curand_uniform(state));
-    val.imag(curand_uniform(state));
-  }
-  else {
-    float2 r = curand_normal2(state);
-    val.real(r.x);
-    val.imag(r.y);
-  }
+  philox_transform(philox_to_double(r.x, r.y), philox_to_double(r.z, r.w),
+                   vals[0], vals[1], dist);
 };
 
-template <typename Gen>
-__inline__ __device__ void get_random(cuda::std::complex<double> &val,
-                                      Gen *state, Distribution_t dist)
+__inline__ __host__ __device__ void
+get_random(cuda::std::complex<float> *vals, const philox4x32_t &r,
+           Distribution_t dist)
 {
-  if (dist == UNIFORM) {
-    val.real(curand_uniform_double(state));
-    val.imag(curand_uniform_double(state));
-  }
-  else {
-    double2 r = curand_normal2_double(state);
-    val.real(r.x);
-    val.imag(r.y);
-  }
+  float re0, im0, re1, im1;
+  philox_transform(philox_to_float(r.x), philox_to_float(r.y), re0, im0, dist);
+  philox_transform(philox_to_float(r.z), philox_to_float(r.w), re1, im1, dist);
+  vals[0] = {re0, im0};
+  vals[1] = {re1, im1};
+};
+
+__inline__ __host__ __device__ void
+get_random(cuda::std::complex<double> *vals, const philox4x32_t &r,
+           Distribution_t dist)
+{
+  double re, im;
+  philox_transform(philox_to_double(r.x, r.y), philox_to_double(r.z, r.w), re,
+                   im, dist);
+  vals[0] = {re, im};
 };
 
 template <typename T, int RANK> class randomTensorView_t;
@@ -117,12 +219,16 @@ template <typename T, int RANK> class randomTensorView_t;
  *   Type of random number
  *
  * Generate random numbers based on a size and seed. Uses the Philox 4x32
- * generator with 10 rounds.
+ * generator with 10 rounds in a stateless, counter-based form: every value is a
+ * pure function of the seed, a per-view counter, and the linear index of the
+ * element. No device memory is allocated, and values are reproducible between
+ * runs and between host and device.
  */
 template <typename T> class randomGenerator_t {
 private:
   index_t total_threads_;
-  curandStatePhilox4_32_10_t *states_;
+  uint64_t seed_;
+  uint64_t counter_ = 0;
 
 public:
   randomGenerator_t() = delete;
@@ -130,29 +236,26 @@ public:
   /**
    * Constructs a random number generator
    *
-   * This call will allocate memory sufficiently large enough to store state of
-   * the RNG
+   * The generator is stateless and requires no memory beyond this object
    *
    * @param total_threads
-   *   Number of random values to generate
+   *   Number of random values to generate. Kept for compatibility; views may be
+   * any size.
    * @param seed
    *   Seed for the RNG
    */
   inline randomGenerator_t(index_t total_threads, uint64_t seed)
-      : total_threads_(total_threads)
+      : total_threads_(total_threads), seed_(seed)
   {
-    matxAlloc((void **)&states_,
-              total_threads_ * sizeof(curandStatePhilox4_32_10_t),
-              MATX_DEVICE_MEMORY);
-
-    int threads = 128;
-    int blocks = static_cast<int>((total_threads_ + threads - 1) / threads);
-    curand_setup_kernel<<<blocks, threads>>>(states_, seed, total_threads);
-  };
+  }
 
   /**
    * Get a tensor view of the random numbers
    *
+   * Each view returned from a generator uses a new counter, so separate views
+   * produce independent streams of numbers. Accessing the same view at the
+   * same index always returns the same value.
+   *
    * @param shape
    *   Dimensions of the view in the form of an tensorShape_t
    * @param dist
@@ -168,7 +271,8 @@ public:
   inline auto GetTensorView(const tensorShape_t<RANK> shape,
                             Distribution_t dist, T alpha = 1, T beta = 0)
   {
-    return randomTensorView_t<T, RANK>(shape, states_, dist, alpha, beta);
+    return randomTensorView_t<T, RANK>(shape, seed_, counter_++, dist, alpha,
+                                       beta);
   }
 
   /**
@@ -190,13 +294,27 @@ public:
                             T alpha = 1, T beta = 0)
   {
     tensorShape_t<RANK> shape((const index_t *)sizes);
-    return randomTensorView_t<T, RANK>(shape, states_, dist, alpha, beta);
+    return GetTensorView<RANK>(shape, dist, alpha, beta);
   }
 
   /**
-   * Destroy the RNG and free all memory
+   * Set the counter used by the next view
+   *
+   * Together with the seed, the counter fully determines the values of a view.
+   * Setting it back to a previous value reproduces that view exactly.
+   *
+   * @param counter
+   *   Counter value
+   */
+  inline void SetCounter(uint64_t counter) { counter_ = counter; }
+
+  /**
+   * Get the counter used by the next view
+   *
+   * @returns
+   *   Counter value
    */
-  inline ~randomGenerator_t() { matxFree(states_); }
+  inline uint64_t GetCounter() const { return counter_; }
 };
 
 /**
@@ -207,44 +325,80 @@ public:
  * @tparam
  *   Rank of view
  *
- * Provides a view into a previously-allocated randomGenerator_t
+ * Provides a view of random numbers from a randomGenerator_t. The view holds
+ * only the seed and counter, and can be evaluated on either the host or the
+ * device.
  */
 template <typename T, int RANK> class randomTensorView_t {
 private:
   tensorShape_t<RANK> shape_;
-  curandStatePhilox4_32_10_t *states_;
+  uint32_t key0_, key1_;
+  uint32_t ctr0_, ctr1_;
   Distribution_t dist_;
   T alpha_, beta_;
 
+  inline __host__ __device__ T Generate(index_t idx) const
+  {
+    uint64_t lidx = static_cast<uint64_t>(idx);
+    T vals[VALUES];
+    GenerateBlock(static_cast<index_t>(lidx / VALUES), vals);
+    return vals[lidx % VALUES];
+  }
+
 public:
   using type = T;
   using scalar_type = T;
   // dummy type to signal this is a matxop
   using matxop = bool;
 
-  randomTensorView_t(const tensorShape_t<RANK> shape,
-                         curandStatePhilox4_32_10_t *states,
-                         Distribution_t dist, T alpha, T beta)
-      : alpha_(alpha), beta_(beta), shape_(shape)
+  /** Number of consecutive elements generated from one Philox block */
+  static constexpr int VALUES = philox_values_v<T>;
+
+  randomTensorView_t(const tensorShape_t<RANK> shape, uint64_t seed,
+                     uint64_t counter, Distribution_t dist, T alpha, T beta)
+      : shape_(shape), key0_(static_cast<uint32_t>(seed)),
+        key1_(static_cast<uint32_t>(seed >> 32)),
+        ctr0_(static_cast<uint32_t>(counter)),
+        ctr1_(static_cast<uint32_t>(counter >> 32)), dist_(dist),
+        alpha_(alpha), beta_(beta)
+  {
+  }
+
+  /**
+   * Generate the values of VALUES consecutive elements from one Philox block
+   *
+   * Element i of the view is value i % VALUES of block i / VALUES, so filling
+   * a whole block at a time gives the same values as reading them one at a
+   * time.
+   *
+   * @param blk
+   *   Block index
+   * @param vals
+   *   Output for VALUES values
+   */
+  inline __host__ __device__ void GenerateBlock(index_t blk, T *vals) const
   {
-    dist_ = dist;
-    states_ = states;
+    uint64_t lblk = static_cast<uint64_t>(blk);
+    philox4x32_t ctr = {static_cast<uint32_t>(lblk),
+                        static_cast<uint32_t>(lblk >> 32), ctr0_, ctr1_};
+    get_random(vals, philox4x32_10(ctr, key0_, key1_), dist_);
+    for (int v = 0; v < VALUES; v++) {
+      vals[v] = alpha_ * vals[v] + beta_;
+    }
   }
 
 #ifdef DOXYGEN_ONLY
   /**
    * Retrieve a value from a rank-0 random view
    */
-  __device__ T operator()()
+  __host__ __device__ T operator()()
   {
 #else
   template <int M = RANK, std::enable_if_t<M == 0, bool> = true>
-  inline __device__ T operator()()
+  inline __host__ __device__ T operator()() const
   {
 #endif
-    T val;
-    get_random(val, &states_[0], dist_);
-    return alpha_ * val + beta_;
+    return Generate(0);
   };
 
 #ifdef DOXYGEN_ONLY
@@ -254,16 +408,14 @@ public:
    * @param i
    *   First index
    */
-  __device__ T operator()(index_t i)
+  __host__ __device__ T operator()(index_t i)
   {
 #else
   template <int M = RANK, std::enable_if_t<M == 1, bool> = true>
-  inline __device__ T operator()(index_t i)
+  inline __host__ __device__ T operator()(index_t i) const
   {
 #endif
-    T val;
-    get_random(val, &states_[i], dist_);
-    return alpha_ * val + beta_;
+    return Generate(i);
   };
 
 #ifdef DOXYGEN_ONLY
@@ -275,16 +427,14 @@ public:
    * @param j
    *   Second index
    */
-  __device__ T operator()(index_t i, index_t j)
+  __host__ __device__ T operator()(index_t i, index_t j)
   {
 #else
   template <int M = RANK, std::enable_if_t<M == 2, bool> = true>
-  inline __device__ T operator()(index_t i, index_t j)
+  inline __host__ __device__ T operator()(index_t i, index_t j) const
   {
 #endif
-    T val;
-    get_random(val, &states_[(index_t)i * Size(1) + j], dist_);
-    return alpha_ * val + beta_;
+    return Generate(i * Size(1) + j);
   };
 
 #ifdef DOXYGEN_ONLY
@@ -298,17 +448,15 @@ public:
    * @param k
    *   Third index
    */
-  __device__ T operator()(index_t i, index_t j, index_t k)
+  __host__ __device__ T operator()(index_t i, index_t j, index_t k)
   {
 #else
   template <int M = RANK, std::enable_if_t<M == 3, bool> = true>
-  inline __device__ T operator()(index_t i, index_t j, index_t k)
+  inline __host__ __device__ T operator()(index_t i, index_t j,
+                                          index_t k) const
   {
 #endif
-    T val;
-    get_random(val, &states_[(index_t)i * Size(1) * Size(2) + j * Size(2) + k],
-               dist_);
-    return alpha_ * val + beta_;
+    return Generate(i * Size(1) * Size(2) + j * Size(2) + k);
   };
 
 #ifdef DOXYGEN_ONLY
@@ -324,19 +472,16 @@ public:
    * @param l
    *   Fourth index
    */
-  __device__ T operator()(index_t i, index_t j, index_t k, index_t l)
+  __host__ __device__ T operator()(index_t i, index_t j, index_t k, index_t l)
   {
 #else
   template <int M = RANK, std::enable_if_t<M == 4, bool> = true>
-  inline __device__ T operator()(index_t i, index_t j, index_t k, index_t l)
+  inline __host__ __device__ T operator()(index_t i, index_t j, index_t k,
+                                          index_t l) const
   {
 #endif
-    T val;
-    get_random(val,
-               &states_[i * Size(1) * Size(2) * Size(3) +
-                        j * Size(2) * Size(3) + k * Size(3) + l],
-               dist_);
-    return alpha_ * val + beta_;
+    return Generate(i * Size(1) * Size(2) * Size(3) + j * Size(2) * Size(3) +
+                    k * Size(3) + l);
   };
 
   static inline constexpr __host__ __device__ int32_t Rank() { return RANK; }
@@ -350,23 +495,37 @@ public:
 /**
  * Populate a tensor with random values
  *
+ * Gives the same values as set(t, r), but each thread writes every value of a
+ * Philox block rather than generating a whole block per element.
+ *
  * @param t
- *   Output tensor view
- * @param dist
- *   Type of random distribution
- * @param seed
- *   Random seed
+ *   Output tensor view. Must be contiguous.
+ * @param r
+ *   Random view with the same shape as t
  * @param stream
  *   Stream to execute
- * Note: leave this function out for now since it may be confusing to users with
- * all the allocations it does
  */
-// template<class T, int RANK>
-// inline void rand(tensor_t<T,RANK> t, Distribution_t dist = UNIFORM,
-// uint64_t seed = 0, cudaStream_t stream = 0) {
-//   randomGenerator_t<T> r(t.TotalSize(), seed);
-//   auto tmp = r.template GetTensorView<RANK> (t.Shape(), dist);
-//   exec(set(t, tmp), stream);
-// }
+template <typename T, int RANK>
+void rand(tensor_t<T, RANK> t, const randomTensorView_t<T, RANK> &r,
+          cudaStream_t stream = 0)
+{
+  MATX_ASSERT_STR(t.IsLinear(), matxInvalidParameter,
+                  "rand() requires a contiguous output tensor");
+  for (int i = 0; i < RANK; i++) {
+    MATX_ASSERT(t.Size(i) == r.Size(i), matxInvalidSize);
+  }
+
+  deferred_flush(stream);
+
+  constexpr int V = randomTensorView_t<T, RANK>::VALUES;
+  const index_t total = t.TotalSize();
+  const index_t blocks = std::min<index_t>(
+      ((total + V - 1) / V + RANDOM_BLOCK_SIZE - 1) / RANDOM_BLOCK_SIZE,
+      65535);
+  if (blocks > 0) {
+    RandomFill<<<static_cast<unsigned int>(blocks), RANDOM_BLOCK_SIZE, 0,
+                 stream>>>(t.Data(), r, total);
+  }
+}
 
 } // end namespace matx
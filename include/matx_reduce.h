@@ -33,10 +33,13 @@
 #pragma once
 
 #include "matx_cub.h"
+#include "matx_deferred.h"
 #include "matx_error.h"
 #include "matx_get_grid_dims.h"
+#include "matx_host_executor.h"
 #include "matx_tensor.h"
 #include "matx_type_utils.h"
+#include <algorithm>
 #include <cfloat>
 
 /**
@@ -584,11 +587,16 @@ __device__ inline T warpReduceOp(T val, Op op, uint32_t size)
   return val;
 }
 
-template <typename T, int RANK, typename InType, typename ReduceOp>
-__global__ void matxReduceKernel(tensor_t<T, RANK> dest, InType in,
-                                 ReduceOp red)
+/**
+ * Reduce the block at z index bz of the grid into dest
+ */
+template <typename I, typename OutType, typename InType, typename ReduceOp>
+__device__ inline void matxReduceBlock(OutType &dest, InType &in,
+                                       ReduceOp &red, I bz)
 {
 
+  using T = typename OutType::scalar_type;
+  constexpr int RANK = OutType::Rank();
   constexpr int DRANK = InType::Rank() - RANK;
   using scalar_type = typename InType::scalar_type;
 #if 1
@@ -617,43 +625,66 @@ __global__ void matxReduceKernel(tensor_t<T, RANK> dest, InType in,
 
   // Read input
   typename InType::scalar_type in_val = red.Init();
-  [[maybe_unused]] index_t idx, idy, idz, idw;
+  [[maybe_unused]] I idx, idy, idz, idw;
+  [[maybe_unused]] I id[InType::Rank() > 4 ? InType::Rank() : 1];
+  [[maybe_unused]] bool valid;
 
   if constexpr (InType::Rank() == 1) {
-    idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+    idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
     if (idx < in.Size(0)) {
       in_val = in(idx);
     }
   }
   else if constexpr (InType::Rank() == 2) {
-    idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-    idy = static_cast<index_t>(blockIdx.y) * blockDim.y + threadIdx.y;
+    idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+    idy = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
     if (idy < in.Size(0) && idx < in.Size(1)) {
       in_val = in(idy, idx);
     }
   }
   else if constexpr (InType::Rank() == 3) {
-    idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-    idy = static_cast<index_t>(blockIdx.y) * blockDim.y + threadIdx.y;
-    idz = static_cast<index_t>(blockIdx.z) * blockDim.z + threadIdx.z;
+    idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+    idy = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
+    idz = bz * blockDim.z + threadIdx.z;
     if (idz < in.Size(0) && idy < in.Size(1) && idx < in.Size(2)) {
       in_val = in(idz, idy, idx);
     }
   }
   else if constexpr (InType::Rank() == 4) {
-    idx = static_cast<index_t>(blockIdx.x) * blockDim.x + threadIdx.x;
-    index_t nmy = static_cast<index_t>(blockIdx.y) * blockDim.y + threadIdx.y;
-    idy = nmy % in.Size(2);
-    idz = nmy / in.Size(2);
-    idw = blockIdx.z * blockDim.z + threadIdx.z;
+    idx = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+    I nmy = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
+    idy = nmy % static_cast<I>(in.Size(2));
+    idz = nmy / static_cast<I>(in.Size(2));
+    idw = bz * blockDim.z + threadIdx.z;
     if (idw < in.Size(0) && idz < in.Size(1) && idy < in.Size(2) &&
         idx < in.Size(3)) {
       in_val = in(idw, idz, idy, idx);
     }
   }
+  else {
+    // Ranks above 4 have their leading dimensions flattened into z
+    constexpr int IRANK = InType::Rank();
+    id[IRANK - 1] = static_cast<I>(blockIdx.x) * blockDim.x + threadIdx.x;
+    id[IRANK - 2] = static_cast<I>(blockIdx.y) * blockDim.y + threadIdx.y;
+    I rem = bz * blockDim.z + threadIdx.z;
+#pragma unroll
+    for (int d = IRANK - 3; d > 0; d--) {
+      id[d] = rem % static_cast<I>(in.Size(d));
+      rem /= static_cast<I>(in.Size(d));
+    }
+    id[0] = rem;
 
-  // Compute offset index based on rank difference
-  if constexpr (DRANK == 1) {
+    valid = id[0] < in.Size(0) && id[IRANK - 2] < in.Size(IRANK - 2);
+    if (valid && id[IRANK - 1] < in.Size(IRANK - 1)) {
+      in_val = apply_indices(in, id, std::make_index_sequence<IRANK>{});
+    }
+  }
+
+  // Compute offset index based on rank difference. Ranks above 4 take the
+  // output indices from id instead.
+  if constexpr (InType::Rank() > 4) {
+  }
+  else if constexpr (DRANK == 1) {
     // Shift ranks by 1
     if constexpr (InType::Rank() >= 2)
       idx = idy;
@@ -679,7 +710,13 @@ __global__ void matxReduceKernel(tensor_t<T, RANK> dest, InType in,
   T *out = nullptr;
 
   // compute output offsets
-  if constexpr (RANK == 0) {
+  if constexpr (InType::Rank() > 4) {
+    // The output's indices are the leading indices of the input
+    if (valid) {
+      out = &apply_indices(dest, id, std::make_index_sequence<RANK>{});
+    }
+  }
+  else if constexpr (RANK == 0) {
     out = &dest();
   }
   else if constexpr (RANK == 1) {
@@ -732,6 +769,23 @@ __global__ void matxReduceKernel(tensor_t<T, RANK> dest, InType in,
 #endif
 }
 
+/**
+ * Reduction kernel. The z dimension of the grid is capped, so z blocks past
+ * the grid are covered by striding over it. Every thread of a block makes the
+ * same number of passes, so the block can synchronize between them before
+ * reusing shared memory.
+ */
+template <typename I, typename OutType, typename InType, typename ReduceOp>
+__global__ void matxReduceKernel(OutType dest, InType in, ReduceOp red,
+                                 I zblocks)
+{
+  for (I bz = static_cast<I>(blockIdx.z); bz < zblocks;
+       bz += static_cast<I>(gridDim.z)) {
+    matxReduceBlock<I>(dest, in, red, bz);
+    __syncthreads();
+  }
+}
+
 /**
  * Perform a reduction
  *
@@ -772,6 +826,8 @@ template <typename T, int RANK, typename InType, typename ReduceOp>
 void inline reduce(tensor_t<T, RANK> dest, InType in, ReduceOp op,
                    cudaStream_t stream = 0, bool init = true)
 {
+  deferred_flush(stream);
+
 
   using scalar_type = typename InType::scalar_type;
 
@@ -798,11 +854,431 @@ void inline reduce(tensor_t<T, RANK> dest, InType in, ReduceOp op,
     get_grid_dims(blocks, threads, in.Size(0), in.Size(1), in.Size(2),
                   in.Size(3));
   }
+  else {
+    static_assert(InType::Rank() <= MATX_MAX_RANK,
+                  "Rank exceeds MATX_MAX_RANK");
+    index_t batch = 1;
+    for (int i = 0; i < InType::Rank() - 2; i++) {
+      batch *= in.Size(i);
+    }
+
+    get_grid_dims(blocks, threads, batch, in.Size(InType::Rank() - 2),
+                  in.Size(InType::Rank() - 1));
+  }
+  // Batches past the z limit of the grid are strided over by the kernel
+  const unsigned int zblocks = blocks.z;
+  blocks.z = std::min(blocks.z, 65535u);
+
   if (init) {
-    (dest = static_cast<promote_half_t<T>>(op.Init())).run(stream);
+    exec(dest = static_cast<promote_half_t<T>>(op.Init()), stream);
   }
-  matxReduceKernel<<<blocks, threads, sizeof(scalar_type) * 32, stream>>>(
-      dest, in, ReduceOp());
+
+  // Run any reductions the input reads before the reduction over it
+  PreRunOp(in, stream);
+
+  // Reduce with 32-bit indices when the input and output views fit, as
+  // exec() does for element-wise statements
+  if constexpr (sizeof(index_t) > sizeof(int32_t)) {
+    index_t sizes[InType::Rank()];
+    for (int i = 0; i < InType::Rank(); i++) {
+      sizes[i] = in.Size(i);
+    }
+
+    if (Fits32(InType::Rank(), sizes, dest, in)) {
+      matxReduceKernel<int32_t>
+          <<<blocks, threads, sizeof(scalar_type) * 32, stream>>>(
+              NarrowOp<int32_t>(dest), NarrowOp<int32_t>(in), ReduceOp(),
+              static_cast<int32_t>(zblocks));
+      PostRunOp(in, stream);
+      return;
+    }
+  }
+
+  matxReduceKernel<index_t>
+      <<<blocks, threads, sizeof(scalar_type) * 32, stream>>>(
+          dest, in, ReduceOp(), static_cast<index_t>(zblocks));
+  PostRunOp(in, stream);
+}
+
+/**
+ * Perform a reduction on the host
+ *
+ * Host version of reduce(), for inputs that are tensor views or element-wise
+ * operators. When there are at least as many outputs as threads, each output
+ * is reduced by a single thread. Otherwise the elements of each output are
+ * split across threads and the partial results are combined in thread order,
+ * so the result doesn't depend on timing.
+ *
+ * @tparam T
+ *   Output data type
+ * @tparam InType
+ *   Input data type
+ * @tparam ReduceOp
+ *   Reduction operator to apply
+ *
+ * @param dest
+ *   Destination view of reduction
+ * @param in
+ *   Input data to reduce
+ * @param op
+ *   Reduction operator
+ * @param exec
+ *   Host executor
+ * @param init
+ *   if true dest will be initialized with ReduceOp::Init()
+ *   otherwise the values in the destination will be included
+ *   in the reduction.
+ */
+template <typename T, int RANK, typename InType, typename ReduceOp>
+void inline reduce(tensor_t<T, RANK> dest, InType in, ReduceOp op,
+                   const matxHostExecutor_t &exec, bool init = true)
+{
+  constexpr int IN_RANK = InType::Rank();
+  static_assert(RANK < IN_RANK);
+  static_assert(is_matx_reduction_v<ReduceOp>);
+  static_assert(is_deferred_elementwise<InType>::value,
+                "Host reductions read tensor views or element-wise operators");
+
+  if constexpr (RANK > 0) {
+    for (uint32_t i = 0; i < RANK; i++) {
+      MATX_ASSERT(dest.Size(i) == in.Size(i), matxInvalidDim);
+    }
+  }
+
+  std::vector<DeferredView_t> reads;
+  DeferredReads(in, reads);
+  std::vector<matxHostAccess_t> access{HostWrite(dest)};
+  for (const auto &r : reads) {
+    access.push_back({r.lo, r.hi, false});
+  }
+
+  if (HostGraphRecord(exec, std::move(access),
+                      [dest, in, op, init](const matxHostExecutor_t &e) {
+                        reduce(dest, in, op, e, init);
+                      })) {
+    return;
+  }
+
+  index_t outer = 1;
+  index_t inner = 1;
+  for (int i = 0; i < IN_RANK; i++) {
+    (i < RANK ? outer : inner) *= in.Size(i);
+  }
+
+  // Value of the input at element k of output o
+  auto value = [&](index_t o, index_t k) {
+    index_t idx[IN_RANK];
+    for (int i = IN_RANK - 1; i >= RANK; i--) {
+      idx[i] = k % in.Size(i);
+      k /= in.Size(i);
+    }
+    for (int i = RANK - 1; i >= 0; i--) {
+      idx[i] = o % in.Size(i);
+      o /= in.Size(i);
+    }
+
+    return static_cast<T>(
+        apply_indices(in, idx, std::make_index_sequence<IN_RANK>{}));
+  };
+
+  auto store = [&](index_t o, T v) {
+    index_t idx[RANK > 0 ? RANK : 1];
+    for (int i = RANK - 1; i >= 0; i--) {
+      idx[i] = o % dest.Size(i);
+      o /= dest.Size(i);
+    }
+
+    T &d = apply_indices(dest, idx, std::make_index_sequence<RANK>{});
+    d = init ? v : op.Reduce(d, v);
+  };
+
+  const int threads = exec.GetNumThreads();
+  if (outer >= threads) {
+    matxHostParallelFor(outer, threads, [&](int, index_t start, index_t end) {
+      for (index_t o = start; o < end; o++) {
+        T acc = op.Init();
+        for (index_t k = 0; k < inner; k++) {
+          acc = op.Reduce(acc, value(o, k));
+        }
+
+        store(o, acc);
+      }
+    });
+    return;
+  }
+
+  std::vector<T> partial(threads);
+  for (index_t o = 0; o < outer; o++) {
+    std::fill(partial.begin(), partial.end(), op.Init());
+    matxHostParallelFor(inner, threads, [&](int tid, index_t start,
+                                            index_t end) {
+      T acc = op.Init();
+      for (index_t k = start; k < end; k++) {
+        acc = op.Reduce(acc, value(o, k));
+      }
+
+      partial[tid] = acc;
+    });
+
+    T acc = op.Init();
+    for (const auto &p : partial) {
+      acc = op.Reduce(acc, p);
+    }
+
+    store(o, acc);
+  }
+}
+
+/**
+ * Reduce every element of a static view in the calling thread
+ *
+ * Nothing is launched; each thread that calls this reduces its own view. The
+ * loop runs over TotalSize() elements in memory order, which is a constant
+ * when every extent is static, so it's fully unrolled and a view of a local
+ * array can stay in registers.
+ *
+ * @tparam T
+ *   Data type of the view
+ * @tparam ReduceOp
+ *   Reduction operator to apply
+ *
+ * @param in
+ *   Input view to reduce
+ * @param op
+ *   Reduction operator
+ *
+ * @returns Reduced value
+ */
+template <typename T, index_t... EXTENTS, typename ReduceOp>
+__host__ __device__ inline T reduce(const tensor_static_t<T, EXTENTS...> &in,
+                                    ReduceOp op)
+{
+  static_assert(is_matx_reduction_v<ReduceOp>);
+
+  T val = op.Init();
+#pragma unroll
+  for (index_t i = 0; i < in.TotalSize(); i++) {
+    val = op.Reduce(val, in.Data()[i]);
+  }
+
+  return val;
+}
+
+/**
+ * Reduction used as an operator inside an expression
+ *
+ * Reads as the reduction of its input over every dimension past the first
+ * RANK, so a rank-0 reduction broadcasts one value across the expression and
+ * a higher rank one is indexed by the leading dimensions of its input. The
+ * value isn't computed per element: exec() runs the reduction first into a
+ * buffer allocated on the stream, launches the expression as a single
+ * element-wise kernel that reads the buffer, and frees the buffer after it in
+ * stream order. The buffer holds one value per output element, so it stays in
+ * cache while the expression reads it.
+ *
+ * Reductions are run for statements built from element-wise operators, and
+ * for the input of another reduction.
+ *
+ * @tparam InType
+ *   Input operator
+ * @tparam ReduceOp
+ *   Reduction operator to apply
+ * @tparam RANK
+ *   Rank of the reduced value
+ */
+template <typename InType, typename ReduceOp, int RANK>
+class ReductionOp : public BaseOp<ReductionOp<InType, ReduceOp, RANK>> {
+private:
+  op_storage_t<InType> in_;
+  tensorShape_t<RANK> shape_;
+  mutable typename InType::scalar_type *ptr_ = nullptr;
+
+public:
+  using matxop = bool;
+  using scalar_type = typename InType::scalar_type;
+
+  inline ReductionOp(const InType &in) : in_(in)
+  {
+    static_assert(RANK < InType::Rank(),
+                  "Reduction rank must be below the input rank");
+    static_assert(is_matx_reduction_v<ReduceOp>);
+
+    if constexpr (RANK > 0) {
+      index_t sizes[RANK];
+      for (int i = 0; i < RANK; i++) {
+        sizes[i] = in.Size(i);
+      }
+      shape_ = tensorShape_t<RANK>(sizes);
+    }
+  }
+
+  template <typename... Is>
+  __device__ inline scalar_type operator()(Is... indices) const
+  {
+    static_assert(sizeof...(Is) == RANK,
+                  "Number of indices must match the reduction rank");
+
+    index_t offset = 0;
+    [[maybe_unused]] uint32_t d = 0;
+    ((offset = offset * shape_.Size(d++) + static_cast<index_t>(indices)),
+     ...);
+    return ptr_[offset];
+  }
+
+  static inline constexpr __host__ __device__ int32_t Rank() { return RANK; }
+
+  index_t inline __host__ __device__ Size(uint32_t dim) const
+  {
+    return shape_.Size(dim);
+  }
+
+  /* Only a single value can be broadcast into merged dimensions */
+  static inline constexpr __host__ bool Collapsible() { return RANK == 0; }
+
+  inline __host__ void CollapseCheck(matxCollapse_t &) const {}
+
+  template <int NR, typename I = index_t>
+  inline __host__ auto Collapse(const matxCollapse_t &) const
+  {
+    return *this;
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    size_t count = 1;
+    for (int i = 0; i < RANK; i++) {
+      count *= static_cast<size_t>(shape_.Size(i));
+    }
+
+    matxAlloc(reinterpret_cast<void **>(&ptr_), sizeof(scalar_type) * count,
+              MATX_ASYNC_DEVICE_MEMORY, stream);
+    reduce(tensor_t<scalar_type, RANK>(ptr_, shape_), in_, ReduceOp(), stream,
+           true);
+  }
+
+  inline __host__ void PostRun(cudaStream_t) const
+  {
+    matxFree(ptr_);
+    ptr_ = nullptr;
+  }
+};
+
+/**
+ * Sum of an operator as an operator
+ *
+ * @tparam RANK
+ *   Rank of the result. The input is summed over its dimensions past the
+ *   first RANK.
+ * @tparam InType
+ *   Input operator type
+ *
+ * @param in
+ *   Input operator
+ *
+ * @returns Operator reading the sum
+ */
+template <int RANK = 0, typename InType,
+          std::enable_if_t<is_matx_op<InType>(), bool> = true>
+inline auto sum(const InType &in)
+{
+  return ReductionOp<InType, reduceOpSum<typename InType::scalar_type>, RANK>(
+      in);
+}
+
+/**
+ * Product of an operator as an operator
+ *
+ * @tparam RANK
+ *   Rank of the result. The input is multiplied over its dimensions past the
+ *   first RANK.
+ * @tparam InType
+ *   Input operator type
+ *
+ * @param in
+ *   Input operator
+ *
+ * @returns Operator reading the product
+ */
+template <int RANK = 0, typename InType,
+          std::enable_if_t<is_matx_op<InType>(), bool> = true>
+inline auto prod(const InType &in)
+{
+  return ReductionOp<InType, reduceOpProd<typename InType::scalar_type>,
+                     RANK>(in);
+}
+
+/**
+ * Maximum of an operator as an operator
+ *
+ * @tparam RANK
+ *   Rank of the result. The maximum is taken over the dimensions of the input
+ *   past the first RANK.
+ * @tparam InType
+ *   Input operator type
+ *
+ * @param in
+ *   Input operator
+ *
+ * @returns Operator reading the maximum
+ */
+template <int RANK = 0, typename InType,
+          std::enable_if_t<is_matx_op<InType>(), bool> = true>
+inline auto rmax(const InType &in)
+{
+  return ReductionOp<InType, reduceOpMax<typename InType::scalar_type>, RANK>(
+      in);
+}
+
+/**
+ * Minimum of an operator as an operator
+ *
+ * @tparam RANK
+ *   Rank of the result. The minimum is taken over the dimensions of the input
+ *   past the first RANK.
+ * @tparam InType
+ *   Input operator type
+ *
+ * @param in
+ *   Input operator
+ *
+ * @returns Operator reading the minimum
+ */
+template <int RANK = 0, typename InType,
+          std::enable_if_t<is_matx_op<InType>(), bool> = true>
+inline auto rmin(const InType &in)
+{
+  return ReductionOp<InType, reduceOpMin<typename InType::scalar_type>, RANK>(
+      in);
+}
+
+/**
+ * Mean of an operator as an operator
+ *
+ * @tparam RANK
+ *   Rank of the result. The mean is taken over the dimensions of the input
+ *   past the first RANK.
+ * @tparam InType
+ *   Input operator type
+ *
+ * @param in
+ *   Input operator
+ *
+ * @returns Operator reading the mean
+ */
+template <int RANK = 0, typename InType,
+          std::enable_if_t<is_matx_op<InType>(), bool> = true>
+inline auto mean(const InType &in)
+{
+  // Scale in double precision for double and complex double inputs
+  using scale_type = std::conditional_t<
+      std::is_same_v<value_promote_t<typename InType::scalar_type>, double>,
+      double, float>;
+  scale_type scale = 1.0;
+  for (int i = RANK; i < InType::Rank(); i++) {
+    scale *= static_cast<scale_type>(in.Size(i));
+  }
+
+  return sum<RANK>(in) / scale;
 }
 
 /**
@@ -832,17 +1308,50 @@ template <typename T, int RANK, typename InType>
 void inline mean(tensor_t<T, RANK> &dest, const InType &in,
                  cudaStream_t stream = 0)
 {
-  float scale = 1.0;
+  using scale_type =
+      std::conditional_t<std::is_same_v<value_promote_t<T>, double>, double,
+                         float>;
+  scale_type scale = 1.0;
 
   reduce(dest, in, reduceOpSum<T>(), stream);
 
   // The reduction is performed over the difference in ranks between input and
   // output. This loop computes the number of elements it was performed over.
   for (int i = 1; i <= InType::Rank() - RANK; i++) {
-    scale *= static_cast<float>(in.Size(InType::Rank() - i));
+    scale *= static_cast<scale_type>(in.Size(InType::Rank() - i));
   }
 
-  (dest = dest * 1.0 / scale).run(stream);
+  exec(dest = dest * 1.0 / scale, stream);
+}
+
+/**
+ * Calculate the mean of values in a tensor on the host
+ *
+ * Host version of mean()
+ *
+ * @param dest
+ *   Destination view of reduction
+ * @param in
+ *   Input data to reduce
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK, typename InType>
+void inline mean(tensor_t<T, RANK> &dest, const InType &in,
+                 const matxHostExecutor_t &exec)
+{
+  using scale_type =
+      std::conditional_t<std::is_same_v<value_promote_t<T>, double>, double,
+                         float>;
+  scale_type scale = 1.0;
+
+  reduce(dest, in, reduceOpSum<T>(), exec);
+
+  for (int i = 1; i <= InType::Rank() - RANK; i++) {
+    scale *= static_cast<scale_type>(in.Size(InType::Rank() - i));
+  }
+
+  matx::exec(dest = dest * 1.0 / scale, exec);
 }
 
 /**
@@ -875,6 +1384,8 @@ void inline median(tensor_t<T, RANK> &dest,
 {
   static_assert(RANK_IN <= 2 && (RANK_IN == RANK + 1));
 
+  deferred_flush(stream);
+
   tensor_t<T, RANK_IN> tmp_sort(in.Shape());
 
   // If the rank is 0 we're finding the median of a vector
@@ -895,7 +1406,7 @@ void inline median(tensor_t<T, RANK> &dest,
           tmp_sort.template Slice<0>({tmp_sort.Lsize() / 2 - 1}, {matxDropDim});
       auto middle2v =
           tmp_sort.template Slice<0>({tmp_sort.Lsize() / 2}, {matxDropDim});
-      (dest = (middle1v + middle2v) / 2.0f).run(stream);
+      exec(dest = (middle1v + middle2v) / 2.0f, stream);
     }
   }
   else if (RANK_IN == 2) {
@@ -908,14 +1419,14 @@ void inline median(tensor_t<T, RANK> &dest,
     if (tmp_sort.Lsize() & 1) {
       auto sv = tmp_sort.template Slice<1>({0, tmp_sort.Lsize() / 2},
                                            {matxEnd, matxDropDim});
-      (dest = self(sv)).run(stream);
+      exec(dest = self(sv), stream);
     }
     else {
       auto sv = tmp_sort.template Slice<1>({0, tmp_sort.Lsize() / 2 - 1},
                                            {matxEnd, matxDropDim});
       auto sv2 = tmp_sort.template Slice<1>({0, tmp_sort.Lsize() / 2},
                                             {matxEnd, matxDropDim});
-      (dest = (sv + sv2) / 2.0f).run(stream);
+      exec(dest = (sv + sv2) / 2.0f, stream);
     }
   }
 }
@@ -945,6 +1456,25 @@ void inline sum(tensor_t<T, RANK> dest, InType in, cudaStream_t stream = 0)
   reduce(dest, in, reduceOpSum<T>(), stream, true);
 }
 
+/**
+ * Compute sum reduction of a tensor on the host
+ *
+ * Host version of sum()
+ *
+ * @param dest
+ *   Destination view of reduction
+ * @param in
+ *   Input data to reduce
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK, typename InType>
+void inline sum(tensor_t<T, RANK> dest, InType in,
+                const matxHostExecutor_t &exec)
+{
+  reduce(dest, in, reduceOpSum<T>(), exec, true);
+}
+
 /**
  * Compute product of numbers
  *
@@ -970,6 +1500,25 @@ void inline prod(tensor_t<T, RANK> dest, InType in, cudaStream_t stream = 0)
   reduce(dest, in, reduceOpProd<T>(), stream, true);
 }
 
+/**
+ * Compute product reduction of a tensor on the host
+ *
+ * Host version of prod()
+ *
+ * @param dest
+ *   Destination view of reduction
+ * @param in
+ *   Input data to reduce
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK, typename InType>
+void inline prod(tensor_t<T, RANK> dest, InType in,
+                 const matxHostExecutor_t &exec)
+{
+  reduce(dest, in, reduceOpProd<T>(), exec, true);
+}
+
 /**
  * Compute max reduction of a tensor
  *
@@ -998,6 +1547,25 @@ void inline rmax(tensor_t<T, RANK> dest, InType in, cudaStream_t stream = 0)
   reduce(dest, in, reduceOpMax<T>(), stream, true);
 }
 
+/**
+ * Compute max reduction of a tensor on the host
+ *
+ * Host version of rmax()
+ *
+ * @param dest
+ *   Destination view of reduction
+ * @param in
+ *   Input data to reduce
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK, typename InType>
+void inline rmax(tensor_t<T, RANK> dest, InType in,
+                 const matxHostExecutor_t &exec)
+{
+  reduce(dest, in, reduceOpMax<T>(), exec, true);
+}
+
 /**
  * Compute min reduction of a tensor
  *
@@ -1026,6 +1594,25 @@ void inline rmin(tensor_t<T, RANK> dest, InType in, cudaStream_t stream = 0)
   reduce(dest, in, reduceOpMin<T>(), stream, true);
 }
 
+/**
+ * Compute min reduction of a tensor on the host
+ *
+ * Host version of rmin()
+ *
+ * @param dest
+ *   Destination view of reduction
+ * @param in
+ *   Input data to reduce
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK, typename InType>
+void inline rmin(tensor_t<T, RANK> dest, InType in,
+                 const matxHostExecutor_t &exec)
+{
+  reduce(dest, in, reduceOpMin<T>(), exec, true);
+}
+
 /**
  * Find if any value is != 0
  *
@@ -1122,7 +1709,7 @@ void inline var(tensor_t<T, RANK> dest, InType in, cudaStream_t stream = 0)
   }
 
   // Sample variance for an unbiased estimate
-  (dest = dest / static_cast<double>(N - 1)).run(stream);
+  exec(dest = dest / static_cast<double>(N - 1), stream);
 
   matxFree(tmps);
 }
@@ -1151,7 +1738,7 @@ template <typename T, int RANK, typename InType>
 void inline stdd(tensor_t<T, RANK> dest, InType in, cudaStream_t stream = 0)
 {
   var(dest, in, stream);
-  (dest = sqrt(dest)).run(stream);
+  exec(dest = sqrt(dest), stream);
 }
 
 } // end namespace matx
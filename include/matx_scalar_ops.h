@@ -96,7 +96,7 @@ template <typename T1, typename F> class UnOp {
 public:
   static inline __host__ __device__ auto op(const T1 &v1) { return F::op(v1); }
 
-  inline __device__ auto operator()(const T1 &v1) { return op(v1); }
+  inline __host__ __device__ auto operator()(const T1 &v1) { return op(v1); }
 
   using scalar_type = std::invoke_result_t<decltype(op), T1>;
 };
@@ -108,7 +108,7 @@ public:
     return F::op(v1, v2);
   }
 
-  inline __device__ auto operator()(const T1 &v1, const T2 &v2)
+  inline __host__ __device__ auto operator()(const T1 &v1, const T2 &v2)
   {
     return op(v1, v2);
   }
@@ -124,7 +124,8 @@ public:
     return F::op(v1, v2, v3);
   }
 
-  inline __device__ auto operator()(const T1 &v1, const T2 &v2, const T3 &v3)
+  inline __host__ __device__ auto operator()(const T1 &v1, const T2 &v2,
+                                            const T3 &v3)
   {
     return op(v1, v2, v3);
   }
@@ -0,0 +1,539 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "kernels/matx_select_kernels.cuh"
+#include "matx_allocator.h"
+#include "matx_deferred.h"
+#include "matx_error.h"
+#include "matx_exec_kernel.h"
+#include "matx_host_executor.h"
+#include "matx_reduce.h"
+#include "matx_tensor.h"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+namespace matx {
+
+/**
+ * Elements of an operator selected by an index operator
+ *
+ * Element i of the result is the element of the input at the row-major linear
+ * index held in element i of idx, so the result has the rank and sizes of idx
+ * whatever the rank of the input. Linear indices are the ones find() writes.
+ */
+template <typename T1, typename T2> class GatherOp {
+private:
+  op_storage_t<T1> op_;
+  op_storage_t<T2> idx_;
+
+public:
+  using matxop = bool;
+  using scalar_type = typename T1::scalar_type;
+
+  inline GatherOp(T1 op, T2 idx) : op_(op), idx_(idx)
+  {
+    static_assert(is_matx_op<T2>(), "Gather indices must be an operator");
+  }
+
+  template <typename... Is> inline __device__ auto operator()(Is... indices)
+  {
+    return SelectElem(op_, static_cast<index_t>(idx_(indices...)));
+  }
+
+  static inline constexpr __host__ __device__ int32_t Rank()
+  {
+    return T2::Rank();
+  }
+  inline __host__ __device__ index_t Size(uint32_t dim) const
+  {
+    return idx_.Size(dim);
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+    PreRunOp(idx_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+    PostRunOp(idx_, stream);
+  }
+};
+
+/**
+ * Helper function to gather the elements of an operator at linear indices
+ *
+ * @param op
+ *   Operator or view to read from
+ * @param idx
+ *   Row-major linear indices into op
+ *
+ * @returns Operator with the rank and sizes of idx
+ */
+template <typename T1, typename T2> auto gather(T1 op, T2 idx)
+{
+  return GatherOp<T1, T2>(op, idx);
+}
+
+/**
+ * Write the values of an operator to the elements of a view at linear
+ * indices, or add them atomically when ADD is set
+ *
+ * The statement has the rank and sizes of the index operator. vals is
+ * broadcast against it like the input of an assignment.
+ */
+template <typename OutType, typename IdxType, typename ValType, bool ADD>
+class ScatterOp
+    : public BaseOp<ScatterOp<OutType, IdxType, ValType, ADD>> {
+private:
+  op_storage_t<OutType> out_;
+  op_storage_t<IdxType> idx_;
+  op_storage_t<ValType> vals_;
+
+public:
+  using scalar_type = typename OutType::scalar_type;
+
+  inline ScatterOp(OutType out, IdxType idx, ValType vals)
+      : out_(out), idx_(idx), vals_(vals)
+  {
+    static_assert(is_matx_op<IdxType>(), "Scatter indices must be an operator");
+    static_assert(!ADD || std::is_same_v<scalar_type, float> ||
+                      std::is_same_v<scalar_type, double> ||
+                      std::is_same_v<scalar_type, int32_t> ||
+                      std::is_same_v<scalar_type, uint32_t> ||
+                      std::is_same_v<scalar_type, unsigned long long> ||
+                      std::is_same_v<scalar_type, cuda::std::complex<float>> ||
+                      std::is_same_v<scalar_type, cuda::std::complex<double>>,
+                  "scatter_add() needs a type with atomicAdd: float, double, "
+                  "int32_t, uint32_t, unsigned long long or complex float "
+                  "or double");
+    if constexpr (Rank() > 0) {
+      for (int i = 0; i < Rank(); i++) {
+        index_t size = get_expanded_size<Rank()>(vals_, i);
+        MATX_ASSERT(size == 0 || size == Size(i), matxInvalidSize);
+      }
+    }
+  }
+
+  template <typename... Is> inline __device__ void operator()(Is... indices)
+  {
+    auto &o = SelectElem(out_, static_cast<index_t>(idx_(indices...)));
+    if constexpr (ADD) {
+      const auto v = static_cast<scalar_type>(get_value(vals_, indices...));
+      if constexpr (is_complex_v<scalar_type>) {
+        // No complex atomicAdd, but each part can be added on its own
+        auto *p = reinterpret_cast<typename scalar_type::value_type *>(&o);
+        atomicAdd(&p[0], v.real());
+        atomicAdd(&p[1], v.imag());
+      }
+      else {
+        atomicAdd(&o, v);
+      }
+    }
+    else {
+      o = static_cast<scalar_type>(get_value(vals_, indices...));
+    }
+  }
+
+  static inline constexpr __host__ __device__ int32_t Rank()
+  {
+    return IdxType::Rank();
+  }
+  inline __host__ __device__ index_t Size(uint32_t dim) const
+  {
+    return idx_.Size(dim);
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(idx_, stream);
+    PreRunOp(vals_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(idx_, stream);
+    PostRunOp(vals_, stream);
+  }
+};
+
+/**
+ * Write values to the elements of a view at linear indices
+ *
+ * Element i of vals is written to the element of out at the row-major linear
+ * index in element i of idx. Which value lands in an element that appears
+ * more than once in idx is unspecified; use scatter_add() to accumulate them.
+ *
+ * @tparam T
+ *   Output data type
+ * @tparam RANK
+ *   Output rank
+ * @tparam IdxType
+ *   Index operator type
+ * @tparam ValType
+ *   Value operator or scalar type
+ *
+ * @param out
+ *   Output view
+ * @param idx
+ *   Row-major linear indices into out
+ * @param vals
+ *   Values to write, broadcast to the sizes of idx
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK, typename IdxType, typename ValType>
+void scatter(tensor_t<T, RANK> out, IdxType idx, ValType vals,
+             cudaStream_t stream = 0)
+{
+  ScatterOp<tensor_t<T, RANK>, IdxType, ValType, false>(out, idx, vals)
+      .run(stream);
+}
+
+/**
+ * Add values atomically to the elements of a view at linear indices
+ *
+ * Same as scatter(), except every value is added to its element, so indices
+ * that repeat accumulate, as in a histogram. The output type must have an
+ * atomicAdd, or be a complex float or double, whose real and imaginary parts
+ * are added separately.
+ *
+ * @tparam T
+ *   Output data type
+ * @tparam RANK
+ *   Output rank
+ * @tparam IdxType
+ *   Index operator type
+ * @tparam ValType
+ *   Value operator or scalar type
+ *
+ * @param out
+ *   Output view
+ * @param idx
+ *   Row-major linear indices into out
+ * @param vals
+ *   Values to add, broadcast to the sizes of idx
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK, typename IdxType, typename ValType>
+void scatter_add(tensor_t<T, RANK> out, IdxType idx, ValType vals,
+                 cudaStream_t stream = 0)
+{
+  ScatterOp<tensor_t<T, RANK>, IdxType, ValType, true>(out, idx, vals)
+      .run(stream);
+}
+
+template <bool FIND, typename T, typename C, typename InType,
+          typename MaskType>
+void InternalSelect(tensor_t<T, 1> &out, tensor_t<C, 0> &count,
+                    const InType &in, const MaskType &mask,
+                    cudaStream_t stream)
+{
+  static_assert(MaskType::Rank() >= 1, "Selection mask must be rank 1 or more");
+
+  deferred_flush(stream);
+
+  index_t n = 1;
+  for (int i = 0; i < MaskType::Rank(); i++) {
+    if constexpr (!FIND) {
+      MATX_ASSERT(in.Size(i) == mask.Size(i), matxInvalidSize);
+    }
+    n *= mask.Size(i);
+  }
+
+  if (n == 0) {
+    exec(count = 0, stream);
+    return;
+  }
+
+  const index_t tiles = (n + SELECT_TILE_SIZE - 1) / SELECT_TILE_SIZE;
+  MATX_ASSERT(tiles <= INT_MAX, matxInvalidSize);
+
+  index_t *counts;
+  matxAlloc(reinterpret_cast<void **>(&counts), 2 * tiles * sizeof(index_t),
+            MATX_ASYNC_DEVICE_MEMORY, stream);
+  index_t *offsets = counts + tiles;
+
+  void *d_temp = nullptr;
+  size_t temp_bytes = 0;
+  cub::DeviceScan::ExclusiveSum(d_temp, temp_bytes, counts, offsets,
+                                static_cast<int>(tiles), stream);
+  matxAlloc(&d_temp, temp_bytes, MATX_ASYNC_DEVICE_MEMORY, stream);
+
+  // find() passes the mask as the input too, which must only be set up once
+  if constexpr (!FIND) {
+    PreRunOp(in, stream);
+  }
+  PreRunOp(mask, stream);
+
+  const auto grid = static_cast<unsigned int>(tiles);
+  SelectCount<<<grid, SELECT_BLOCK_SIZE, 0, stream>>>(counts, mask, n);
+  cub::DeviceScan::ExclusiveSum(d_temp, temp_bytes, counts, offsets,
+                                static_cast<int>(tiles), stream);
+  SelectWrite<FIND><<<grid, SELECT_BLOCK_SIZE, 0, stream>>>(
+      out, count, in, mask, offsets, counts, n);
+
+  if constexpr (!FIND) {
+    PostRunOp(in, stream);
+  }
+  PostRunOp(mask, stream);
+
+  matxFree(d_temp);
+  matxFree(counts);
+}
+
+template <bool FIND, typename T, typename C, typename T2, typename M,
+          int RANK>
+void InternalSelect(tensor_t<T, 1> &out, tensor_t<C, 0> &count,
+                    const tensor_t<T2, RANK> &in, const tensor_t<M, RANK> &mask,
+                    const matxHostExecutor_t &exec)
+{
+  static_assert(RANK >= 1, "Selection mask must be rank 1 or more");
+
+  index_t n = 1;
+  for (int i = 0; i < RANK; i++) {
+    MATX_ASSERT(in.Size(i) == mask.Size(i), matxInvalidSize);
+    n *= mask.Size(i);
+  }
+
+  // The same two passes as the device: count each chunk, scan the counts,
+  // then write each chunk from its offset
+  const index_t chunks = std::max<index_t>(
+      1, std::min<index_t>(exec.GetNumThreads(), n / SELECT_TILE_SIZE));
+  const index_t chunk = (n + chunks - 1) / chunks;
+  std::vector<index_t> counts(static_cast<size_t>(chunks) + 1, 0);
+
+  matxHostParallelFor(
+      chunks, exec.GetNumThreads(), [&](int, index_t start, index_t end) {
+        for (index_t c = start; c < end; c++) {
+          index_t total = 0;
+          for (index_t l = c * chunk; l < std::min(n, (c + 1) * chunk); l++) {
+            total += SelectFlag(mask, l, n);
+          }
+          counts[static_cast<size_t>(c) + 1] = total;
+        }
+      });
+
+  for (index_t c = 0; c < chunks; c++) {
+    counts[static_cast<size_t>(c) + 1] += counts[static_cast<size_t>(c)];
+  }
+
+  const index_t cap = out.Size(0);
+  matxHostParallelFor(
+      chunks, exec.GetNumThreads(), [&](int, index_t start, index_t end) {
+        for (index_t c = start; c < end; c++) {
+          index_t pos = counts[static_cast<size_t>(c)];
+          for (index_t l = c * chunk; l < std::min(n, (c + 1) * chunk); l++) {
+            if (!SelectFlag(mask, l, n)) {
+              continue;
+            }
+
+            if (pos < cap) {
+              if constexpr (FIND) {
+                out(pos) = static_cast<T>(l);
+              }
+              else {
+                out(pos) = static_cast<T>(SelectElem(in, l));
+              }
+            }
+            pos++;
+          }
+        }
+      });
+
+  count() = static_cast<C>(counts[static_cast<size_t>(chunks)]);
+}
+
+/**
+ * Find the elements selected by a mask
+ *
+ * Writes the row-major linear indices of the elements where mask is true, in
+ * increasing order, to out, and their number to count. mask is any operator,
+ * for example the detections of cfar() or a comparison like x > thresh, and
+ * is evaluated on the fly. gather() reads the elements at the indices.
+ *
+ * The selection is a parallel scan in two passes over the mask: each tile
+ * of the mask counts its selected elements, the counts are scanned to give
+ * each tile its offset in the output, and each tile then writes its elements
+ * from that offset. Elements past the end of out are dropped, and count still
+ * holds the number found.
+ *
+ * @tparam T
+ *   Index type
+ * @tparam C
+ *   Count type
+ * @tparam MaskType
+ *   Mask operator type
+ *
+ * @param out
+ *   Linear indices of the selected elements
+ * @param count
+ *   Number of selected elements
+ * @param mask
+ *   Operator that is true for the elements to select
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, typename C, typename MaskType>
+void find(tensor_t<T, 1> out, tensor_t<C, 0> count, const MaskType &mask,
+          cudaStream_t stream = 0)
+{
+  InternalSelect<true>(out, count, mask, mask, stream);
+}
+
+/**
+ * Find the elements selected by a mask on the host
+ *
+ * Host version of find(). The mask is split into one chunk per thread, and
+ * the chunks are counted, scanned and written the same way as the tiles on
+ * the device.
+ *
+ * @tparam T
+ *   Index type
+ * @tparam C
+ *   Count type
+ * @tparam M
+ *   Mask data type
+ * @tparam RANK
+ *   Mask rank
+ *
+ * @param out
+ *   Linear indices of the selected elements
+ * @param count
+ *   Number of selected elements
+ * @param mask
+ *   View that is true for the elements to select
+ * @param exec
+ *   Host executor
+ */
+template <typename T, typename C, typename M, int RANK>
+void find(tensor_t<T, 1> out, tensor_t<C, 0> count,
+          const tensor_t<M, RANK> &mask, const matxHostExecutor_t &exec)
+{
+  if (HostGraphRecord(exec, {HostRead(mask), HostWrite(out), HostWrite(count)},
+                      [out, count, mask](const matxHostExecutor_t &e) {
+                        find(out, count, mask, e);
+                      })) {
+    return;
+  }
+
+  InternalSelect<true>(out, count, mask, mask, exec);
+}
+
+/**
+ * Compact the elements of an operator selected by a mask
+ *
+ * Writes the elements of in where mask is true, in row-major order, to out,
+ * and their number to count. The selection is the same as find(), with the
+ * elements written in place of their indices.
+ *
+ * @tparam T
+ *   Output data type
+ * @tparam C
+ *   Count type
+ * @tparam InType
+ *   Input operator type
+ * @tparam MaskType
+ *   Mask operator type
+ *
+ * @param out
+ *   Selected elements
+ * @param count
+ *   Number of selected elements
+ * @param in
+ *   Input operator
+ * @param mask
+ *   Operator with the sizes of in that is true for the elements to select
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, typename C, typename InType, typename MaskType>
+void compact(tensor_t<T, 1> out, tensor_t<C, 0> count, const InType &in,
+             const MaskType &mask, cudaStream_t stream = 0)
+{
+  static_assert(InType::Rank() == MaskType::Rank(),
+                "Input and mask of compact() must have the same rank");
+  InternalSelect<false>(out, count, in, mask, stream);
+}
+
+/**
+ * Compact the elements of a view selected by a mask on the host
+ *
+ * Host version of compact().
+ *
+ * @tparam T
+ *   Output data type
+ * @tparam C
+ *   Count type
+ * @tparam T2
+ *   Input data type
+ * @tparam M
+ *   Mask data type
+ * @tparam RANK
+ *   Input and mask rank
+ *
+ * @param out
+ *   Selected elements
+ * @param count
+ *   Number of selected elements
+ * @param in
+ *   Input view
+ * @param mask
+ *   View with the sizes of in that is true for the elements to select
+ * @param exec
+ *   Host executor
+ */
+template <typename T, typename C, typename T2, typename M, int RANK>
+void compact(tensor_t<T, 1> out, tensor_t<C, 0> count,
+             const tensor_t<T2, RANK> &in, const tensor_t<M, RANK> &mask,
+             const matxHostExecutor_t &exec)
+{
+  if (HostGraphRecord(exec,
+                      {HostRead(in), HostRead(mask), HostWrite(out),
+                       HostWrite(count)},
+                      [out, count, in, mask](const matxHostExecutor_t &e) {
+                        compact(out, count, in, mask, e);
+                      })) {
+    return;
+  }
+
+  InternalSelect<false>(out, count, in, mask, exec);
+}
+
+} // end namespace matx
@@ -50,6 +50,8 @@ namespace matx {
  */
 template <int RANK> class tensorShape_t {
 public:
+  static_assert(RANK <= MATX_MAX_RANK, "Rank exceeds MATX_MAX_RANK");
+
   tensorShape_t(){};
 
   /**
@@ -168,4 +170,282 @@ operator!=(const tensorShape_t<RANK1> &lhs, const tensorShape_t<RANK2> &rhs)
   return !(lhs == rhs);
 }
 
+/**
+ * Extent of a dimension of a tensorExtents_t that is only known at runtime
+ */
+inline constexpr index_t matxDynamicExtent = -1;
+
+/**
+ * Sizes of a tensor where some or all of the dimensions are known at compile
+ * time
+ *
+ * Each extent is either a size fixed at compile time or matxDynamicExtent,
+ * in which case the size is given at runtime, similar to std::extents. Sizes
+ * of static dimensions are constants, so index arithmetic that uses them can
+ * be folded and loops over them unrolled.
+ *
+ * @tparam EXTENTS
+ *   Size of each dimension, or matxDynamicExtent
+ */
+template <index_t... EXTENTS> class tensorExtents_t {
+public:
+  static_assert(sizeof...(EXTENTS) > 0, "Extents must have at least one "
+                                         "dimension");
+  static_assert(sizeof...(EXTENTS) <= MATX_MAX_RANK,
+                "Rank exceeds MATX_MAX_RANK");
+  static_assert(((EXTENTS == matxDynamicExtent || EXTENTS > 0) && ...),
+                "Static extents must be positive");
+
+  /**
+   * Construct the extents from the sizes of the dynamic dimensions, in order
+   *
+   * @param sizes
+   *   Sizes of the dynamic dimensions
+   */
+  template <typename... S,
+            std::enable_if_t<(std::is_integral_v<S> && ...), bool> = true>
+  __host__ __device__ tensorExtents_t(S... sizes) noexcept
+      : dyn_{static_cast<index_t>(sizes)...}
+  {
+    static_assert(sizeof...(S) == RankDynamic(),
+                  "One size must be given for each dynamic extent");
+  }
+
+  /**
+   * Construct the extents from the sizes of all dimensions. Static
+   * dimensions must match their extent.
+   *
+   * @param sizes
+   *   Sizes of every dimension
+   */
+  __host__ tensorExtents_t(const index_t *sizes)
+  {
+    for (int i = 0; i < Rank(); i++) {
+      if (IsDynamic(i)) {
+        dyn_[DynamicIndex(i)] = sizes[i];
+      }
+      else {
+        MATX_ASSERT_STR(sizes[i] == StaticSize(i), matxInvalidSize,
+                        "Size does not match the static extent");
+      }
+    }
+  }
+
+  /**
+   * Number of dimensions
+   */
+  static inline constexpr __host__ __device__ int32_t Rank()
+  {
+    return sizeof...(EXTENTS);
+  }
+
+  /**
+   * Number of dimensions whose size is only known at runtime
+   */
+  static inline constexpr __host__ __device__ int32_t RankDynamic()
+  {
+    return ((EXTENTS == matxDynamicExtent ? 1 : 0) + ... + 0);
+  }
+
+  /**
+   * Extent of a dimension, or matxDynamicExtent if it's dynamic
+   */
+  static inline constexpr __host__ __device__ index_t StaticSize(int dim)
+  {
+    index_t e = 0;
+    int i = 0;
+    ((e = i++ == dim ? EXTENTS : e), ...);
+    return e;
+  }
+
+  /**
+   * Whether the size of a dimension is only known at runtime
+   */
+  static inline constexpr __host__ __device__ bool IsDynamic(int dim)
+  {
+    return StaticSize(dim) == matxDynamicExtent;
+  }
+
+  /**
+   * Number of elements when every extent is static, or matxDynamicExtent
+   */
+  static inline constexpr __host__ __device__ index_t StaticTotalSize()
+  {
+    return RankDynamic() > 0 ? matxDynamicExtent : (EXTENTS * ... * 1);
+  }
+
+  /**
+   * Size of a dimension
+   */
+  inline __host__ __device__ index_t Size(int dim) const noexcept
+  {
+    return IsDynamic(dim) ? dyn_[DynamicIndex(dim)] : StaticSize(dim);
+  }
+
+  /**
+   * Number of elements
+   */
+  inline __host__ __device__ index_t TotalSize() const noexcept
+  {
+    if constexpr (RankDynamic() == 0) {
+      return StaticTotalSize();
+    }
+    else {
+      index_t total = 1;
+      for (int i = 0; i < Rank(); i++) {
+        total *= Size(i);
+      }
+
+      return total;
+    }
+  }
+
+private:
+  /* Position of a dynamic dimension in dyn_ */
+  static inline constexpr __host__ __device__ int DynamicIndex(int dim)
+  {
+    int d = 0;
+    for (int i = 0; i < dim; i++) {
+      d += IsDynamic(i) ? 1 : 0;
+    }
+
+    return d;
+  }
+
+  index_t dyn_[RankDynamic() > 0 ? RankDynamic() : 1];
+};
+
+/**
+ * Dimensions of an element-wise statement that can be merged into one, and
+ * whether its indices fit in 32 bits
+ *
+ * Adjacent dimensions d and d + 1 can be merged when every view in the
+ * statement has stride(d) == stride(d + 1) * size(d + 1), so walking the two
+ * as a single dimension of size(d) * size(d + 1) and stride(d + 1) visits the
+ * same elements in the same order. exec() records the strides of each view
+ * with Add() and, when dimensions can be merged, launches the statement at
+ * the lower rank so threads decode fewer indices.
+ *
+ * Independently of merging, when the statement has fewer than 2^31 elements
+ * and every offset into its views fits in an int32_t, the statement is
+ * launched with 32-bit index arithmetic even in a 64-bit index build.
+ */
+struct matxCollapse_t {
+  /**
+   * Start an analysis of a statement
+   *
+   * @param rank
+   *   Rank of the statement
+   * @param sizes
+   *   Sizes of the statement
+   * @param merge
+   *   Whether dimensions may be merged. Kernels that give each dimension its
+   *   own meaning, like reductions, only use the analysis for the index width.
+   */
+  matxCollapse_t(int rank, const index_t *sizes, bool merge = true)
+      : rank_(rank), ok_(merge)
+  {
+    index_t total = 1;
+    for (int i = 0; i < rank_; i++) {
+      size_[i] = sizes[i];
+      merge_[i] = i < rank_ - 1;
+      total *= sizes[i];
+    }
+
+    // Leave room for the threads of the last block past the end
+    fits32_ = total <= INT32_MAX - 1024;
+  }
+
+  /**
+   * Record the strides of a view in the statement. Views of a different rank
+   * or with sizes that differ from the statement's are broadcast, so they
+   * stop the statement from being collapsed.
+   *
+   * @param rank
+   *   Rank of the view
+   * @param sizes
+   *   Sizes of the view
+   * @param strides
+   *   Strides of the view
+   */
+  void Add(int rank, const index_t *sizes, const index_t *strides)
+  {
+    index_t last = 0;
+    for (int i = 0; i < rank; i++) {
+      last += (sizes[i] - 1) * (strides[i] < 0 ? -strides[i] : strides[i]);
+    }
+
+    fits32_ = fits32_ && last <= INT32_MAX;
+
+    if (rank != rank_) {
+      ok_ = false;
+      return;
+    }
+
+    for (int i = 0; i < rank_; i++) {
+      ok_ = ok_ && sizes[i] == size_[i];
+    }
+
+    for (int i = 0; i < rank_ - 1; i++) {
+      merge_[i] = merge_[i] && strides[i] == strides[i + 1] * size_[i + 1];
+    }
+  }
+
+  /**
+   * Rank of the statement after merging
+   */
+  int Rank() const
+  {
+    if (!ok_) {
+      return rank_;
+    }
+
+    int r = rank_;
+    for (int i = 0; i < rank_ - 1; i++) {
+      r -= merge_[i] ? 1 : 0;
+    }
+
+    return r;
+  }
+
+  /**
+   * Whether every index of the statement and every offset into the views
+   * recorded so far fits in an int32_t
+   */
+  bool Fits32() const { return fits32_; }
+
+  /**
+   * Sizes and strides of a view after merging
+   *
+   * @param strides
+   *   Strides of the view
+   * @param nsizes
+   *   Merged sizes, Rank() long
+   * @param nstrides
+   *   Merged strides, Rank() long
+   */
+  void Apply(const index_t *strides, index_t *nsizes, index_t *nstrides) const
+  {
+    int d = 0;
+    nsizes[0] = size_[0];
+    nstrides[0] = strides[0];
+    for (int i = 1; i < rank_; i++) {
+      if (!ok_ || !merge_[i - 1]) {
+        d++;
+        nsizes[d] = 1;
+      }
+
+      nsizes[d] *= size_[i];
+      nstrides[d] = strides[i];
+    }
+  }
+
+private:
+  int rank_;
+  bool ok_;
+  bool fits32_;
+  index_t size_[MATX_MAX_RANK];
+  bool merge_[MATX_MAX_RANK];
+};
+
 }; // namespace matx
\ No newline at end of file
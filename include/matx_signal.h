@@ -32,56 +32,406 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
 #include <cstdint>
+#include <numeric>
 #include <type_traits>
+#include <vector>
 
+#include "kernels/matx_channelize_kernels.cuh"
+#include "kernels/matx_czt_kernels.cuh"
+#include "kernels/matx_dct_kernels.cuh"
+#include "kernels/matx_resample_kernels.cuh"
+#include "kernels/matx_stft_kernels.cuh"
 #include "matx_allocator.h"
+#include "matx_cache.h"
+#include "matx_deferred.h"
 #include "matx_error.h"
+#include "matx_fft.h"
+#include "matx_host_fft.h"
+#include "matx_host_solver.h"
 #include "matx_shape.h"
 #include "matx_tensor.h"
 #include "matx_type_utils.h"
+#include "matx_window.h"
 
 namespace matx {
 namespace signal {
 
-/* Operator for perfoming the 2*exp(-j*pi*k/(2N)) part of the DCT */
-template <typename O, typename I> class dctOp : public BaseOp<dctOp<O, I>> {
-private:
-  O out_;
-  I in_;
-  index_t N_;
+/**
+ * Parameters needed to compute a batched DCT. Plans are specific to the
+ * number of rows, the length, the type and whether they run on the host.
+ */
+struct DctParams_t {
+  index_t rows;
+  index_t n;
+  dctType_t type;
+  MatXDataType_t dtype;
+  bool host;
+  cudaStream_t stream;
+};
 
+/**
+ * Plan for batched discrete cosine transforms
+ *
+ * Each DCT is computed from a single FFT with pre and post processing
+ * passes. DCT-II and DCT-III reorder the input into even and odd samples so
+ * an N-point real FFT (or inverse real FFT) does the work, and DCT-IV packs
+ * the input into an N / 2-point complex FFT. The twiddles for the passes are
+ * computed once in double precision when the plan is created, and the FFT
+ * plans and buffers belong to the plan, so executing it allocates nothing.
+ *
+ * @tparam T
+ *   Data type. Must be float or double
+ */
+template <typename T> class matxDctPlan_t {
 public:
-  dctOp(O out, I in, index_t N) : out_(out), in_(in), N_(N) {}
+  using complex_type = cuda::std::complex<T>;
+
+  /**
+   * Construct a DCT plan
+   *
+   * @param rows
+   *   Number of transforms in each batch. Only used on the device
+   * @param n
+   *   Length of each transform. Must be even for DCT-IV
+   * @param type
+   *   DCT variant
+   * @param host
+   *   Create the plan for the host instead of the device
+   */
+  matxDctPlan_t(index_t rows, index_t n, dctType_t type, bool host)
+      : rows_(rows), n_(n), type_(type), host_(host)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "DCT type must be float or double");
+    MATX_ASSERT(rows > 0 && n > 0, matxInvalidSize);
+    MATX_ASSERT(type != DCT_TYPE_IV || n % 2 == 0, matxInvalidSize);
+
+    htw_ = MakeTwiddles(n, type);
+    nfft_ = (type == DCT_TYPE_IV) ? n / 2 : n;
+    if (host_) {
+      hfft_ = GetHostFFTPlan<complex_type>(nfft_);
+      return;
+    }
+
+    // The real buffer is only used by DCT-II and DCT-III, and DCT-IV is done
+    // in place in the spectrum buffer
+    const index_t nb = n / 2 + 1;
+    matxAlloc((void **)&tw_, n * sizeof(complex_type), MATX_DEVICE_MEMORY);
+    matxAlloc((void **)&spec_, rows * nb * sizeof(complex_type),
+              MATX_DEVICE_MEMORY);
+    cudaMemcpy(tw_, htw_.data(), n * sizeof(complex_type),
+               cudaMemcpyHostToDevice);
+
+    if (type == DCT_TYPE_IV) {
+      tensor_t<complex_type, 2> spec_v(spec_, {rows, nfft_});
+      c2c_ = new matxFFTPlan1D_t<complex_type, complex_type>{spec_v, spec_v};
+      return;
+    }
+
+    matxAlloc((void **)&buf_, rows * n * sizeof(T), MATX_DEVICE_MEMORY);
+    tensor_t<T, 2> buf_v(buf_, {rows, n});
+    tensor_t<complex_type, 2> spec_v(spec_, {rows, nb});
+    if (type == DCT_TYPE_II) {
+      r2c_ = new matxFFTPlan1D_t<complex_type, T>{spec_v, buf_v};
+    }
+    else {
+      c2r_ = new matxFFTPlan1D_t<T, complex_type>{buf_v, spec_v};
+    }
+  }
+
+  /**
+   * DCT plan destructor
+   *
+   * Frees the buffers, twiddles and FFT plans
+   */
+  ~matxDctPlan_t()
+  {
+    if (host_) {
+      return;
+    }
 
-  __device__ inline void operator()(index_t idx)
+    delete r2c_;
+    delete c2r_;
+    delete c2c_;
+    matxFree(tw_);
+    matxFree(spec_);
+    if (buf_ != nullptr) {
+      matxFree(buf_);
+    }
+  }
+
+  /**
+   * Twiddles for the pre and post processing passes of a DCT of length n.
+   * Scale factors of the transform are folded in so the passes are a single
+   * complex multiply.
+   */
+  static std::vector<complex_type> MakeTwiddles(index_t n, dctType_t type)
+  {
+    std::vector<complex_type> tw(static_cast<size_t>(n));
+    const double N = static_cast<double>(n);
+    auto rot = [](double scale, double ph) {
+      return complex_type{static_cast<T>(scale * cos(ph)),
+                          static_cast<T>(scale * sin(ph))};
+    };
+
+    if (type == DCT_TYPE_II) {
+      for (index_t k = 0; k < n; k++) {
+        tw[k] = rot(2.0, -M_PI * static_cast<double>(k) / (2.0 * N));
+      }
+    }
+    else if (type == DCT_TYPE_III) {
+      for (index_t k = 0; k <= n / 2; k++) {
+        tw[k] = rot(N, M_PI * static_cast<double>(k) / (2.0 * N));
+      }
+    }
+    else {
+      for (index_t k = 0; k < n / 2; k++) {
+        tw[k] = rot(1.0, -M_PI * static_cast<double>(4 * k + 1) / (4.0 * N));
+        tw[n / 2 + k] = rot(2.0, -M_PI * static_cast<double>(k) / N);
+      }
+    }
+
+    return tw;
+  }
+
+  /**
+   * Execute the DCT on the device
+   *
+   * @param out
+   *   Output tensor
+   * @param in
+   *   Input tensor
+   * @param stream
+   *   CUDA stream
+   */
+  template <int RANK>
+  void Exec(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+            cudaStream_t stream)
+  {
+    const index_t nb = n_ / 2 + 1;
+    dim3 block(DCT_BLOCK_SIZE);
+    dim3 grid(static_cast<unsigned int>((n_ + DCT_BLOCK_SIZE - 1) /
+                                        DCT_BLOCK_SIZE),
+              static_cast<unsigned int>(std::min<index_t>(rows_, 65535)));
+
+    if (type_ == DCT_TYPE_II) {
+      tensor_t<T, 2> buf_v(buf_, {rows_, n_});
+      tensor_t<complex_type, 2> spec_v(spec_, {rows_, nb});
+      DctIIPre<<<grid, block, 0, stream>>>(buf_, in, n_, rows_);
+      r2c_->Forward(spec_v, buf_v, stream);
+      DctIIPost<<<grid, block, 0, stream>>>(out, spec_, tw_, n_, rows_);
+    }
+    else if (type_ == DCT_TYPE_III) {
+      tensor_t<T, 2> buf_v(buf_, {rows_, n_});
+      tensor_t<complex_type, 2> spec_v(spec_, {rows_, nb});
+      DctIIIPre<<<grid, block, 0, stream>>>(spec_, in, tw_, n_, rows_);
+      c2r_->Inverse(buf_v, spec_v, stream);
+      DctIIIPost<<<grid, block, 0, stream>>>(out, buf_, n_, rows_);
+    }
+    else {
+      tensor_t<complex_type, 2> spec_v(spec_, {rows_, nfft_});
+      DctIVPre<<<grid, block, 0, stream>>>(spec_, in, tw_, n_, rows_);
+      c2c_->Forward(spec_v, spec_v, stream);
+      DctIVPost<<<grid, block, 0, stream>>>(out, spec_, tw_, n_, rows_);
+    }
+  }
+
+  /**
+   * Execute the DCT on the host
+   *
+   * Rows are split across threads, and each thread runs the same passes as
+   * the device through the host FFT.
+   *
+   * @param out
+   *   Output tensor
+   * @param in
+   *   Input tensor
+   * @param exec
+   *   Host executor
+   */
+  template <int RANK>
+  void Exec(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+            const matxHostExecutor_t &exec)
   {
-    out_(idx) =
-        in_(idx).real() * 2.0f * cuda::std::cos(-1 * M_PI * idx / (2.0 * N_)) -
-        in_(idx).imag() * 2.0f * cuda::std::sin(-1 * M_PI * idx / (2.0 * N_));
+    index_t rows = 1;
+    for (int i = 0; i < RANK - 1; i++) {
+      rows *= in.Size(i);
+    }
+
+    const index_t N = n_;
+    const complex_type *tw = htw_.data();
+    matxHostParallelFor(
+        rows, exec.GetNumThreads(), [&](int, index_t start, index_t end) {
+          std::vector<complex_type> row(static_cast<size_t>(nfft_));
+          std::vector<complex_type> work(
+              static_cast<size_t>(hfft_->WorkSize()));
+          for (index_t b = start; b < end; b++) {
+            if (type_ == DCT_TYPE_II) {
+              for (index_t n = 0; n < N; n++) {
+                row[n] = static_cast<T>(DctElem(in, b, DctReorder(n, N)));
+              }
+              hfft_->Forward(row.data(), work.data());
+              for (index_t k = 0; k < N; k++) {
+                DctElem(out, b, k) = DctIIOutput(row.data(), tw, k, N);
+              }
+            }
+            else if (type_ == DCT_TYPE_III) {
+              for (index_t k = 0; k <= N / 2; k++) {
+                row[k] = DctIIIInput(in, tw, b, k, N);
+              }
+              for (index_t k = N / 2 + 1; k < N; k++) {
+                row[k] = HostConj(row[N - k]);
+              }
+              hfft_->Inverse(row.data(), work.data());
+              for (index_t n = 0; n < N; n++) {
+                DctElem(out, b, DctReorder(n, N)) = row[n].real();
+              }
+            }
+            else {
+              for (index_t n = 0; n < N / 2; n++) {
+                row[n] = DctIVInput(in, tw, b, n, N);
+              }
+              hfft_->Forward(row.data(), work.data());
+              for (index_t k = 0; k < N / 2; k++) {
+                DctIVOutput(out, row.data(), tw, b, k, N);
+              }
+            }
+          }
+        });
   }
 
-  __host__ __device__ inline index_t Size(uint32_t i) const
+private:
+  index_t rows_;
+  index_t n_;
+  index_t nfft_;
+  dctType_t type_;
+  bool host_;
+  std::vector<complex_type> htw_;
+  complex_type *tw_ = nullptr;
+  complex_type *spec_ = nullptr;
+  T *buf_ = nullptr;
+  matxFFTPlan1D_t<complex_type, T> *r2c_ = nullptr;
+  matxFFTPlan1D_t<T, complex_type> *c2r_ = nullptr;
+  matxFFTPlan1D_t<complex_type, complex_type> *c2c_ = nullptr;
+  matxHostFFTPlan1D_t<complex_type> *hfft_ = nullptr;
+};
+
+/**
+ * Crude hash on DCT parameters to get a reasonably good delta for collisions.
+ * This doesn't need to be perfect, but fast enough to not slow down lookups,
+ * and different enough so the common DCT parameters change
+ */
+struct DctParamsKeyHash {
+  std::size_t operator()(const DctParams_t &k) const noexcept
   {
-    return out_.Size(i);
+    return std::hash<index_t>()(k.rows) + std::hash<index_t>()(k.n) +
+           std::hash<index_t>()(k.type) + std::hash<index_t>()(k.host) +
+           std::hash<index_t>()((size_t)k.stream);
   }
+};
 
-  static inline constexpr __host__ __device__ int32_t Rank()
+/**
+ * Test DCT parameters for equality. Unlike the hash, all parameters must
+ * match.
+ */
+struct DctParamsKeyEq {
+  bool operator()(const DctParams_t &l, const DctParams_t &t) const noexcept
   {
-    return O::Rank();
+    return l.rows == t.rows && l.n == t.n && l.type == t.type &&
+           l.dtype == t.dtype && l.host == t.host && l.stream == t.stream;
   }
 };
 
+// Static cache of DCT plans
+static matxCache_t<DctParams_t, DctParamsKeyHash, DctParamsKeyEq> dct_cache;
+
+/**
+ * Get a cached DCT plan for the shape of in, creating it if it doesn't exist.
+ * Host plans don't depend on the number of rows or the stream.
+ */
+template <typename T, int RANK>
+matxDctPlan_t<T> *GetDctPlan(const tensor_t<T, RANK> &out,
+                             const tensor_t<T, RANK> &in, dctType_t type,
+                             bool host, cudaStream_t stream)
+{
+  static_assert(RANK >= 1 && RANK <= 4, "DCT tensors must be rank 1 to 4");
+
+  DctParams_t params;
+  params.rows = 1;
+  for (int i = 0; i < RANK; i++) {
+    MATX_ASSERT(out.Size(i) == in.Size(i), matxInvalidSize);
+    if (i < RANK - 1) {
+      params.rows *= in.Size(i);
+    }
+  }
+
+  params.n = in.Size(RANK - 1);
+  params.type = type;
+  params.dtype = TypeToInt<T>();
+  params.host = host;
+  params.stream = stream;
+  if (host) {
+    params.rows = 1;
+  }
+
+  auto ret = dct_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    auto tmp = new matxDctPlan_t<T>{params.rows, params.n, type, host};
+    dct_cache.Insert(params, static_cast<void *>(tmp));
+    return tmp;
+  }
+
+  return static_cast<matxDctPlan_t<T> *>(ret.value());
+}
+
 /**
  * Discrete Cosine Transform
  *
- * Computes the DCT of input sequence "in". The input and output ranks must be
- *1, and the sizes must match.
+ * Computes a DCT of each row of the last dimension of "in", with any leading
+ * dimensions treated as batches. The transforms are unnormalized and match
+ * scipy.fft.dct for types 2, 3 and 4, so DCT-III is the inverse of DCT-II
+ * scaled by 2N. Every row is transformed by one batched FFT of length N, or
+ * N / 2 for DCT-IV, between a pre and post processing pass. The plan, its
+ * buffers and twiddles are cached, so repeated calls don't allocate.
  *
  * @tparam T
- *   Input data type
+ *   Data type. Must be float or double
+ * @tparam RANK
+ *   Rank of input and output tensor. Must be 1 to 4
+ *
+ * @param out
+ *   Output tensor. Must be the same shape as the input
+ * @param in
+ *   Input tensor
+ * @param type
+ *   DCT variant. DCT-IV requires an even length
+ * @param stream
+ *   CUDA stream
+ *
+ **/
+template <typename T, int RANK>
+void dct(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, dctType_t type,
+         const cudaStream_t stream = 0)
+{
+  deferred_flush(stream);
+
+  GetDctPlan(out, in, type, false, stream)->Exec(out, in, stream);
+}
+
+/**
+ * Discrete Cosine Transform
+ *
+ * Computes the DCT-II of each row of "in". See the overload taking a
+ * dctType_t for details.
+ *
+ * @tparam T
+ *   Data type. Must be float or double
  * @tparam RANK
- *   Rank of input and output tensor. Must be 1
+ *   Rank of input and output tensor. Must be 1 to 4
  *
  * @param out
  *   Output tensor
@@ -92,17 +442,1772 @@ public:
  *
  **/
 template <typename T, int RANK>
-void dct(tensor_t<T, RANK> &out, tensor_t<T, RANK> &in,
+void dct(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+         const cudaStream_t stream = 0)
+{
+  dct(out, in, DCT_TYPE_II, stream);
+}
+
+/**
+ * Discrete Cosine Transform on the host
+ *
+ * Host version of dct()
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param type
+ *   DCT variant. DCT-IV requires an even length
+ * @param exec
+ *   Host executor
+ *
+ **/
+template <typename T, int RANK>
+void dct(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, dctType_t type,
+         const matxHostExecutor_t &exec)
+{
+  auto plan = GetDctPlan(out, in, type, true, 0);
+  if (HostGraphRecord(exec, {HostRead(in), HostWrite(out), HostUse(plan)},
+                      [plan, out, in](const matxHostExecutor_t &e) mutable {
+                        plan->Exec(out, in, e);
+                      })) {
+    return;
+  }
+
+  plan->Exec(out, in, exec);
+}
+
+/**
+ * DCT-II on the host
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param exec
+ *   Host executor
+ *
+ **/
+template <typename T, int RANK>
+void dct(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+         const matxHostExecutor_t &exec)
+{
+  dct(out, in, DCT_TYPE_II, exec);
+}
+
+/**
+ * Parameters needed to compute a batched chirp-Z transform. Plans are
+ * specific to the contour, the input and output lengths, the number of rows,
+ * the type and whether they run on the host.
+ */
+struct CztParams_t {
+  index_t rows;
+  index_t n;
+  index_t m;
+  cuda::std::complex<double> w;
+  cuda::std::complex<double> a;
+  MatXDataType_t dtype;
+  bool host;
+  cudaStream_t stream;
+};
+
+/**
+ * Plan for batched chirp-Z transforms
+ *
+ * Computes M points of the z-transform of each row on the spiral contour
+ * z_k = A W^-k with Bluestein's algorithm:
+ *
+ *   X[k] = W^(k^2 / 2) sum_n (x[n] A^-n W^(n^2 / 2)) W^(-(k - n)^2 / 2)
+ *
+ * The sum is a linear convolution with a chirp, done with FFTs of the power
+ * of two length L >= N + M - 1, so the cost depends on the number of output
+ * bins rather than the resolution. The chirps and the spectrum of the chirp
+ * filter are computed once in double precision when the plan is created. The
+ * inverse FFT of the convolution is a forward FFT of the conjugate, with the
+ * 1 / L scaling folded into the output chirp, so each call is a load pass, two
+ * batched FFTs, a multiply pass and a store pass.
+ *
+ * @tparam T
+ *   Precision of the transform. Must be float or double
+ */
+template <typename T> class matxCztPlan_t {
+public:
+  using complex_type = cuda::std::complex<T>;
+
+  /**
+   * Construct a chirp-Z transform plan
+   *
+   * @param rows
+   *   Number of transforms in each batch. Only used on the device
+   * @param n
+   *   Input length
+   * @param m
+   *   Number of output points
+   * @param w
+   *   Ratio between points on the contour
+   * @param a
+   *   Starting point of the contour
+   * @param host
+   *   Create the plan for the host instead of the device
+   */
+  matxCztPlan_t(index_t rows, index_t n, index_t m,
+                cuda::std::complex<double> w, cuda::std::complex<double> a,
+                bool host)
+      : rows_(rows), n_(n), m_(m), host_(host)
+  {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>,
+                  "CZT precision must be float or double");
+    MATX_ASSERT(rows > 0 && n > 0 && m > 0, matxInvalidSize);
+    MATX_ASSERT(w != cuda::std::complex<double>(0) &&
+                    a != cuda::std::complex<double>(0),
+                matxInvalidParameter);
+
+    l_ = 1;
+    while (l_ < n + m - 1) {
+      l_ *= 2;
+    }
+
+    MakeChirps(w, a);
+    if (host_) {
+      hfft_ = GetHostFFTPlan<complex_type>(l_);
+      return;
+    }
+
+    matxAlloc((void **)&pre_, n_ * sizeof(complex_type), MATX_DEVICE_MEMORY);
+    matxAlloc((void **)&post_, m_ * sizeof(complex_type), MATX_DEVICE_MEMORY);
+    matxAlloc((void **)&spec_, l_ * sizeof(complex_type), MATX_DEVICE_MEMORY);
+    matxAlloc((void **)&buf_, rows_ * l_ * sizeof(complex_type),
+              MATX_DEVICE_MEMORY);
+    cudaMemcpy(pre_, hpre_.data(), n_ * sizeof(complex_type),
+               cudaMemcpyHostToDevice);
+    cudaMemcpy(post_, hpost_.data(), m_ * sizeof(complex_type),
+               cudaMemcpyHostToDevice);
+    cudaMemcpy(spec_, hspec_.data(), l_ * sizeof(complex_type),
+               cudaMemcpyHostToDevice);
+
+    tensor_t<complex_type, 2> buf_v(buf_, {rows_, l_});
+    fft_ = new matxFFTPlan1D_t<complex_type, complex_type>{buf_v, buf_v};
+  }
+
+  /**
+   * Chirp-Z transform plan destructor
+   *
+   * Frees the buffers, chirps and FFT plan
+   */
+  ~matxCztPlan_t()
+  {
+    if (host_) {
+      return;
+    }
+
+    delete fft_;
+    matxFree(pre_);
+    matxFree(post_);
+    matxFree(spec_);
+    matxFree(buf_);
+  }
+
+  /**
+   * Execute the chirp-Z transform on the device
+   *
+   * @param out
+   *   Output tensor
+   * @param in
+   *   Input tensor, real or complex
+   * @param stream
+   *   CUDA stream
+   */
+  template <typename InType, int RANK>
+  void Exec(tensor_t<complex_type, RANK> &out, const tensor_t<InType, RANK> &in,
+            cudaStream_t stream)
+  {
+    dim3 block(CZT_BLOCK_SIZE);
+    dim3 grid(static_cast<unsigned int>((l_ + CZT_BLOCK_SIZE - 1) /
+                                        CZT_BLOCK_SIZE),
+              static_cast<unsigned int>(std::min<index_t>(rows_, 65535)));
+    dim3 out_grid(static_cast<unsigned int>((m_ + CZT_BLOCK_SIZE - 1) /
+                                            CZT_BLOCK_SIZE),
+                  grid.y);
+
+    tensor_t<complex_type, 2> buf_v(buf_, {rows_, l_});
+    CztLoad<<<grid, block, 0, stream>>>(buf_, in, pre_, n_, l_, rows_);
+    fft_->Forward(buf_v, buf_v, stream);
+    CztMul<<<grid, block, 0, stream>>>(buf_, spec_, l_, rows_);
+    fft_->Forward(buf_v, buf_v, stream);
+    CztStore<<<out_grid, block, 0, stream>>>(out, buf_, post_, m_, l_, rows_);
+  }
+
+  /**
+   * Execute the chirp-Z transform on the host
+   *
+   * Rows are split across threads, and each thread runs the same passes as
+   * the device through the host FFT.
+   *
+   * @param out
+   *   Output tensor
+   * @param in
+   *   Input tensor, real or complex
+   * @param exec
+   *   Host executor
+   */
+  template <typename InType, int RANK>
+  void Exec(tensor_t<complex_type, RANK> &out, const tensor_t<InType, RANK> &in,
+            const matxHostExecutor_t &exec)
+  {
+    index_t rows = 1;
+    for (int i = 0; i < RANK - 1; i++) {
+      rows *= in.Size(i);
+    }
+
+    const complex_type *pre = hpre_.data();
+    const complex_type *post = hpost_.data();
+    matxHostParallelFor(
+        rows, exec.GetNumThreads(), [&](int, index_t start, index_t end) {
+          std::vector<complex_type> row(static_cast<size_t>(l_));
+          std::vector<complex_type> work(
+              static_cast<size_t>(hfft_->WorkSize()));
+          for (index_t b = start; b < end; b++) {
+            for (index_t i = 0; i < l_; i++) {
+              row[i] = CztInput(in, pre, b, i, n_);
+            }
+            hfft_->Forward(row.data(), work.data());
+            for (index_t i = 0; i < l_; i++) {
+              row[i] = HostConj(row[i] * hspec_[i]);
+            }
+            hfft_->Forward(row.data(), work.data());
+            for (index_t k = 0; k < m_; k++) {
+              CztElem(out, b, k) = CztOutput(row.data(), post, k);
+            }
+          }
+        });
+  }
+
+private:
+  /**
+   * Compute the input and output chirps and the spectrum of the chirp filter.
+   * Powers of W and A are taken on the principal branch, the same as
+   * scipy.signal.czt.
+   */
+  void MakeChirps(cuda::std::complex<double> w, cuda::std::complex<double> a)
+  {
+    using dcomplex = std::complex<double>;
+    const dcomplex lw = std::log(dcomplex(w.real(), w.imag()));
+    const dcomplex la = std::log(dcomplex(a.real(), a.imag()));
+    auto chirp = [&](double p, double q) {
+      const dcomplex v = std::exp(p * lw + q * la);
+      return complex_type{static_cast<T>(v.real()), static_cast<T>(v.imag())};
+    };
+
+    hpre_.resize(static_cast<size_t>(n_));
+    for (index_t i = 0; i < n_; i++) {
+      const double di = static_cast<double>(i);
+      hpre_[i] = chirp(di * di / 2.0, -di);
+    }
+
+    hpost_.resize(static_cast<size_t>(m_));
+    for (index_t k = 0; k < m_; k++) {
+      const double dk = static_cast<double>(k);
+      hpost_[k] = chirp(dk * dk / 2.0, 0.0) / static_cast<T>(l_);
+    }
+
+    // Chirp filter covering lags -(n - 1) to m - 1, with the negative lags
+    // wrapped to the end of the circular convolution
+    hspec_.assign(static_cast<size_t>(l_), complex_type(0));
+    for (index_t j = 0; j < m_; j++) {
+      const double dj = static_cast<double>(j);
+      hspec_[j] = chirp(-dj * dj / 2.0, 0.0);
+    }
+    for (index_t j = 1; j < n_; j++) {
+      const double dj = static_cast<double>(j);
+      hspec_[l_ - j] = chirp(-dj * dj / 2.0, 0.0);
+    }
+
+    auto plan = GetHostFFTPlan<complex_type>(l_);
+    std::vector<complex_type> work(static_cast<size_t>(plan->WorkSize()));
+    plan->Forward(hspec_.data(), work.data());
+  }
+
+  index_t rows_;
+  index_t n_;
+  index_t m_;
+  index_t l_;
+  bool host_;
+  std::vector<complex_type> hpre_;
+  std::vector<complex_type> hpost_;
+  std::vector<complex_type> hspec_;
+  complex_type *pre_ = nullptr;
+  complex_type *post_ = nullptr;
+  complex_type *spec_ = nullptr;
+  complex_type *buf_ = nullptr;
+  matxFFTPlan1D_t<complex_type, complex_type> *fft_ = nullptr;
+  matxHostFFTPlan1D_t<complex_type> *hfft_ = nullptr;
+};
+
+struct CztParamsKeyHash {
+  std::size_t operator()(const CztParams_t &k) const noexcept
+  {
+    return std::hash<index_t>()(k.rows) + std::hash<index_t>()(k.n) +
+           std::hash<index_t>()(k.m) + std::hash<double>()(k.w.imag()) +
+           std::hash<double>()(k.a.imag()) + std::hash<index_t>()(k.host) +
+           std::hash<index_t>()((size_t)k.stream);
+  }
+};
+
+struct CztParamsKeyEq {
+  bool operator()(const CztParams_t &l, const CztParams_t &t) const noexcept
+  {
+    return l.rows == t.rows && l.n == t.n && l.m == t.m && l.w == t.w &&
+           l.a == t.a && l.dtype == t.dtype && l.host == t.host &&
+           l.stream == t.stream;
+  }
+};
+
+// Static cache of chirp-Z transform plans
+static matxCache_t<CztParams_t, CztParamsKeyHash, CztParamsKeyEq> czt_cache;
+
+/**
+ * Get a cached chirp-Z transform plan for the shapes of out and in, creating
+ * it if it doesn't exist. Host plans don't depend on the number of rows or
+ * the stream.
+ */
+template <typename T, typename InType, int RANK>
+matxCztPlan_t<value_type_t<T>> *
+GetCztPlan(const tensor_t<T, RANK> &out, const tensor_t<InType, RANK> &in,
+           cuda::std::complex<double> w, cuda::std::complex<double> a,
+           bool host, cudaStream_t stream)
+{
+  static_assert(RANK >= 1 && RANK <= 4, "CZT tensors must be rank 1 to 4");
+  static_assert(is_complex_v<T>, "CZT output must be complex");
+
+  CztParams_t params;
+  params.rows = 1;
+  for (int i = 0; i < RANK - 1; i++) {
+    MATX_ASSERT(out.Size(i) == in.Size(i), matxInvalidSize);
+    params.rows *= in.Size(i);
+  }
+
+  params.n = in.Size(RANK - 1);
+  params.m = out.Size(RANK - 1);
+  params.w = w;
+  params.a = a;
+  params.dtype = TypeToInt<T>();
+  params.host = host;
+  params.stream = stream;
+  if (host) {
+    params.rows = 1;
+  }
+
+  auto ret = czt_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    auto tmp = new matxCztPlan_t<value_type_t<T>>{params.rows, params.n,
+                                                   params.m, w, a, host};
+    czt_cache.Insert(params, static_cast<void *>(tmp));
+    return tmp;
+  }
+
+  return static_cast<matxCztPlan_t<value_type_t<T>> *>(ret.value());
+}
+
+/**
+ * Chirp-Z transform
+ *
+ * Computes m points of the z-transform of each row of the last dimension of
+ * "in" along the spiral contour z_k = a w^-k, k = 0 ... m - 1:
+ *
+ *   out[k] = sum_n in[n] a^-n w^(n k)
+ *
+ * the same as scipy.signal.czt. Leading dimensions are batches. The
+ * transform uses Bluestein's algorithm with a cached plan holding the chirps,
+ * the chirp filter spectrum and the FFT plan, so only m output bins are
+ * computed rather than a large zero-padded FFT.
+ *
+ * @tparam T
+ *   Complex output type
+ * @tparam InType
+ *   Input type, real or complex
+ * @tparam RANK
+ *   Rank of input and output tensor. Must be 1 to 4
+ *
+ * @param out
+ *   Output tensor with m points in the last dimension
+ * @param in
+ *   Input tensor
+ * @param m
+ *   Number of output points
+ * @param w
+ *   Ratio between points on the contour
+ * @param a
+ *   Starting point of the contour
+ * @param stream
+ *   CUDA stream
+ *
+ **/
+template <typename T, typename InType, int RANK>
+void czt(tensor_t<T, RANK> &out, const tensor_t<InType, RANK> &in, index_t m,
+         cuda::std::complex<double> w, cuda::std::complex<double> a = 1.0,
+         const cudaStream_t stream = 0)
+{
+  deferred_flush(stream);
+
+  MATX_ASSERT(out.Size(RANK - 1) == m, matxInvalidSize);
+  GetCztPlan(out, in, w, a, false, stream)->Exec(out, in, stream);
+}
+
+/**
+ * Chirp-Z transform around the unit circle
+ *
+ * Same as the version above with w = exp(-2j pi / m) and a = 1, which is the
+ * m point DFT of the input.
+ *
+ * @param out
+ *   Output tensor with m points in the last dimension
+ * @param in
+ *   Input tensor
+ * @param m
+ *   Number of output points
+ * @param stream
+ *   CUDA stream
+ *
+ **/
+template <typename T, typename InType, int RANK>
+void czt(tensor_t<T, RANK> &out, const tensor_t<InType, RANK> &in, index_t m,
          const cudaStream_t stream = 0)
 {
-  MATX_ASSERT(RANK == 1, matxInvalidDim);
-  index_t N = in.Size(RANK - 1);
+  const auto w = std::polar(1.0, -2.0 * M_PI / static_cast<double>(m));
+  czt(out, in, m, cuda::std::complex<double>{w.real(), w.imag()}, 1.0, stream);
+}
+
+/**
+ * Chirp-Z transform on the host
+ *
+ * Host version of czt()
+ *
+ * @param out
+ *   Output tensor with m points in the last dimension
+ * @param in
+ *   Input tensor
+ * @param m
+ *   Number of output points
+ * @param w
+ *   Ratio between points on the contour
+ * @param a
+ *   Starting point of the contour
+ * @param exec
+ *   Host executor
+ *
+ **/
+template <typename T, typename InType, int RANK>
+void czt(tensor_t<T, RANK> &out, const tensor_t<InType, RANK> &in, index_t m,
+         cuda::std::complex<double> w, cuda::std::complex<double> a,
+         const matxHostExecutor_t &exec)
+{
+  MATX_ASSERT(out.Size(RANK - 1) == m, matxInvalidSize);
+  auto plan = GetCztPlan(out, in, w, a, true, 0);
+  if (HostGraphRecord(exec, {HostRead(in), HostWrite(out), HostUse(plan)},
+                      [plan, out, in](const matxHostExecutor_t &e) mutable {
+                        plan->Exec(out, in, e);
+                      })) {
+    return;
+  }
+
+  plan->Exec(out, in, exec);
+}
+
+/**
+ * Contour of a zoom FFT from f1 to f2 over the points of the output, the same
+ * as scipy.signal.ZoomFFT
+ */
+inline void ZoomFFTContour(double f1, double f2, double fs, index_t m,
+                           bool endpoint, cuda::std::complex<double> &w,
+                           cuda::std::complex<double> &a)
+{
+  MATX_ASSERT(fs > 0.0, matxInvalidParameter);
+  const double steps = static_cast<double>(endpoint && m > 1 ? m - 1 : m);
+  const auto wd = std::polar(1.0, -2.0 * M_PI * (f2 - f1) / (steps * fs));
+  const auto ad = std::polar(1.0, 2.0 * M_PI * f1 / fs);
+  w = cuda::std::complex<double>{wd.real(), wd.imag()};
+  a = cuda::std::complex<double>{ad.real(), ad.imag()};
+}
+
+/**
+ * Zoom FFT
+ *
+ * Computes the DFT of each row of the last dimension of "in" at the points
+ * of the output spread evenly over the band from f1 to f2, with the same
+ * definition as scipy.signal.zoomfft. This gives a narrow band at high
+ * resolution for the cost of the output bins, where the FFT would need a
+ * large zero-padded transform for the same bin spacing. It is a chirp-Z
+ * transform on the unit circle, and uses the same cached plans as czt().
+ *
+ * @tparam T
+ *   Complex output type
+ * @tparam InType
+ *   Input type, real or complex
+ * @tparam RANK
+ *   Rank of input and output tensor. Must be 1 to 4
+ *
+ * @param out
+ *   Output tensor. The size of the last dimension is the number of bins
+ * @param in
+ *   Input tensor
+ * @param f1
+ *   Start of the band
+ * @param f2
+ *   End of the band
+ * @param fs
+ *   Sampling frequency
+ * @param endpoint
+ *   Whether the last bin is at f2, or one bin spacing before it
+ * @param stream
+ *   CUDA stream
+ *
+ **/
+template <typename T, typename InType, int RANK>
+void zoomfft(tensor_t<T, RANK> &out, const tensor_t<InType, RANK> &in,
+             double f1, double f2, double fs = 2.0, bool endpoint = false,
+             const cudaStream_t stream = 0)
+{
+  const index_t m = out.Size(RANK - 1);
+  cuda::std::complex<double> w, a;
+  ZoomFFTContour(f1, f2, fs, m, endpoint, w, a);
+  czt(out, in, m, w, a, stream);
+}
 
-  tensor_t<cuda::std::complex<T>, 1> tmp{{N + 1}};
-  fft(tmp, in);
-  auto s = tmp.Slice({0}, {N});
-  dctOp(out, s, N).run(stream);
+/**
+ * Zoom FFT on the host
+ *
+ * Host version of zoomfft()
+ *
+ * @param out
+ *   Output tensor. The size of the last dimension is the number of bins
+ * @param in
+ *   Input tensor
+ * @param f1
+ *   Start of the band
+ * @param f2
+ *   End of the band
+ * @param fs
+ *   Sampling frequency
+ * @param endpoint
+ *   Whether the last bin is at f2, or one bin spacing before it
+ * @param exec
+ *   Host executor
+ *
+ **/
+template <typename T, typename InType, int RANK>
+void zoomfft(tensor_t<T, RANK> &out, const tensor_t<InType, RANK> &in,
+             double f1, double f2, double fs, bool endpoint,
+             const matxHostExecutor_t &exec)
+{
+  const index_t m = out.Size(RANK - 1);
+  cuda::std::complex<double> w, a;
+  ZoomFFTContour(f1, f2, fs, m, endpoint, w, a);
+  czt(out, in, m, w, a, exec);
 }
 
+/**
+ * Parameters needed to compute a short-time Fourier transform. Plans only
+ * depend on the number of frames, the FFT size and whether the spectrum goes
+ * through a buffer, so signals with different frame layouts or windows can
+ * share a plan.
+ */
+struct StftParams_t {
+  index_t rows; // Total frames across all batches
+  index_t nfft;
+  bool buffered; // Power output, or a complex output that isn't contiguous
+  MatXDataType_t dtype;
+  cudaStream_t stream;
+};
+
+template <typename T> class matxStftPlan_t {
+public:
+  using spec_type =
+      std::conditional_t<is_complex_v<T>, T, cuda::std::complex<T>>;
+
+  /**
+   * Construct a short-time Fourier transform plan
+   *
+   * The plan owns a buffer holding every windowed frame and a batched 1D
+   * FFT plan over it. A buffered plan also owns a buffer for the spectrum of
+   * every frame, which is needed for a power output or a complex output
+   * that isn't contiguous. Otherwise the FFT writes the output directly.
+   * Nothing is allocated when the plan is executed, so a cached plan can be
+   * run repeatedly, or captured in a CUDA graph. Real input produces the
+   * nfft / 2 + 1 one-sided bins, and complex input produces all nfft bins.
+   *
+   * @param rows
+   *   Number of frames across all batch dimensions
+   * @param nfft
+   *   Size of the FFT of each frame
+   * @param buffered
+   *   Whether the spectrum goes through the plan's buffer
+   */
+  matxStftPlan_t(index_t rows, index_t nfft, bool buffered)
+      : rows_(rows), nfft_(nfft), buffered_(buffered)
+  {
+    MATX_ASSERT(rows > 0 && nfft > 0, matxInvalidSize);
+    nbins_ = is_complex_v<T> ? nfft : nfft / 2 + 1;
+
+    matxAlloc((void **)&buf_, rows_ * nfft_ * sizeof(T), MATX_DEVICE_MEMORY);
+    if (buffered_) {
+      matxAlloc((void **)&spec_, rows_ * nbins_ * sizeof(spec_type),
+                MATX_DEVICE_MEMORY);
+    }
+
+    // Only the shapes are used to build the FFT plan
+    tensor_t<T, 2> buf_v(buf_, {rows_, nfft_});
+    tensor_t<spec_type, 2> spec_v(spec_, {rows_, nbins_});
+    fft_ = new matxFFTPlan1D_t<spec_type, T>{spec_v, buf_v};
+  }
+
+  template <typename OutType, int RANK>
+  static StftParams_t GetStftParams(const tensor_t<OutType, RANK + 1> &out,
+                                    const tensor_t<T, RANK> &x,
+                                    index_t nperseg, index_t noverlap,
+                                    index_t nfft)
+  {
+    static_assert(RANK >= 1 && RANK <= 3,
+                  "STFT input must be rank 1 to 3");
+    MATX_ASSERT(nperseg > 0 && nperseg <= x.Size(RANK - 1), matxInvalidSize);
+    MATX_ASSERT(noverlap >= 0 && noverlap < nperseg, matxInvalidSize);
+    MATX_ASSERT(nfft >= nperseg, matxInvalidSize);
+
+    StftParams_t params;
+    params.rows = (x.Size(RANK - 1) - nperseg) / (nperseg - noverlap) + 1;
+    for (int i = 0; i < RANK - 1; i++) {
+      params.rows *= x.Size(i);
+    }
+
+    params.nfft = nfft;
+    params.buffered = !is_complex_v<OutType> || !out.IsLinear();
+    params.dtype = TypeToInt<T>();
+
+    return params;
+  }
+
+  /**
+   * STFT plan destructor
+   *
+   * Frees the frame and spectrum buffers and the FFT plan
+   */
+  ~matxStftPlan_t()
+  {
+    delete fft_;
+    matxFree(buf_);
+    if (spec_ != nullptr) {
+      matxFree(spec_);
+    }
+  }
+
+  /**
+   * Execute a short-time Fourier transform
+   *
+   * Windowed frames are loaded from an overlapping view of the input into
+   * the frame buffer and zero padded up to the FFT size, then a single
+   * batched FFT computes the spectrum of every frame. A contiguous complex
+   * output is written by the FFT directly. Otherwise the FFT writes the
+   * plan's spectrum buffer, and a final kernel writes the power |X|^2 of
+   * each bin to a real output, or copies the spectrum to a strided complex
+   * output.
+   *
+   * @tparam OutType
+   *   Output data type. Complex for the spectrum, or real for the power
+   * @tparam WinType
+   *   Window type. Any rank 1 tensor or generator of length nperseg
+   * @tparam RANK
+   *   Rank of the input signal. Leading dimensions are batch dimensions
+   *
+   * @param out
+   *   Output view of shape [..., frames, bins]
+   * @param x
+   *   Input signal
+   * @param win
+   *   Window applied to each frame
+   * @param nperseg
+   *   Samples per frame
+   * @param noverlap
+   *   Samples shared between consecutive frames
+   * @param stream
+   *   CUDA stream
+   */
+#ifdef DOXYGEN_ONLY
+  void Exec(tensor_t &out, const tensor_t &x, WinType win, index_t nperseg,
+            index_t noverlap, cudaStream_t stream)
+  {
+#else
+  template <typename OutType, typename WinType, int RANK>
+  void Exec(tensor_t<OutType, RANK + 1> &out, const tensor_t<T, RANK> &x,
+            WinType win, index_t nperseg, index_t noverlap,
+            cudaStream_t stream)
+  {
+#endif
+    if constexpr (is_complex_v<OutType>) {
+      static_assert(std::is_same_v<OutType, spec_type>,
+                    "Complex STFT output must match the spectrum type");
+    }
+
+    auto frames = x.OverlapView({nperseg}, {nperseg - noverlap});
+    MATX_ASSERT(out.Size(RANK) == nbins_, matxInvalidSize);
+    for (int i = 0; i < RANK; i++) {
+      MATX_ASSERT(out.Size(i) == frames.Size(i), matxInvalidSize);
+    }
+
+    const bool direct = is_complex_v<OutType> && out.IsLinear();
+    MATX_ASSERT_STR(direct != buffered_, matxInvalidParameter,
+                    "STFT output layout doesn't match the plan");
+
+    tensor_t<T, 2> buf_v(buf_, {rows_, nfft_});
+
+    dim3 block(STFT_BLOCK_SIZE);
+    dim3 load_grid(static_cast<unsigned int>(rows_),
+                   static_cast<unsigned int>((nfft_ + STFT_BLOCK_SIZE - 1) /
+                                             STFT_BLOCK_SIZE));
+    StftLoadFrames<<<load_grid, block, 0, stream>>>(
+        buf_, frames, win, static_cast<int>(nperseg),
+        static_cast<int>(nfft_));
+
+    if constexpr (is_complex_v<OutType>) {
+      if (direct) {
+        tensor_t<spec_type, 2> out_v(out.Data(), {rows_, nbins_});
+        fft_->Forward(out_v, buf_v, stream);
+        return;
+      }
+    }
+
+    tensor_t<spec_type, 2> spec_v(spec_, {rows_, nbins_});
+    fft_->Forward(spec_v, buf_v, stream);
+
+    dim3 out_grid(static_cast<unsigned int>(rows_),
+                  static_cast<unsigned int>((nbins_ + STFT_BLOCK_SIZE - 1) /
+                                            STFT_BLOCK_SIZE));
+    if constexpr (is_complex_v<OutType>) {
+      StftCopy<<<out_grid, block, 0, stream>>>(out, spec_,
+                                               static_cast<int>(nbins_));
+    }
+    else {
+      StftPower<<<out_grid, block, 0, stream>>>(out, spec_,
+                                                static_cast<int>(nbins_));
+    }
+  }
+
+private:
+  T *buf_;
+  spec_type *spec_ = nullptr;
+  matxFFTPlan1D_t<spec_type, T> *fft_;
+  index_t rows_;
+  index_t nfft_;
+  index_t nbins_;
+  bool buffered_;
+};
+
+/**
+ * Crude hash on STFT to get a reasonably good delta for collisions. This
+ * doesn't need to be perfect, but fast enough to not slow down lookups, and
+ * different enough so the common STFT parameters change
+ */
+struct StftParamsKeyHash {
+  std::size_t operator()(const StftParams_t &k) const noexcept
+  {
+    return std::hash<index_t>()(k.rows) + std::hash<index_t>()(k.nfft) +
+           std::hash<index_t>()((size_t)k.stream);
+  }
+};
+
+/**
+ * Test STFT parameters for equality. Unlike the hash, all parameters must
+ * match.
+ */
+struct StftParamsKeyEq {
+  bool operator()(const StftParams_t &l, const StftParams_t &t) const noexcept
+  {
+    return l.rows == t.rows && l.nfft == t.nfft &&
+           l.buffered == t.buffered && l.dtype == t.dtype &&
+           l.stream == t.stream;
+  }
+};
+
+// Static cache of STFT plans
+static matxCache_t<StftParams_t, StftParamsKeyHash, StftParamsKeyEq>
+    stft_cache;
+
+template <typename OutType, typename T, int RANK, typename WinType>
+void InternalStft(tensor_t<OutType, RANK + 1> &out, const tensor_t<T, RANK> &x,
+                  WinType win, index_t nperseg, index_t noverlap,
+                  cudaStream_t stream)
+{
+  deferred_flush(stream);
+
+  // The FFT size comes from the output, the same as fft()
+  const index_t nbins = out.Size(RANK);
+  const index_t nfft = is_complex_v<T> ? nbins : (nbins - 1) * 2;
+
+  auto params =
+      matxStftPlan_t<T>::GetStftParams(out, x, nperseg, noverlap, nfft);
+  params.stream = stream;
+
+  // Get cache or new STFT plan if it doesn't exist
+  auto ret = stft_cache.Lookup(params);
+  if (ret == std::nullopt) {
+    auto tmp = new matxStftPlan_t<T>{params.rows, nfft, params.buffered};
+    stft_cache.Insert(params, static_cast<void *>(tmp));
+    tmp->Exec(out, x, win, nperseg, noverlap, stream);
+  }
+  else {
+    auto stft_type = static_cast<matxStftPlan_t<T> *>(ret.value());
+    stft_type->Exec(out, x, win, nperseg, noverlap, stream);
+  }
+}
+
+/**
+ * Short-time Fourier transform
+ *
+ * Splits the last dimension of x into frames of nperseg samples overlapping by
+ * noverlap samples, applies the window to each frame, and takes the FFT of
+ * each frame. Any leading dimensions of x are batch dimensions. The FFT size
+ * is taken from the last dimension of the output the same way as fft(): a
+ * real input with nfft / 2 + 1 output bins, or a complex input with nfft
+ * bins. Frames shorter than the FFT are zero padded. Frames that would run
+ * past the end of the signal are dropped.
+ *
+ * The output is laid out as [..., frame, frequency]. Use Permute() to get a
+ * frequency by time view. The result is not scaled.
+ *
+ * @tparam T
+ *   Input data type
+ * @tparam RANK
+ *   Rank of the input signal
+ * @tparam WinType
+ *   Window type
+ *
+ * @param out
+ *   Complex output view of shape [..., frames, bins]
+ * @param x
+ *   Input signal
+ * @param win
+ *   Window of length nperseg, such as hamming_x({nperseg}) or a tensor
+ * @param nperseg
+ *   Samples per frame
+ * @param noverlap
+ *   Samples shared between consecutive frames
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK, typename WinType>
+void stft(tensor_t<typename matxStftPlan_t<T>::spec_type, RANK + 1> &out,
+          const tensor_t<T, RANK> &x, WinType win, index_t nperseg,
+          index_t noverlap, cudaStream_t stream = 0)
+{
+  InternalStft(out, x, win, nperseg, noverlap, stream);
+}
+
+/**
+ * Spectrogram
+ *
+ * Computes the power |X|^2 of the short-time Fourier transform of x. The
+ * complex spectrum is held in a buffer owned by the cached plan and reduced
+ * to power in a separate pass, so the caller doesn't need a complex
+ * temporary. Parameters and output layout are the same as stft(), with a
+ * real output. As with stft(), the result is not scaled by the window
+ * or sample rate.
+ *
+ * @tparam T
+ *   Input data type
+ * @tparam RANK
+ *   Rank of the input signal
+ * @tparam WinType
+ *   Window type
+ *
+ * @param out
+ *   Real output view of shape [..., frames, bins]
+ * @param x
+ *   Input signal
+ * @param win
+ *   Window of length nperseg, such as hamming_x({nperseg}) or a tensor
+ * @param nperseg
+ *   Samples per frame
+ * @param noverlap
+ *   Samples shared between consecutive frames
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK, typename WinType>
+void spectrogram(tensor_t<value_type_t<T>, RANK + 1> &out,
+                 const tensor_t<T, RANK> &x, WinType win, index_t nperseg,
+                 index_t noverlap, cudaStream_t stream = 0)
+{
+  InternalStft(out, x, win, nperseg, noverlap, stream);
+}
+
+/**
+ * Windowed-sinc lowpass filter with unit gain at DC, the same design as
+ * scipy.signal.firwin with a Kaiser or Hamming window
+ *
+ * @param numtaps
+ *   Filter length
+ * @param cutoff
+ *   Cutoff frequency relative to Nyquist
+ * @param kaiser
+ *   Use a Kaiser window with the given beta instead of a Hamming window
+ * @param beta
+ *   Kaiser window shape
+ */
+inline std::vector<double> ResampleFirwin(index_t numtaps, double cutoff,
+                                          bool kaiser, double beta)
+{
+  std::vector<double> h(static_cast<size_t>(numtaps));
+  const auto w = WindowCoeffs(kaiser ? WINDOW_TYPE_KAISER : WINDOW_TYPE_HAMMING,
+                              numtaps, beta);
+  const double alpha = 0.5 * static_cast<double>(numtaps - 1);
+  double sum = 0.0;
+  for (index_t k = 0; k < numtaps; k++) {
+    const double t = cutoff * (static_cast<double>(k) - alpha);
+    const double sinc = t == 0.0 ? 1.0 : sin(M_PI * t) / (M_PI * t);
+
+    h[k] = cutoff * sinc * w[k];
+    sum += h[k];
+  }
+
+  for (auto &v : h) {
+    v /= sum;
+  }
+
+  return h;
+}
+
+/**
+ * Parameters of a cached default resampling filter
+ */
+struct ResampleTapsParams_t {
+  index_t up;
+  index_t down;
+  bool decimate; // Hamming decimation filter instead of the Kaiser default
+  MatXDataType_t dtype;
+};
+
+struct ResampleTapsParamsKeyHash {
+  std::size_t operator()(const ResampleTapsParams_t &k) const noexcept
+  {
+    return std::hash<index_t>()(k.up) + std::hash<index_t>()(k.down) +
+           std::hash<index_t>()(k.decimate);
+  }
+};
+
+struct ResampleTapsParamsKeyEq {
+  bool operator()(const ResampleTapsParams_t &l,
+                  const ResampleTapsParams_t &t) const noexcept
+  {
+    return l.up == t.up && l.down == t.down && l.decimate == t.decimate &&
+           l.dtype == t.dtype;
+  }
+};
+
+// Static cache of designed resampling filters
+static matxCache_t<ResampleTapsParams_t, ResampleTapsParamsKeyHash,
+                   ResampleTapsParamsKeyEq>
+    resample_taps_cache;
+
+/**
+ * Get the default filter for a resampling ratio, designing it the first time
+ * it's used. resample_poly uses a Kaiser window with beta 5 and
+ * 20 * max(up, down) + 1 taps, and decimate uses a 31 tap Hamming window, both
+ * the same as scipy.signal.
+ */
+template <typename F>
+tensor_t<F, 1> &GetResampleTaps(index_t up, index_t down, bool decimate)
+{
+  ResampleTapsParams_t params;
+  params.up = up;
+  params.down = down;
+  params.decimate = decimate;
+  params.dtype = TypeToInt<F>();
+
+  auto ret = resample_taps_cache.Lookup(params);
+  if (ret != std::nullopt) {
+    return *static_cast<tensor_t<F, 1> *>(ret.value());
+  }
+
+  const index_t max_rate = std::max(up, down);
+  const index_t numtaps = decimate ? 31 : 20 * max_rate + 1;
+  auto h = ResampleFirwin(numtaps, 1.0 / static_cast<double>(max_rate),
+                          !decimate, 5.0);
+
+  // Managed memory, so the taps can be read by both host and device
+  auto tmp = new tensor_t<F, 1>{{numtaps}};
+  for (index_t k = 0; k < numtaps; k++) {
+    (*tmp)(k) = static_cast<F>(h[k]);
+  }
+
+  resample_taps_cache.Insert(params, static_cast<void *>(tmp));
+  return *tmp;
+}
+
+template <typename T, int RANK>
+index_t ResampleBatches(const tensor_t<T, RANK> &out,
+                        const tensor_t<T, RANK> &in)
+{
+  static_assert(RANK >= 1 && RANK <= 4,
+                "Resampling tensors must be rank 1 to 4");
+  index_t batches = 1;
+  for (int i = 0; i < RANK - 1; i++) {
+    MATX_ASSERT(out.Size(i) == in.Size(i), matxInvalidSize);
+    batches *= in.Size(i);
+  }
+
+  return batches;
+}
+
+/**
+ * Polyphase resampling of nout outputs per row starting at upsampled index
+ * m0, with hist_len inputs carried over in hist. The last hist_len inputs of
+ * this call are written to hist_next if it's not null.
+ */
+template <typename T, int RANK, typename F>
+void InternalResamplePoly(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+                          const tensor_t<F, 1> &taps, index_t up,
+                          index_t down, index_t m0, index_t nout,
+                          const T *hist, T *hist_next, index_t hist_len,
+                          cudaStream_t stream)
+{
+  deferred_flush(stream);
+
+  const index_t batches = ResampleBatches(out, in);
+  const index_t len = in.Size(RANK - 1);
+
+  if (nout > 0) {
+    dim3 block(RESAMPLE_BLOCK_SIZE);
+    dim3 grid(static_cast<unsigned int>((nout + RESAMPLE_BLOCK_SIZE - 1) /
+                                        RESAMPLE_BLOCK_SIZE),
+              static_cast<unsigned int>(std::min<index_t>(batches, 65535)));
+    ResamplePoly<<<grid, block, 0, stream>>>(out, in, taps, hist, hist_len,
+                                             len, taps.Size(0), up, down, m0,
+                                             nout, batches);
+  }
+
+  if (hist_next != nullptr && hist_len > 0) {
+    const index_t hl = batches * hist_len;
+    ResampleSaveTail<<<static_cast<unsigned int>(
+                           (hl + RESAMPLE_BLOCK_SIZE - 1) /
+                           RESAMPLE_BLOCK_SIZE),
+                       RESAMPLE_BLOCK_SIZE, 0, stream>>>(
+        hist_next, in, hist, hist_len, len, batches);
+  }
+}
+
+/**
+ * Host version of InternalResamplePoly. The taps are rearranged into a
+ * polyphase bank with each phase reversed, and every row is copied into a
+ * contiguous buffer that includes the carried inputs and zero padding. Each
+ * output is then a dot product of two contiguous arrays with no bounds checks,
+ * which the compiler can vectorize. Rows and blocks of outputs are split
+ * across threads.
+ */
+template <typename T, int RANK, typename F>
+void InternalResamplePoly(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+                          const tensor_t<F, 1> &taps, index_t up,
+                          index_t down, index_t m0, index_t nout,
+                          const T *hist, T *hist_next, index_t hist_len,
+                          const matxHostExecutor_t &exec)
+{
+  using tap_t = decltype(ResampleTap<T>(F{}));
+  constexpr index_t TILE = 4096;
+
+  const index_t batches = ResampleBatches(out, in);
+  const index_t len = in.Size(RANK - 1);
+  const index_t ntaps = taps.Size(0);
+  const index_t J = (ntaps + up - 1) / up; // Taps per phase
+  const int threads = exec.GetNumThreads();
+
+  // Phase p holds taps p + (J - 1 - t) * up, scaled by the upsampling gain
+  std::vector<tap_t> bank(static_cast<size_t>(up * J), tap_t(0));
+  for (index_t p = 0; p < up; p++) {
+    for (index_t t = 0; t < J; t++) {
+      const index_t k = p + (J - 1 - t) * up;
+      if (k < ntaps) {
+        bank[p * J + t] = ResampleTap<T>(taps(k)) * static_cast<tap_t>(up);
+      }
+    }
+  }
+
+  // Element q of a row buffer is input q - (J - 1), so output n is the dot
+  // product of its phase with the J elements starting at (m0 + n * down) / up
+  const index_t xlen =
+      nout > 0 ? std::max(len, (m0 + (nout - 1) * down) / up + 1) + J : 0;
+  std::vector<T> xb(static_cast<size_t>(batches * xlen));
+  matxHostParallelFor(batches, threads, [&](int, index_t start, index_t end) {
+    for (index_t b = start; b < end; b++) {
+      for (index_t q = 0; q < xlen; q++) {
+        xb[b * xlen + q] =
+            ResampleInput(in, hist, b, q - (J - 1), len, hist_len);
+      }
+    }
+  });
+
+  if (hist_next != nullptr) {
+    for (index_t idx = 0; idx < batches * hist_len; idx++) {
+      const index_t b = idx / hist_len;
+      const index_t j = idx % hist_len;
+      hist_next[idx] =
+          ResampleInput(in, hist, b, len - hist_len + j, len, hist_len);
+    }
+  }
+
+  const index_t tiles = (nout + TILE - 1) / TILE;
+  matxHostParallelFor(
+      batches * tiles, threads, [&](int, index_t start, index_t end) {
+        for (index_t w = start; w < end; w++) {
+          const index_t b = w / tiles;
+          const index_t n1 = std::min(nout, (w % tiles + 1) * TILE);
+          const T *x = &xb[b * xlen];
+          for (index_t n = (w % tiles) * TILE; n < n1; n++) {
+            const index_t m = m0 + n * down;
+            const tap_t *hp = &bank[(m % up) * J];
+            const T *xp = x + m / up;
+
+            T acc = 0;
+            for (index_t t = 0; t < J; t++) {
+              acc += xp[t] * hp[t];
+            }
+            ResampleElem(out, b, n) = acc;
+          }
+        }
+      });
+}
+
+template <typename T, int RANK, typename F, typename Executor>
+void InternalResamplePolyOnce(tensor_t<T, RANK> &out,
+                              const tensor_t<T, RANK> &in, index_t up,
+                              index_t down, const tensor_t<F, 1> &taps,
+                              Executor &&exec)
+{
+  MATX_ASSERT(up > 0 && down > 0, matxInvalidParameter);
+  MATX_ASSERT(taps.Size(0) > 0, matxInvalidSize);
+
+  const index_t g = std::gcd(up, down);
+  up /= g;
+  down /= g;
+
+  const index_t len = in.Size(RANK - 1);
+  const index_t nout = (len * up + down - 1) / down;
+  MATX_ASSERT(out.Size(RANK - 1) == nout, matxInvalidSize);
+
+  // Outputs are centred on the filter, so output n sits half the filter
+  // length past index n * down of the upsampled input
+  const index_t half_len = (taps.Size(0) - 1) / 2;
+  InternalResamplePoly(out, in, taps, up, down, half_len, nout,
+                       static_cast<const T *>(nullptr),
+                       static_cast<T *>(nullptr), 0, exec);
+}
+
+/**
+ * Polyphase rational resampling
+ *
+ * Resamples the last dimension of in by up / down with an FIR filter applied
+ * at the upsampled rate, the same as scipy.signal.resample_poly. Only the
+ * retained outputs are computed, and each output only uses the taps of its
+ * polyphase branch, so the work is len * up / down * taps / up
+ * multiply-adds per row. Zeros are never inserted and there are no
+ * temporaries. The output length must be ceil(len * up / down). Leading
+ * dimensions are batches.
+ *
+ * The taps are scaled by up and centred on each output. The input is treated
+ * as zero outside its bounds. See matxResamplePolyPlan_t to resample a stream
+ * in chunks.
+ *
+ * @tparam T
+ *   Data type
+ * @tparam RANK
+ *   Rank of the input and output
+ * @tparam F
+ *   Filter type
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param up
+ *   Upsampling factor
+ * @param down
+ *   Downsampling factor
+ * @param taps
+ *   FIR filter designed for the upsampled rate
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK, typename F>
+void resample_poly(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+                   index_t up, index_t down, const tensor_t<F, 1> &taps,
+                   cudaStream_t stream = 0)
+{
+  InternalResamplePolyOnce(out, in, up, down, taps, stream);
+}
+
+/**
+ * Polyphase rational resampling with the default filter
+ *
+ * Same as resample_poly() with a Kaiser-windowed lowpass filter of
+ * 20 * max(up, down) + 1 taps and beta 5, as used by scipy. The filter is
+ * designed once per ratio and cached.
+ *
+ * @tparam T
+ *   Data type
+ * @tparam RANK
+ *   Rank of the input and output
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param up
+ *   Upsampling factor
+ * @param down
+ *   Downsampling factor
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK>
+void resample_poly(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+                   index_t up, index_t down, cudaStream_t stream = 0)
+{
+  const index_t g = std::gcd(up, down);
+  auto &taps = GetResampleTaps<value_type_t<T>>(up / g, down / g, false);
+  InternalResamplePolyOnce(out, in, up / g, down / g, taps, stream);
+}
+
+/**
+ * Polyphase rational resampling on the host
+ *
+ * Host version of resample_poly()
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param up
+ *   Upsampling factor
+ * @param down
+ *   Downsampling factor
+ * @param taps
+ *   FIR filter designed for the upsampled rate
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK, typename F>
+void resample_poly(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+                   index_t up, index_t down, const tensor_t<F, 1> &taps,
+                   const matxHostExecutor_t &exec)
+{
+  if (HostGraphRecord(exec, {HostRead(in), HostRead(taps), HostWrite(out)},
+                      [out, in, up, down, taps](
+                          const matxHostExecutor_t &e) mutable {
+                        InternalResamplePolyOnce(out, in, up, down, taps, e);
+                      })) {
+    return;
+  }
+
+  InternalResamplePolyOnce(out, in, up, down, taps, exec);
+}
+
+/**
+ * Polyphase rational resampling on the host with the default filter
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param up
+ *   Upsampling factor
+ * @param down
+ *   Downsampling factor
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK>
+void resample_poly(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in,
+                   index_t up, index_t down, const matxHostExecutor_t &exec)
+{
+  const index_t g = std::gcd(up, down);
+  auto &taps = GetResampleTaps<value_type_t<T>>(up / g, down / g, false);
+  resample_poly(out, in, up / g, down / g, taps, exec);
+}
+
+/**
+ * FIR decimation
+ *
+ * Lowpass filters and keeps every q-th sample of the last dimension, the
+ * same as scipy.signal.decimate with ftype='fir': a 31 tap Hamming-windowed
+ * filter with cutoff 1 / q, applied without phase shift. Only the kept
+ * samples are computed. The output length must be ceil(len / q). Use
+ * resample_poly() with up = 1 for a custom filter.
+ *
+ * @tparam T
+ *   Data type
+ * @tparam RANK
+ *   Rank of the input and output
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param q
+ *   Decimation factor
+ * @param stream
+ *   CUDA stream
+ */
+template <typename T, int RANK>
+void decimate(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, index_t q,
+              cudaStream_t stream = 0)
+{
+  auto &taps = GetResampleTaps<value_type_t<T>>(1, q, true);
+  InternalResamplePolyOnce(out, in, 1, q, taps, stream);
+}
+
+/**
+ * FIR decimation on the host
+ *
+ * @param out
+ *   Output tensor
+ * @param in
+ *   Input tensor
+ * @param q
+ *   Decimation factor
+ * @param exec
+ *   Host executor
+ */
+template <typename T, int RANK>
+void decimate(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in, index_t q,
+              const matxHostExecutor_t &exec)
+{
+  auto &taps = GetResampleTaps<value_type_t<T>>(1, q, true);
+  resample_poly(out, in, 1, q, taps, exec);
+}
+
+/**
+ * Streaming polyphase resampler
+ *
+ * Resamples a stream by up / down in chunks of any length, carrying the
+ * inputs still needed by the filter between calls. The outputs are the same
+ * as filtering the whole stream at once with a causal filter, so output n is
+ * at index n * down of the upsampled stream and the group delay of the filter
+ * is not removed. Each call produces OutputSize(len) outputs per row, which
+ * varies with the ratio and the position in the stream.
+ *
+ * Plans created with a stream run on the device, and plans created with a
+ * host executor run on the host. The taps must be accessible from where the
+ * plan runs.
+ *
+ * @tparam T
+ *   Data type
+ * @tparam F
+ *   Filter type
+ */
+template <typename T, typename F> class matxResamplePolyPlan_t {
+public:
+  /**
+   * Construct a device streaming resampler
+   *
+   * @param taps
+   *   FIR filter designed for the upsampled rate
+   * @param up
+   *   Upsampling factor
+   * @param down
+   *   Downsampling factor
+   * @param batches
+   *   Number of independent rows in each chunk
+   * @param stream
+   *   CUDA stream
+   */
+  matxResamplePolyPlan_t(const tensor_t<F, 1> &taps, index_t up,
+                         index_t down, index_t batches,
+                         cudaStream_t stream = 0)
+      : taps_(taps), host_(false), stream_(stream)
+  {
+    Init(up, down, batches);
+  }
+
+  /**
+   * Construct a host streaming resampler
+   *
+   * @param taps
+   *   FIR filter designed for the upsampled rate
+   * @param up
+   *   Upsampling factor
+   * @param down
+   *   Downsampling factor
+   * @param batches
+   *   Number of independent rows in each chunk
+   * @param exec
+   *   Host executor
+   */
+  matxResamplePolyPlan_t(const tensor_t<F, 1> &taps, index_t up,
+                         index_t down, index_t batches,
+                         const matxHostExecutor_t &exec)
+      : taps_(taps), host_(true), stream_(0), exec_(exec)
+  {
+    Init(up, down, batches);
+  }
+
+  ~matxResamplePolyPlan_t()
+  {
+    if (!host_) {
+      matxFree(hist_);
+      matxFree(hist_next_);
+    }
+  }
+
+  /**
+   * Number of outputs per row the next call will produce for a chunk of len
+   * samples
+   */
+  index_t OutputSize(index_t len) const
+  {
+    return len * up_ > m0_ ? (len * up_ - m0_ + down_ - 1) / down_ : 0;
+  }
+
+  /**
+   * Start the stream again from zero
+   */
+  void Reset()
+  {
+    m0_ = 0;
+    if (host_) {
+      std::fill(hhist_.begin(), hhist_.end(), T(0));
+    }
+    else {
+      cudaMemsetAsync(hist_, 0, hist_bytes_, stream_);
+    }
+  }
+
+  /**
+   * Resample the next chunk of the stream
+   *
+   * @param out
+   *   Output tensor. The last dimension must hold at least OutputSize(len)
+   * samples
+   * @param in
+   *   Next chunk of len samples per row
+   * @returns
+   *   Number of outputs written to each row
+   */
+  template <int RANK>
+  index_t Exec(tensor_t<T, RANK> &out, const tensor_t<T, RANK> &in)
+  {
+    MATX_ASSERT(ResampleBatches(out, in) == batches_, matxInvalidSize);
+
+    const index_t len = in.Size(RANK - 1);
+    const index_t nout = OutputSize(len);
+    MATX_ASSERT(out.Size(RANK - 1) >= nout, matxInvalidSize);
+
+    if (host_) {
+      InternalResamplePoly(out, in, taps_, up_, down_, m0_, nout, hist_,
+                           hist_next_, hist_len_, exec_);
+    }
+    else {
+      InternalResamplePoly(out, in, taps_, up_, down_, m0_, nout, hist_,
+                           hist_next_, hist_len_, stream_);
+    }
+    std::swap(hist_, hist_next_);
+
+    m0_ += nout * down_ - len * up_;
+    return nout;
+  }
+
+private:
+  void Init(index_t up, index_t down, index_t batches)
+  {
+    MATX_ASSERT(up > 0 && down > 0 && batches > 0, matxInvalidParameter);
+    MATX_ASSERT(taps_.Size(0) > 0, matxInvalidSize);
+
+    const index_t g = std::gcd(up, down);
+    up_ = up / g;
+    down_ = down / g;
+    batches_ = batches;
+    m0_ = 0;
+
+    // Inputs needed before the first new one by the longest phase
+    hist_len_ = (taps_.Size(0) - 1) / up_;
+    const index_t hl = std::max<index_t>(batches_ * hist_len_, 1);
+    hist_bytes_ = hl * sizeof(T);
+
+    if (host_) {
+      hhist_.assign(static_cast<size_t>(hl), T(0));
+      hhist_next_.assign(static_cast<size_t>(hl), T(0));
+      hist_ = hhist_.data();
+      hist_next_ = hhist_next_.data();
+    }
+    else {
+      matxAlloc((void **)&hist_, hist_bytes_, MATX_DEVICE_MEMORY);
+      matxAlloc((void **)&hist_next_, hist_bytes_, MATX_DEVICE_MEMORY);
+      cudaMemset(hist_, 0, hist_bytes_);
+    }
+  }
+
+  tensor_t<F, 1> taps_;
+  bool host_;
+  cudaStream_t stream_;
+  matxHostExecutor_t exec_;
+  index_t up_;
+  index_t down_;
+  index_t batches_;
+  index_t hist_len_;
+  index_t m0_; // Upsampled index of the next output, relative to the chunk
+  size_t hist_bytes_;
+  T *hist_;
+  T *hist_next_;
+  std::vector<T> hhist_;
+  std::vector<T> hhist_next_;
+};
+
+
+template <typename OutType, typename T, int RANK>
+index_t ChannelizeBatches(const tensor_t<OutType, RANK + 1> &out,
+                          const tensor_t<T, RANK> &in)
+{
+  static_assert(RANK >= 1 && RANK <= 3,
+                "Channelizer input must be rank 1 to 3");
+  static_assert(is_complex_v<OutType>, "Channelizer output must be complex");
+
+  index_t batches = 1;
+  for (int i = 0; i < RANK - 1; i++) {
+    MATX_ASSERT(out.Size(i) == in.Size(i), matxInvalidSize);
+    batches *= in.Size(i);
+  }
+
+  return batches;
+}
+
+/**
+ * Channelize nframes frames per row, the first at input sample t0, whose
+ * position in the stream modulo the number of channels is phase0. hist holds
+ * hist_len inputs carried over from the previous call, and the last hist_len
+ * inputs of this call are written to hist_next if it's not null. The
+ * polyphase FIR writes its frames straight into the output, which is then
+ * transformed in place with a cached batched FFT, so there are no
+ * temporaries.
+ */
+template <typename OutType, typename T, int RANK, typename F>
+void InternalChannelizePoly(tensor_t<OutType, RANK + 1> &out,
+                            const tensor_t<T, RANK> &in,
+                            const tensor_t<F, 1> &taps, index_t decimation,
+                            index_t t0, index_t phase0, index_t nframes,
+                            const T *hist, T *hist_next, index_t hist_len,
+                            cudaStream_t stream)
+{
+  deferred_flush(stream);
+
+  const index_t batches = ChannelizeBatches(out, in);
+  const index_t len = in.Size(RANK - 1);
+  const index_t channels = out.Size(RANK);
+
+  if (hist_next != nullptr && hist_len > 0) {
+    const index_t hl = batches * hist_len;
+    ResampleSaveTail<<<static_cast<unsigned int>(
+                           (hl + CHANNELIZE_BLOCK_SIZE - 1) /
+                           CHANNELIZE_BLOCK_SIZE),
+                       CHANNELIZE_BLOCK_SIZE, 0, stream>>>(
+        hist_next, in, hist, hist_len, len, batches);
+  }
+
+  if (nframes == 0) {
+    return;
+  }
+
+  index_t firsts[RANK + 1] = {0};
+  index_t ends[RANK + 1];
+  std::fill_n(ends, RANK + 1, matxEnd);
+  ends[RANK - 1] = nframes;
+  auto frames = out.Slice(firsts, ends);
+
+  dim3 block(CHANNELIZE_BLOCK_SIZE);
+  dim3 grid(static_cast<unsigned int>(nframes),
+            static_cast<unsigned int>((channels + CHANNELIZE_BLOCK_SIZE - 1) /
+                                      CHANNELIZE_BLOCK_SIZE),
+            static_cast<unsigned int>(std::min<index_t>(batches, 65535)));
+  ChannelizePoly<<<grid, block, 0, stream>>>(
+      frames, in, taps, hist, hist_len, len, taps.Size(0), channels,
+      decimation, t0, phase0, batches);
+
+  fft(frames, frames, stream);
+}
+
+/**
+ * Polyphase filter-bank channelizer
+ *
+ * Splits the last dimension of in into channels equally spaced frequency
+ * channels, each filtered by the prototype lowpass filter taps and output at
+ * 1 / decimation of the input rate. Channel c of frame n is
+ *
+ *   y[n, c] = sum_k h[k] x[n * decimation - k] e^(-2 pi j c (n * decimation - k) / channels)
+ *
+ * which is the input shifted down by c / channels of the sample rate,
+ * filtered, and sampled every decimation samples. With decimation equal to
+ * channels the bank is critically sampled, and a smaller decimation gives an
+ * oversampled bank. The filter is applied causally, with the input treated
+ * as zero before its first sample.
+ *
+ * The filter is split into channels polyphase branches that are applied
+ * directly to the input at the output rate, and each frame of branch outputs
+ * is transformed with one batched FFT across all frames and rows. The
+ * branches are written straight into the output and transformed in place
+ * with a cached FFT plan, so no temporaries are allocated. See
+ * matxChannelizePolyPlan_t to channelize a stream in blocks.
+ *
+ * @tparam OutType
+ *   Output data type. Must be complex
+ * @tparam T
+ *   Input data type
+ * @tparam RANK
+ *   Rank of the input. Leading dimensions are batches
+ * @tparam F
+ *   Filter type
+ *
+ * @param out
+ *   Output of shape [..., ceil(len / decimation), channels]
+ * @param in
+ *   Input of shape [..., len]
+ * @param taps
+ *   Prototype lowpass filter
+ * @param decimation
+ *   Input samples per output frame, from 1 to the number of channels
+ * @param stream
+ *   CUDA stream
+ */
+template <typename OutType, typename T, int RANK, typename F>
+void channelize_poly(tensor_t<OutType, RANK + 1> &out,
+                     const tensor_t<T, RANK> &in, const tensor_t<F, 1> &taps,
+                     index_t decimation, cudaStream_t stream = 0)
+{
+  const index_t channels = out.Size(RANK);
+  const index_t len = in.Size(RANK - 1);
+  const index_t nframes = (len + decimation - 1) / decimation;
+
+  MATX_ASSERT(taps.Size(0) > 0, matxInvalidSize);
+  MATX_ASSERT(decimation > 0 && decimation <= channels, matxInvalidParameter);
+  MATX_ASSERT(out.Size(RANK - 1) == nframes, matxInvalidSize);
+
+  InternalChannelizePoly(out, in, taps, decimation, 0, 0, nframes,
+                         static_cast<const T *>(nullptr),
+                         static_cast<T *>(nullptr), 0, stream);
+}
+
+/**
+ * Streaming polyphase filter-bank channelizer
+ *
+ * Channelizes a stream in blocks of any length, the same as channelize_poly()
+ * on the whole stream at once. The taps - 1 inputs still under the filter are
+ * carried between calls, along with the position of the next frame and the
+ * phase of the stream, so frames that straddle blocks and the rotation of an
+ * oversampled bank both stay continuous. Each call produces
+ * OutputSize(len) frames per row.
+ *
+ * @tparam T
+ *   Input data type
+ * @tparam F
+ *   Filter type
+ */
+template <typename T, typename F> class matxChannelizePolyPlan_t {
+public:
+  /**
+   * Construct a streaming channelizer
+   *
+   * @param taps
+   *   Prototype lowpass filter
+   * @param channels
+   *   Number of channels
+   * @param decimation
+   *   Input samples per output frame, from 1 to channels
+   * @param batches
+   *   Number of independent rows in each block
+   * @param stream
+   *   CUDA stream
+   */
+  matxChannelizePolyPlan_t(const tensor_t<F, 1> &taps, index_t channels,
+                           index_t decimation, index_t batches,
+                           cudaStream_t stream = 0)
+      : taps_(taps), channels_(channels), decimation_(decimation),
+        batches_(batches), stream_(stream)
+  {
+    MATX_ASSERT(taps_.Size(0) > 0, matxInvalidSize);
+    MATX_ASSERT(channels > 0 && batches > 0, matxInvalidParameter);
+    MATX_ASSERT(decimation > 0 && decimation <= channels,
+                matxInvalidParameter);
+
+    hist_len_ = taps_.Size(0) - 1;
+    hist_bytes_ = std::max<index_t>(batches_ * hist_len_, 1) * sizeof(T);
+    matxAlloc((void **)&hist_, hist_bytes_, MATX_DEVICE_MEMORY);
+    matxAlloc((void **)&hist_next_, hist_bytes_, MATX_DEVICE_MEMORY);
+    Reset();
+  }
+
+  ~matxChannelizePolyPlan_t()
+  {
+    matxFree(hist_);
+    matxFree(hist_next_);
+  }
+
+  /**
+   * Number of frames per row the next call will produce for a block of len
+   * samples
+   */
+  index_t OutputSize(index_t len) const
+  {
+    return len > t0_ ? (len - t0_ + decimation_ - 1) / decimation_ : 0;
+  }
+
+  /**
+   * Start the stream again from zero
+   */
+  void Reset()
+  {
+    t0_ = 0;
+    phase_ = 0;
+    cudaMemsetAsync(hist_, 0, hist_bytes_, stream_);
+  }
+
+  /**
+   * Channelize the next block of the stream
+   *
+   * @param out
+   *   Output of shape [..., frames, channels]. The frames dimension must hold
+   * at least OutputSize(len) frames
+   * @param in
+   *   Next block of len samples per row
+   * @returns
+   *   Number of frames written to each row
+   */
+  template <typename OutType, int RANK>
+  index_t Exec(tensor_t<OutType, RANK + 1> &out, const tensor_t<T, RANK> &in)
+  {
+    MATX_ASSERT(ChannelizeBatches(out, in) == batches_, matxInvalidSize);
+    MATX_ASSERT(out.Size(RANK) == channels_, matxInvalidSize);
+
+    const index_t len = in.Size(RANK - 1);
+    const index_t nframes = OutputSize(len);
+    MATX_ASSERT(out.Size(RANK - 1) >= nframes, matxInvalidSize);
+
+    InternalChannelizePoly(out, in, taps_, decimation_, t0_, phase_, nframes,
+                           hist_, hist_next_, hist_len_, stream_);
+    std::swap(hist_, hist_next_);
+
+    // The next frame and the stream position of the next frame
+    phase_ = (phase_ + nframes * decimation_) % channels_;
+    t0_ += nframes * decimation_ - len;
+    return nframes;
+  }
+
+private:
+  tensor_t<F, 1> taps_;
+  index_t channels_;
+  index_t decimation_;
+  index_t batches_;
+  cudaStream_t stream_;
+  index_t hist_len_;
+  index_t t0_;    // Index of the next frame, relative to the block
+  index_t phase_; // Stream position of the next frame modulo channels
+  size_t hist_bytes_;
+  T *hist_;
+  T *hist_next_;
+};
+
 }; // namespace signal
 }; // namespace matx
\ No newline at end of file
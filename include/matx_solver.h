@@ -34,6 +34,8 @@
 
 #include "cublas_v2.h"
 #include "cusolverDn.h"
+#include "kernels/matx_jacobi_kernels.cuh"
+#include "matx_deferred.h"
 #include "matx_dim.h"
 #include "matx_error.h"
 #include "matx_tensor.h"
@@ -318,6 +320,8 @@ void chol(tensor_t<T1, RANK> &out, const tensor_t<T1, RANK> &a,
           cudaStream_t stream = 0,
           cublasFillMode_t uplo = CUBLAS_FILL_MODE_UPPER)
 {
+  deferred_flush(stream);
+
   /* Temporary WAR
      cuSolver doesn't support row-major layouts. Since we want to make the
      library appear as though everything is row-major, we take a performance hit
@@ -538,6 +542,8 @@ template <typename T1, int RANK>
 void lu(tensor_t<T1, RANK> &out, tensor_t<int64_t, RANK - 1> &piv,
         const tensor_t<T1, RANK> &a, const cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   /* Temporary WAR
      cuSolver doesn't support row-major layouts. Since we want to make the
      library appear as though everything is row-major, we take a performance hit
@@ -596,6 +602,8 @@ template <typename T1, int RANK>
 void det(tensor_t<T1, RANK - 2> &out, const tensor_t<T1, RANK> &a,
          const cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   // Get parameters required by these tensors
   tensorShape_t<RANK - 1> s;
 
@@ -808,6 +816,8 @@ template <typename T1, int RANK>
 void qr(tensor_t<T1, RANK> &out, tensor_t<T1, RANK - 1> &tau,
         const tensor_t<T1, RANK> &a, cudaStream_t stream = 0)
 {
+  deferred_flush(stream);
+
   /* Temporary WAR
      cuSolver doesn't support row-major layouts. Since we want to make the
      library appear as though everything is row-major, we take a performance hit
@@ -1084,6 +1094,8 @@ void svd(tensor_t<T2, RANK> &u, tensor_t<T3, RANK - 1> &s,
          tensor_t<T4, RANK> &v, const tensor_t<T1, RANK> &a,
          cudaStream_t stream = 0, const char jobu = 'A', const char jobvt = 'A')
 {
+  deferred_flush(stream);
+
   /* Temporary WAR
      cuSolver doesn't support row-major layouts. Since we want to make the
      library appear as though everything is row-major, we take a performance hit
@@ -1313,6 +1325,12 @@ static matxCache_t<DnEigParams_t, DnEigParamsKeyHash, DnEigParamsKeyEq>
  * tensor. In that case, the input is destroyed and the output is stored
  * in-place.
  *
+ * Batches of small matrices are decomposed with a batched cyclic Jacobi kernel
+ * instead of cuSolver, with one thread block per matrix. The outputs have the
+ * same layout in both cases: eigenvalues in ascending order, and eigenvectors
+ * in the columns of out. With CUSOLVER_EIG_MODE_NOVECTOR the Jacobi kernel
+ * skips the eigenvector updates and leaves out untouched.
+ *
  * @tparam T1
  *   Data type of matrix A
  * @tparam RANK
@@ -1338,6 +1356,25 @@ void eig(tensor_t<T1, RANK> &out, tensor_t<T2, RANK - 1> &w,
          cusolverEigMode_t jobz = CUSOLVER_EIG_MODE_VECTOR,
          cublasFillMode_t uplo = CUBLAS_FILL_MODE_UPPER)
 {
+  deferred_flush(stream);
+
+  // Many small matrices are faster with one Jacobi solve per block than with
+  // a cuSolver call per matrix
+  const index_t n = a.Size(RANK - 1);
+  const uint32_t batches = matxDnSolver_t::GetNumBatches(a);
+  const size_t shm = JacobiEigSharedBytes<T1>(n);
+  if (batches > 1 && n <= MATX_JACOBI_EIG_MAX_N &&
+      shm <= JACOBI_MAX_SHARED_BYTES) {
+    MATX_ASSERT(out.Size(RANK - 1) == n && out.Size(RANK - 2) == n,
+                matxInvalidSize);
+    MATX_ASSERT(w.Size(RANK - 2) == n, matxInvalidSize);
+
+    JacobiEig<T1, T2><<<batches, JACOBI_BLOCK_SIZE, shm, stream>>>(
+        out, w, a, static_cast<int>(n), uplo == CUBLAS_FILL_MODE_LOWER,
+        jobz == CUSOLVER_EIG_MODE_VECTOR);
+    return;
+  }
+
   /* Temporary WAR
      cuSolver doesn't support row-major layouts. Since we want to make the
      library appear as though everything is row-major, we take a performance hit
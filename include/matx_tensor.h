@@ -73,6 +73,302 @@ enum {
 };
 #endif
 
+/**
+ * Non-owning view of a tensor's memory
+ *
+ * Holds the data pointer, shape and strides of a tensor_t but not its
+ * reference count, so copying one doesn't touch the atomic counter. Operators
+ * store their tensor inputs and outputs this way, which keeps building and
+ * copying expression trees free of atomics. The tensor_t it was made from
+ * owns the memory, so that tensor must outlive every operator built from it.
+ *
+ * Offsets are computed with the index type I. exec() rebuilds views with a
+ * 32-bit I when every offset into them fits, which saves the 64-bit
+ * multiplies of an INDEX_64_BIT build on each access.
+ */
+template <typename T, int RANK, typename I = index_t> class tensor_ref_t {
+public:
+  // Type specifier for reflection on class
+  using type = T;
+  using scalar_type = T;
+  using tensor_view = bool;
+
+  // Type specifier for signaling this is a matx operation
+  using matxop = bool;
+
+  /**
+   * Reference the memory of a tensor view
+   *
+   * @param t
+   *   Tensor view to reference
+   */
+  inline __host__ tensor_ref_t(const tensor_t<T, RANK> &t) noexcept
+      : ldata_(t.Data()), shape_(t.Shape())
+  {
+    if constexpr (RANK > 0) {
+      for (int i = 0; i < RANK; i++) {
+        s_[i] = static_cast<I>(t.Stride(i));
+      }
+    }
+  }
+
+  /**
+   * Reference memory with the given sizes and strides
+   *
+   * @param data
+   *   Pointer to the first element
+   * @param sizes
+   *   Sizes of each dimension
+   * @param strides
+   *   Strides of each dimension
+   */
+  inline __host__ tensor_ref_t(T *data, const index_t *sizes,
+                               const index_t *strides) noexcept
+      : ldata_(data), shape_(sizes)
+  {
+    for (int i = 0; i < RANK; i++) {
+      s_[i] = static_cast<I>(strides[i]);
+    }
+  }
+
+  static inline constexpr __host__ __device__ int32_t Rank() { return RANK; }
+
+  inline __host__ __device__ index_t Size(uint32_t dim) const noexcept
+  {
+    return shape_.Size(dim);
+  }
+
+  template <int M = RANK, std::enable_if_t<M >= 1, bool> = true>
+  inline __host__ __device__ index_t Stride(uint32_t dim) const noexcept
+  {
+    return s_[dim];
+  }
+
+  /* Views can be collapsed by exec() when they have at least one dimension */
+  static inline constexpr __host__ bool Collapsible() { return RANK >= 1; }
+
+  inline __host__ void CollapseCheck(matxCollapse_t &c) const
+  {
+    std::array<index_t, RANK> n, s;
+    for (int i = 0; i < RANK; i++) {
+      n[i] = Size(i);
+      s[i] = s_[i];
+    }
+
+    c.Add(RANK, n.data(), s.data());
+  }
+
+  /**
+   * Rebuild the view at the merged rank of a collapse analysis with index
+   * type J. When nothing was merged, NR is the rank of the statement and the
+   * view keeps its own rank, which may be lower if it's broadcast.
+   */
+  template <int NR, typename J = index_t>
+  inline __host__ auto Collapse(const matxCollapse_t &c) const
+  {
+    std::array<index_t, RANK> n, s;
+    for (int i = 0; i < RANK; i++) {
+      n[i] = Size(i);
+      s[i] = s_[i];
+    }
+
+    if constexpr (NR >= RANK) {
+      return tensor_ref_t<T, RANK, J>(ldata_, n.data(), s.data());
+    }
+    else {
+      index_t nn[NR], ns[NR];
+      c.Apply(s.data(), nn, ns);
+      return tensor_ref_t<T, NR, J>(ldata_, nn, ns);
+    }
+  }
+
+  inline __host__ __device__ T *Data() const noexcept { return ldata_; }
+
+  inline tensorShape_t<RANK> Shape() const noexcept { return shape_; }
+
+  template <int M = RANK, std::enable_if_t<M == 0, bool> = true>
+  inline __host__ __device__ T &operator()() const noexcept
+  {
+    return *ldata_;
+  }
+
+  template <int M = RANK, std::enable_if_t<M == 1, bool> = true>
+  inline __host__ __device__ T &operator()(index_t id0) const noexcept
+  {
+    return *(ldata_ + s_[0] * static_cast<I>(id0));
+  }
+
+  template <int M = RANK, std::enable_if_t<M == 2, bool> = true>
+  inline __host__ __device__ T &operator()(index_t id0,
+                                           index_t id1) const noexcept
+  {
+    return *(ldata_ + (s_[0] * static_cast<I>(id0) +
+                       s_[1] * static_cast<I>(id1)));
+  }
+
+  template <int M = RANK, std::enable_if_t<M == 3, bool> = true>
+  inline __host__ __device__ T &operator()(index_t id0, index_t id1,
+                                           index_t id2) const noexcept
+  {
+    return *(ldata_ + (s_[0] * static_cast<I>(id0) +
+                       s_[1] * static_cast<I>(id1) +
+                       s_[2] * static_cast<I>(id2)));
+  }
+
+  template <int M = RANK, std::enable_if_t<M == 4, bool> = true>
+  inline __host__ __device__ T &operator()(index_t id0, index_t id1,
+                                           index_t id2,
+                                           index_t id3) const noexcept
+  {
+    return *(ldata_ + (s_[0] * static_cast<I>(id0) +
+                       s_[1] * static_cast<I>(id1) +
+                       s_[2] * static_cast<I>(id2) +
+                       s_[3] * static_cast<I>(id3)));
+  }
+
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4 && sizeof...(Is) == RANK &&
+                              (std::is_integral_v<Is> && ...)),
+                             bool> = true>
+  inline __host__ __device__ T &operator()(Is... indices) const noexcept
+  {
+    const I idx[] = {static_cast<I>(indices)...};
+    I offset = 0;
+#pragma unroll
+    for (int i = 0; i < RANK; i++) {
+      offset += s_[i] * idx[i];
+    }
+
+    return *(ldata_ + offset);
+  }
+
+private:
+  T *ldata_;
+  tensorShape_t<RANK> shape_;
+  std::array<I, RANK> s_;
+};
+
+/**
+ * Type an operator stores for one of its inputs or outputs. Tensor views are
+ * stored as a non-owning tensor_ref_t, and everything else by value.
+ */
+template <typename T> struct op_storage {
+  using type = T;
+};
+template <typename T, int RANK> struct op_storage<tensor_t<T, RANK>> {
+  using type = tensor_ref_t<T, RANK>;
+};
+template <typename T> using op_storage_t = typename op_storage<T>::type;
+
+/**
+ * Whether an operator defines the members exec() uses to merge its
+ * dimensions
+ */
+template <typename T, typename = void> struct has_collapse : std::false_type {
+};
+template <typename T>
+struct has_collapse<T, std::void_t<decltype(T::Collapsible())>>
+    : std::true_type {
+};
+
+/**
+ * Whether exec() can merge the dimensions of an operator. Scalars always can,
+ * operators can when they define Collapsible() and it returns true, and
+ * anything else can't.
+ */
+template <typename T, typename = void>
+struct is_collapsible_op
+    : std::bool_constant<!is_matx_op<T>() &&
+                         !std::is_base_of_v<BaseOp<T>, T>> {
+};
+template <typename T>
+struct is_collapsible_op<T, std::enable_if_t<has_collapse<T>::value>>
+    : std::bool_constant<T::Collapsible()> {
+};
+
+/**
+ * Record the strides of the views an operator reads in a collapse analysis
+ */
+template <typename T>
+inline __host__ void CollapseCheckOp(const T &op, matxCollapse_t &c)
+{
+  if constexpr (has_collapse<T>::value) {
+    op.CollapseCheck(c);
+  }
+}
+
+/**
+ * Rebuild an operator at the merged rank of a collapse analysis, with its
+ * views indexed by I
+ */
+template <int NR, typename I = index_t, typename T>
+inline __host__ auto CollapseOp(const T &op, const matxCollapse_t &c)
+{
+  if constexpr (has_collapse<T>::value) {
+    return op.template Collapse<NR, I>(c);
+  }
+  else {
+    return op;
+  }
+}
+
+/**
+ * Whether an operator has work to queue before and after the kernels that
+ * read it, like the reduce phase of a lazy reduction
+ */
+template <typename T, typename = void> struct has_prerun : std::false_type {
+};
+template <typename T>
+struct has_prerun<T, std::void_t<decltype(std::declval<const T &>().PreRun(
+                         std::declval<cudaStream_t>()))>> : std::true_type {
+};
+
+/**
+ * Queue the work an operator needs done before the kernels that read it
+ */
+template <typename T>
+inline __host__ void PreRunOp(const T &op, cudaStream_t stream)
+{
+  if constexpr (has_prerun<T>::value) {
+    op.PreRun(stream);
+  }
+}
+
+/**
+ * Release what PreRunOp() set up, once the kernels that read the operator
+ * are queued
+ */
+template <typename T>
+inline __host__ void PostRunOp(const T &op, cudaStream_t stream)
+{
+  if constexpr (has_prerun<T>::value) {
+    op.PostRun(stream);
+  }
+}
+
+/**
+ * Whether a kernel over the given sizes and every offset into the views of
+ * ops fit in an int32_t. Nothing is merged, so this suits kernels that give
+ * each dimension its own meaning, like reductions and convolutions.
+ */
+template <typename... Ops>
+inline __host__ bool Fits32(int rank, const index_t *sizes, const Ops &...ops)
+{
+  matxCollapse_t c(rank, sizes, false);
+  (CollapseCheckOp(op_storage_t<Ops>(ops), c), ...);
+  return c.Fits32();
+}
+
+/**
+ * Rebuild an operator with its views indexed by I and its dimensions
+ * unchanged, once Fits32() has said the offsets fit
+ */
+template <typename I, typename T> inline __host__ auto NarrowOp(const T &op)
+{
+  const matxCollapse_t c(0, nullptr, false);
+  return CollapseOp<T::Rank(), I>(op_storage_t<T>(op), c);
+}
+
 /**
  * Assignment from one operator/View into a View
  *
@@ -86,12 +382,15 @@ enum {
  *   Rank of operator
  * @tparam Op
  *   Operator to use as input
+ * @tparam OutType
+ *   Type of the output view
  **/
-template <class T, int RANK, class Op>
-class set : public BaseOp<set<T, RANK, Op>> {
+template <class T, int RANK, class Op,
+          typename OutType = tensor_ref_t<T, RANK>>
+class set : public BaseOp<set<T, RANK, Op, OutType>> {
 private:
-  tensor_t<T, RANK> out_;
-  Op op_;
+  OutType out_;
+  op_storage_t<Op> op_;
 
 public:
   // Type specifier for reflection on class
@@ -106,7 +405,22 @@ public:
    * @param op
    *   Input operator
    */
-  inline set(tensor_t<T, RANK> &out, const Op op) : out_(out), op_(op)
+  inline set(tensor_t<T, RANK> &out, const Op op)
+      : set(OutType(out), op)
+  {
+  }
+
+  /**
+   * Constructor to assign an operator to a referenced view
+   *
+   * @param out
+   *   Output destination view
+   *
+   * @param op
+   *   Input operator
+   */
+  inline set(const OutType &out, const Op op)
+      : out_(out), op_(op)
   {
     MATX_STATIC_ASSERT(get_rank<Op>() == -1 || Rank() == get_rank<Op>(),
                        matxInvalidDim);
@@ -122,7 +436,7 @@ public:
 
   set &operator=(const set &) = delete;
 
-  __device__ inline auto operator()() noexcept
+  __host__ __device__ inline auto operator()() noexcept
   {
     if constexpr (is_matx_half_v<T> &&
                   std::is_integral_v<decltype(get_value(op_))>) {
@@ -135,7 +449,7 @@ public:
     return out_();
   }
 
-  __device__ inline auto operator()(index_t i) noexcept
+  __host__ __device__ inline auto operator()(index_t i) noexcept
   {
     if constexpr (is_matx_half_v<T> &&
                   std::is_integral_v<decltype(get_value(op_, i))>) {
@@ -148,7 +462,7 @@ public:
     return out_(i);
   }
 
-  __device__ inline auto operator()(index_t i, index_t j) noexcept
+  __host__ __device__ inline auto operator()(index_t i, index_t j) noexcept
   {
     if constexpr (is_matx_half_v<T> &&
                   std::is_integral_v<decltype(get_value(op_, i, j))>) {
@@ -161,7 +475,8 @@ public:
     return out_(i, j);
   }
 
-  __device__ inline auto operator()(index_t i, index_t j, index_t k) noexcept
+  __host__ __device__ inline auto operator()(index_t i, index_t j,
+                                             index_t k) noexcept
   {
     if constexpr (is_matx_half_v<T> &&
                   std::is_integral_v<decltype(get_value(op_, i, j, k))>) {
@@ -174,7 +489,7 @@ public:
     return out_(i, j, k);
   }
 
-  __device__ inline auto operator()(index_t i, index_t j, index_t k,
+  __host__ __device__ inline auto operator()(index_t i, index_t j, index_t k,
                                     index_t l) noexcept
   {
     if constexpr (is_matx_half_v<T> &&
@@ -188,6 +503,22 @@ public:
     return out_(i, j, k, l);
   }
 
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4 && sizeof...(Is) == RANK),
+                             bool> = true>
+  __host__ __device__ inline auto operator()(Is... is) noexcept
+  {
+    if constexpr (is_matx_half_v<T> &&
+                  std::is_integral_v<decltype(get_value(op_, is...))>) {
+      out_(is...) = static_cast<float>(get_value(op_, is...));
+    }
+    else {
+      out_(is...) = get_value(op_, is...);
+    }
+
+    return out_(is...);
+  }
+
   /**
    * Get the rank of the operator
    *
@@ -209,6 +540,57 @@ public:
   {
     return out_.Size(dim);
   }
+
+  /**
+   * Get the destination view
+   *
+   * @return
+   *   Destination view
+   */
+  inline __host__ const OutType &Output() const { return out_; }
+
+  /**
+   * Call a function on the input operator. Used to find the tensors a
+   * deferred statement reads.
+   *
+   * @param f
+   *   Function to call
+   */
+  template <typename F> inline __host__ void VisitInputs(F &&f) const
+  {
+    f(op_);
+  }
+
+  /* Whether exec() can merge the dimensions of this statement */
+  static inline constexpr __host__ bool Collapsible()
+  {
+    return RANK >= 1 && is_collapsible_op<OutType>::value &&
+           is_collapsible_op<op_storage_t<Op>>::value;
+  }
+
+  inline __host__ void CollapseCheck(matxCollapse_t &c) const
+  {
+    CollapseCheckOp(out_, c);
+    CollapseCheckOp(op_, c);
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
+  template <int NR, typename I = index_t>
+  inline __host__ auto Collapse(const matxCollapse_t &c) const
+  {
+    auto op = CollapseOp<NR, I>(op_, c);
+    auto out = CollapseOp<NR, I>(out_, c);
+    return set<T, NR, decltype(op), decltype(out)>(out, op);
+  }
 };
 
 /**
@@ -249,10 +631,18 @@ public:
 #endif
   }
 
-  __host__ __device__ tensor_t<T, RANK>(tensor_t<T, RANK> const &&rhs) noexcept
-      : data_(rhs.data_), ldata_(rhs.ldata_), shape_(std::move(rhs.shape_)),
-        s_(rhs.s_), refcnt_(rhs.refcnt_)
+  /**
+   * Move a tensor view. The reference held by rhs is taken over rather than
+   * counted again, and rhs no longer releases it.
+   *
+   * @param rhs
+   *   Tensor to move from
+   */
+  __host__ __device__ tensor_t<T, RANK>(tensor_t<T, RANK> &&rhs) noexcept
+      : data_(rhs.data_), ldata_(rhs.ldata_), refcnt_(rhs.refcnt_),
+        shape_(std::move(rhs.shape_)), s_(rhs.s_)
   {
+    rhs.refcnt_ = nullptr;
   }
 
   /** Perform a shallow copy of a tensor view
@@ -1077,7 +1467,7 @@ public:
       s[i] = s_[d];
     }
 
-    return tensor_t(data_, data_, n, s, refcnt_);
+    return tensor_t(data_, ldata_, n, s, refcnt_);
   }
 
   /**
@@ -1504,6 +1894,56 @@ public:
     return *(ldata_ + s_[0] * id0 + s_[1] * id1 + s_[2] * id2 + s_[3] * id3);
   }
 
+  /**
+   * operator() getter for ranks above 4
+   *
+   * @param indices
+   *   Index into each dimension
+   *
+   * @returns value at given index
+   *
+   */
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4 && sizeof...(Is) == RANK &&
+                              (std::is_integral_v<Is> && ...)),
+                             bool> = true>
+  inline __host__ __device__ const T &operator()(Is... indices) const noexcept
+  {
+    const index_t idx[] = {static_cast<index_t>(indices)...};
+    index_t offset = 0;
+#pragma unroll
+    for (int i = 0; i < RANK; i++) {
+      offset += s_[i] * idx[i];
+    }
+
+    return *(ldata_ + offset);
+  }
+
+  /**
+   * operator() setter for ranks above 4
+   *
+   * @param indices
+   *   Index into each dimension
+   *
+   * @returns reference to value at given index
+   *
+   */
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4 && sizeof...(Is) == RANK &&
+                              (std::is_integral_v<Is> && ...)),
+                             bool> = true>
+  inline __host__ __device__ T &operator()(Is... indices) noexcept
+  {
+    const index_t idx[] = {static_cast<index_t>(indices)...};
+    index_t offset = 0;
+#pragma unroll
+    for (int i = 0; i < RANK; i++) {
+      offset += s_[i] * idx[i];
+    }
+
+    return *(ldata_ + offset);
+  }
+
   /**
    * Create an overlapping tensor view
    *
@@ -1517,10 +1957,12 @@ public:
    *  3 4
    *  4 5]
    *
-   * Currently this only works on 1D tensors going to 2D, but may be expanded
-   * for higher dimensions in the future. Note that if the window size does not
-   * divide evenly into the existing column dimension, the view may chop off the
-   * end of the data to make the tensor rectangular.
+   * The windows are taken along the last dimension, which is split into a
+   * dimension of windows followed by the elements of each window. Any leading
+   * dimensions are kept as batch dimensions, so a rank N tensor becomes rank
+   * N + 1. Note that if the window size does not divide evenly into the
+   * existing column dimension, the view may chop off the end of the data to
+   * make the tensor rectangular.
    *
    * @param windows
    *   Window size (columns in output)
@@ -1536,7 +1978,7 @@ public:
               std::initializer_list<index_t> const &strides) const
   {
 #else
-  template <int M = RANK, std::enable_if_t<M == 1, bool> = true>
+  template <int M = RANK, std::enable_if_t<(M >= 1 && M < MATX_MAX_RANK), bool> = true>
   inline tensor_t<T, RANK + 1>
   OverlapView(std::initializer_list<index_t> const &windows,
               std::initializer_list<index_t> const &strides) const
@@ -1544,28 +1986,31 @@ public:
 #endif
     index_t n[RANK + 1], s[RANK + 1];
 
-    // This only works for 1D tensors going to 2D at the moment. Generalize to
-    // higher dims later
     index_t window_size = *(windows.begin());
     index_t stride_size = *(strides.begin());
 
-    MATX_ASSERT(stride_size < window_size, matxInvalidSize);
+    MATX_ASSERT(stride_size <= window_size, matxInvalidSize);
     MATX_ASSERT(stride_size > 0, matxInvalidSize);
 
     // Figure out the actual length of the signal we can use. It might be
     // shorter than the original tensor if the window/stride doesn't line up
     // properly to make a rectangular matrix.
-    index_t adj_el = Size(0) - window_size;
+    index_t adj_el = Size(RANK - 1) - window_size;
     while ((adj_el % stride_size) != 0) {
       adj_el--;
     }
 
-    n[1] = window_size;
-    s[1] = 1;
-    n[0] = adj_el / stride_size + 1;
-    s[0] = stride_size;
+    for (int i = 0; i < RANK - 1; i++) {
+      n[i] = Size(i);
+      s[i] = s_[i];
+    }
 
-    return tensor_t<T, RANK + 1>(data_, data_, n, s, refcnt_);
+    n[RANK] = window_size;
+    s[RANK] = s_[RANK - 1];
+    n[RANK - 1] = adj_el / stride_size + 1;
+    s[RANK - 1] = stride_size * s_[RANK - 1];
+
+    return tensor_t<T, RANK + 1>(data_, ldata_, n, s, refcnt_);
   }
 
   /**
@@ -1597,7 +2042,8 @@ public:
   tensor_t<T, N> Clone(const index_t (&clones)[N]) const
   {
 #else
-  template <int N, std::enable_if_t<(N <= 4 && N > RANK), bool> = true>
+  template <int N,
+            std::enable_if_t<(N <= MATX_MAX_RANK && N > RANK), bool> = true>
   inline tensor_t<T, N> Clone(const index_t (&clones)[N]) const
   {
 #endif
@@ -1627,7 +2073,7 @@ public:
     MATX_ASSERT_STR(d == RANK, matxInvalidDim,
                     "Must keep as many dimension as the original tensor has");
 
-    return tensor_t<T, N>(data_, data_, n, s, refcnt_);
+    return tensor_t<T, N>(data_, ldata_, n, s, refcnt_);
   }
 
   /**
@@ -2414,4 +2860,157 @@ private:
   std::array<index_t, RANK> s_; // +1 to avoid zero sized array
 };
 
+
+/**
+ * View of contiguous memory with sizes known at compile time
+ *
+ * Each dimension's size is either fixed by EXTENTS or given when the view is
+ * made, with matxDynamicExtent marking the runtime ones, as in std::extents.
+ * Elements are stored in row-major order with no padding, so the strides
+ * follow from the sizes and need no storage of their own. Offsets into a view
+ * whose extents are all static are computed from constants, which lets the
+ * compiler fold the index arithmetic and fully unroll loops over the view.
+ *
+ * Like tensor_ref_t, the view doesn't own its memory. A view of a local array
+ * made inside a kernel has no runtime state other than the pointer, so small
+ * blocks like 3x3 matrices can be kept in registers.
+ *
+ * Static views can be used as the input or output of any operator. exec()
+ * doesn't merge the dimensions of statements that use them, since that would
+ * replace their constant strides with runtime ones.
+ *
+ * @tparam T
+ *   Type of the elements
+ * @tparam EXTENTS
+ *   Size of each dimension, or matxDynamicExtent
+ */
+template <typename T, index_t... EXTENTS> class tensor_static_t {
+public:
+  // Type specifier for reflection on class
+  using type = T;
+  using scalar_type = T;
+  using tensor_view = bool;
+  using extents_type = tensorExtents_t<EXTENTS...>;
+
+  // Type specifier for signaling this is a matx operation
+  using matxop = bool;
+
+  /**
+   * View memory with the given sizes for the dynamic dimensions
+   *
+   * @param data
+   *   Pointer to the first element
+   * @param sizes
+   *   Sizes of the dynamic dimensions, in order
+   */
+  template <typename... S,
+            std::enable_if_t<(std::is_integral_v<S> && ...), bool> = true>
+  inline __host__ __device__ tensor_static_t(T *data, S... sizes) noexcept
+      : ldata_(data), ext_(sizes...)
+  {
+  }
+
+  tensor_static_t(const tensor_static_t &) = default;
+
+  /**
+   * View the memory of a tensor. The tensor must be contiguous and its
+   * sizes must match the static extents.
+   *
+   * @param t
+   *   Tensor view to reference
+   */
+  inline __host__ tensor_static_t(const tensor_t<T, sizeof...(EXTENTS)> &t)
+      : ldata_(t.Data()), ext_(Sizes(t).data())
+  {
+    MATX_ASSERT_STR(t.IsLinear(), matxInvalidParameter,
+                    "Static views require a contiguous tensor");
+  }
+
+  static inline constexpr __host__ __device__ int32_t Rank()
+  {
+    return extents_type::Rank();
+  }
+
+  inline __host__ __device__ index_t Size(uint32_t dim) const noexcept
+  {
+    return ext_.Size(static_cast<int>(dim));
+  }
+
+  inline __host__ __device__ index_t TotalSize() const noexcept
+  {
+    return ext_.TotalSize();
+  }
+
+  inline __host__ __device__ T *Data() const noexcept { return ldata_; }
+
+  /**
+   * Access an element. Offsets are computed innermost dimension last, so
+   * each step multiplies by the size of one dimension, a constant when it's
+   * static.
+   *
+   * @param indices
+   *   Index into each dimension
+   */
+  template <typename... Is,
+            std::enable_if_t<(std::is_integral_v<Is> && ...), bool> = true>
+  inline __host__ __device__ T &operator()(Is... indices) const noexcept
+  {
+    static_assert(sizeof...(Is) == Rank(),
+                  "Number of indices must match the rank of the view");
+
+    const index_t idx[] = {static_cast<index_t>(indices)...};
+    index_t offset = idx[0];
+#pragma unroll
+    for (int i = 1; i < Rank(); i++) {
+      offset = offset * Size(i) + idx[i];
+    }
+
+    return ldata_[offset];
+  }
+
+  /**
+   * Lazy assignment operator=. Used to create a "set" object for deferred
+   * execution on a device
+   *
+   * @param op
+   *   Tensor view source
+   *
+   * @returns set object containing the destination view and source object
+   */
+  [[nodiscard]] inline __host__ auto operator=(const tensor_static_t &op)
+  {
+    return set<T, Rank(), tensor_static_t, tensor_static_t>(*this, op);
+  }
+
+  /**
+   * Lazy assignment operator=. Used to create a "set" object for deferred
+   * execution on a device
+   *
+   * @param op
+   *   Operator or scalar type to assign
+   *
+   * @returns set object containing the destination view and source object
+   */
+  template <typename T2>
+  [[nodiscard]] inline __host__ auto operator=(const T2 &op)
+  {
+    return set<T, Rank(), T2, tensor_static_t>(*this, op);
+  }
+
+private:
+  static inline __host__ std::array<index_t, sizeof...(EXTENTS)>
+  Sizes(const tensor_t<T, sizeof...(EXTENTS)> &t)
+  {
+    std::array<index_t, sizeof...(EXTENTS)> n;
+    for (int i = 0; i < Rank(); i++) {
+      n[i] = t.Size(i);
+    }
+
+    return n;
+  }
+
+  T *ldata_;
+  extents_type ext_;
+};
+
 } // end namespace matx
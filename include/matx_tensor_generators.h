@@ -36,6 +36,7 @@
 #include <cmath>
 
 #include "matx_tensor.h"
+#include "matx_window.h"
 
 namespace matx {
 
@@ -51,11 +52,20 @@ public:
 
   ConstVal(tensorShape_t<RANK> s, T val) : s_(s), v_(val){};
 
-  inline __device__ T operator()() { return v_; };
-  inline __device__ T operator()(index_t) { return v_; };
-  inline __device__ T operator()(index_t, index_t) { return v_; };
-  inline __device__ T operator()(index_t, index_t, index_t) { return v_; };
-  inline __device__ T operator()(index_t, index_t, index_t, index_t)
+  inline __host__ __device__ T operator()() { return v_; };
+  inline __host__ __device__ T operator()(index_t) { return v_; };
+  inline __host__ __device__ T operator()(index_t, index_t) { return v_; };
+  inline __host__ __device__ T operator()(index_t, index_t, index_t)
+  {
+    return v_;
+  };
+  inline __host__ __device__ T operator()(index_t, index_t, index_t, index_t)
+  {
+    return v_;
+  };
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+  inline __host__ __device__ T operator()(Is...)
   {
     return v_;
   };
@@ -126,29 +136,30 @@ public:
 
   Diag(tensorShape_t<RANK> s, T val) : s_(s), val_(val){};
 
-  inline __device__ T operator()() { return T(val_); };
-  inline __device__ T operator()(index_t i)
+  inline __host__ __device__ T operator()() { return T(val_); };
+  inline __host__ __device__ T operator()(index_t i)
   {
     if (i == 0)
       return val_;
     else
       return T(0.0f);
   };
-  inline __device__ T operator()(index_t i, index_t j)
+  inline __host__ __device__ T operator()(index_t i, index_t j)
   {
     if (i == j)
       return T(val_);
     else
       return T(0.0f);
   };
-  inline __device__ T operator()(index_t i, index_t j, index_t k)
+  inline __host__ __device__ T operator()(index_t i, index_t j, index_t k)
   {
     if (i == j && i == k)
       return T(val_);
     else
       return T(0.0f);
   };
-  inline __device__ T operator()(index_t i, index_t j, index_t k, index_t l)
+  inline __host__ __device__ T operator()(index_t i, index_t j, index_t k,
+                                         index_t l)
   {
     if (i == j && k == l && i == k)
       return T(val_);
@@ -215,8 +226,8 @@ public:
   using scalar_type = typename Generator1D::scalar_type;
 
   matxGenerator1D_t(tensorShape_t<RANK> s, Generator1D f) : f_(f), s_(s) {}
-  inline __device__ auto operator()(int i) { return f_(i); };
-  inline __device__ auto operator()(int i, int j)
+  inline __host__ __device__ auto operator()(int i) { return f_(i); };
+  inline __host__ __device__ auto operator()(int i, int j)
   {
     if constexpr (Dim == 0) {
       return f_(i);
@@ -227,7 +238,7 @@ public:
     // BUG WAR
     return scalar_type(0);
   };
-  inline __device__ auto operator()(int i, int j, int k)
+  inline __host__ __device__ auto operator()(int i, int j, int k)
   {
     if constexpr (Dim == 0) {
       return f_(i);
@@ -241,7 +252,7 @@ public:
     // BUG WAR
     return scalar_type(0);
   };
-  inline __device__ auto operator()(int i, int j, int k, int l)
+  inline __host__ __device__ auto operator()(int i, int j, int k, int l)
   {
     if constexpr (Dim == 0) {
       return f_(i);
@@ -270,27 +281,15 @@ private:
   tensorShape_t<RANK> s_;
 };
 
-template <typename T> class Hamming {
-private:
-  index_t size_;
-
-public:
-  using scalar_type = T;
-
-  inline __host__ __device__ Hamming(index_t size) : size_(size){};
-
-  inline __host__ __device__ T operator()(index_t i)
-  {
-    return T(.54) - T(.46) * cuda::std::cos(T(2 * M_PI) * T(i) / T(size_ - 1));
-  }
-};
-
 /// @name HammingWindows
 /// @{
 /**
  * Creates a Hamming window operator of shape s with the
  * window applies along the x, y, z, or w dimension
  *
+ * The coefficients are computed once per window length and read from a
+ * cached table, so the window costs one load per element.
+ *
  * @tparam T
  *   Data type
  *
@@ -306,68 +305,54 @@ template <typename T = float, int RANK>
 inline auto hamming_x(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 1);
-  Hamming<T> h(s.Size(RANK - 1));
-  return matxGenerator1D_t<Hamming<T>, RANK - 1, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HAMMING, s.Size(RANK - 1));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 1, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hamming_x(const index_t (&s)[RANK])
 {
-  return hamming_x(tensorShape_t<RANK>{(const index_t *)s});
+  return hamming_x<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto hamming_y(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 2);
-  Hamming<T> h(s.Size(RANK - 2));
-  return matxGenerator1D_t<Hamming<T>, RANK - 2, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HAMMING, s.Size(RANK - 2));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 2, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hamming_y(const index_t (&s)[RANK])
 {
-  return hamming_y(tensorShape_t<RANK>{(const index_t *)s});
+  return hamming_y<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto hamming_z(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 3);
-  Hamming<T> h(s.Size(RANK - 3));
-  return matxGenerator1D_t<Hamming<T>, RANK - 3, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HAMMING, s.Size(RANK - 3));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 3, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hamming_z(const index_t (&s)[RANK])
 {
-  return hamming_z(tensorShape_t<RANK>{(const index_t *)s});
+  return hamming_z<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto hamming_w(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 4);
-  Hamming<T> h(s.Size(RANK - 4));
-  return matxGenerator1D_t<Hamming<T>, RANK - 4, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HAMMING, s.Size(RANK - 4));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 4, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hamming_w(const index_t (&s)[RANK])
 {
-  return hamming_w(tensorShape_t<RANK>{(const index_t *)s});
+  return hamming_w<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
-
 /// @}
-template <typename T> class Hanning {
-private:
-  index_t size_;
-
-public:
-  using scalar_type = T;
-  inline __host__ __device__ Hanning(index_t size) : size_(size){};
-
-  inline __host__ __device__ T operator()(index_t i)
-  {
-    return T(0.5) * (1 - cuda::std::cos(T(2 * M_PI) * T(i) / T(size_ - 1)));
-  }
-};
 
 /// @name HanningWindows
 /// @{
@@ -375,11 +360,13 @@ public:
  * Creates a Hanning window operator of shape s with the
  * window applies along the x, y, z, or w dimension
  *
+ * The coefficients are read from a cached table.
+ *
  * @tparam T
  *   Data type
  *
  * @tparam RANK
- *   The RANK of the shape
+ *   The RANK of the shape, can be deduced from shape
  *
  * @param s
  *   The shape of the tensor
@@ -390,81 +377,66 @@ template <typename T = float, int RANK>
 inline auto hanning_x(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 1);
-  Hanning<T> h(s.Size(RANK - 1));
-  return matxGenerator1D_t<Hanning<T>, RANK - 1, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HANN, s.Size(RANK - 1));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 1, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hanning_x(const index_t (&s)[RANK])
 {
-  return hanning_x(tensorShape_t<RANK>{(const index_t *)s});
+  return hanning_x<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto hanning_y(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 2);
-  Hanning<T> h(s.Size(RANK - 2));
-  return matxGenerator1D_t<Hanning<T>, RANK - 2, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HANN, s.Size(RANK - 2));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 2, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hanning_y(const index_t (&s)[RANK])
 {
-  return hanning_y(tensorShape_t<RANK>{(const index_t *)s});
+  return hanning_y<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto hanning_z(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 3);
-  Hanning<T> h(s.Size(RANK - 3));
-  return matxGenerator1D_t<Hanning<T>, RANK - 3, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HANN, s.Size(RANK - 3));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 3, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hanning_z(const index_t (&s)[RANK])
 {
-  return hanning_z(tensorShape_t<RANK>{(const index_t *)s});
+  return hanning_z<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto hanning_w(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 4);
-  Hanning<T> h(s.Size(RANK - 4));
-  return matxGenerator1D_t<Hanning<T>, RANK - 4, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_HANN, s.Size(RANK - 4));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 4, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto hanning_w(const index_t (&s)[RANK])
 {
-  return hanning_w(tensorShape_t<RANK>{(const index_t *)s});
+  return hanning_w<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
-
-template <typename T> class Blackman {
-private:
-  index_t size_;
-
-public:
-  using scalar_type = T;
-  inline __host__ __device__ Blackman(index_t size) : size_(size){};
-
-  inline __host__ __device__ T operator()(index_t i)
-  {
-    return T(0.42) +
-           ((T)0.5 *
-            cuda::std::cos(T(M_PI) * (1 - size_ + 2 * T(i)) / T(size_ - 1))) +
-           ((T)0.08 * cuda::std::cos(T(2 * M_PI) * (1 - size_ + 2 * T(i)) /
-                                     T(size_ - 1)));
-  }
-};
+/// @}
 
 /**
  * Creates a Blackman window operator of shape s with the
  * window applies along the x, y, z, or w dimension
  *
+ * The coefficients are read from a cached table.
+ *
  * @tparam T
  *   Data type
  *
  * @tparam RANK
- *   The RANK of the shape
+ *   The RANK of the shape, can be deduced from shape
  *
  * @param s
  *   The shape of the tensor
@@ -475,52 +447,285 @@ template <typename T = float, int RANK>
 inline auto blackman_x(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 1);
-  Blackman<T> h(s.Size(RANK - 1));
-  return matxGenerator1D_t<Blackman<T>, RANK - 1, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_BLACKMAN, s.Size(RANK - 1));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 1, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto blackman_x(const index_t (&s)[RANK])
 {
-  return blackman_x(tensorShape_t<RANK>{(const index_t *)s});
+  return blackman_x<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto blackman_y(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 2);
-  Blackman<T> h(s.Size(RANK - 2));
-  return matxGenerator1D_t<Blackman<T>, RANK - 2, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_BLACKMAN, s.Size(RANK - 2));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 2, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto blackman_y(const index_t (&s)[RANK])
 {
-  return blackman_y(tensorShape_t<RANK>{(const index_t *)s});
+  return blackman_y<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto blackman_z(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 3);
-  Blackman<T> h(s.Size(RANK - 3));
-  return matxGenerator1D_t<Blackman<T>, RANK - 3, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_BLACKMAN, s.Size(RANK - 3));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 3, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto blackman_z(const index_t (&s)[RANK])
 {
-  return blackman_z(tensorShape_t<RANK>{(const index_t *)s});
+  return blackman_z<T>(tensorShape_t<RANK>{(const index_t *)s});
 }
 
 template <typename T = float, int RANK>
 inline auto blackman_w(const tensorShape_t<RANK> &s)
 {
   static_assert(RANK >= 4);
-  Blackman<T> h(s.Size(RANK - 4));
-  return matxGenerator1D_t<Blackman<T>, RANK - 4, RANK>(s, h);
+  WindowTable<T> h(WINDOW_TYPE_BLACKMAN, s.Size(RANK - 4));
+  return matxGenerator1D_t<WindowTable<T>, RANK - 4, RANK>(s, h);
 }
 template <typename T = float, int RANK>
 inline auto blackman_w(const index_t (&s)[RANK])
 {
-  return blackman_w(tensorShape_t<RANK>{(const index_t *)s});
+  return blackman_w<T>(tensorShape_t<RANK>{(const index_t *)s});
+}
+
+/**
+ * Creates a Kaiser window operator of shape s with the
+ * window applies along the x, y, z, or w dimension
+ *
+ * The coefficients are read from a cached table keyed by the length and
+ * beta.
+ *
+ * @tparam T
+ *   Data type
+ *
+ * @tparam RANK
+ *   The RANK of the shape, can be deduced from shape
+ *
+ * @param s
+ *   The shape of the tensor
+ *
+ * @param beta
+ *   Shape of the window. Larger values give lower sidelobes and a wider
+ * main lobe
+ *
+ * Returns values for a Kaiser window across the selected dimension.
+ */
+template <typename T = float, int RANK>
+inline auto kaiser_x(const tensorShape_t<RANK> &s, double beta)
+{
+  static_assert(RANK >= 1);
+  WindowTable<T> h(WINDOW_TYPE_KAISER, s.Size(RANK - 1), beta);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 1, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto kaiser_x(const index_t (&s)[RANK], double beta)
+{
+  return kaiser_x<T>(tensorShape_t<RANK>{(const index_t *)s}, beta);
+}
+
+template <typename T = float, int RANK>
+inline auto kaiser_y(const tensorShape_t<RANK> &s, double beta)
+{
+  static_assert(RANK >= 2);
+  WindowTable<T> h(WINDOW_TYPE_KAISER, s.Size(RANK - 2), beta);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 2, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto kaiser_y(const index_t (&s)[RANK], double beta)
+{
+  return kaiser_y<T>(tensorShape_t<RANK>{(const index_t *)s}, beta);
+}
+
+template <typename T = float, int RANK>
+inline auto kaiser_z(const tensorShape_t<RANK> &s, double beta)
+{
+  static_assert(RANK >= 3);
+  WindowTable<T> h(WINDOW_TYPE_KAISER, s.Size(RANK - 3), beta);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 3, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto kaiser_z(const index_t (&s)[RANK], double beta)
+{
+  return kaiser_z<T>(tensorShape_t<RANK>{(const index_t *)s}, beta);
+}
+
+template <typename T = float, int RANK>
+inline auto kaiser_w(const tensorShape_t<RANK> &s, double beta)
+{
+  static_assert(RANK >= 4);
+  WindowTable<T> h(WINDOW_TYPE_KAISER, s.Size(RANK - 4), beta);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 4, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto kaiser_w(const index_t (&s)[RANK], double beta)
+{
+  return kaiser_w<T>(tensorShape_t<RANK>{(const index_t *)s}, beta);
+}
+
+/**
+ * Creates a Dolph-Chebyshev window operator of shape s with the
+ * window applies along the x, y, z, or w dimension
+ *
+ * All sidelobes are at the given attenuation. The coefficients are read
+ * from a cached table keyed by the length and attenuation.
+ *
+ * @tparam T
+ *   Data type
+ *
+ * @tparam RANK
+ *   The RANK of the shape, can be deduced from shape
+ *
+ * @param s
+ *   The shape of the tensor
+ *
+ * @param at
+ *   Sidelobe attenuation in dB
+ *
+ * Returns values for a Chebyshev window across the selected dimension.
+ */
+template <typename T = float, int RANK>
+inline auto chebwin_x(const tensorShape_t<RANK> &s, double at)
+{
+  static_assert(RANK >= 1);
+  WindowTable<T> h(WINDOW_TYPE_CHEBYSHEV, s.Size(RANK - 1), at);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 1, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto chebwin_x(const index_t (&s)[RANK], double at)
+{
+  return chebwin_x<T>(tensorShape_t<RANK>{(const index_t *)s}, at);
+}
+
+template <typename T = float, int RANK>
+inline auto chebwin_y(const tensorShape_t<RANK> &s, double at)
+{
+  static_assert(RANK >= 2);
+  WindowTable<T> h(WINDOW_TYPE_CHEBYSHEV, s.Size(RANK - 2), at);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 2, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto chebwin_y(const index_t (&s)[RANK], double at)
+{
+  return chebwin_y<T>(tensorShape_t<RANK>{(const index_t *)s}, at);
+}
+
+template <typename T = float, int RANK>
+inline auto chebwin_z(const tensorShape_t<RANK> &s, double at)
+{
+  static_assert(RANK >= 3);
+  WindowTable<T> h(WINDOW_TYPE_CHEBYSHEV, s.Size(RANK - 3), at);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 3, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto chebwin_z(const index_t (&s)[RANK], double at)
+{
+  return chebwin_z<T>(tensorShape_t<RANK>{(const index_t *)s}, at);
+}
+
+template <typename T = float, int RANK>
+inline auto chebwin_w(const tensorShape_t<RANK> &s, double at)
+{
+  static_assert(RANK >= 4);
+  WindowTable<T> h(WINDOW_TYPE_CHEBYSHEV, s.Size(RANK - 4), at);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 4, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto chebwin_w(const index_t (&s)[RANK], double at)
+{
+  return chebwin_w<T>(tensorShape_t<RANK>{(const index_t *)s}, at);
+}
+
+/**
+ * Creates a Taylor window operator of shape s with the
+ * window applies along the x, y, z, or w dimension
+ *
+ * The first nbar - 1 sidelobes are nearly constant at sll dB below the
+ * main lobe, and the window is normalized to one at the center. The
+ * coefficients are read from a cached table keyed by the length, nbar and
+ * sll.
+ *
+ * @tparam T
+ *   Data type
+ *
+ * @tparam RANK
+ *   The RANK of the shape, can be deduced from shape
+ *
+ * @param s
+ *   The shape of the tensor
+ *
+ * @param nbar
+ *   Number of nearly constant sidelobes next to the main lobe
+ *
+ * @param sll
+ *   Sidelobe level in dB below the main lobe
+ *
+ * Returns values for a Taylor window across the selected dimension.
+ */
+template <typename T = float, int RANK>
+inline auto taylor_x(const tensorShape_t<RANK> &s, index_t nbar = 4,
+                     double sll = 30.0)
+{
+  static_assert(RANK >= 1);
+  WindowTable<T> h(WINDOW_TYPE_TAYLOR, s.Size(RANK - 1), sll, nbar);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 1, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto taylor_x(const index_t (&s)[RANK], index_t nbar = 4,
+                     double sll = 30.0)
+{
+  return taylor_x<T>(tensorShape_t<RANK>{(const index_t *)s}, nbar, sll);
+}
+
+template <typename T = float, int RANK>
+inline auto taylor_y(const tensorShape_t<RANK> &s, index_t nbar = 4,
+                     double sll = 30.0)
+{
+  static_assert(RANK >= 2);
+  WindowTable<T> h(WINDOW_TYPE_TAYLOR, s.Size(RANK - 2), sll, nbar);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 2, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto taylor_y(const index_t (&s)[RANK], index_t nbar = 4,
+                     double sll = 30.0)
+{
+  return taylor_y<T>(tensorShape_t<RANK>{(const index_t *)s}, nbar, sll);
+}
+
+template <typename T = float, int RANK>
+inline auto taylor_z(const tensorShape_t<RANK> &s, index_t nbar = 4,
+                     double sll = 30.0)
+{
+  static_assert(RANK >= 3);
+  WindowTable<T> h(WINDOW_TYPE_TAYLOR, s.Size(RANK - 3), sll, nbar);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 3, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto taylor_z(const index_t (&s)[RANK], index_t nbar = 4,
+                     double sll = 30.0)
+{
+  return taylor_z<T>(tensorShape_t<RANK>{(const index_t *)s}, nbar, sll);
+}
+
+template <typename T = float, int RANK>
+inline auto taylor_w(const tensorShape_t<RANK> &s, index_t nbar = 4,
+                     double sll = 30.0)
+{
+  static_assert(RANK >= 4);
+  WindowTable<T> h(WINDOW_TYPE_TAYLOR, s.Size(RANK - 4), sll, nbar);
+  return matxGenerator1D_t<WindowTable<T>, RANK - 4, RANK>(s, h);
+}
+template <typename T = float, int RANK>
+inline auto taylor_w(const index_t (&s)[RANK], index_t nbar = 4,
+                     double sll = 30.0)
+{
+  return taylor_w<T>(tensorShape_t<RANK>{(const index_t *)s}, nbar, sll);
 }
 
 template <typename T> class Bartlett {
@@ -618,7 +823,7 @@ public:
 
   Range(T first, T step) : first_(first), step_(step) {}
 
-  __device__ inline T operator()(index_t idx)
+  __host__ __device__ inline T operator()(index_t idx)
   {
     if constexpr (is_matx_half_v<T>) {
       return first_ + T(static_cast<T>((float)idx) * step_);
@@ -828,7 +1033,7 @@ public:
 #endif
   }
 
-  __device__ inline T operator()(index_t idx) { return range_(idx); }
+  __host__ __device__ inline T operator()(index_t idx) { return range_(idx); }
 };
 
 /// @name Linspace
@@ -926,7 +1131,7 @@ public:
 #endif
   }
 
-  __device__ inline T operator()(index_t idx)
+  __host__ __device__ inline T operator()(index_t idx)
   {
     if constexpr (is_matx_half_v<T>) {
       return static_cast<T>(
@@ -1025,7 +1230,7 @@ public:
 
   Meshgrid_X(std::array<T, 3> x, std::array<T, 3> y) : x_(x), y_(y) {}
 
-  inline __device__ T operator()(index_t i, index_t j)
+  inline __host__ __device__ T operator()(index_t i, index_t j)
   {
     return x_[0] + j * (x_[1] - x_[0]) / (x_[2] - 1);
   }
@@ -1049,7 +1254,7 @@ public:
 
   Meshgrid_Y(std::array<T, 3> x, std::array<T, 3> y) : x_(x), y_(y) {}
 
-  inline __device__ T operator()(index_t i, index_t j)
+  inline __host__ __device__ T operator()(index_t i, index_t j)
   {
     return y_[0] + i * (y_[1] - y_[0]) / (y_[2] - 1);
   };
@@ -36,7 +36,9 @@
 #include <cassert>
 #include <initializer_list>
 
+#include "matx_deferred.h"
 #include "matx_exec_kernel.h"
+#include "matx_host_executor.h"
 #include "matx_scalar_ops.h"
 #include "matx_tensor.h"
 #include "matx_transpose.cuh"
@@ -44,22 +46,120 @@
 
 namespace matx {
 
+/**
+ * Whether a statement can run on the host: an element-wise assignment into a
+ * view of rank 4 or less
+ */
+template <typename T> struct is_host_statement : std::false_type {
+};
+template <class T, int RANK, class Op>
+struct is_host_statement<set<T, RANK, Op>>
+    : std::bool_constant<RANK <= 4 && is_deferred_elementwise<Op>::value> {
+};
+
+/**
+ * Execute an element-wise statement on the host
+ *
+ * Host version of exec() for assignments of element-wise operators into a
+ * view of rank 4 or less. The rows of the output, its innermost dimension,
+ * are split across threads. When capturing, the statement is recorded with
+ * the views it reads and the one it writes.
+ *
+ * @param op
+ *   Statement to execute
+ * @param executor
+ *   Host executor
+ */
+template <class Op> void exec(Op op, const matxHostExecutor_t &executor)
+{
+  static_assert(is_host_statement<Op>::value,
+                "Host statements must be element-wise assignments into a "
+                "view of rank 4 or less");
+  constexpr int RANK = Op::Rank();
+
+  std::vector<DeferredView_t> reads;
+  op.VisitInputs([&](const auto &in) { DeferredReads(in, reads); });
+  const auto write = DeferredMakeView(op.Output());
+  std::vector<matxHostAccess_t> access{{write.lo, write.hi, true}};
+  for (const auto &r : reads) {
+    access.push_back({r.lo, r.hi, false});
+  }
+
+  if (HostGraphRecord(executor, std::move(access),
+                      [op](const matxHostExecutor_t &e) { exec(op, e); })) {
+    return;
+  }
+
+  if constexpr (RANK == 0) {
+    op();
+  }
+  else {
+    const index_t cols = op.Size(RANK - 1);
+    index_t rows = 1;
+    for (int i = 0; i < RANK - 1; i++) {
+      rows *= op.Size(i);
+    }
+
+    if (cols == 0) {
+      return;
+    }
+
+    const int threads = executor.GetNumThreads();
+    matxHostParallelFor(rows, threads, [&](int, index_t start, index_t end) {
+      for (index_t r = start; r < end; r++) {
+        index_t idx[RANK];
+        index_t rem = r;
+        for (int i = RANK - 2; i >= 0; i--) {
+          idx[i] = rem % op.Size(i);
+          rem /= op.Size(i);
+        }
+
+        for (index_t c = 0; c < cols; c++) {
+          idx[RANK - 1] = c;
+          apply_indices(op, idx, std::make_index_sequence<RANK>{});
+        }
+      }
+    });
+  }
+}
+
 template <typename T> class BaseOp {
 public:
   using matxop = bool;
 
-  // Launch work in the stream
+  // Launch work in the stream, or queue it if the stream is deferred
   void run(cudaStream_t stream = 0) noexcept
   {
+    auto q = GetDeferredQueue(stream);
+    if (q != nullptr) {
+      q->Enqueue(*static_cast<T *>(this));
+      return;
+    }
+
     exec(*static_cast<T *>(this), stream);
   }
 
-  // Record an event after the work
+  // Record an event after the work. A deferred stream is flushed first so
+  // the event covers everything queued before it.
   void run(cudaEvent_t ev, cudaStream_t stream = 0) noexcept
   {
-    exec(*static_cast<T *>(this), stream);
+    auto q = GetDeferredQueue(stream);
+    if (q != nullptr) {
+      q->Enqueue(*static_cast<T *>(this));
+      q->Flush();
+    }
+    else {
+      exec(*static_cast<T *>(this), stream);
+    }
+
     cudaEventRecord(ev, stream);    
   }  
+
+  // Run on the host, or record into the graph being captured
+  void run(const matxHostExecutor_t &executor)
+  {
+    exec(*static_cast<T *>(this), executor);
+  }
 };
 
 /**
@@ -84,13 +184,39 @@ template <class T, int Rank>
 inline void copy(tensor_t<T, Rank> out, const tensor_t<T, Rank> &in,
                  const cudaStream_t stream)
 {
+  deferred_flush(stream);
+
   constexpr int rank = Rank;
 
   for (int i = 0; i < rank; i++) {
     MATX_ASSERT(out.Size(i) == in.Size(i), matxInvalidSize);
   }
 
-  (out = self(in)).run(stream);
+  exec(out = self(in), stream);
+};
+
+/**
+ * Copy a tensor view on the host
+ *
+ * Host version of copy(). Both tensor views must be the same rank and size in
+ * every dimension.
+ *
+ * @param out
+ *   Tensor to copy into
+ * @param in
+ *   Tensor to copy from
+ * @param executor
+ *   Host executor
+ */
+template <class T, int Rank>
+inline void copy(tensor_t<T, Rank> out, const tensor_t<T, Rank> &in,
+                 const matxHostExecutor_t &executor)
+{
+  for (int i = 0; i < Rank; i++) {
+    MATX_ASSERT(out.Size(i) == in.Size(i), matxInvalidSize);
+  }
+
+  exec(out = in, executor);
 };
 
 /**
@@ -117,6 +243,8 @@ inline void transpose(tensor_t<T, RANK> &out,
                       const tensor_t<T, RANK> &in,
                       const cudaStream_t stream)
 {
+  deferred_flush(stream);
+
 
   if constexpr (RANK <= 1) {
     return;
@@ -204,6 +332,12 @@ public:
   inline __device__ auto operator()(index_t i, index_t j, index_t k, index_t l)
   {
   }
+  // Accessor for ranks above 4
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+  inline __device__ auto operator()(Is...)
+  {
+  }
 
   // Rank of chain. Purely for type annotations and has no meaning
   static inline constexpr __host__ __device__ int32_t Rank() { return -2; }
@@ -220,7 +354,7 @@ public:
 template <typename T1, typename... ARGS>
 class CHAIN<T1, ARGS...> : public BaseOp<CHAIN<T1, ARGS...>> {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
   CHAIN<ARGS...> args_;
 
 public:
@@ -264,6 +398,26 @@ public:
     args_.operator()(i, j, k, l);
   }
 
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+  inline __device__ auto operator()(Is... is)
+  {
+    get_value(op_, is...);
+    args_.operator()(is...);
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+    PreRunOp(args_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+    PostRunOp(args_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank() noexcept
   {
     return std::max({T1::Rank(), ARGS::Rank()...});
@@ -292,8 +446,8 @@ template <typename... Args> CHAIN(Args...)->CHAIN<Args...>;
  */
 template <typename T1, typename T2> class IF : public BaseOp<IF<T1, T2>> {
 private:
-  T1 cond_;
-  T2 op_;
+  op_storage_t<T1> cond_;
+  op_storage_t<T2> op_;
 
 public:
   using scalar_type = void;
@@ -343,6 +497,25 @@ public:
     if (get_value(cond_, i, j, k, l))
       get_value(op_, i, j, k, l);
   }
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+  __device__ inline auto operator()(Is... is)
+  {
+    if (get_value(cond_, is...))
+      get_value(op_, is...);
+  }
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(cond_, stream);
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(cond_, stream);
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return MAX(get_rank<T1>(), get_rank<T2>());
@@ -369,9 +542,9 @@ public:
 template <typename C1, typename T1, typename T2>
 class IFELSE : public BaseOp<IFELSE<C1, T1, T2>> {
 private:
-  C1 cond_;
-  T1 op1_;
-  T2 op2_;
+  op_storage_t<C1> cond_;
+  op_storage_t<T1> op1_;
+  op_storage_t<T2> op2_;
 
 public:
   using scalar_type = void;
@@ -434,6 +607,29 @@ public:
     else
       get_value(op2_, i, j, k, l);
   }
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+  __device__ inline auto operator()(Is... is)
+  {
+    if (get_value(cond_, is...))
+      get_value(op1_, is...);
+    else
+      get_value(op2_, is...);
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(cond_, stream);
+    PreRunOp(op1_, stream);
+    PreRunOp(op2_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(cond_, stream);
+    PostRunOp(op1_, stream);
+    PostRunOp(op2_, stream);
+  }
 
   static inline constexpr __host__ __device__ int32_t Rank()
   {
@@ -459,7 +655,7 @@ public:
  */
 template <typename T1, int DIM> class ReverseOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -504,6 +700,16 @@ public:
     return op_(i, j, k, l);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -592,7 +798,7 @@ template <typename T1> auto fliplr(T1 t)
  */
 template <typename T1, int DIM> class HermitianTransOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -615,6 +821,16 @@ public:
     return conj(op_(l, k, j, i));
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -643,7 +859,7 @@ template <typename T1> auto hermitianT(T1 t)
  */
 template <typename T1, int RANK> class DiagOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -673,6 +889,16 @@ public:
     return op_(i, j, k, k);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return RANK - 1;
@@ -719,8 +945,8 @@ template <typename T1> auto diag(T1 t) { return DiagOp<T1, T1::Rank()>(t); }
  */
 template <typename T1, typename T2, int DIM> class KronOp {
 private:
-  T1 op1_;
-  T2 op2_;
+  op_storage_t<T1> op1_;
+  op_storage_t<T2> op2_;
 
 public:
   using matxop = bool;
@@ -747,6 +973,18 @@ public:
            op1_(i, j, k / op2_.Size(2), l / op2_.Size(3));
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op1_, stream);
+    PreRunOp(op2_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op1_, stream);
+    PostRunOp(op2_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -792,7 +1030,7 @@ template <typename T1, typename T2> auto kron(T1 a, T2 b)
  */
 template <typename T1, int DIM> class RepMatOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
   index_t reps_[MAX_TENSOR_DIM];
 
 public:
@@ -836,6 +1074,16 @@ public:
                l % op_.Size(3));
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -908,7 +1156,7 @@ template <typename T1> auto repmat(T1 t, const index_t *reps)
  */
 template <typename T1, int DIM> class SelfOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -928,6 +1176,16 @@ public:
     return op_(i, j, k, l);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -963,7 +1221,7 @@ template <typename T1> auto self(T1 t) { return SelfOp<T1, T1::Rank()>(t); };
  */
 template <typename T1, int DIM> class ShiftOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
   index_t shift_;
   index_t base_;
 
@@ -1027,6 +1285,16 @@ public:
     return op_(i, j, k, l);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -1111,7 +1379,7 @@ template <typename T1> auto shift3(T1 t, index_t s)
 
 template <typename T1> class FFTShift1DOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -1146,6 +1414,16 @@ public:
     return op_(i, j, k, l);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -1175,7 +1453,7 @@ template <typename T1> auto fftshift1D(T1 t) { return FFTShift1DOp<T1>(t); }
 
 template <typename T1> class FFTShift2DOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -1210,6 +1488,16 @@ public:
     return op_(i, j, k, l);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -1240,7 +1528,7 @@ template <typename T1> auto fftshift2D(T1 t) { return FFTShift2DOp<T1>(t); }
 
 template <typename T1> class IFFTShift1DOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -1275,6 +1563,16 @@ public:
     return op_(i, j, k, l);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -1305,7 +1603,7 @@ template <typename T1> auto ifftshift1D(T1 t) { return IFFTShift1DOp<T1>(t); }
 
 template <typename T1> class IFFTShift2DOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -1340,6 +1638,16 @@ public:
     return op_(i, j, k, l);
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -1373,7 +1681,7 @@ template <typename T1> auto ifftshift2D(T1 t) { return IFFTShift2DOp<T1>(t); }
 // The op here has two inputs.
 template <class I1, class Op> class matxUnaryOp {
 private:
-  I1 in1_;
+  op_storage_t<I1> in1_;
   Op op_;
 
 public:
@@ -1383,31 +1691,45 @@ public:
 
   inline matxUnaryOp(I1 in1, Op op) : in1_(in1), op_(op) {}
 
-  __device__ inline auto operator()()
+  // Call f on each input. Used to find the tensors a deferred statement reads
+  template <typename F> inline __host__ void VisitInputs(F &&f) const
+  {
+    f(in1_);
+  }
+
+  __host__ __device__ inline auto operator()()
   {
     auto i1 = get_value(in1_);
     return op_(i1);
   }
-  __device__ inline auto operator()(index_t i)
+  __host__ __device__ inline auto operator()(index_t i)
   {
     auto i1 = get_value(in1_, i);
     return op_(i1);
   }
-  __device__ inline auto operator()(index_t i, index_t j)
+  __host__ __device__ inline auto operator()(index_t i, index_t j)
   {
     auto i1 = get_value(in1_, i, j);
     return op_(i1);
   }
-  __device__ inline auto operator()(index_t i, index_t j, index_t k)
+  __host__ __device__ inline auto operator()(index_t i, index_t j, index_t k)
   {
     auto i1 = get_value(in1_, i, j, k);
     return op_(i1);
   }
-  __device__ inline auto operator()(index_t i, uint32_t j, index_t k, index_t l)
+  __host__ __device__ inline auto operator()(index_t i, uint32_t j, index_t k,
+                                             index_t l)
   {
     auto i1 = get_value(in1_, i, j, k, l);
     return op_(i1);
   }
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+  __host__ __device__ inline auto operator()(Is... is)
+  {
+    auto i1 = get_value(in1_, is...);
+    return op_(i1);
+  }
 
   static inline constexpr __host__ __device__ int32_t Rank()
   {
@@ -1418,13 +1740,40 @@ public:
   {
     return get_size(in1_, dim);
   }
+
+  static inline constexpr __host__ bool Collapsible()
+  {
+    return is_collapsible_op<op_storage_t<I1>>::value;
+  }
+
+  inline __host__ void CollapseCheck(matxCollapse_t &c) const
+  {
+    CollapseCheckOp(in1_, c);
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(in1_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(in1_, stream);
+  }
+
+  template <int NR, typename I = index_t>
+  inline __host__ auto Collapse(const matxCollapse_t &c) const
+  {
+    auto in1 = CollapseOp<NR, I>(in1_, c);
+    return matxUnaryOp<decltype(in1), Op>(in1, op_);
+  }
 };
 
 template <typename T1, std::enable_if_t<is_complex_v<extract_scalar_type_t<T1>>,
                                         bool> = true>
 class ComplexPlanarOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -1461,6 +1810,16 @@ public:
     return op_(i, j, k, l).real();
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -1504,7 +1863,7 @@ template <typename T1,
               true>
 class ComplexInterleavedOp {
 private:
-  T1 op_;
+  op_storage_t<T1> op_;
 
 public:
   using matxop = bool;
@@ -1533,6 +1892,16 @@ public:
     return {op_(i, j, k, l), op_(i, j, k + op_.Size(2) / 2, l)};
   }
 
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(op_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(op_, stream);
+  }
+
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return get_rank<T1>();
@@ -1575,8 +1944,8 @@ auto interleaved(T1 t)
 
 template <class I1, class I2, class Op> class matxBinaryOp {
 private:
-  I1 in1_;
-  I2 in2_;
+  op_storage_t<I1> in1_;
+  op_storage_t<I2> in2_;
   Op op_;
 
 public:
@@ -1596,53 +1965,102 @@ public:
     }
   }
 
-  __device__ inline auto operator()()
+  __host__ __device__ inline auto operator()()
   {
     // Rank 0
     auto i1 = get_value(in1_);
     auto i2 = get_value(in2_);
     return op_(i1, i2);
   }
-  __device__ inline auto operator()(index_t i)
+  __host__ __device__ inline auto operator()(index_t i)
   {
     // Rank 1
     auto i1 = get_value(in1_, i);
     auto i2 = get_value(in2_, i);
     return op_(i1, i2);
   }
-  __device__ inline auto operator()(index_t i, index_t j)
+  __host__ __device__ inline auto operator()(index_t i, index_t j)
   {
     // Rank 2
     auto i1 = get_value(in1_, i, j);
     auto i2 = get_value(in2_, i, j);
     return op_(i1, i2);
   }
-  __device__ inline auto operator()(index_t i, index_t j, index_t k)
+  __host__ __device__ inline auto operator()(index_t i, index_t j, index_t k)
   {
     // Rank 3
     auto i1 = get_value(in1_, i, j, k);
     auto i2 = get_value(in2_, i, j, k);
     return op_(i1, i2);
   }
-  __device__ inline auto operator()(index_t i, index_t j, index_t k, index_t l)
+  __host__ __device__ inline auto operator()(index_t i, index_t j, index_t k,
+                                             index_t l)
   {
     // Rank 4
     auto i1 = get_value(in1_, i, j, k, l);
     auto i2 = get_value(in2_, i, j, k, l);
     return op_(i1, i2);
   }
+  template <typename... Is,
+            std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+  __host__ __device__ inline auto operator()(Is... is)
+  {
+    // Ranks above 4
+    auto i1 = get_value(in1_, is...);
+    auto i2 = get_value(in2_, is...);
+    return op_(i1, i2);
+  }
 
   static inline constexpr __host__ __device__ int32_t Rank()
   {
     return MAX(get_rank<I1>(), get_rank<I2>());
   }
 
+  // Call f on each input. Used to find the tensors a deferred statement reads
+  template <typename F> inline __host__ void VisitInputs(F &&f) const
+  {
+    f(in1_);
+    f(in2_);
+  }
+
   index_t inline __host__ __device__ Size(int dim) const
   {
     index_t size1 = get_expanded_size<Rank()>(in1_, dim);
     index_t size2 = get_expanded_size<Rank()>(in2_, dim);
     return MAX(size1, size2);
   }
+
+  static inline constexpr __host__ bool Collapsible()
+  {
+    return is_collapsible_op<op_storage_t<I1>>::value &&
+           is_collapsible_op<op_storage_t<I2>>::value;
+  }
+
+  inline __host__ void CollapseCheck(matxCollapse_t &c) const
+  {
+    CollapseCheckOp(in1_, c);
+    CollapseCheckOp(in2_, c);
+  }
+
+  inline __host__ void PreRun(cudaStream_t stream) const
+  {
+    PreRunOp(in1_, stream);
+    PreRunOp(in2_, stream);
+  }
+
+  inline __host__ void PostRun(cudaStream_t stream) const
+  {
+    PostRunOp(in1_, stream);
+    PostRunOp(in2_, stream);
+  }
+
+  template <int NR, typename I = index_t>
+  inline __host__ auto Collapse(const matxCollapse_t &c) const
+  {
+    auto in1 = CollapseOp<NR, I>(in1_, c);
+    auto in2 = CollapseOp<NR, I>(in2_, c);
+    return matxBinaryOp<decltype(in1), decltype(in2), Op>(in1, in2, op_);
+  }
 };
 
 #define DEFINE_UNARY_OP(FUNCTION, TENSOR_OP)                                   \
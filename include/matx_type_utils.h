@@ -38,6 +38,7 @@
 #include <complex>
 #include <cublas_v2.h>
 #include <type_traits>
+#include <utility>
 
 namespace matx {
 
@@ -54,6 +55,12 @@ using index_t = int32_t;
 static_assert(false, "Must choose either 64-bit or 32-bit index mode");
 #endif
 
+// Highest rank of a tensor. Ranks above 4 are indexed through variadic
+// accessors, and exec() flattens their leading dimensions.
+#ifndef MATX_MAX_RANK
+#define MATX_MAX_RANK 8
+#endif
+
 template <typename T, typename = void>
 struct is_matx_op_impl : std::false_type {
 };
@@ -283,7 +290,7 @@ inline __host__ __device__ index_t
 // We also have to do this recursively to get around bug
 // We also have to invert logic and repeat to get around bug
 template <class T, class M = T>
-inline __device__ auto get_matx_value(T i, index_t idx)
+inline __host__ __device__ auto get_matx_value(T i, index_t idx)
 {
   if constexpr (T::Rank() == 1) {
     return i(idx);
@@ -302,7 +309,7 @@ inline __device__ auto get_matx_value(T i, index_t idx)
 }
 
 template <class T, class M = T>
-inline __device__ auto get_matx_value(T i, index_t idy, index_t idx)
+inline __host__ __device__ auto get_matx_value(T i, index_t idy, index_t idx)
 {
   if constexpr (T::Rank() == 2) {
     return i(idy, idx);
@@ -321,8 +328,8 @@ inline __device__ auto get_matx_value(T i, index_t idy, index_t idx)
 }
 
 template <class T, class M = T>
-inline __device__ auto get_matx_value(T i, index_t idz, index_t idy,
-                                      index_t idx)
+inline __host__ __device__ auto get_matx_value(T i, index_t idz, index_t idy,
+                                               index_t idx)
 {
   if constexpr (T::Rank() == 3) {
     return i(idz, idy, idx);
@@ -341,8 +348,8 @@ inline __device__ auto get_matx_value(T i, index_t idz, index_t idy,
 }
 
 template <class T, class M = T>
-inline __device__ auto get_matx_value(T i, index_t idw, index_t idz,
-                                      index_t idy, index_t idx)
+inline __host__ __device__ auto get_matx_value(T i, index_t idw, index_t idz,
+                                               index_t idy, index_t idx)
 {
   if constexpr (T::Rank() == 4) {
     return i(idw, idz, idy, idx);
@@ -360,7 +367,7 @@ inline __device__ auto get_matx_value(T i, index_t idw, index_t idz,
   }
 }
 
-template <class T, class M = T> inline __device__ auto get_value(T i)
+template <class T, class M = T> inline __host__ __device__ auto get_value(T i)
 {
   if constexpr (is_matx_op<M>()) {
     return i();
@@ -379,7 +386,7 @@ template <class T, class M = T> inline __device__ auto get_value(T i)
 }
 
 template <class T, class M = T>
-inline __device__ auto get_value(T i, index_t idx)
+inline __host__ __device__ auto get_value(T i, index_t idx)
 {
   if constexpr (is_matx_op<M>()) {
     return get_matx_value(i, idx);
@@ -398,7 +405,7 @@ inline __device__ auto get_value(T i, index_t idx)
 }
 
 template <class T, class M = T>
-inline __device__ auto get_value(T i, index_t idy, index_t idx)
+inline __host__ __device__ auto get_value(T i, index_t idy, index_t idx)
 {
   if constexpr (is_matx_op<M>()) {
     return get_matx_value(i, idy, idx);
@@ -417,7 +424,8 @@ inline __device__ auto get_value(T i, index_t idy, index_t idx)
 }
 
 template <class T, class M = T>
-inline __device__ auto get_value(T i, index_t idz, index_t idy, index_t idx)
+inline __host__ __device__ auto get_value(T i, index_t idz, index_t idy,
+                                          index_t idx)
 {
   if constexpr (is_matx_op<M>()) {
     return get_matx_value(i, idz, idy, idx);
@@ -436,8 +444,8 @@ inline __device__ auto get_value(T i, index_t idz, index_t idy, index_t idx)
 }
 
 template <class T, class M = T>
-inline __device__ auto get_value(T i, index_t idw, index_t idz, index_t idy,
-                                 index_t idx)
+inline __host__ __device__ auto get_value(T i, index_t idw, index_t idz,
+                                          index_t idy, index_t idx)
 {
   if constexpr (is_matx_op<M>()) {
     return get_matx_value(i, idw, idz, idy, idx);
@@ -455,6 +463,35 @@ inline __device__ auto get_value(T i, index_t idw, index_t idz, index_t idy,
   }
 }
 
+/**
+ * Call an operator with the indices held in an array
+ */
+template <typename T, typename Idx, size_t... S>
+inline __host__ __device__ decltype(auto)
+apply_indices(T &&op, const Idx &idx, std::index_sequence<S...>)
+{
+  return op(idx[S]...);
+}
+
+/**
+ * Value of an operator at more than four indices. As with the fixed-rank
+ * overloads, an operator of lower rank is broadcast by dropping the leading
+ * indices.
+ */
+template <class T, class M = T, typename... Is,
+          std::enable_if_t<(sizeof...(Is) > 4), bool> = true>
+inline __host__ __device__ auto get_value(T i, Is... indices)
+{
+  if constexpr (is_matx_op<M>()) {
+    constexpr int drop = static_cast<int>(sizeof...(Is)) - T::Rank();
+    const index_t idx[] = {static_cast<index_t>(indices)...};
+    return apply_indices(i, idx + drop, std::make_index_sequence<T::Rank()>{});
+  }
+  else {
+    return i;
+  }
+}
+
 // Supported MatX data types. This enum helps translate types into integers for
 // hashing purposes
 typedef enum {
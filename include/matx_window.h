@@ -0,0 +1,368 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+#include "matx_cache.h"
+#include "matx_error.h"
+#include "matx_tensor.h"
+#include "matx_type_utils.h"
+
+namespace matx {
+
+/**
+ * Window types that can be materialized into a cached coefficient table.
+ * Windows are symmetric and follow the definitions in scipy.signal.windows.
+ */
+typedef enum {
+  WINDOW_TYPE_RECT,      ///< All ones
+  WINDOW_TYPE_HAMMING,   ///< 0.54 - 0.46 cos(2 pi i / (n - 1))
+  WINDOW_TYPE_HANN,      ///< 0.5 - 0.5 cos(2 pi i / (n - 1))
+  WINDOW_TYPE_BLACKMAN,  ///< 0.42 - 0.5 cos(2 pi i / (n - 1)) + 0.08 cos(4 pi
+                         ///< i / (n - 1))
+  WINDOW_TYPE_KAISER,    ///< Kaiser window. The parameter is beta
+  WINDOW_TYPE_CHEBYSHEV, ///< Dolph-Chebyshev window. The parameter is the
+                         ///< sidelobe attenuation in dB
+  WINDOW_TYPE_TAYLOR,    ///< Taylor window with nbar nearly constant
+                         ///< sidelobes. The parameter is the sidelobe level in
+                         ///< dB below the main lobe
+} windowType_t;
+
+/**
+ * Zeroth order modified Bessel function of the first kind, used by the Kaiser
+ * window
+ */
+inline double WindowBesselI0(double x)
+{
+  double sum = 1.0;
+  double term = 1.0;
+  const double q = x * x / 4.0;
+  for (int k = 1; k < 500; k++) {
+    term *= q / (static_cast<double>(k) * static_cast<double>(k));
+    sum += term;
+    if (term < sum * 1e-17) {
+      break;
+    }
+  }
+
+  return sum;
+}
+
+/**
+ * Dolph-Chebyshev window with the given sidelobe attenuation in dB, computed
+ * the same way as scipy.signal.windows.chebwin: the window is the real part
+ * of the DFT of the Chebyshev polynomial sampled on the unit circle,
+ * normalized to a peak of one. The DFT is done directly since the window is
+ * only computed once.
+ */
+inline std::vector<double> WindowChebyshev(index_t n, double at)
+{
+  const double order = static_cast<double>(n - 1);
+  const double beta = std::cosh(std::acosh(std::pow(10.0, at / 20.0)) / order);
+  const double dn = static_cast<double>(n);
+
+  std::vector<double> pre(static_cast<size_t>(n));
+  std::vector<double> pim(static_cast<size_t>(n), 0.0);
+  for (index_t k = 0; k < n; k++) {
+    const double x = beta * std::cos(M_PI * static_cast<double>(k) / dn);
+    double p;
+    if (x > 1.0) {
+      p = std::cosh(order * std::acosh(x));
+    }
+    else if (x < -1.0) {
+      p = (n % 2 == 1 ? 1.0 : -1.0) * std::cosh(order * std::acosh(-x));
+    }
+    else {
+      p = std::cos(order * std::acos(x));
+    }
+
+    // Even lengths are shifted by half a sample so the window is symmetric
+    if (n % 2 == 0) {
+      const double ph = M_PI * static_cast<double>(k) / dn;
+      pre[k] = p * std::cos(ph);
+      pim[k] = p * std::sin(ph);
+    }
+    else {
+      pre[k] = p;
+    }
+  }
+
+  const index_t half = n % 2 == 1 ? (n + 1) / 2 : n / 2 + 1;
+  std::vector<double> spec(static_cast<size_t>(half));
+  for (index_t k = 0; k < half; k++) {
+    double acc = 0.0;
+    for (index_t m = 0; m < n; m++) {
+      const double ph = 2.0 * M_PI * static_cast<double>((k * m) % n) / dn;
+      acc += pre[m] * std::cos(ph) + pim[m] * std::sin(ph);
+    }
+    spec[k] = acc;
+  }
+
+  std::vector<double> w(static_cast<size_t>(n));
+  for (index_t i = 0; i < n; i++) {
+    if (n % 2 == 1) {
+      w[i] = spec[std::abs(i - (half - 1))];
+    }
+    else {
+      w[i] = i < half - 1 ? spec[half - 1 - i] : spec[i - (half - 1) + 1];
+    }
+  }
+
+  const double peak = *std::max_element(w.begin(), w.end());
+  for (auto &v : w) {
+    v /= peak;
+  }
+
+  return w;
+}
+
+/**
+ * Taylor window with nbar nearly constant sidelobes at sll dB below the main
+ * lobe, normalized to one at the center, the same as
+ * scipy.signal.windows.taylor
+ */
+inline std::vector<double> WindowTaylor(index_t n, index_t nbar, double sll)
+{
+  const double b = std::pow(10.0, sll / 20.0);
+  const double a = std::acosh(b) / M_PI;
+  const double dnbar = static_cast<double>(nbar);
+  const double s2 = dnbar * dnbar / (a * a + (dnbar - 0.5) * (dnbar - 0.5));
+
+  std::vector<double> fm(static_cast<size_t>(std::max<index_t>(nbar - 1, 0)));
+  for (index_t m = 1; m < nbar; m++) {
+    const double m2 = static_cast<double>(m * m);
+    double numer = (m % 2 == 1) ? 1.0 : -1.0;
+    double denom = 2.0;
+    for (index_t i = 1; i < nbar; i++) {
+      const double di = static_cast<double>(i);
+      numer *= 1.0 - m2 / s2 / (a * a + (di - 0.5) * (di - 0.5));
+      if (i != m) {
+        denom *= 1.0 - m2 / (di * di);
+      }
+    }
+    fm[m - 1] = numer / denom;
+  }
+
+  const double dn = static_cast<double>(n);
+  auto eval = [&](double x) {
+    double v = 1.0;
+    for (index_t m = 1; m < nbar; m++) {
+      v += 2.0 * fm[m - 1] *
+           std::cos(2.0 * M_PI * static_cast<double>(m) *
+                    (x - dn / 2.0 + 0.5) / dn);
+    }
+    return v;
+  };
+
+  const double scale = 1.0 / eval((dn - 1.0) / 2.0);
+  std::vector<double> w(static_cast<size_t>(n));
+  for (index_t i = 0; i < n; i++) {
+    w[i] = eval(static_cast<double>(i)) * scale;
+  }
+
+  return w;
+}
+
+/**
+ * Coefficients of an n point window, evaluated in double precision
+ *
+ * @param type
+ *   Window type
+ * @param n
+ *   Window length
+ * @param param
+ *   Kaiser beta, Chebyshev attenuation or Taylor sidelobe level. Ignored by
+ * the other windows
+ * @param nbar
+ *   Number of nearly constant sidelobes of a Taylor window
+ */
+inline std::vector<double> WindowCoeffs(windowType_t type, index_t n,
+                                        double param = 0.0, index_t nbar = 4)
+{
+  if (n == 1 || type == WINDOW_TYPE_RECT) {
+    return std::vector<double>(static_cast<size_t>(n), 1.0);
+  }
+
+  if (type == WINDOW_TYPE_CHEBYSHEV) {
+    return WindowChebyshev(n, param);
+  }
+
+  if (type == WINDOW_TYPE_TAYLOR) {
+    return WindowTaylor(n, nbar, param);
+  }
+
+  std::vector<double> w(static_cast<size_t>(n));
+  const double dn = static_cast<double>(n - 1);
+  for (index_t i = 0; i < n; i++) {
+    const double di = static_cast<double>(i);
+    if (type == WINDOW_TYPE_HAMMING) {
+      w[i] = 0.54 - 0.46 * std::cos(2.0 * M_PI * di / dn);
+    }
+    else if (type == WINDOW_TYPE_HANN) {
+      w[i] = 0.5 - 0.5 * std::cos(2.0 * M_PI * di / dn);
+    }
+    else if (type == WINDOW_TYPE_BLACKMAN) {
+      w[i] = 0.42 - 0.5 * std::cos(2.0 * M_PI * di / dn) +
+             0.08 * std::cos(4.0 * M_PI * di / dn);
+    }
+    else {
+      const double r = 2.0 * di / dn - 1.0;
+      w[i] = WindowBesselI0(param * std::sqrt(std::max(0.0, 1.0 - r * r))) /
+             WindowBesselI0(param);
+    }
+  }
+
+  return w;
+}
+
+/**
+ * Parameters of a cached window table
+ */
+struct WindowParams_t {
+  windowType_t type;
+  index_t n;
+  double param;
+  index_t nbar;
+  MatXDataType_t dtype;
+};
+
+struct WindowParamsKeyHash {
+  std::size_t operator()(const WindowParams_t &k) const noexcept
+  {
+    return std::hash<index_t>()(k.type) + std::hash<index_t>()(k.n) +
+           std::hash<double>()(k.param);
+  }
+};
+
+struct WindowParamsKeyEq {
+  bool operator()(const WindowParams_t &l,
+                  const WindowParams_t &t) const noexcept
+  {
+    return l.type == t.type && l.n == t.n && l.param == t.param &&
+           l.nbar == t.nbar && l.dtype == t.dtype;
+  }
+};
+
+// Static cache of window tables
+static matxCache_t<WindowParams_t, WindowParamsKeyHash, WindowParamsKeyEq>
+    window_cache;
+
+/**
+ * Get the coefficients of a window, computing them the first time the window
+ * is used. The table is in managed memory, so it can be read by both host and
+ * device, and stays valid for the life of the program.
+ *
+ * @tparam T
+ *   Real coefficient type
+ *
+ * @param type
+ *   Window type
+ * @param n
+ *   Window length
+ * @param param
+ *   Kaiser beta, Chebyshev attenuation in dB or Taylor sidelobe level in dB.
+ * Ignored by the other windows
+ * @param nbar
+ *   Number of nearly constant sidelobes of a Taylor window
+ *
+ * @returns
+ *   Rank 1 tensor of n coefficients
+ */
+template <typename T>
+tensor_t<T, 1> &GetWindowTable(windowType_t type, index_t n,
+                               double param = 0.0, index_t nbar = 4)
+{
+  static_assert(!is_complex_v<T>, "Window coefficients must be real");
+  MATX_ASSERT(n > 0, matxInvalidSize);
+  MATX_ASSERT_STR((type != WINDOW_TYPE_CHEBYSHEV &&
+                   type != WINDOW_TYPE_TAYLOR) ||
+                      param > 0.0,
+                  matxInvalidParameter,
+                  "Chebyshev and Taylor windows need a sidelobe level in dB");
+  MATX_ASSERT(type != WINDOW_TYPE_TAYLOR || nbar > 0, matxInvalidParameter);
+
+  WindowParams_t params;
+  params.type = type;
+  params.n = n;
+  params.param = param;
+  params.nbar = nbar;
+  params.dtype = TypeToInt<T>();
+
+  auto ret = window_cache.Lookup(params);
+  if (ret != std::nullopt) {
+    return *static_cast<tensor_t<T, 1> *>(ret.value());
+  }
+
+  auto w = WindowCoeffs(type, n, param, nbar);
+  auto tmp = new tensor_t<T, 1>{{n}};
+  for (index_t i = 0; i < n; i++) {
+    (*tmp)(i) = static_cast<T>(w[i]);
+  }
+
+  window_cache.Insert(params, static_cast<void *>(tmp));
+  return *tmp;
+}
+
+/**
+ * Generator reading a cached window table, so evaluating a window costs one
+ * load per element. The table is double precision for double and complex
+ * double data, and single precision otherwise.
+ */
+template <typename T> class WindowTable {
+private:
+  using coeff_type =
+      std::conditional_t<std::is_same_v<value_promote_t<T>, double>, double,
+                         float>;
+
+  const coeff_type *w_;
+
+public:
+  using scalar_type = T;
+
+  inline WindowTable(windowType_t type, index_t size, double param = 0.0,
+                     index_t nbar = 4)
+      : w_(GetWindowTable<coeff_type>(type, size, param, nbar).Data()){};
+
+  inline __host__ __device__ T operator()(index_t i)
+  {
+    return static_cast<T>(w_[i]);
+  }
+};
+
+}; // namespace matx
@@ -0,0 +1,168 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+
+/* Element-wise statements over the same shape, including in-place updates
+ * and a temporary consumed by a later statement */
+TEST(DeferredTests, FusedChain)
+{
+  MATX_ENTER_HANDLER();
+
+  constexpr index_t rows = 33;
+  constexpr index_t cols = 70;
+  tensor_t<float, 2> a({rows, cols});
+  tensor_t<float, 2> b({rows, cols});
+  tensor_t<float, 2> tmp({rows, cols});
+  tensor_t<float, 2> c({rows, cols});
+
+  for (index_t i = 0; i < rows; i++) {
+    for (index_t j = 0; j < cols; j++) {
+      a(i, j) = static_cast<float>(i - j);
+      b(i, j) = static_cast<float>(i * cols + j) * 0.01f;
+    }
+  }
+
+  {
+    matxDeferredScope_t scope;
+    (tmp = a * b).run();
+    (tmp = tmp + 1.0f).run();
+    (c = tmp / 2.0f - a).run();
+    (a = a * 3.0f).run();
+
+    EXPECT_EQ(GetDeferredQueue(0)->Size(), static_cast<size_t>(4));
+  }
+
+  EXPECT_EQ(GetDeferredQueue(0), nullptr);
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < rows; i++) {
+    for (index_t j = 0; j < cols; j++) {
+      const float av = static_cast<float>(i - j);
+      const float bv = static_cast<float>(i * cols + j) * 0.01f;
+      const float t = av * bv + 1.0f;
+      EXPECT_TRUE(MatXUtils::MatXTypeCompare(tmp(i, j), t));
+      EXPECT_TRUE(MatXUtils::MatXTypeCompare(c(i, j), t / 2.0f - av));
+      EXPECT_TRUE(MatXUtils::MatXTypeCompare(a(i, j), av * 3.0f));
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Reads of memory written earlier through a different view must see the
+ * whole earlier statement, so they can't be fused with it */
+TEST(DeferredTests, OverlappingViews)
+{
+  MATX_ENTER_HANDLER();
+
+  constexpr index_t n = 1000;
+  tensor_t<float, 1> x({n});
+  tensor_t<float, 1> y({n - 1});
+  tensor_t<float, 1> z({n - 1});
+  for (index_t i = 0; i < n; i++) {
+    x(i) = static_cast<float>(i);
+  }
+
+  auto lo = x.Slice({0}, {n - 1});
+  auto hi = x.Slice({1}, {n});
+
+  deferred_begin();
+  (y = lo + 0.0f).run();
+  (lo = lo * 2.0f).run();
+  (z = hi + y).run();
+  deferred_flush();
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < n - 1; i++) {
+    EXPECT_TRUE(MatXUtils::MatXTypeCompare(y(i), static_cast<float>(i)));
+    const float hv = static_cast<float>(i + 1 < n - 1 ? 2 * (i + 1) : i + 1);
+    EXPECT_TRUE(MatXUtils::MatXTypeCompare(z(i), hv + static_cast<float>(i)));
+  }
+
+  // Statements that aren't element-wise run on their own in order
+  (y = reverseX(lo)).run();
+  (z = y + 1.0f).run();
+  deferred_end();
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < n - 1; i++) {
+    const float lv = 2.0f * static_cast<float>(n - 2 - i);
+    EXPECT_TRUE(MatXUtils::MatXTypeCompare(z(i), lv + 1.0f));
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Library calls flush the queue before launching, and calls made while a
+ * statement is launched from the queue run immediately */
+TEST(DeferredTests, LibraryCalls)
+{
+  MATX_ENTER_HANDLER();
+
+  constexpr index_t n = 500;
+  tensor_t<float, 1> x({n});
+  tensor_t<float, 1> y({n});
+  tensor_t<float, 1> z({n});
+  tensor_t<float, 0> s;
+  for (index_t i = 0; i < n; i++) {
+    x(i) = static_cast<float>(i % 10);
+  }
+
+  {
+    matxDeferredScope_t scope;
+    (y = x * 2.0f).run();
+    (y = y + 1.0f).run();
+
+    // 2 * 4.5 + 1 on average
+    sum(s, y);
+    EXPECT_EQ(GetDeferredQueue(0)->Size(), static_cast<size_t>(0));
+    cudaStreamSynchronize(0);
+    EXPECT_TRUE(MatXUtils::MatXTypeCompare(s(), 10.0f * static_cast<float>(n)));
+
+    (z = y - mean(y)).run();
+    (z = z * 2.0f).run();
+  }
+
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < n; i++) {
+    const float yv = 2.0f * static_cast<float>(i % 10) + 1.0f;
+    EXPECT_TRUE(MatXUtils::MatXTypeCompare(z(i), (yv - 10.0f) * 2.0f));
+  }
+
+  MATX_EXIT_HANDLER();
+}
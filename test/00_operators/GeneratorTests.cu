@@ -111,6 +111,19 @@ TYPED_TEST(BasicGeneratorTestsFloatNonComplex, Windows)
 
   (ov = blackman_x(shape)).run();
   MATX_TEST_ASSERT_COMPARE(pb, ov, "blackman", 0.01);
+
+  (ov = kaiser_x(shape, 14.0)).run();
+  MATX_TEST_ASSERT_COMPARE(pb, ov, "kaiser", 0.01);
+
+  (ov = chebwin_x(shape, 60.0)).run();
+  MATX_TEST_ASSERT_COMPARE(pb, ov, "chebwin", 0.01);
+
+  (ov = taylor_x(shape)).run();
+  MATX_TEST_ASSERT_COMPARE(pb, ov, "taylor", 0.01);
+
+  // The second use of a window reads the cached table
+  (ov = taylor_x(shape)).run();
+  MATX_TEST_ASSERT_COMPARE(pb, ov, "taylor", 0.01);
   MATX_EXIT_HANDLER();
 }
 
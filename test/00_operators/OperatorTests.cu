@@ -1200,6 +1200,214 @@ TYPED_TEST(OperatorTestsNumericNonComplex, Prod)
 //   MATX_EXIT_HANDLER();
 // }
 
+TYPED_TEST(OperatorTestsNumericNonComplex, CollapseDims)
+{
+  MATX_ENTER_HANDLER();
+
+  // A contiguous rank-4 view merges into one dimension, and a slice that
+  // skips part of the last dimension only merges its first two
+  {
+    const index_t sizes[4] = {2, 3, 4, 5};
+    const index_t strides[4] = {60, 20, 5, 1};
+    matxCollapse_t c(4, sizes);
+    c.Add(4, sizes, strides);
+    ASSERT_EQ(c.Rank(), 1);
+  }
+  {
+    const index_t sizes[3] = {2, 3, 4};
+    const index_t strides[3] = {15, 5, 1};
+    matxCollapse_t c(3, sizes);
+    c.Add(3, sizes, strides);
+    ASSERT_EQ(c.Rank(), 2);
+
+    // A broadcast view of a lower rank stops any merging
+    c.Add(1, sizes + 2, strides + 2);
+    ASSERT_EQ(c.Rank(), 3);
+  }
+  {
+    // So does a view of the same rank broadcast along a dimension of size 1
+    const index_t sizes[2] = {4, 5};
+    const index_t bsizes[2] = {1, 5};
+    const index_t strides[2] = {5, 1};
+    matxCollapse_t c(2, sizes);
+    c.Add(2, bsizes, strides);
+    ASSERT_EQ(c.Rank(), 2);
+  }
+
+  tensor_t<TypeParam, 4> t4a({2, 3, 4, 5});
+  tensor_t<TypeParam, 4> t4b({2, 3, 4, 5});
+  tensor_t<TypeParam, 4> t4o({2, 3, 4, 5});
+  for (index_t i = 0; i < t4a.Size(0); i++) {
+    for (index_t j = 0; j < t4a.Size(1); j++) {
+      for (index_t k = 0; k < t4a.Size(2); k++) {
+        for (index_t l = 0; l < t4a.Size(3); l++) {
+          t4a(i, j, k, l) = static_cast<TypeParam>(i + j + k + l);
+          t4b(i, j, k, l) = static_cast<TypeParam>(l);
+        }
+      }
+    }
+  }
+
+  (t4o = t4a + t4b).run();
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < t4o.Size(0); i++) {
+    for (index_t j = 0; j < t4o.Size(1); j++) {
+      for (index_t k = 0; k < t4o.Size(2); k++) {
+        for (index_t l = 0; l < t4o.Size(3); l++) {
+          MATX_ASSERT_EQ(t4o(i, j, k, l), t4a(i, j, k, l) + t4b(i, j, k, l));
+        }
+      }
+    }
+  }
+
+  // Write only the first four elements of each row of a rank-3 slice
+  auto t3a = t4a.template Slice<3>({0, 0, 0, 0},
+                                    {matxDropDim, matxEnd, matxEnd, 4});
+  auto t3o = t4o.template Slice<3>({0, 0, 0, 0},
+                                    {matxDropDim, matxEnd, matxEnd, 4});
+  (t3o = t3a * t3a).run();
+  cudaStreamSynchronize(0);
+
+  for (index_t j = 0; j < t4o.Size(1); j++) {
+    for (index_t k = 0; k < t4o.Size(2); k++) {
+      for (index_t l = 0; l < t4o.Size(3); l++) {
+        if (l < 4) {
+          MATX_ASSERT_EQ(t4o(0, j, k, l), t4a(0, j, k, l) * t4a(0, j, k, l));
+        }
+        else {
+          MATX_ASSERT_EQ(t4o(0, j, k, l), t4a(0, j, k, l) + t4b(0, j, k, l));
+        }
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(OperatorTestsNumericNonComplex, IndexWidth)
+{
+  MATX_ENTER_HANDLER();
+
+  // Statements with 2^31 or more elements, or a view with an offset past
+  // INT32_MAX, need 64-bit indices
+  if constexpr (sizeof(index_t) > sizeof(int32_t)) {
+    const index_t big[2] = {1 << 20, 1 << 12};
+    matxCollapse_t cb(2, big);
+    ASSERT_FALSE(cb.Fits32());
+
+    const index_t sizes[2] = {4, 5};
+    const index_t strides[2] = {5, 1};
+    matxCollapse_t c(2, sizes, false);
+    c.Add(2, sizes, strides);
+    ASSERT_TRUE(c.Fits32());
+    ASSERT_EQ(c.Rank(), 2);
+
+    const index_t far[2] = {INT32_MAX, 1};
+    c.Add(2, sizes, far);
+    ASSERT_FALSE(c.Fits32());
+  }
+
+  // A strided view whose dimensions can't be merged still runs with 32-bit
+  // offsets
+  tensor_t<TypeParam, 2> t2a({4, 5});
+  tensor_t<TypeParam, 2> t2o({4, 6});
+  for (index_t i = 0; i < t2o.Size(0); i++) {
+    for (index_t j = 0; j < t2o.Size(1); j++) {
+      t2o(i, j) = static_cast<TypeParam>(0);
+      if (j < t2a.Size(1)) {
+        t2a(i, j) = static_cast<TypeParam>(i * t2a.Size(1) + j);
+      }
+    }
+  }
+
+  auto t2s = t2o.Slice({0, 0}, {matxEnd, 5});
+  (t2s = t2a + t2a).run();
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < t2o.Size(0); i++) {
+    for (index_t j = 0; j < t2o.Size(1); j++) {
+      if (j < t2a.Size(1)) {
+        MATX_ASSERT_EQ(t2o(i, j), t2a(i, j) + t2a(i, j));
+      }
+      else {
+        MATX_ASSERT_EQ(t2o(i, j), static_cast<TypeParam>(0));
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(OperatorTestsNumericNonComplex, HighRank)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<TypeParam, 6> t6a({2, 3, 4, 2, 3, 5});
+  tensor_t<TypeParam, 6> t6o({5, 3, 2, 4, 3, 2});
+  tensor_t<TypeParam, 1> t1({2});
+  for (index_t i = 0; i < t6a.Size(0); i++) {
+    for (index_t j = 0; j < t6a.Size(1); j++) {
+      for (index_t k = 0; k < t6a.Size(2); k++) {
+        for (index_t l = 0; l < t6a.Size(3); l++) {
+          for (index_t m = 0; m < t6a.Size(4); m++) {
+            for (index_t n = 0; n < t6a.Size(5); n++) {
+              t6a(i, j, k, l, m, n) =
+                  static_cast<TypeParam>(i + j + k + l + m + n);
+            }
+          }
+        }
+      }
+    }
+  }
+  t1(0) = static_cast<TypeParam>(7);
+  t1(1) = static_cast<TypeParam>(9);
+
+  // A contiguous statement merges down to rank 1
+  (t6o = t6a.Permute({5, 4, 3, 2, 1, 0})).run();
+  tensor_t<TypeParam, 6> t6b({5, 3, 2, 4, 3, 2});
+  (t6b = t6o + t6o).run();
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < t6a.Size(0); i++) {
+    for (index_t j = 0; j < t6a.Size(1); j++) {
+      for (index_t k = 0; k < t6a.Size(2); k++) {
+        for (index_t l = 0; l < t6a.Size(3); l++) {
+          for (index_t m = 0; m < t6a.Size(4); m++) {
+            for (index_t n = 0; n < t6a.Size(5); n++) {
+              MATX_ASSERT_EQ(t6o(n, m, l, k, j, i), t6a(i, j, k, l, m, n));
+              MATX_ASSERT_EQ(t6b(n, m, l, k, j, i),
+                             t6a(i, j, k, l, m, n) + t6a(i, j, k, l, m, n));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  // A permuted input with a broadcast can't be merged, so the leading
+  // dimensions are flattened into the grid
+  (t6o = t6a.Permute({5, 4, 3, 2, 1, 0}) + t1).run();
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < t6a.Size(0); i++) {
+    for (index_t j = 0; j < t6a.Size(1); j++) {
+      for (index_t k = 0; k < t6a.Size(2); k++) {
+        for (index_t l = 0; l < t6a.Size(3); l++) {
+          for (index_t m = 0; m < t6a.Size(4); m++) {
+            for (index_t n = 0; n < t6a.Size(5); n++) {
+              MATX_ASSERT_EQ(t6o(n, m, l, k, j, i),
+                             t6a(i, j, k, l, m, n) + t1(i));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
 TYPED_TEST(OperatorTestsNumeric, Broadcast)
 {
   MATX_ENTER_HANDLER();
@@ -196,6 +196,153 @@ TYPED_TEST(ReductionTestsFloatNonComplexNonHalf, Reduce)
   MATX_EXIT_HANDLER();
 }
 
+TYPED_TEST(ReductionTestsFloatNonComplexNonHalf, StaticReduce)
+{
+  MATX_ENTER_HANDLER();
+  tensor_t<TypeParam, 3> t3({5, 4, 3});
+  for (index_t i = 0; i < t3.Size(0); i++) {
+    for (index_t j = 0; j < t3.Size(1); j++) {
+      for (index_t k = 0; k < t3.Size(2); k++) {
+        t3(i, j, k) = static_cast<TypeParam>(k + 1);
+      }
+    }
+  }
+
+  // Reduce over the static inner dimensions of a view with a dynamic batch
+  tensor_static_t<TypeParam, matxDynamicExtent, 4, 3> s3{t3.Data(), 5};
+  tensor_t<TypeParam, 1> t1({5});
+  sum(t1, s3, 0);
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < t1.Size(0); i++) {
+    EXPECT_TRUE(MatXUtils::MatXTypeCompare(t1(i), (TypeParam)(24)));
+  }
+
+  tensor_t<TypeParam, 0> t0;
+  rmax(t0, s3, 0);
+  cudaStreamSynchronize(0);
+  EXPECT_TRUE(MatXUtils::MatXTypeCompare(t0(), (TypeParam)(3)));
+
+  // Reduce a whole static view in the calling thread
+  tensor_static_t<TypeParam, 4, 3> s2{t3.Data()};
+  EXPECT_TRUE(MatXUtils::MatXTypeCompare(
+      reduce(s2, reduceOpSum<TypeParam>()), (TypeParam)(24)));
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(ReductionTestsFloatNonComplexNonHalf, HighRankReduce)
+{
+  MATX_ENTER_HANDLER();
+  auto t6 = ones<float>({3, 4, 5, 6, 7, 8});
+
+  tensor_t<TypeParam, 0> t0;
+  sum(t0, t6, 0);
+  cudaStreamSynchronize(0);
+  EXPECT_TRUE(MatXUtils::MatXTypeCompare(
+      t0(), (TypeParam)(3 * 4 * 5 * 6 * 7 * 8)));
+
+  tensor_t<TypeParam, 2> t2({3, 4});
+  sum(t2, t6, 0);
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < t2.Size(0); i++) {
+    for (index_t j = 0; j < t2.Size(1); j++) {
+      EXPECT_TRUE(
+          MatXUtils::MatXTypeCompare(t2(i, j), (TypeParam)(5 * 6 * 7 * 8)));
+    }
+  }
+
+  tensor_t<TypeParam, 5> t5({3, 4, 5, 6, 7});
+  sum(t5, t6, 0);
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < t5.Size(0); i++) {
+    for (index_t j = 0; j < t5.Size(1); j++) {
+      for (index_t k = 0; k < t5.Size(2); k++) {
+        for (index_t l = 0; l < t5.Size(3); l++) {
+          for (index_t m = 0; m < t5.Size(4); m++) {
+            EXPECT_TRUE(MatXUtils::MatXTypeCompare(t5(i, j, k, l, m),
+                                                   (TypeParam)(8)));
+          }
+        }
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(ReductionTestsFloatNonComplexNonHalf, LazyReduce)
+{
+  MATX_ENTER_HANDLER();
+  tensor_t<TypeParam, 2> t2({4, 5});
+  for (index_t i = 0; i < t2.Size(0); i++) {
+    for (index_t j = 0; j < t2.Size(1); j++) {
+      t2(i, j) = static_cast<TypeParam>(j + 1);
+    }
+  }
+
+  // Normalize by the sum in a single statement
+  tensor_t<TypeParam, 2> y({4, 5});
+  (y = t2 / sum(t2)).run();
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < y.Size(0); i++) {
+    for (index_t j = 0; j < y.Size(1); j++) {
+      EXPECT_TRUE(MatXUtils::MatXTypeCompare(
+          y(i, j), static_cast<TypeParam>(j + 1) / (TypeParam)(60)));
+    }
+  }
+
+  tensor_t<TypeParam, 1> t1({4});
+  (t1 = sum<1>(t2) * 2).run();
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < t1.Size(0); i++) {
+    EXPECT_TRUE(MatXUtils::MatXTypeCompare(t1(i), (TypeParam)(30)));
+  }
+
+  tensor_t<TypeParam, 0> t0;
+  (t0 = rmax(t2) - rmin(t2)).run();
+  cudaStreamSynchronize(0);
+  EXPECT_TRUE(MatXUtils::MatXTypeCompare(t0(), (TypeParam)(4)));
+
+  (t0 = mean(t2)).run();
+  cudaStreamSynchronize(0);
+  EXPECT_TRUE(MatXUtils::MatXTypeCompare(t0(), (TypeParam)(3)));
+
+  // Reductions nested in the input of another reduction
+  (t0 = sum(t2 / sum(t2))).run();
+  cudaStreamSynchronize(0);
+  EXPECT_TRUE(MatXUtils::MatXTypeCompare(t0(), (TypeParam)(1)));
+
+  sum(t0, t2 - mean(t2), 0);
+  cudaStreamSynchronize(0);
+  EXPECT_TRUE(MatXUtils::MatXTypeCompare(t0(), (TypeParam)(0)));
+
+  // Reductions under composite operators
+  tensor_t<TypeParam, 2> z({4, 5});
+  CHAIN(y = t2 / sum(t2), z = t2 - mean(t2)).run();
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < y.Size(0); i++) {
+    for (index_t j = 0; j < y.Size(1); j++) {
+      EXPECT_TRUE(MatXUtils::MatXTypeCompare(
+          y(i, j), static_cast<TypeParam>(j + 1) / (TypeParam)(60)));
+      EXPECT_TRUE(MatXUtils::MatXTypeCompare(
+          z(i, j), static_cast<TypeParam>(j + 1) - (TypeParam)(3)));
+    }
+  }
+
+  (z = zeros<TypeParam>(z.Shape())).run();
+  IF(t2 > mean(t2), z = shift1(t2, 1) - rmin(t2)).run();
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < z.Size(0); i++) {
+    for (index_t j = 0; j < z.Size(1); j++) {
+      const TypeParam expected =
+          j >= 3 ? static_cast<TypeParam>((j + 1) % 5) : (TypeParam)(0);
+      EXPECT_TRUE(MatXUtils::MatXTypeCompare(z(i, j), expected));
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
 TEST(ReductionTests, Any)
 {
   MATX_ENTER_HANDLER();
@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+
+class SelectTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    for (index_t i = 0; i < x.Size(0); i++) {
+      for (index_t j = 0; j < x.Size(1); j++) {
+        for (index_t k = 0; k < x.Size(2); k++) {
+          x(i, j, k) = static_cast<float>((i * x.Size(1) + j) * x.Size(2) + k);
+        }
+      }
+    }
+  }
+
+  tensor_t<float, 3> x{{4, 30, 50}};
+  tensor_t<index_t, 1> idx{{6000}};
+  tensor_t<int, 0> count;
+};
+
+/* find() writes the linear indices of the selected elements in order, and
+ * compact() the elements themselves */
+TEST_F(SelectTests, FindCompact)
+{
+  MATX_ENTER_HANDLER();
+
+  find(idx, count, x > 4000.0f);
+  cudaStreamSynchronize(0);
+  ASSERT_EQ(count(), 1999);
+  for (index_t i = 0; i < count(); i++) {
+    ASSERT_EQ(idx(i), 4001 + i);
+  }
+
+  tensor_t<float, 1> vals({6000});
+  compact(vals, count, x, (x < 10.0f) || (x >= 5990.0f));
+  cudaStreamSynchronize(0);
+  ASSERT_EQ(count(), 20);
+  for (index_t i = 0; i < count(); i++) {
+    ASSERT_EQ(vals(i), static_cast<float>(i < 10 ? i : 5980 + i));
+  }
+
+  // Reductions in the mask are run before the selection
+  find(idx, count, x > mean(x));
+  cudaStreamSynchronize(0);
+  ASSERT_EQ(count(), 3000);
+  ASSERT_EQ(idx(0), 3000);
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Elements that don't fit in the output are dropped but still counted */
+TEST_F(SelectTests, FindBounded)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<index_t, 1> small({3});
+  find(small, count, x > 100.0f);
+  cudaStreamSynchronize(0);
+  ASSERT_EQ(count(), 5899);
+  ASSERT_EQ(small(0), 101);
+  ASSERT_EQ(small(2), 103);
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Host and device select the same elements */
+TEST_F(SelectTests, HostMatchesDevice)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<int, 3> dets({4, 30, 50});
+  for (index_t i = 0; i < dets.Size(0); i++) {
+    for (index_t j = 0; j < dets.Size(1); j++) {
+      for (index_t k = 0; k < dets.Size(2); k++) {
+        dets(i, j, k) = ((i * 7 + j * 13 + k * 29) % 31) == 0;
+      }
+    }
+  }
+
+  tensor_t<index_t, 1> hidx({6000});
+  tensor_t<int, 0> hcount;
+  find(idx, count, dets);
+  cudaStreamSynchronize(0);
+  find(hidx, hcount, dets, matxHostExecutor_t{});
+  ASSERT_EQ(count(), hcount());
+  for (index_t i = 0; i < count(); i++) {
+    ASSERT_EQ(idx(i), hidx(i));
+  }
+
+  tensor_t<float, 1> vals({6000});
+  tensor_t<float, 1> hvals({6000});
+  compact(vals, count, x, dets);
+  cudaStreamSynchronize(0);
+  compact(hvals, hcount, x, dets, matxHostExecutor_t{3});
+  ASSERT_EQ(count(), hcount());
+  for (index_t i = 0; i < count(); i++) {
+    ASSERT_EQ(vals(i), hvals(i));
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* gather() reads the elements find() selects, and scatter() writes them back */
+TEST_F(SelectTests, GatherScatter)
+{
+  MATX_ENTER_HANDLER();
+
+  find(idx, count, x > 5900.0f);
+  cudaStreamSynchronize(0);
+  ASSERT_EQ(count(), 99);
+
+  auto sel = idx.Slice({0}, {count()});
+  tensor_t<float, 1> g({count()});
+  (g = gather(x, sel) * 2.0f).run();
+
+  tensor_t<float, 3> y({4, 30, 50});
+  (y = 0.0f).run();
+  scatter(y, sel, g);
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < y.Size(0); i++) {
+    for (index_t j = 0; j < y.Size(1); j++) {
+      for (index_t k = 0; k < y.Size(2); k++) {
+        const float v = x(i, j, k);
+        ASSERT_EQ(y(i, j, k), v > 5900.0f ? 2.0f * v : 0.0f);
+      }
+    }
+  }
+
+  // Repeated indices accumulate with scatter_add()
+  tensor_t<int, 1> bins({1000});
+  tensor_t<float, 1> hist({4});
+  for (index_t i = 0; i < bins.Size(0); i++) {
+    bins(i) = static_cast<int>(i % 4);
+  }
+  (hist = 0.0f).run();
+  scatter_add(hist, bins, 0.5f);
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < hist.Size(0); i++) {
+    ASSERT_EQ(hist(i), 125.0f);
+  }
+
+  tensor_t<cuda::std::complex<float>, 1> chist({4});
+  (chist = cuda::std::complex<float>(0.0f, 0.0f)).run();
+  scatter_add(chist, bins, cuda::std::complex<float>(0.5f, -1.0f));
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < chist.Size(0); i++) {
+    ASSERT_EQ(chist(i).real(), 125.0f);
+    ASSERT_EQ(chist(i).imag(), -250.0f);
+  }
+
+  MATX_EXIT_HANDLER();
+}
@@ -81,3 +81,18 @@ TYPED_TEST(CholSolverTestNonComplexFloatTypes, CholeskyBasic)
 
   MATX_EXIT_HANDLER();
 }
+
+TYPED_TEST(CholSolverTestNonComplexFloatTypes, CholeskyBasicHost)
+{
+  MATX_ENTER_HANDLER();
+
+  chol(this->Bv, this->Bv, matxHostExecutor_t{}, CUBLAS_FILL_MODE_LOWER);
+
+  for (index_t i = 0; i < this->Bv.Size(0); i++) {
+    for (index_t j = 0; j <= i; j++) {
+      ASSERT_NEAR(this->Bv(i, j), this->Lv(i, j), 0.001);
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
@@ -80,3 +80,15 @@ TYPED_TEST(DetSolverTestNonComplexFloatTypes, Determinant)
 
   MATX_EXIT_HANDLER();
 }
+
+TYPED_TEST(DetSolverTestNonComplexFloatTypes, DeterminantHost)
+{
+  MATX_ENTER_HANDLER();
+
+  // The host solver works on row-major data directly
+  det(this->detv, this->Av, matxHostExecutor_t{});
+
+  MATX_TEST_ASSERT_COMPARE(this->pb, this->detv, "det", 0.1);
+
+  MATX_EXIT_HANDLER();
+}
@@ -96,3 +96,172 @@ TYPED_TEST(EigenSolverTestNonComplexFloatTypes, EigenBasic)
 
   MATX_EXIT_HANDLER();
 }
+
+TYPED_TEST(EigenSolverTestNonComplexFloatTypes, EigenBasicHost)
+{
+  MATX_ENTER_HANDLER();
+  eig(this->Evv, this->Wov, this->Bv, matxHostExecutor_t{});
+
+  // Check A*v = lambda*v for each eigenvector directly on the host
+  for (index_t i = 0; i < dim_size; i++) {
+    for (index_t j = 0; j < dim_size; j++) {
+      TypeParam av = 0;
+      for (index_t k = 0; k < dim_size; k++) {
+        av += this->Bv(j, k) * this->Evv(k, i);
+      }
+
+      ASSERT_NEAR(av, this->Wov(i) * this->Evv(j, i), 0.001);
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(EigenSolverTestNonComplexFloatTypes, EigenBatchedSmall)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t batches = 64;
+  constexpr index_t sn = 8;
+  tensor_t<TypeParam, 3> Av{{batches, sn, sn}};
+  tensor_t<TypeParam, 3> Ev{{batches, sn, sn}};
+  tensor_t<TypeParam, 2> Wv{{batches, sn}};
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t i = 0; i < sn; i++) {
+      for (index_t j = 0; j <= i; j++) {
+        TypeParam val = static_cast<TypeParam>((b + 3 * i + 5 * j) % 7) -
+                        static_cast<TypeParam>(3);
+        Av(b, i, j) = val;
+        Av(b, j, i) = val;
+      }
+    }
+  }
+
+  // Small batched matrices use the Jacobi kernel
+  eig(Ev, Wv, Av);
+  cudaStreamSynchronize(0);
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t i = 0; i < sn; i++) {
+      if (i > 0) {
+        ASSERT_LE(Wv(b, i - 1), Wv(b, i));
+      }
+
+      for (index_t j = 0; j < sn; j++) {
+        TypeParam av = 0;
+        for (index_t k = 0; k < sn; k++) {
+          av += Av(b, j, k) * Ev(b, k, i);
+        }
+
+        ASSERT_NEAR(av, Wv(b, i) * Ev(b, j, i), 0.001);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+template <typename TensorType>
+class EigenSolverTestComplexTypes : public ::testing::Test {
+};
+
+TYPED_TEST_SUITE(EigenSolverTestComplexTypes, MatXComplexNonHalfTypes);
+
+/* Batch of Hermitian matrices with small integer real and imaginary parts off
+ * the diagonal and a real diagonal */
+template <typename T> static void FillHermitian(tensor_t<T, 3> &a)
+{
+  using real_t = typename T::value_type;
+  for (index_t b = 0; b < a.Size(0); b++) {
+    for (index_t i = 0; i < a.Size(1); i++) {
+      for (index_t j = 0; j < i; j++) {
+        T val{static_cast<real_t>((b + i + 2 * j) % 7) - real_t(3),
+              static_cast<real_t>((b + 3 * i + j) % 5) - real_t(2)};
+        a(b, i, j) = val;
+        a(b, j, i) = cuda::std::conj(val);
+      }
+
+      a(b, i, i) = T{static_cast<real_t>((b + i) % 4), 0};
+    }
+  }
+}
+
+/* Check A * v = lambda * v for every eigenpair, with the eigenvalues real and
+ * ascending */
+template <typename T>
+static void CheckHermitianEigen(const tensor_t<T, 3> &a,
+                                const tensor_t<T, 3> &e,
+                                const tensor_t<typename T::value_type, 2> &w)
+{
+  const index_t n = a.Size(1);
+  for (index_t b = 0; b < a.Size(0); b++) {
+    for (index_t i = 0; i < n; i++) {
+      if (i > 0) {
+        ASSERT_LE(w(b, i - 1), w(b, i));
+      }
+
+      for (index_t j = 0; j < n; j++) {
+        T av = 0;
+        for (index_t k = 0; k < n; k++) {
+          av += a(b, j, k) * e(b, k, i);
+        }
+
+        ASSERT_LT(cuda::std::abs(av - w(b, i) * e(b, j, i)), 0.01);
+      }
+    }
+  }
+}
+
+TYPED_TEST(EigenSolverTestComplexTypes, EigenHermitian)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t sn = 40;
+  tensor_t<TypeParam, 3> Av{{1, sn, sn}};
+  tensor_t<TypeParam, 3> Ev{{1, sn, sn}};
+  tensor_t<typename TypeParam::value_type, 2> Wv{{1, sn}};
+  FillHermitian(Av);
+
+  // A single matrix goes through cuSolver
+  eig(Ev, Wv, Av);
+  cudaStreamSynchronize(0);
+
+  CheckHermitianEigen(Av, Ev, Wv);
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(EigenSolverTestComplexTypes, EigenHermitianBatchedSmall)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t batches = 16;
+  constexpr index_t sn = 8;
+  tensor_t<TypeParam, 3> Av{{batches, sn, sn}};
+  tensor_t<TypeParam, 3> Ev{{batches, sn, sn}};
+  tensor_t<typename TypeParam::value_type, 2> Wv{{batches, sn}};
+  FillHermitian(Av);
+
+  // Small batched matrices use the Jacobi kernel
+  eig(Ev, Wv, Av);
+  cudaStreamSynchronize(0);
+
+  CheckHermitianEigen(Av, Ev, Wv);
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(EigenSolverTestComplexTypes, EigenHermitianHost)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t batches = 3;
+  constexpr index_t sn = 40;
+  tensor_t<TypeParam, 3> Av{{batches, sn, sn}};
+  tensor_t<TypeParam, 3> Ev{{batches, sn, sn}};
+  tensor_t<typename TypeParam::value_type, 2> Wv{{batches, sn}};
+  FillHermitian(Av);
+
+  eig(Ev, Wv, Av, matxHostExecutor_t{2});
+
+  CheckHermitianEigen(Av, Ev, Wv);
+
+  MATX_EXIT_HANDLER();
+}
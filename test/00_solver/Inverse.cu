@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+
+#include "assert.h"
+#include "matx.h"
+#include "test_types.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+
+template <typename T> class InvSolverTest : public ::testing::Test {
+protected:
+  template <int N, int BATCH> void RunInverse()
+  {
+    tensor_t<T, 3> a{{BATCH, N, N}};
+    tensor_t<T, 3> ainv{{BATCH, N, N}};
+    tensor_t<T, 3> ident{{BATCH, N, N}};
+
+    // Diagonally dominant, so well-conditioned, but still requiring pivots
+    for (index_t b = 0; b < BATCH; b++) {
+      for (index_t i = 0; i < N; i++) {
+        for (index_t j = 0; j < N; j++) {
+          a(b, i, j) = static_cast<T>(((b + 3 * i + 7 * j) % 11) - 5) /
+                           static_cast<T>(N) +
+                       ((i == (N - 1 - j)) ? static_cast<T>(8) : T(0));
+        }
+      }
+    }
+
+    inv(ainv, a);
+    matmul(ident, a, ainv);
+    cudaStreamSynchronize(0);
+
+    for (index_t b = 0; b < BATCH; b++) {
+      for (index_t i = 0; i < N; i++) {
+        for (index_t j = 0; j < N; j++) {
+          ASSERT_NEAR(ident(b, i, j), (i == j) ? 1.0 : 0.0, 0.001);
+        }
+      }
+    }
+  }
+};
+
+template <typename TensorType>
+class InvSolverTestNonComplexFloatTypes : public InvSolverTest<TensorType> {
+};
+
+TYPED_TEST_SUITE(InvSolverTestNonComplexFloatTypes,
+                 MatXFloatNonComplexNonHalfTypes);
+
+TYPED_TEST(InvSolverTestNonComplexFloatTypes, InverseSmallBatched)
+{
+  MATX_ENTER_HANDLER();
+  this->template RunInverse<3, 100>();
+  this->template RunInverse<8, 100>();
+  this->template RunInverse<29, 10>();
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(InvSolverTestNonComplexFloatTypes, InverseLarge)
+{
+  MATX_ENTER_HANDLER();
+  this->template RunInverse<48, 4>();
+  MATX_EXIT_HANDLER();
+}
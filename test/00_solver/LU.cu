@@ -90,3 +90,59 @@ TYPED_TEST(LUSolverTestNonComplexFloatTypes, LUBasic)
 
   MATX_EXIT_HANDLER();
 }
+
+TYPED_TEST(LUSolverTestNonComplexFloatTypes, LUBasicHost)
+{
+  MATX_ENTER_HANDLER();
+  lu(this->Av, this->PivV, this->Av, matxHostExecutor_t{});
+
+  for (index_t i = 0; i < this->Av.Size(0); i++) {
+    for (index_t j = 0; j < this->Av.Size(1); j++) {
+      if (i > j) { // Lower triangle
+        ASSERT_NEAR(this->Av(i, j), this->Lv(i, j), 0.001);
+      }
+      else {
+        ASSERT_NEAR(this->Av(i, j), this->Uv(i, j), 0.001);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Larger than the host solver's block size, so the factorization runs over
+ * several panels with trailing updates, for both tall and wide matrices */
+TYPED_TEST(LUSolverTestNonComplexFloatTypes, LUBlockedHost)
+{
+  MATX_ENTER_HANDLER();
+
+  for (const auto &[rows, cols] :
+       {std::pair<index_t, index_t>{150, 130}, {130, 150}}) {
+    const index_t r = std::min(rows, cols);
+    auto pb = std::make_unique<MatXPybind>();
+    pb->InitAndRunTVGenerator<TypeParam>("00_solver", "lu", "run",
+                                         {rows, cols});
+    tensor_t<TypeParam, 2> a{{rows, cols}};
+    tensor_t<TypeParam, 2> l{{rows, r}};
+    tensor_t<TypeParam, 2> u{{r, cols}};
+    tensor_t<int64_t, 1> piv{{r}};
+    pb->NumpyToTensorView(a, "A");
+    pb->NumpyToTensorView(l, "L");
+    pb->NumpyToTensorView(u, "U");
+
+    lu(a, piv, a, matxHostExecutor_t{4});
+
+    for (index_t i = 0; i < a.Size(0); i++) {
+      for (index_t j = 0; j < a.Size(1); j++) {
+        if (i > j) {
+          ASSERT_NEAR(a(i, j), l(i, j), 0.001);
+        }
+        else {
+          ASSERT_NEAR(a(i, j), u(i, j), 0.001);
+        }
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
@@ -93,3 +93,50 @@ TYPED_TEST(QRSolverTestNonComplexFloatTypes, QRBasic)
 
   MATX_EXIT_HANDLER();
 }
+
+TYPED_TEST(QRSolverTestNonComplexFloatTypes, QRBasicHost)
+{
+  MATX_ENTER_HANDLER();
+
+  qr(this->Av, this->TauV, this->Av, matxHostExecutor_t{});
+
+  for (index_t i = 0; i < this->Av.Size(0); i++) {
+    for (index_t j = 0; j < this->Av.Size(1); j++) {
+      if (i <= j) {
+        ASSERT_NEAR(this->Av(i, j), this->Rv(i, j), 0.001);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Larger than the host solver's block size, so the reflectors are applied in
+ * several blocked panels, for both tall and wide matrices */
+TYPED_TEST(QRSolverTestNonComplexFloatTypes, QRBlockedHost)
+{
+  MATX_ENTER_HANDLER();
+
+  for (const auto &[rows, cols] :
+       {std::pair<index_t, index_t>{150, 130}, {130, 150}}) {
+    const index_t r = std::min(rows, cols);
+    auto pb = std::make_unique<MatXPybind>();
+    pb->InitAndRunTVGenerator<TypeParam>("00_solver", "qr", "run",
+                                         {rows, cols});
+    tensor_t<TypeParam, 2> a{{rows, cols}};
+    tensor_t<TypeParam, 2> rv{{r, cols}};
+    tensor_t<TypeParam, 1> tau{{r}};
+    pb->NumpyToTensorView(a, "A");
+    pb->NumpyToTensorView(rv, "R");
+
+    qr(a, tau, a, matxHostExecutor_t{4});
+
+    for (index_t i = 0; i < r; i++) {
+      for (index_t j = i; j < cols; j++) {
+        ASSERT_NEAR(a(i, j), rv(i, j), 0.001);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
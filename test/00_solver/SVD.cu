@@ -117,3 +117,30 @@ TYPED_TEST(SVDSolverTestNonComplexFloatTypes, SVDBasic)
 
   MATX_EXIT_HANDLER();
 }
+
+TYPED_TEST(SVDSolverTestNonComplexFloatTypes, SVDBasicHost)
+{
+  MATX_ENTER_HANDLER();
+
+  // The host version is row-major throughout, and returns V' directly
+  svd(this->Uv, this->Sv, this->Vv, this->Av, matxHostExecutor_t{});
+
+  (this->Sav = zeros({m, n})).run();
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < n; i++) {
+    this->Sav(i, i) = this->Sv(i);
+  }
+
+  matmul(this->tmpV, this->Uv, this->Sav); // U * S
+  matmul(this->Sav, this->tmpV, this->Vv); // (U * S) * V'
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < this->Av.Size(0); i++) {
+    for (index_t j = 0; j < this->Av.Size(1); j++) {
+      ASSERT_NEAR(this->Av(i, j), this->Sav(i, j), 0.001) << i << " " << j;
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
@@ -159,6 +159,25 @@ TYPED_TEST(BasicTensorTestsAll, RefCnt)
   MATX_EXIT_HANDLER();
 }
 
+TYPED_TEST(BasicTensorTestsAll, RefCntMove)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<float, 2> tmp{{10,4}};
+  tensor_t<float, 2> tmp2{std::move(tmp)};
+  ASSERT_EQ(tmp.GetRefCount(), 0);
+  ASSERT_EQ(tmp2.GetRefCount(), 1);
+
+  // Operators reference their tensors without adding to the count
+  auto op = tmp2 + tmp2;
+  auto op2 = op;
+  auto s = (tmp2 = op2);
+  ASSERT_EQ(tmp2.GetRefCount(), 1);
+  ASSERT_EQ(s.Size(0), 10);
+
+  MATX_EXIT_HANDLER();
+}
+
 TYPED_TEST(BasicTensorTestsAll, ViewSize)
 {
   MATX_ENTER_HANDLER();
@@ -406,3 +425,53 @@ TYPED_TEST(BasicTensorTestsIntegral, InitAssign)
   MATX_EXIT_HANDLER();
 }
 
+
+TYPED_TEST(BasicTensorTestsNumericNonComplex, StaticTensor)
+{
+  MATX_ENTER_HANDLER();
+  tensor_t<TypeParam, 2> a{{4, 3}};
+  tensor_t<TypeParam, 2> b{{4, 3}};
+  for (index_t i = 0; i < a.Size(0); i++) {
+    for (index_t j = 0; j < a.Size(1); j++) {
+      a(i, j) = static_cast<TypeParam>(i * 3 + j);
+    }
+  }
+
+  // Static output from a view with a dynamic row count
+  tensor_static_t<TypeParam, 4, 3> bs{b};
+  tensor_static_t<TypeParam, matxDynamicExtent, 3> as{a.Data(), 4};
+  ASSERT_EQ(as.Size(0), 4);
+  ASSERT_EQ(as.Size(1), 3);
+  ASSERT_EQ(bs.TotalSize(), 12);
+
+  (bs = as + as).run();
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < b.Size(0); i++) {
+    for (index_t j = 0; j < b.Size(1); j++) {
+      ASSERT_EQ(b(i, j), a(i, j) + a(i, j));
+    }
+  }
+
+  // Static input broadcast against a tensor
+  (b = a + tensor_static_t<TypeParam, 3>{a.Data()}).run();
+  cudaStreamSynchronize(0);
+  for (index_t i = 0; i < b.Size(0); i++) {
+    for (index_t j = 0; j < b.Size(1); j++) {
+      ASSERT_EQ(b(i, j), a(i, j) + a(0, j));
+    }
+  }
+
+  // Small products on local arrays, computed in the calling thread
+  TypeParam la[4] = {1, 2, 3, 4};
+  TypeParam lb[4] = {5, 6, 7, 8};
+  TypeParam lc[4];
+  tensor_static_t<TypeParam, 2, 2> ta{la}, tb{lb}, tc{lc};
+  matmul(tc, ta, tb);
+  ASSERT_EQ(tc(0, 0), static_cast<TypeParam>(19));
+  ASSERT_EQ(tc(0, 1), static_cast<TypeParam>(22));
+  ASSERT_EQ(tc(1, 0), static_cast<TypeParam>(43));
+  ASSERT_EQ(tc(1, 1), static_cast<TypeParam>(50));
+  ASSERT_EQ(reduce(tc, reduceOpSum<TypeParam>()), static_cast<TypeParam>(134));
+
+  MATX_EXIT_HANDLER();
+}
@@ -50,4 +50,27 @@ TEST(ShapeTests, Equality)
   ASSERT_TRUE(t1a != t1c);
   ASSERT_TRUE(t2a == t2b);
   ASSERT_TRUE(t2a != t2c);
-}
\ No newline at end of file
+}
+
+TEST(ShapeTests, StaticExtents)
+{
+  using e3 = tensorExtents_t<matxDynamicExtent, 4, matxDynamicExtent>;
+  static_assert(e3::Rank() == 3);
+  static_assert(e3::RankDynamic() == 2);
+  static_assert(e3::StaticSize(1) == 4);
+  static_assert(e3::IsDynamic(0) && !e3::IsDynamic(1) && e3::IsDynamic(2));
+  static_assert(e3::StaticTotalSize() == matxDynamicExtent);
+  static_assert(tensorExtents_t<3, 3>::StaticTotalSize() == 9);
+
+  e3 a{2, 5};
+  ASSERT_EQ(a.Size(0), 2);
+  ASSERT_EQ(a.Size(1), 4);
+  ASSERT_EQ(a.Size(2), 5);
+  ASSERT_EQ(a.TotalSize(), 40);
+
+  index_t sizes[] = {6, 4, 7};
+  e3 b{sizes};
+  ASSERT_EQ(b.Size(0), 6);
+  ASSERT_EQ(b.Size(2), 7);
+  ASSERT_EQ(b.TotalSize(), 168);
+}
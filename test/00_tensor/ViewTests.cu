@@ -148,6 +148,64 @@ TYPED_TEST(ViewTestsNumericNonComplex, OverlapView)
   MATX_EXIT_HANDLER();
 }
 
+TYPED_TEST(ViewTestsNumericNonComplex, OverlapViewBatched)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<TypeParam, 2> a{{2, 10}};
+  for (index_t i = 0; i < a.Size(0); i++) {
+    for (index_t j = 0; j < a.Size(1); j++) {
+      a(i, j) = static_cast<TypeParam>(i * 10 + j);
+    }
+  }
+
+  auto ao = a.OverlapView({4}, {2});
+  ASSERT_EQ(ao.Size(0), 2);
+  ASSERT_EQ(ao.Size(1), 4);
+  ASSERT_EQ(ao.Size(2), 4);
+
+  for (index_t i = 0; i < ao.Size(0); i++) {
+    for (index_t f = 0; f < ao.Size(1); f++) {
+      for (index_t j = 0; j < ao.Size(2); j++) {
+        ASSERT_EQ(ao(i, f, j), a(i, f * 2 + j));
+      }
+    }
+  }
+
+  // Non-overlapping frames of a strided view
+  auto as = a.Slice({0, 0}, {matxEnd, matxEnd}, {1, 2});
+  auto ao2 = as.OverlapView({2}, {2});
+  ASSERT_EQ(ao2.Size(1), 2);
+  for (index_t i = 0; i < ao2.Size(0); i++) {
+    for (index_t f = 0; f < ao2.Size(1); f++) {
+      for (index_t j = 0; j < ao2.Size(2); j++) {
+        ASSERT_EQ(ao2(i, f, j), as(i, f * 2 + j));
+      }
+    }
+  }
+
+  // Frames of a row and a slice that start past the beginning of the data
+  auto r1 = a.template Slice<1>({1, 0}, {matxDropDim, matxEnd});
+  auto ao3 = r1.OverlapView({4}, {3});
+  ASSERT_EQ(ao3.Size(0), 3);
+  for (index_t f = 0; f < ao3.Size(0); f++) {
+    for (index_t j = 0; j < ao3.Size(1); j++) {
+      ASSERT_EQ(ao3(f, j), a(1, f * 3 + j));
+    }
+  }
+
+  auto r2 = a.Slice({1, 3}, {2, matxEnd});
+  auto ao4 = r2.OverlapView({2}, {1});
+  ASSERT_EQ(ao4.Size(1), 6);
+  for (index_t f = 0; f < ao4.Size(1); f++) {
+    for (index_t j = 0; j < ao4.Size(2); j++) {
+      ASSERT_EQ(ao4(0, f, j), a(1, 3 + f + j));
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
 TYPED_TEST(ViewTestsAll, Stride)
 {
   MATX_ENTER_HANDLER();
@@ -447,6 +505,41 @@ TEST(BasicTensorTest, Clone)
     }
   }
 
+  // clone t3 past rank 4
+  auto t3c2 = t3.Clone<5>({2, matxKeepDim, 3, matxKeepDim, matxKeepDim});
+  ASSERT_EQ(t3c2.Size(0), 2);
+  ASSERT_EQ(t3c2.Size(2), 3);
+  for (index_t i = 0; i < t3c2.Size(0); i++) {
+    for (index_t j = 0; j < t3c2.Size(1); j++) {
+      for (index_t k = 0; k < t3c2.Size(2); k++) {
+        for (index_t l = 0; l < t3c2.Size(3); l++) {
+          for (index_t m = 0; m < t3c2.Size(4); m++) {
+            ASSERT_EQ(t3c2(i, j, k, l, m), t3(j, l, m));
+          }
+        }
+      }
+    }
+  }
+
+  // clone and permute a slice that doesn't start at the beginning of the data
+  for (index_t i = 0; i < t2.Size(0); i++) {
+    for (index_t j = 0; j < t2.Size(1); j++) {
+      t2(i, j) = static_cast<float>(i * 10 + j);
+    }
+  }
+
+  auto t2s = t2.Slice({3, 2}, {5, matxEnd});
+  auto t2sc = t2s.Clone<3>({4, matxKeepDim, matxKeepDim});
+  auto t2sp = t2s.Permute({1, 0});
+  for (index_t j = 0; j < t2s.Size(0); j++) {
+    for (index_t k = 0; k < t2s.Size(1); k++) {
+      ASSERT_EQ(t2sp(k, j), t2(3 + j, 2 + k));
+      for (index_t i = 0; i < t2sc.Size(0); i++) {
+        ASSERT_EQ(t2sc(i, j, k), t2(3 + j, 2 + k));
+      }
+    }
+  }
+
   MATX_EXIT_HANDLER();
 }
 
@@ -503,6 +596,52 @@ TEST(ViewTests, Random)
   MATX_EXIT_HANDLER();
 }
 
+TEST(ViewTests, RandomReproducible)
+{
+  MATX_ENTER_HANDLER();
+  {
+    index_t count = 1000;
+    randomGenerator_t<float> rfloat(count, 5);
+    auto t1fu = rfloat.GetTensorView<1>({count}, UNIFORM);
+    auto t1fe = rfloat.GetTensorView<1>({count}, EXPONENTIAL);
+
+    rfloat.SetCounter(0);
+    auto t1fu2 = rfloat.GetTensorView<1>({count}, UNIFORM);
+
+    tensor_t<float, 1> t1f({count});
+    tensor_t<float, 1> t1f2({count});
+
+    (t1f = t1fu).run();
+    (t1f2 = t1fe).run();
+    cudaDeviceSynchronize();
+
+    float total = 0;
+    for (index_t i = 0; i < count; i++) {
+      // Device and host must generate identical uniform values
+      ASSERT_EQ(t1f(i), t1fu(i));
+      ASSERT_EQ(t1f(i), t1fu2(i));
+      ASSERT_GT(t1f2(i), 0.0f);
+      total += t1f2(i);
+    }
+
+    ASSERT_LT(fabs(total / count - 1.0f), .1);
+
+    // Filling a block at a time must match reading element by element, for
+    // sizes that aren't a multiple of the values per block
+    auto t1fn = rfloat.GetTensorView<1>({count - 1}, NORMAL);
+    auto t1fn_set = t1f.Slice({0}, {count - 1});
+    tensor_t<float, 1> t1fn_rand({count - 1});
+    (t1fn_set = t1fn).run();
+    rand(t1fn_rand, t1fn);
+    cudaDeviceSynchronize();
+
+    for (index_t i = 0; i < count - 1; i++) {
+      ASSERT_EQ(t1fn_set(i), t1fn_rand(i));
+    }
+  }
+  MATX_EXIT_HANDLER();
+}
+
 
 TYPED_TEST(ViewTestsComplex, RealComplexView)
 {
@@ -80,3 +80,87 @@ TYPED_TEST(CovarianceTestFloatTypes, SmallCov)
   MATX_TEST_ASSERT_COMPARE(this->pb, this->cv, "c_cov", this->thresh);
   MATX_EXIT_HANDLER();
 }
+
+TYPED_TEST(CovarianceTestFloatTypes, SmallCovHost)
+{
+  MATX_ENTER_HANDLER();
+  this->pb->RunTVGenerator("cov");
+  this->pb->NumpyToTensorView(this->av, "a");
+  cov(this->cv, this->av, matxHostExecutor_t{});
+
+  MATX_TEST_ASSERT_COMPARE(this->pb, this->cv, "c_cov", this->thresh);
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(CovarianceTestFloatTypes, BatchedCovHostThreads)
+{
+  MATX_ENTER_HANDLER();
+  // Five blocks of rows on four threads, which the parallel for splits into
+  // fewer chunks than threads
+  constexpr index_t batches = 3;
+  constexpr index_t m = 320;
+  constexpr index_t n = 6;
+  tensor_t<TypeParam, 3> a{{batches, m, n}};
+  tensor_t<TypeParam, 3> c_host{{batches, n, n}};
+  tensor_t<TypeParam, 3> c_dev{{batches, n, n}};
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t i = 0; i < m; i++) {
+      for (index_t j = 0; j < n; j++) {
+        const float v = static_cast<float>((b + i * 7 + j * 3) % 11) / 4.0f;
+        a(b, i, j) = static_cast<TypeParam>(v);
+      }
+    }
+  }
+
+  cov(c_dev, a, 0);
+  cov(c_host, a, matxHostExecutor_t{4});
+  cudaStreamSynchronize(0);
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t i = 0; i < n; i++) {
+      for (index_t j = 0; j < n; j++) {
+        EXPECT_TRUE(MatXUtils::MatXTypeCompare(c_host(b, i, j), c_dev(b, i, j),
+                                               this->thresh));
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(CovarianceTestFloatTypes, ManyBatchesCov)
+{
+  MATX_ENTER_HANDLER();
+  // More batches than fit in one grid dimension
+  constexpr index_t batches = 70000;
+  constexpr index_t m = 4;
+  constexpr index_t n = 2;
+  tensor_t<TypeParam, 3> a{{batches, m, n}};
+  tensor_t<TypeParam, 3> c_host{{batches, n, n}};
+  tensor_t<TypeParam, 3> c_dev{{batches, n, n}};
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t i = 0; i < m; i++) {
+      for (index_t j = 0; j < n; j++) {
+        const float v = static_cast<float>((b + i * 5 + j * 3) % 7) / 4.0f;
+        a(b, i, j) = static_cast<TypeParam>(v);
+      }
+    }
+  }
+
+  cov(c_dev, a, 0);
+  cov(c_host, a, matxHostExecutor_t{});
+  cudaStreamSynchronize(0);
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t i = 0; i < n; i++) {
+      for (index_t j = 0; j < n; j++) {
+        EXPECT_TRUE(MatXUtils::MatXTypeCompare(c_host(b, i, j), c_dev(b, i, j),
+                                               this->thresh));
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
@@ -157,6 +157,83 @@ TYPED_TEST(FFTTestComplexNonHalfTypes, FFT1D1024R2C)
   MATX_EXIT_HANDLER();
 }
 
+TYPED_TEST(FFTTestComplexNonHalfTypes, FFT1D1000PadC2CHost)
+{
+  MATX_ENTER_HANDLER();
+  const index_t fft_dim = 1000;
+  this->pb->template InitAndRunTVGenerator<TypeParam>(
+      "00_transforms", "fft_operators", "fft_1d", {fft_dim, fft_dim * 3 / 2});
+  tensor_t<TypeParam, 1> av{{fft_dim}};
+  tensor_t<TypeParam, 1> avo{{fft_dim * 3 / 2}};
+  this->pb->NumpyToTensorView(av, "a_in");
+
+  fft(avo, av, matxHostExecutor_t{});
+
+  MATX_TEST_ASSERT_COMPARE(this->pb, avo, "a_out", this->thresh);
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(FFTTestComplexNonHalfTypes, FFT1D1024R2CHost)
+{
+  MATX_ENTER_HANDLER();
+  const index_t fft_dim = 1024;
+  using rtype = typename TypeParam::value_type;
+  this->pb->template InitAndRunTVGenerator<rtype>(
+      "00_transforms", "fft_operators", "rfft_1d", {fft_dim, fft_dim});
+
+  tensor_t<typename TypeParam::value_type, 1> av{{fft_dim}};
+  tensor_t<TypeParam, 1> avo{{fft_dim / 2 + 1}};
+  this->pb->NumpyToTensorView(av, "a_in");
+
+  fft(avo, av, matxHostExecutor_t{});
+
+  MATX_TEST_ASSERT_COMPARE(this->pb, avo, "a_out", this->thresh);
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(FFTTestComplexNonHalfTypes, FFT1D1024C2CHostGraph)
+{
+  MATX_ENTER_HANDLER();
+  const index_t fft_dim = 1024;
+  this->pb->template InitAndRunTVGenerator<TypeParam>(
+      "00_transforms", "fft_operators", "fft_1d", {fft_dim, fft_dim});
+
+  tensor_t<TypeParam, 1> av{{fft_dim}};
+  tensor_t<TypeParam, 1> avo{{fft_dim}};
+  tensor_t<TypeParam, 1> avi{{fft_dim}};
+  tensor_t<TypeParam, 1> avo2{{fft_dim}};
+  this->pb->NumpyToTensorView(av, "a_in");
+
+  // The inverse depends on the first transform, and the second transform of
+  // the same input is independent of both
+  matxHostGraph_t graph;
+  auto exec = graph.BeginCapture(matxHostExecutor_t{4});
+  fft(avo, av, exec);
+  ifft(avi, avo, exec);
+  fft(avo2, av, exec);
+  graph.EndCapture();
+
+  EXPECT_EQ(graph.Size(), static_cast<size_t>(3));
+  EXPECT_EQ(graph.NumEdges(), static_cast<size_t>(1));
+
+  for (int r = 0; r < 2; r++) {
+    for (index_t i = 0; i < fft_dim; i++) {
+      avo(i) = avi(i) = avo2(i) = TypeParam(0);
+    }
+
+    graph.Replay();
+
+    MATX_TEST_ASSERT_COMPARE(this->pb, avo, "a_out", this->thresh);
+    MATX_TEST_ASSERT_COMPARE(this->pb, avo2, "a_out", this->thresh);
+    for (index_t i = 0; i < fft_dim; i++) {
+      EXPECT_NEAR(avi(i).real(), av(i).real(), this->thresh);
+      EXPECT_NEAR(avi(i).imag(), av(i).imag(), this->thresh);
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
 TYPED_TEST(FFTTestComplexTypes, FFT2D16C2C)
 {
   MATX_ENTER_HANDLER();
@@ -140,4 +140,273 @@ TYPED_TEST(MatMulTestFloatTypes, MediumRect)
   // MATX_TEST_ASSERT_COMPARE(this->pb, c, "c", this->thresh);
 
   MATX_EXIT_HANDLER();
-}
\ No newline at end of file
+}
+template <typename TensorType>
+class MatMulTestFloatNonComplexNonHalfTypes : public ::testing::Test {
+};
+
+TYPED_TEST_SUITE(MatMulTestFloatNonComplexNonHalfTypes,
+                 MatXFloatNonComplexNonHalfTypes);
+
+TYPED_TEST(MatMulTestFloatNonComplexNonHalfTypes, HostGraphScope)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t m = 37;
+  constexpr index_t k = 19;
+  constexpr index_t n = 23;
+
+  tensor_t<TypeParam, 2> a{{m, k}};
+  tensor_t<TypeParam, 2> a2{{m, k}};
+  tensor_t<TypeParam, 2> b{{k, n}};
+  tensor_t<TypeParam, 2> c{{m, n}};
+  tensor_t<TypeParam, 2> c2{{m, n}};
+  tensor_t<TypeParam, 1> rows{{m}};
+  tensor_t<TypeParam, 0> total;
+
+  for (index_t i = 0; i < m; i++) {
+    for (index_t p = 0; p < k; p++) {
+      a(i, p) = static_cast<TypeParam>((i * 7 + p * 3) % 11) - 5;
+    }
+  }
+  for (index_t p = 0; p < k; p++) {
+    for (index_t j = 0; j < n; j++) {
+      b(p, j) = static_cast<TypeParam>((p * 5 + j) % 7) - 3;
+    }
+  }
+
+  // Calls made with a plain host executor inside the scope are recorded, and
+  // only run when the graph is replayed
+  matxHostGraph_t graph;
+  {
+    matxHostGraphScope_t scope{graph, matxHostExecutor_t{4}};
+    (a2 = a * 2 + 1).run(matxHostExecutor_t{});
+    matmul(c, a2, b, matxHostExecutor_t{});
+    copy(c2, c, matxHostExecutor_t{});
+    sum(rows, c2, matxHostExecutor_t{});
+    sum(total, c2, matxHostExecutor_t{});
+  }
+
+  EXPECT_EQ(graph.Size(), static_cast<size_t>(5));
+  EXPECT_EQ(graph.NumEdges(), static_cast<size_t>(4));
+
+  for (int r = 0; r < 2; r++) {
+    for (index_t i = 0; i < m; i++) {
+      for (index_t j = 0; j < n; j++) {
+        c(i, j) = c2(i, j) = 0;
+      }
+    }
+
+    graph.Replay();
+
+    TypeParam expected_total = 0;
+    for (index_t i = 0; i < m; i++) {
+      TypeParam expected_row = 0;
+      for (index_t j = 0; j < n; j++) {
+        TypeParam dot = 0;
+        for (index_t p = 0; p < k; p++) {
+          dot += (a(i, p) * 2 + 1) * b(p, j);
+        }
+        EXPECT_NEAR(c2(i, j), dot, 0.001);
+        expected_row += dot;
+      }
+      EXPECT_NEAR(rows(i), expected_row, 0.001);
+      expected_total += expected_row;
+    }
+    EXPECT_NEAR(total(), expected_total, 0.01);
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+template <typename TensorType>
+class EinsumTestFloatNonComplexNonHalfTypes : public ::testing::Test {
+};
+
+TYPED_TEST_SUITE(EinsumTestFloatNonComplexNonHalfTypes,
+                 MatXFloatNonComplexNonHalfTypes);
+
+TYPED_TEST(EinsumTestFloatNonComplexNonHalfTypes, ProjectChannels)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t nc = 3;
+  constexpr index_t np = 16;
+  constexpr index_t nk = 8;
+  constexpr index_t nb = 5;
+  tensor_t<TypeParam, 3> a{{nc, np, nk}};
+  tensor_t<TypeParam, 2> b{{nb, nk}};
+  tensor_t<TypeParam, 3> c{{nc, np, nb}};
+
+  for (index_t i = 0; i < nc; i++) {
+    for (index_t j = 0; j < np; j++) {
+      for (index_t k = 0; k < nk; k++) {
+        a(i, j, k) = static_cast<TypeParam>((i * np + j + k) % 7) - 3;
+      }
+    }
+  }
+  for (index_t i = 0; i < nb; i++) {
+    for (index_t k = 0; k < nk; k++) {
+      b(i, k) = static_cast<TypeParam>((i * nk + k) % 5) - 2;
+    }
+  }
+
+  einsum(c, "cpk,bk->cpb", a, b);
+  cudaStreamSynchronize(0);
+
+  for (index_t i = 0; i < nc; i++) {
+    for (index_t j = 0; j < np; j++) {
+      for (index_t l = 0; l < nb; l++) {
+        TypeParam sum = 0;
+        for (index_t k = 0; k < nk; k++) {
+          sum += a(i, j, k) * b(l, k);
+        }
+        EXPECT_NEAR(c(i, j, l), sum, 0.001);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(EinsumTestFloatNonComplexNonHalfTypes, StridedBatches)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t nb = 4;
+  constexpr index_t m = 6;
+  constexpr index_t k = 8;
+  constexpr index_t n = 10;
+  tensor_t<TypeParam, 3> a{{nb, m, k}};
+  tensor_t<TypeParam, 3> b{{nb, k, n}};
+  tensor_t<TypeParam, 3> c{{m, nb, n}};
+
+  for (index_t x = 0; x < nb; x++) {
+    for (index_t i = 0; i < m; i++) {
+      for (index_t l = 0; l < k; l++) {
+        a(x, i, l) = static_cast<TypeParam>((x + i * k + l) % 7) - 3;
+      }
+    }
+    for (index_t l = 0; l < k; l++) {
+      for (index_t j = 0; j < n; j++) {
+        b(x, l, j) = static_cast<TypeParam>((x * 3 + l + j) % 5) - 2;
+      }
+    }
+  }
+
+  // The batch is the middle dimension of C, so its batches are one row apart
+  einsum(c, "bik,bkj->ibj", a, b);
+  cudaStreamSynchronize(0);
+
+  for (index_t x = 0; x < nb; x++) {
+    for (index_t i = 0; i < m; i++) {
+      for (index_t j = 0; j < n; j++) {
+        TypeParam sum = 0;
+        for (index_t l = 0; l < k; l++) {
+          sum += a(x, i, l) * b(x, l, j);
+        }
+        EXPECT_NEAR(c(i, x, j), sum, 0.001);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(EinsumTestFloatNonComplexNonHalfTypes, LoopFallback)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t n = 8;
+  tensor_t<TypeParam, 2> a{{n, n}};
+  tensor_t<TypeParam, 3> b{{n, n, n}};
+  tensor_t<TypeParam, 1> c{{n}};
+  tensor_t<TypeParam, 1> d{{n}};
+
+  for (index_t i = 0; i < n; i++) {
+    for (index_t j = 0; j < n; j++) {
+      a(i, j) = static_cast<TypeParam>((i * n + j) % 7) - 3;
+      for (index_t l = 0; l < n; l++) {
+        b(i, j, l) = static_cast<TypeParam>((i + j * 3 + l) % 5) - 2;
+      }
+    }
+  }
+
+  // A repeated label takes the diagonal of a
+  auto b0 = b.template Slice<2>({0, 0, 0}, {matxEnd, matxEnd, matxDropDim});
+  einsum(c, "ii,ij->j", a, b0);
+
+  // The summed labels are in opposite orders in a and b, so they can't be
+  // merged into one K dimension
+  einsum(d, "ij,jil->l", a, b);
+  cudaStreamSynchronize(0);
+
+  for (index_t j = 0; j < n; j++) {
+    TypeParam sum = 0;
+    for (index_t i = 0; i < n; i++) {
+      sum += a(i, i) * b(i, j, 0);
+    }
+    EXPECT_NEAR(c(j), sum, 0.001);
+  }
+
+  for (index_t l = 0; l < n; l++) {
+    TypeParam sum = 0;
+    for (index_t i = 0; i < n; i++) {
+      for (index_t j = 0; j < n; j++) {
+        sum += a(i, j) * b(j, i, l);
+      }
+    }
+    EXPECT_NEAR(d(l), sum, 0.001);
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TYPED_TEST(EinsumTestFloatNonComplexNonHalfTypes, TiledFallback)
+{
+  MATX_ENTER_HANDLER();
+  constexpr index_t nx = 3;
+  constexpr index_t ni = 20;
+  constexpr index_t nj = 5;
+  constexpr index_t nk = 6;
+  constexpr index_t nl = 18;
+  tensor_t<TypeParam, 4> a{{nx, ni, nj, nk}};
+  tensor_t<TypeParam, 4> b{{nx, nk, nj, nl}};
+  tensor_t<TypeParam, 3> c{{ni, nx, nl}};
+
+  for (index_t x = 0; x < nx; x++) {
+    for (index_t i = 0; i < ni; i++) {
+      for (index_t j = 0; j < nj; j++) {
+        for (index_t k = 0; k < nk; k++) {
+          a(x, i, j, k) =
+              static_cast<TypeParam>((x + i * 3 + j + k * 2) % 7) - 3;
+        }
+      }
+    }
+    for (index_t k = 0; k < nk; k++) {
+      for (index_t j = 0; j < nj; j++) {
+        for (index_t l = 0; l < nl; l++) {
+          b(x, k, j, l) =
+              static_cast<TypeParam>((x * 3 + k + j * 2 + l) % 5) - 2;
+        }
+      }
+    }
+  }
+
+  // The summed labels are in opposite orders in a and b, so this runs as a
+  // loop nest tiled over i and l, with tiles that don't divide the sizes
+  einsum(c, "xijk,xkjl->ixl", a, b);
+  cudaStreamSynchronize(0);
+
+  for (index_t x = 0; x < nx; x++) {
+    for (index_t i = 0; i < ni; i++) {
+      for (index_t l = 0; l < nl; l++) {
+        TypeParam sum = 0;
+        for (index_t j = 0; j < nj; j++) {
+          for (index_t k = 0; k < nk; k++) {
+            sum += a(x, i, j, k) * b(x, k, j, l);
+          }
+        }
+        EXPECT_NEAR(c(i, x, l), sum, 0.001);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
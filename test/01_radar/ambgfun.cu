@@ -101,4 +101,79 @@ TEST_F(RadarAmbiguityFunction, CutDoppler)
   MATX_TEST_ASSERT_COMPARE(pb, doppler1d, "amf_doppler", 0.01);
 
   MATX_EXIT_HANDLER();
-}
\ No newline at end of file
+}
+
+TEST_F(RadarAmbiguityFunction, Cross)
+{
+  MATX_ENTER_HANDLER();
+
+  // Regenerate the vectors with a second signal y that differs from x
+  pb->RunTVGenerator("run_cross");
+  pb->NumpyToTensorView(xv, "x");
+  tensor_t<complex, 1> yv{{sig_size}};
+  pb->NumpyToTensorView(yv, "y");
+
+  const index_t nfreq =
+      (index_t)pow(2, std::ceil(std::log2(2 * sig_size - 1)));
+  tensor_t<float, 2> amf2dv({2 * sig_size - 1, nfreq});
+  signal::ambgfun(amf2dv, xv, yv, 1e3, signal::AMGBFUN_CUT_TYPE_2D, 1.0);
+  MATX_TEST_ASSERT_COMPARE(pb, amf2dv, "amf_2d", 0.01);
+
+  tensor_t<float, 2> amf_delay_v({1, nfreq});
+  signal::ambgfun(amf_delay_v, xv, yv, 1e3, signal::AMGBFUN_CUT_TYPE_DELAY,
+                  1.0);
+  auto delay1d = amf_delay_v.Slice<1>({0, 0}, {matxDropDim, matxEnd});
+  MATX_TEST_ASSERT_COMPARE(pb, delay1d, "amf_delay", 0.01);
+
+  tensor_t<float, 2> amf_doppler_v({1, xv.Size(0) * 2 - 1});
+  signal::ambgfun(amf_doppler_v, xv, yv, 1e3,
+                  signal::AMGBFUN_CUT_TYPE_DOPPLER, 1.0);
+  auto doppler1d = amf_doppler_v.Slice<1>({0, 0}, {matxDropDim, matxEnd});
+  MATX_TEST_ASSERT_COMPARE(pb, doppler1d, "amf_doppler", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(RadarAmbiguityFunction, PlanReuse)
+{
+  MATX_ENTER_HANDLER();
+
+  signal::matxAmbgFunPlan_t<complex> plan{sig_size, sig_size,
+                                          signal::AMGBFUN_CUT_TYPE_2D};
+  tensor_t<float, 2> amf2dv({plan.Rows(), plan.Cols()});
+
+  // Repeated calls reuse the plan's workspace and give the same result
+  for (int i = 0; i < 3; i++) {
+    plan.Exec(amf2dv, xv, 1e3, 1.0);
+    cudaStreamSynchronize(0);
+    MATX_TEST_ASSERT_COMPARE(pb, amf2dv, "amf_2d", 0.01);
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(RadarAmbiguityFunction, Host)
+{
+  MATX_ENTER_HANDLER();
+
+  const index_t nfreq =
+      (index_t)pow(2, std::ceil(std::log2(2 * sig_size - 1)));
+  tensor_t<float, 2> amf2dv({2 * sig_size - 1, nfreq});
+  signal::ambgfun(amf2dv, xv, 1e3, signal::AMGBFUN_CUT_TYPE_2D, 1.0,
+                  matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, amf2dv, "amf_2d", 0.01);
+
+  tensor_t<float, 2> amf_delay_v({1, nfreq});
+  signal::ambgfun(amf_delay_v, xv, 1e3, signal::AMGBFUN_CUT_TYPE_DELAY, 1.0,
+                  matxHostExecutor_t{});
+  auto delay1d = amf_delay_v.Slice<1>({0, 0}, {matxDropDim, matxEnd});
+  MATX_TEST_ASSERT_COMPARE(pb, delay1d, "amf_delay", 0.01);
+
+  tensor_t<float, 2> amf_doppler_v({1, xv.Size(0) * 2 - 1});
+  signal::ambgfun(amf_doppler_v, xv, 1e3, signal::AMGBFUN_CUT_TYPE_DOPPLER,
+                  1.0, matxHostExecutor_t{});
+  auto doppler1d = amf_doppler_v.Slice<1>({0, 0}, {matxDropDim, matxEnd});
+  MATX_TEST_ASSERT_COMPARE(pb, doppler1d, "amf_doppler", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
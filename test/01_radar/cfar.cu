@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "matx_radar.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+
+class CfarTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    for (index_t b = 0; b < batches; b++) {
+      for (index_t r = 0; r < rows; r++) {
+        for (index_t c = 0; c < cols; c++) {
+          xv(b, r, c) =
+              static_cast<float>(((b * 7 + r * 13 + c * 29) % 17) + 1) / 17.0f;
+        }
+      }
+
+      // A strong target in the middle of each channel
+      xv(b, rows / 2, cols / 2 + b) = 100.0f;
+    }
+  }
+
+  static constexpr index_t batches = 3;
+  static constexpr index_t rows = 24;
+  static constexpr index_t cols = 70;
+  static constexpr index_t guard_r = 1;
+  static constexpr index_t guard_c = 2;
+  static constexpr index_t ref_r = 2;
+  static constexpr index_t ref_c = 5;
+
+  tensor_t<float, 3> xv{{batches, rows, cols}};
+  tensor_t<int, 3> dets{{batches, rows, cols}};
+  tensor_t<float, 3> ba{{batches, rows, cols}};
+};
+
+/* Cell-averaging background matches a direct average over the window,
+ * including the clipped windows at the edges */
+TEST_F(CfarTests, CellAveraging)
+{
+  MATX_ENTER_HANDLER();
+
+  signal::cfar(dets, ba, xv, {guard_r, guard_c}, {ref_r, ref_c}, 1e-4);
+  cudaStreamSynchronize(0);
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t r = 0; r < rows; r++) {
+      for (index_t c = 0; c < cols; c++) {
+        double sum = 0;
+        index_t n = 0;
+        for (index_t i = r - guard_r - ref_r; i <= r + guard_r + ref_r; i++) {
+          for (index_t j = c - guard_c - ref_c; j <= c + guard_c + ref_c;
+               j++) {
+            if (i < 0 || j < 0 || i >= rows || j >= cols ||
+                (std::abs(i - r) <= guard_r && std::abs(j - c) <= guard_c)) {
+              continue;
+            }
+            sum += xv(b, i, j);
+            n++;
+          }
+        }
+
+        ASSERT_NEAR(ba(b, r, c), sum / static_cast<double>(n), 1e-4);
+        ASSERT_EQ(dets(b, r, c), (r == rows / 2 && c == cols / 2 + b) ? 1 : 0);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Host and device give the same result for every detector type */
+TEST_F(CfarTests, HostMatchesDevice)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<int, 3> hdets{{batches, rows, cols}};
+  tensor_t<float, 3> hba{{batches, rows, cols}};
+
+  for (auto type : {signal::CFAR_TYPE_CA, signal::CFAR_TYPE_GO,
+                    signal::CFAR_TYPE_SO, signal::CFAR_TYPE_OS}) {
+    signal::cfar(dets, ba, xv, {guard_r, guard_c}, {ref_r, ref_c}, 1e-4, type);
+    cudaStreamSynchronize(0);
+    signal::cfar(hdets, hba, xv, {guard_r, guard_c}, {ref_r, ref_c}, 1e-4,
+                 type, matxHostExecutor_t{});
+
+    for (index_t b = 0; b < batches; b++) {
+      ASSERT_EQ(hdets(b, rows / 2, cols / 2 + b), 1);
+      for (index_t r = 0; r < rows; r++) {
+        for (index_t c = 0; c < cols; c++) {
+          ASSERT_NEAR(ba(b, r, c), hba(b, r, c), 1e-4);
+          ASSERT_EQ(dets(b, r, c), hdets(b, r, c));
+        }
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
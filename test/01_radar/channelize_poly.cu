@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "matx_signal.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+using complex = cuda::std::complex<float>;
+
+class ChannelizePolyTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    for (index_t k = 0; k < taps; k++) {
+      hv(k) = cosf(0.05f * static_cast<float>(k - taps / 2)) /
+              static_cast<float>(taps);
+    }
+
+    for (index_t b = 0; b < batches; b++) {
+      for (index_t i = 0; i < sig_size; i++) {
+        float t = static_cast<float>(i + b * 13);
+        xv(b, i) = complex{sinf(0.41f * t), cosf(0.07f * t * t / 50.0f)};
+      }
+    }
+  }
+
+  // Direct filter bank output for channel c of frame n of row b
+  cuda::std::complex<double> Ref(index_t b, index_t n, index_t c,
+                                 index_t channels, index_t decimation)
+  {
+    cuda::std::complex<double> sum = 0;
+    const index_t t = n * decimation;
+    for (index_t k = 0; k < taps && k <= t; k++) {
+      const double ph = -2.0 * M_PI * static_cast<double>(c * (t - k)) /
+                        static_cast<double>(channels);
+      sum += static_cast<double>(hv(k)) *
+             cuda::std::complex<double>(xv(b, t - k)) *
+             cuda::std::complex<double>{cos(ph), sin(ph)};
+    }
+    return sum;
+  }
+
+  template <typename OutType>
+  void CheckOutput(OutType &y, index_t channels, index_t decimation)
+  {
+    for (index_t b = 0; b < batches; b++) {
+      for (index_t n = 0; n < y.Size(1); n++) {
+        for (index_t c = 0; c < channels; c++) {
+          auto ref = Ref(b, n, c, channels, decimation);
+          ASSERT_NEAR(y(b, n, c).real(), ref.real(), 1e-3);
+          ASSERT_NEAR(y(b, n, c).imag(), ref.imag(), 1e-3);
+        }
+      }
+    }
+  }
+
+  static constexpr index_t taps = 64;
+  static constexpr index_t batches = 2;
+  static constexpr index_t sig_size = 500;
+
+  tensor_t<float, 1> hv{{taps}};
+  tensor_t<complex, 2> xv{{batches, sig_size}};
+};
+
+TEST_F(ChannelizePolyTests, CriticallySampled)
+{
+  MATX_ENTER_HANDLER();
+
+  constexpr index_t channels = 8;
+  tensor_t<complex, 3> y{{batches, (sig_size + channels - 1) / channels,
+                          channels}};
+  signal::channelize_poly(y, xv, hv, channels);
+  cudaStreamSynchronize(0);
+  CheckOutput(y, channels, channels);
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(ChannelizePolyTests, Oversampled)
+{
+  MATX_ENTER_HANDLER();
+
+  constexpr index_t channels = 12;
+  constexpr index_t decimation = 8;
+  tensor_t<complex, 3> y{{batches, (sig_size + decimation - 1) / decimation,
+                          channels}};
+  signal::channelize_poly(y, xv, hv, decimation);
+  cudaStreamSynchronize(0);
+  CheckOutput(y, channels, decimation);
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Streaming in uneven blocks, including blocks shorter than a frame, matches
+ * channelizing the whole signal at once */
+TEST_F(ChannelizePolyTests, Streaming)
+{
+  MATX_ENTER_HANDLER();
+
+  constexpr index_t channels = 12;
+  constexpr index_t decimation = 8;
+  constexpr index_t frames = (sig_size + decimation - 1) / decimation;
+  tensor_t<complex, 3> y{{batches, frames, channels}};
+  signal::matxChannelizePolyPlan_t<complex, float> plan{hv, channels,
+                                                        decimation, batches};
+
+  const index_t blocks[] = {1, 5, 123, 3, 200, 168};
+  index_t pos = 0;
+  index_t fpos = 0;
+  for (auto len : blocks) {
+    tensor_t<complex, 2> block{{batches, len}};
+    tensor_t<complex, 3> yb{{batches, plan.OutputSize(len) + 1, channels}};
+    for (index_t b = 0; b < batches; b++) {
+      for (index_t i = 0; i < len; i++) {
+        block(b, i) = xv(b, pos + i);
+      }
+    }
+
+    const index_t n = plan.Exec(yb, block);
+    cudaStreamSynchronize(0);
+
+    for (index_t b = 0; b < batches; b++) {
+      for (index_t f = 0; f < n; f++) {
+        for (index_t c = 0; c < channels; c++) {
+          y(b, fpos + f, c) = yb(b, f, c);
+        }
+      }
+    }
+    pos += len;
+    fpos += n;
+  }
+
+  ASSERT_EQ(fpos, frames);
+  CheckOutput(y, channels, decimation);
+
+  MATX_EXIT_HANDLER();
+}
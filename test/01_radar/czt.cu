@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "matx_pybind.h"
+#include "matx_signal.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+using complex = cuda::std::complex<double>;
+
+class CztTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    pb = std::make_unique<MatXPybind>();
+    pb->InitAndRunTVGenerator<complex>("01_signal", "czt", "run",
+                                       {rows, sig_size, bins});
+
+    pb->NumpyToTensorView(xv, "x");
+  }
+
+  void TearDown() { pb.reset(); }
+
+  static constexpr index_t rows = 6;
+  static constexpr index_t sig_size = 100;
+  static constexpr index_t bins = 37;
+
+  tensor_t<complex, 2> xv{{rows, sig_size}};
+  std::unique_ptr<MatXPybind> pb;
+};
+
+/* Default contour is the DFT */
+TEST_F(CztTests, UnitCircle)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<complex, 2> out{{rows, sig_size}};
+  signal::czt(out, xv, sig_size);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y_fft", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Fewer output points than inputs on an arc inside the unit circle */
+TEST_F(CztTests, Spiral)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<complex, 2> out{{rows, bins}};
+  signal::czt(out, xv, bins, cuda::std::exp(complex{0, -0.02}),
+              cuda::std::exp(complex{0, 0.5}));
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Higher rank batches are flattened into rows */
+TEST_F(CztTests, ZoomRank3)
+{
+  MATX_ENTER_HANDLER();
+
+  auto x3 = xv.View({2, rows / 2, sig_size});
+  tensor_t<complex, 2> out{{rows, bins}};
+  auto out3 = out.View({2, rows / 2, bins});
+  signal::zoomfft(out3, x3, 100.0, 150.0, 1000.0);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y_zoom", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(CztTests, Host)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<complex, 2> out{{rows, bins}};
+  signal::czt(out, xv, bins, cuda::std::exp(complex{0, -0.02}),
+              cuda::std::exp(complex{0, 0.5}), matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y", 0.01);
+
+  signal::zoomfft(out, xv, 100.0, 150.0, 1000.0, false, matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y_zoom", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
@@ -70,3 +70,76 @@ TEST_F(DctTests, Real1DN100)
 
   MATX_EXIT_HANDLER();
 }
+
+class DctBatchedTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    pb = std::make_unique<MatXPybind>();
+    pb->InitAndRunTVGenerator<double>("01_signal", "dct_batched", "run",
+                                      {rows, sig_size});
+
+    pb->NumpyToTensorView(xv, "x");
+  }
+
+  void TearDown() { pb.reset(); }
+
+  static constexpr index_t rows = 6;
+  static constexpr index_t sig_size = 100;
+
+  tensor_t<double, 2> xv{{rows, sig_size}};
+  std::unique_ptr<MatXPybind> pb;
+};
+
+/* DCT-II, III and IV of every row of a batch */
+TEST_F(DctBatchedTests, Types)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<double, 2> out{{rows, sig_size}};
+  signal::dct(out, xv, signal::DCT_TYPE_II);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "Y2", 0.01);
+
+  signal::dct(out, xv, signal::DCT_TYPE_III);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "Y3", 0.01);
+
+  signal::dct(out, xv, signal::DCT_TYPE_IV);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "Y4", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Higher rank batches are flattened into rows */
+TEST_F(DctBatchedTests, Rank3)
+{
+  MATX_ENTER_HANDLER();
+
+  auto x3 = xv.View({2, rows / 2, sig_size});
+  tensor_t<double, 2> out{{rows, sig_size}};
+  auto out3 = out.View({2, rows / 2, sig_size});
+  signal::dct(out3, x3);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "Y2", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(DctBatchedTests, Host)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<double, 2> out{{rows, sig_size}};
+  signal::dct(out, xv, matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "Y2", 0.01);
+
+  signal::dct(out, xv, signal::DCT_TYPE_III, matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "Y3", 0.01);
+
+  signal::dct(out, xv, signal::DCT_TYPE_IV, matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "Y4", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
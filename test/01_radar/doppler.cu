@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "matx_radar.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+using complex = cuda::std::complex<float>;
+
+class DopplerTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    for (index_t c = 0; c < channels; c++) {
+      for (index_t p = 0; p < pulses; p++) {
+        for (index_t r = 0; r < bins; r++) {
+          float t = static_cast<float>(c * 7 + r);
+          cube(c, p, r) = complex{sinf(0.37f * t + 0.2f * p),
+                                  cosf(0.11f * t - 0.05f * p * p)};
+        }
+      }
+    }
+  }
+
+  // Direct DFT of the windowed pulses of one range bin, zero-padded to nfft
+  cuda::std::complex<double> Ref(index_t c, index_t r, index_t k, index_t nfft,
+                                 const std::vector<double> &w)
+  {
+    cuda::std::complex<double> sum = 0;
+    for (index_t p = 0; p < static_cast<index_t>(w.size()); p++) {
+      double ph = -2.0 * M_PI * static_cast<double>((k * p) % nfft) / nfft;
+      sum += w[p] * cuda::std::complex<double>(cube(c, p, r)) *
+             cuda::std::complex<double>{cos(ph), sin(ph)};
+    }
+    return sum;
+  }
+
+  static constexpr index_t channels = 3;
+  static constexpr index_t pulses = 30;
+  static constexpr index_t bins = 67;
+
+  tensor_t<complex, 3> cube{{channels, pulses, bins}};
+};
+
+/* Transforming along the pulse axis with zero padding matches the windowed
+ * DFT of each range bin, and a second call reuses the cached plan */
+TEST_F(DopplerTests, PulseAxis)
+{
+  MATX_ENTER_HANDLER();
+
+  const index_t nfft = 32;
+  tensor_t<complex, 3> out{{channels, nfft, bins}};
+
+  for (int i = 0; i < 2; i++) {
+    signal::doppler(out, cube, 1);
+    cudaStreamSynchronize(0);
+  }
+
+  auto w = WindowCoeffs(WINDOW_TYPE_HAMMING, pulses);
+
+  for (index_t c = 0; c < channels; c++) {
+    for (index_t k = 0; k < nfft; k++) {
+      for (index_t r = 0; r < bins; r++) {
+        auto ref = Ref(c, r, k, nfft, w);
+        ASSERT_NEAR(out(c, k, r).real(), ref.real(), 1e-3);
+        ASSERT_NEAR(out(c, k, r).imag(), ref.imag(), 1e-3);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* The last axis of a permuted view, so the rows are strided and the load
+ * goes through the untiled path */
+TEST_F(DopplerTests, PermutedLastAxis)
+{
+  MATX_ENTER_HANDLER();
+
+  auto in = cube.Permute({0, 2, 1});
+  tensor_t<complex, 3> out{{channels, bins, pulses}};
+
+  signal::doppler(out, in, 2, WINDOW_TYPE_RECT);
+  cudaStreamSynchronize(0);
+
+  auto w = WindowCoeffs(WINDOW_TYPE_RECT, pulses);
+
+  for (index_t c = 0; c < channels; c++) {
+    for (index_t r = 0; r < bins; r++) {
+      for (index_t k = 0; k < pulses; k++) {
+        auto ref = Ref(c, r, k, pulses, w);
+        ASSERT_NEAR(out(c, r, k).real(), ref.real(), 1e-3);
+        ASSERT_NEAR(out(c, r, k).imag(), ref.imag(), 1e-3);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Rank 4 in place, where the first pulses of the output are the input */
+TEST_F(DopplerTests, Rank4InPlace)
+{
+  MATX_ENTER_HANDLER();
+
+  const index_t len = 20;
+  tensor_t<complex, 4> x{{2, channels, pulses, bins}};
+  for (index_t b = 0; b < 2; b++) {
+    for (index_t c = 0; c < channels; c++) {
+      for (index_t p = 0; p < pulses; p++) {
+        for (index_t r = 0; r < bins; r++) {
+          x(b, c, p, r) = cube(c, p, r);
+        }
+      }
+    }
+  }
+
+  auto in = x.Slice({0, 0, 0, 0}, {2, channels, len, bins});
+  signal::doppler(x, in, 2, WINDOW_TYPE_HAMMING);
+  cudaStreamSynchronize(0);
+
+  auto w = WindowCoeffs(WINDOW_TYPE_HAMMING, len);
+
+  for (index_t b = 0; b < 2; b++) {
+    for (index_t c = 0; c < channels; c++) {
+      for (index_t k = 0; k < pulses; k++) {
+        for (index_t r = 0; r < bins; r++) {
+          auto ref = Ref(c, r, k, pulses, w);
+          ASSERT_NEAR(x(b, c, k, r).real(), ref.real(), 1e-3);
+          ASSERT_NEAR(x(b, c, k, r).imag(), ref.imag(), 1e-3);
+        }
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Windows with parameters are passed as a cached table */
+TEST_F(DopplerTests, TaylorTable)
+{
+  MATX_ENTER_HANDLER();
+
+  const index_t nfft = 64;
+  tensor_t<complex, 3> out{{channels, nfft, bins}};
+
+  auto &win = GetWindowTable<float>(WINDOW_TYPE_TAYLOR, pulses, 35.0, 5);
+  signal::doppler(out, cube, 1, win);
+  cudaStreamSynchronize(0);
+
+  auto w = WindowCoeffs(WINDOW_TYPE_TAYLOR, pulses, 35.0, 5);
+  for (index_t c = 0; c < channels; c++) {
+    for (index_t k = 0; k < nfft; k++) {
+      for (index_t r = 0; r < bins; r++) {
+        auto ref = Ref(c, r, k, nfft, w);
+        ASSERT_NEAR(out(c, k, r).real(), ref.real(), 1e-3);
+        ASSERT_NEAR(out(c, k, r).imag(), ref.imag(), 1e-3);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
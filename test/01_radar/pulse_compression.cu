@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "matx_radar.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+using complex = cuda::std::complex<float>;
+
+class PulseCompressionTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    for (index_t k = 0; k < taps; k++) {
+      float ph = 0.01f * static_cast<float>(k * k);
+      wv(k) = complex{cosf(ph), sinf(ph)};
+    }
+
+    for (index_t c = 0; c < channels; c++) {
+      for (index_t i = 0; i < sig_size; i++) {
+        float t = static_cast<float>(i + c * 17);
+        xv(c, i) = complex{sinf(0.37f * t), cosf(0.11f * t * t / 100.0f)};
+      }
+    }
+  }
+
+  // Direct matched filter output for sample n of channel c
+  cuda::std::complex<double> Ref(index_t c, index_t n)
+  {
+    double energy = 0;
+    cuda::std::complex<double> sum = 0;
+    for (index_t k = 0; k < taps; k++) {
+      cuda::std::complex<double> w = wv(k);
+      energy += cuda::std::norm(w);
+
+      index_t m = n - (taps - 1) + k;
+      if (m >= 0) {
+        sum += cuda::std::conj(w) * cuda::std::complex<double>(xv(c, m));
+      }
+    }
+    return sum / sqrt(energy);
+  }
+
+  // Feed the signal in uneven chunks, filtering each chunk in place
+  template <typename Plan> void RunChunks(Plan &plan, tensor_t<complex, 2> &y)
+  {
+    const index_t chunks[] = {1, 37, 250, 3, 400, 309};
+    index_t pos = 0;
+    for (auto len : chunks) {
+      tensor_t<complex, 2> chunk{{channels, len}};
+      for (index_t c = 0; c < channels; c++) {
+        for (index_t i = 0; i < len; i++) {
+          chunk(c, i) = xv(c, pos + i);
+        }
+      }
+
+      plan.Exec(chunk, chunk);
+      cudaStreamSynchronize(0);
+
+      for (index_t c = 0; c < channels; c++) {
+        for (index_t i = 0; i < len; i++) {
+          y(c, pos + i) = chunk(c, i);
+        }
+      }
+      pos += len;
+    }
+  }
+
+  static constexpr index_t taps = 45;
+  static constexpr index_t channels = 3;
+  static constexpr index_t sig_size = 1000;
+
+  tensor_t<complex, 1> wv{{taps}};
+  tensor_t<complex, 2> xv{{channels, sig_size}};
+};
+
+/* Streaming in chunks, including chunks longer than one pass, matches the
+ * direct filter over the whole signal */
+TEST_F(PulseCompressionTests, StreamingDevice)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<complex, 2> y{{channels, sig_size}};
+  signal::matxPulseCompressionPlan_t<complex> plan{wv, channels, 128};
+  RunChunks(plan, y);
+
+  for (index_t c = 0; c < channels; c++) {
+    for (index_t n = 0; n < sig_size; n++) {
+      auto ref = Ref(c, n);
+      ASSERT_NEAR(y(c, n).real(), ref.real(), 1e-3);
+      ASSERT_NEAR(y(c, n).imag(), ref.imag(), 1e-3);
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(PulseCompressionTests, StreamingHost)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<complex, 2> y{{channels, sig_size}};
+
+  // Non power of two block size runs through the Bluestein host FFT
+  signal::matxPulseCompressionPlan_t<complex> plan{wv, channels, 128, 100,
+                                                   matxHostExecutor_t{}};
+  RunChunks(plan, y);
+
+  for (index_t c = 0; c < channels; c++) {
+    for (index_t n = 0; n < sig_size; n++) {
+      auto ref = Ref(c, n);
+      ASSERT_NEAR(y(c, n).real(), ref.real(), 1e-3);
+      ASSERT_NEAR(y(c, n).imag(), ref.imag(), 1e-3);
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
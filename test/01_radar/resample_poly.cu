@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "matx_pybind.h"
+#include "matx_signal.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+
+class ResamplePolyTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    pb = std::make_unique<MatXPybind>();
+    pb->InitAndRunTVGenerator<double>("01_signal", "resample_poly", "run",
+                                      {batches, sig_size, up, down});
+
+    pb->NumpyToTensorView(xv, "x");
+    pb->NumpyToTensorView(hv, "h");
+  }
+
+  void TearDown() { pb.reset(); }
+
+  static constexpr index_t batches = 2;
+  static constexpr index_t sig_size = 100;
+  static constexpr index_t up = 3;
+  static constexpr index_t down = 2;
+  static constexpr index_t out_size = (sig_size * up + down - 1) / down;
+
+  tensor_t<double, 2> xv{{batches, sig_size}};
+  tensor_t<double, 1> hv{{31}};
+  std::unique_ptr<MatXPybind> pb;
+};
+
+TEST_F(ResamplePolyTests, DefaultFilter)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<double, 2> out{{batches, out_size}};
+  signal::resample_poly(out, xv, up, down);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(ResamplePolyTests, CustomFilter)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<double, 2> out{{batches, out_size}};
+  signal::resample_poly(out, xv, up, down, hv);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y_taps", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(ResamplePolyTests, Host)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<double, 2> out{{batches, out_size}};
+  signal::resample_poly(out, xv, up, down, matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y", 0.01);
+
+  signal::resample_poly(out, xv, up, down, hv, matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y_taps", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+TEST_F(ResamplePolyTests, Decimate)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<double, 2> out{{batches, (sig_size + down - 1) / down}};
+  signal::decimate(out, xv, down);
+  cudaStreamSynchronize(0);
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y_dec", 0.01);
+
+  signal::decimate(out, xv, down, matxHostExecutor_t{});
+  MATX_TEST_ASSERT_COMPARE(pb, out, "y_dec", 0.01);
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Streaming in uneven chunks matches the causal filter over the whole signal */
+TEST_F(ResamplePolyTests, Streaming)
+{
+  MATX_ENTER_HANDLER();
+
+  signal::matxResamplePolyPlan_t<double, double> dplan{hv, up, down, batches};
+  signal::matxResamplePolyPlan_t<double, double> hplan{hv, up, down, batches,
+                                                       matxHostExecutor_t{}};
+
+  for (auto *plan : {&dplan, &hplan}) {
+    tensor_t<double, 2> out{{batches, out_size}};
+    const index_t chunks[] = {1, 7, 30, 2, 60};
+    index_t pos = 0;
+    index_t opos = 0;
+    for (auto len : chunks) {
+      tensor_t<double, 2> chunk{{batches, len}};
+      tensor_t<double, 2> y{{batches, plan->OutputSize(len)}};
+      for (index_t b = 0; b < batches; b++) {
+        for (index_t i = 0; i < len; i++) {
+          chunk(b, i) = xv(b, pos + i);
+        }
+      }
+
+      const index_t n = plan->Exec(y, chunk);
+      cudaStreamSynchronize(0);
+
+      for (index_t b = 0; b < batches; b++) {
+        for (index_t i = 0; i < n; i++) {
+          out(b, opos + i) = y(b, i);
+        }
+      }
+      pos += len;
+      opos += n;
+    }
+
+    ASSERT_EQ(opos, out_size);
+    MATX_TEST_ASSERT_COMPARE(pb, out, "y_causal", 0.01);
+  }
+
+  MATX_EXIT_HANDLER();
+}
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2021, NVIDIA Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+/////////////////////////////////////////////////////////////////////////////////
+
+#include "assert.h"
+#include "matx.h"
+#include "matx_signal.h"
+#include "utilities.h"
+#include "gtest/gtest.h"
+
+using namespace matx;
+using complex = cuda::std::complex<float>;
+
+class StftTests : public ::testing::Test {
+protected:
+  void SetUp() override
+  {
+    for (index_t b = 0; b < batches; b++) {
+      for (index_t i = 0; i < sig_size; i++) {
+        float t = static_cast<float>(i);
+        xv(b, i) = cosf(0.3f * t * static_cast<float>(b + 1)) +
+                   0.25f * sinf(1.7f * t);
+      }
+    }
+
+    for (index_t k = 0; k < nperseg; k++) {
+      win(k) = 0.54f - 0.46f * cosf(2.0f * static_cast<float>(M_PI) *
+                                    static_cast<float>(k) /
+                                    static_cast<float>(nperseg - 1));
+    }
+  }
+
+  // Reference DFT of one windowed, zero padded frame
+  std::complex<double> RefBin(index_t b, index_t f, index_t k)
+  {
+    std::complex<double> sum = 0;
+    for (index_t n = 0; n < nperseg; n++) {
+      double v = static_cast<double>(xv(b, f * nstep + n)) *
+                 static_cast<double>(win(n));
+      double ph = -2.0 * M_PI * static_cast<double>(k * n) /
+                  static_cast<double>(nfft);
+      sum += v * std::complex<double>(cos(ph), sin(ph));
+    }
+    return sum;
+  }
+
+  static constexpr index_t batches = 2;
+  static constexpr index_t sig_size = 200;
+  static constexpr index_t nperseg = 32;
+  static constexpr index_t noverlap = 8;
+  static constexpr index_t nstep = nperseg - noverlap;
+  static constexpr index_t nfft = 64;
+  static constexpr index_t frames = (sig_size - nperseg) / nstep + 1;
+
+  tensor_t<float, 2> xv{{batches, sig_size}};
+  tensor_t<float, 1> win{{nperseg}};
+};
+
+/* Batched real STFT with overlap and zero padding matches a direct DFT of
+ * each windowed frame */
+TEST_F(StftTests, RealBatched)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<complex, 3> out{{batches, frames, nfft / 2 + 1}};
+  signal::stft(out, xv, win, nperseg, noverlap);
+  cudaStreamSynchronize(0);
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t f = 0; f < frames; f++) {
+      for (index_t k = 0; k < out.Size(2); k++) {
+        auto ref = RefBin(b, f, k);
+        ASSERT_NEAR(out(b, f, k).real(), ref.real(), 1e-3);
+        ASSERT_NEAR(out(b, f, k).imag(), ref.imag(), 1e-3);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* A complex output that isn't contiguous goes through the plan's spectrum
+ * buffer and gets the same result as the direct FFT */
+TEST_F(StftTests, StridedOutput)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<complex, 3> tf{{batches, nfft / 2 + 1, frames}};
+  auto out = tf.Permute({0, 2, 1});
+  signal::stft(out, xv, win, nperseg, noverlap);
+  cudaStreamSynchronize(0);
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t f = 0; f < frames; f++) {
+      for (index_t k = 0; k < out.Size(2); k++) {
+        auto ref = RefBin(b, f, k);
+        ASSERT_NEAR(tf(b, k, f).real(), ref.real(), 1e-3);
+        ASSERT_NEAR(tf(b, k, f).imag(), ref.imag(), 1e-3);
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
+
+/* Spectrogram is the power of the STFT, and a generator window gives the same
+ * result as a tensor window */
+TEST_F(StftTests, Spectrogram)
+{
+  MATX_ENTER_HANDLER();
+
+  tensor_t<float, 3> sxx{{batches, frames, nfft / 2 + 1}};
+  tensor_t<float, 3> sxx_gen{{batches, frames, nfft / 2 + 1}};
+  signal::spectrogram(sxx, xv, win, nperseg, noverlap);
+  signal::spectrogram(sxx_gen, xv, hamming_x<float>({nperseg}), nperseg,
+                      noverlap);
+  cudaStreamSynchronize(0);
+
+  for (index_t b = 0; b < batches; b++) {
+    for (index_t f = 0; f < frames; f++) {
+      for (index_t k = 0; k < sxx.Size(2); k++) {
+        double ref = std::norm(RefBin(b, f, k));
+        ASSERT_NEAR(sxx(b, f, k), ref, 1e-3 * (1.0 + ref));
+        ASSERT_NEAR(sxx_gen(b, f, k), ref, 1e-3 * (1.0 + ref));
+      }
+    }
+  }
+
+  MATX_EXIT_HANDLER();
+}
@@ -1,6 +1,7 @@
 #!/usr/bin/env python3
 
 import numpy as np
+from scipy import signal as ss
 from typing import Dict, List
 
 
@@ -45,12 +46,18 @@ class window:
         self.hanning = np.hanning(self.win_size)
         self.blackman = np.blackman(self.win_size)
         self.bartlett = np.bartlett(self.win_size)
+        self.kaiser = np.kaiser(self.win_size, 14)
+        self.chebwin = ss.windows.chebwin(self.win_size, 60)
+        self.taylor = ss.windows.taylor(self.win_size, 4, 30)
 
         return {
             'hamming': self.hamming,
             'hanning': self.hanning,
             'blackman': self.blackman,
-            'bartlett': self.bartlett
+            'bartlett': self.bartlett,
+            'kaiser': self.kaiser,
+            'chebwin': self.chebwin,
+            'taylor': self.taylor
         }
 
 
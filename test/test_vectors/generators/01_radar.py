@@ -136,7 +136,15 @@ class ambgfun:
     def run(self):
         siglen = self.size[0]
         x = matx_common.randn_ndarray((siglen,), self.dtype)
-        y = None
+        return self.amf(x, None)
+
+    def run_cross(self):
+        siglen = self.size[0]
+        x = matx_common.randn_ndarray((siglen,), self.dtype)
+        y = matx_common.randn_ndarray((siglen,), self.dtype)
+        return self.amf(x, y)
+
+    def amf(self, x, y):
         fs = 1e3
         cutValue = 1.0
 
@@ -173,6 +181,7 @@ class ambgfun:
             y = x
             ynorm = xnorm
         else:
+            y = cp.asarray(y, dtype=x.dtype)
             ynorm = y / cp.linalg.norm(y)
 
         len_seq = len(xnorm) + len(ynorm)
@@ -223,4 +232,5 @@ class ambgfun:
             'amf_delay': cp.asnumpy(amf_delay),
             'amf_doppler': cp.asnumpy(amf_doppler),
             'x': cp.asnumpy(x),
+            'y': cp.asnumpy(y),
         }
@@ -2,6 +2,7 @@
 
 import numpy as np
 from scipy import fft as sf
+from scipy import signal as ss
 from numpy import random
 from typing import Dict, List
 
@@ -22,3 +23,61 @@ class dct:
             'x': x,
             'Y': Y
         }
+
+
+class dct_batched:
+    def __init__(self, dtype: str, size: List[int]):
+        self.size = size
+        self.dtype = dtype
+
+    def run(self):
+        rows, N = self.size
+
+        x = np.random.randn(rows, N)
+
+        return {
+            'x': x,
+            'Y2': sf.dct(x, type=2, axis=-1),
+            'Y3': sf.dct(x, type=3, axis=-1),
+            'Y4': sf.dct(x, type=4, axis=-1),
+        }
+
+
+class czt:
+    def __init__(self, dtype: str, size: List[int]):
+        self.size = size
+        self.dtype = dtype
+
+    def run(self):
+        rows, N, M = self.size
+
+        x = np.random.randn(rows, N) + 1j * np.random.randn(rows, N)
+
+        return {
+            'x': x,
+            'y_fft': ss.czt(x, axis=-1),
+            'y': ss.czt(x, M, np.exp(-0.02j), np.exp(0.5j), axis=-1),
+            'y_zoom': ss.zoomfft(x, [100, 150], M, fs=1000, axis=-1),
+        }
+
+
+class resample_poly:
+    def __init__(self, dtype: str, size: List[int]):
+        self.size = size
+        self.dtype = dtype
+
+    def run(self):
+        batches, N, up, down = self.size
+
+        x = np.random.randn(batches, N)
+        h = ss.firwin(31, 1.0 / max(up, down))
+        nout = (N * up + down - 1) // down
+
+        return {
+            'x': x,
+            'h': h,
+            'y': ss.resample_poly(x, up, down, axis=1),
+            'y_taps': ss.resample_poly(x, up, down, axis=1, window=h),
+            'y_dec': ss.decimate(x, down, ftype='fir', axis=1),
+            'y_causal': up * ss.upfirdn(h, x, up, down, axis=1)[:, :nout],
+        }